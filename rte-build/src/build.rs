@@ -1,35 +1,87 @@
 use std::env;
+use std::fs;
 use std::path::Path;
 use std::process::Command;
 
 use num_cpus;
 
+use crate::cpu::dpdk_machine;
+use crate::rte::{MACHINE, RTE_ARCH, RTE_MACHINE, RTE_OS, RTE_TOOLCHAIN};
+
+/// Build DPDK for `RTE_MACHINE` in the `rte_target` directory of `rte_sdk`.
+///
+/// DPDK only ships the defconfig of the `native` machine, so the target is configured from it
+/// and `CONFIG_RTE_MACHINE` is overridden for the other machines.
 pub fn build_dpdk(rte_sdk: &Path, rte_target: &str) {
     let debug_mode = env::var("DEBUG")
         .map(|s| s.parse().unwrap_or_default())
         .unwrap_or_default();
+    let defconfig = format!("{}-{}-{}app-{}", *RTE_ARCH, MACHINE, *RTE_OS, *RTE_TOOLCHAIN);
+    let (machine, march) = dpdk_machine(&RTE_MACHINE);
 
     info!(
-        "building {} mode DPDK {} @ {:?}",
+        "building {} mode DPDK {} for machine {} @ {:?}",
         if debug_mode { "debug" } else { "release" },
         rte_target,
+        *RTE_MACHINE,
         rte_sdk
     );
 
-    Command::new("make")
-        .arg("install")
-        .arg(format!("T={}", rte_target))
-        .args(&["-j", &num_cpus::get().to_string()])
-        .env("CONFIG_RTE_BUILD_COMBINE_LIBS", "y")
-        .env(
-            "EXTRA_CFLAGS",
-            if debug_mode {
-                "-fPIC -fkeep-inline-functions -O0 -g -ggdb"
-            } else {
-                "-fPIC -fkeep-inline-functions -O"
-            },
-        )
-        .current_dir(rte_sdk)
-        .status()
-        .unwrap_or_else(|e| panic!("failed to build DPDK: {}", e));
+    make(
+        Command::new("make")
+            .arg("config")
+            .arg(format!("T={}", defconfig))
+            .arg(format!("O={}", rte_target))
+            .current_dir(rte_sdk),
+    );
+
+    let config = rte_sdk.join(rte_target).join(".config");
+
+    set_config(&config, "CONFIG_RTE_MACHINE", &format!("\"{}\"", machine));
+    set_config(&config, "CONFIG_RTE_BUILD_COMBINE_LIBS", "y");
+
+    let mut extra_cflags = if debug_mode {
+        "-fPIC -fkeep-inline-functions -O0 -g -ggdb".to_owned()
+    } else {
+        "-fPIC -fkeep-inline-functions -O".to_owned()
+    };
+
+    if let Some(march) = march {
+        extra_cflags += &format!(" -march={}", march);
+    }
+
+    make(
+        Command::new("make")
+            .arg(format!("O={}", rte_target))
+            .args(&["-j", &num_cpus::get().to_string()])
+            .env("EXTRA_CFLAGS", extra_cflags)
+            .current_dir(rte_sdk),
+    );
+}
+
+fn make(cmd: &mut Command) {
+    let status = cmd.status().unwrap_or_else(|e| panic!("failed to build DPDK: {}", e));
+
+    if !status.success() {
+        panic!("failed to build DPDK: {:?} {}", cmd, status);
+    }
+}
+
+// replace the `name=...` line of a DPDK `.config`, or append it
+fn set_config(config: &Path, name: &str, value: &str) {
+    let content =
+        fs::read_to_string(config).unwrap_or_else(|e| panic!("failed to read DPDK config {:?}: {}", config, e));
+    let prefix = format!("{}=", name);
+    let unset = format!("# {} is not set", name);
+
+    let mut lines = content
+        .lines()
+        .filter(|l| !l.starts_with(&prefix) && *l != unset)
+        .map(|l| l.to_owned())
+        .collect::<Vec<_>>();
+
+    lines.push(format!("{}{}", prefix, value));
+
+    fs::write(config, lines.join("\n") + "\n")
+        .unwrap_or_else(|e| panic!("failed to write DPDK config {:?}: {}", config, e));
 }
@@ -1,8 +1,149 @@
 use std::iter;
+use std::process::{Command, Stdio};
 
+use cc;
 use raw_cpuid;
 
+use crate::rte::{MACHINE, RTE_MACHINE};
+
+/// A CPU variant of the C stubs, which is built besides the `RTE_MACHINE` one and selected at runtime.
+pub struct CpuVariant {
+    /// The suffix of stub functions.
+    pub name: &'static str,
+    /// The compiler flags, which only enable the instruction sets probed by `rte_sys::dispatch`.
+    pub cflags: &'static [&'static str],
+}
+
+/// The CPU variants built on x86_64, from the oldest to the newest.
+pub const CPU_VARIANTS: &[CpuVariant] = &[
+    CpuVariant {
+        name: "sse42",
+        cflags: &["-march=x86-64", "-msse4.2"],
+    },
+    CpuVariant {
+        name: "avx2",
+        cflags: &["-march=x86-64", "-mavx2"],
+    },
+    CpuVariant {
+        name: "avx512",
+        cflags: &["-march=x86-64", "-mavx512f"],
+    },
+];
+
+// the macro defined by the compiler, the DPDK machine flag and the DPDK runtime flag, like `mk/rte.cpuflags.mk`
+const CPU_FLAGS: &[(&str, &str, Option<&str>)] = &[
+    ("__SSE__", "RTE_MACHINE_CPUFLAG_SSE", Some("RTE_CPUFLAG_SSE")),
+    ("__SSE2__", "RTE_MACHINE_CPUFLAG_SSE2", Some("RTE_CPUFLAG_SSE2")),
+    ("__SSE3__", "RTE_MACHINE_CPUFLAG_SSE3", Some("RTE_CPUFLAG_SSE3")),
+    ("__SSSE3__", "RTE_MACHINE_CPUFLAG_SSSE3", Some("RTE_CPUFLAG_SSSE3")),
+    ("__SSE4_1__", "RTE_MACHINE_CPUFLAG_SSE4_1", Some("RTE_CPUFLAG_SSE4_1")),
+    ("__SSE4_2__", "RTE_MACHINE_CPUFLAG_SSE4_2", Some("RTE_CPUFLAG_SSE4_2")),
+    ("__AES__", "RTE_MACHINE_CPUFLAG_AES", Some("RTE_CPUFLAG_AES")),
+    (
+        "__PCLMUL__",
+        "RTE_MACHINE_CPUFLAG_PCLMULQDQ",
+        Some("RTE_CPUFLAG_PCLMULQDQ"),
+    ),
+    ("__AVX__", "RTE_MACHINE_CPUFLAG_AVX", Some("RTE_CPUFLAG_AVX")),
+    ("__RDRND__", "RTE_MACHINE_CPUFLAG_RDRAND", None),
+    ("__F16C__", "RTE_MACHINE_CPUFLAG_F16C", None),
+    ("__FSGSBASE__", "RTE_MACHINE_CPUFLAG_FSGSBASE", None),
+    ("__AVX2__", "RTE_MACHINE_CPUFLAG_AVX2", Some("RTE_CPUFLAG_AVX2")),
+    (
+        "__AVX512F__",
+        "RTE_MACHINE_CPUFLAG_AVX512F",
+        Some("RTE_CPUFLAG_AVX512F"),
+    ),
+];
+
+/// The `-march` target of a DPDK machine in `mk/machine/`, or the machine itself for the others.
+pub fn machine_march(machine: &str) -> &str {
+    match machine {
+        "default" | "nhm" => "corei7",
+        "wsm" => "westmere",
+        "snb" => "corei7-avx",
+        "ivb" => "core-avx-i",
+        "hsw" => "core-avx2",
+        "atm" => "atom",
+        _ => machine,
+    }
+}
+
+// the x86 machines of DPDK in `mk/machine/`
+const DPDK_MACHINES: &[&str] = &["native", "default", "nhm", "wsm", "snb", "ivb", "hsw", "atm"];
+
+/// The DPDK machine to configure DPDK with, and the extra `-march` target for a machine unknown to DPDK.
+pub fn dpdk_machine(machine: &str) -> (&str, Option<&str>) {
+    if DPDK_MACHINES.contains(&machine) {
+        (machine, None)
+    } else {
+        ("default", Some(machine))
+    }
+}
+
+/// The CPU flags of `RTE_MACHINE`, which probes the build host for the `native` machine.
 pub fn gen_cpu_features() -> impl Iterator<Item = (&'static str, Option<String>)> {
+    let (cflags, compile_time_cpuflags) = if RTE_MACHINE.as_str() == MACHINE {
+        probe_host_cpu_features()
+    } else {
+        probe_compiler_cpu_features(&[&format!("-march={}", machine_march(&RTE_MACHINE))])
+    };
+
+    to_defines(cflags, compile_time_cpuflags)
+}
+
+/// The CPU flags enabled by the compiler for the compiler flags of a CPU variant.
+pub fn gen_variant_cpu_features(variant: &CpuVariant) -> impl Iterator<Item = (&'static str, Option<String>)> {
+    let (cflags, compile_time_cpuflags) = probe_compiler_cpu_features(variant.cflags);
+
+    to_defines(cflags, compile_time_cpuflags)
+}
+
+fn to_defines(
+    cflags: Vec<&'static str>,
+    compile_time_cpuflags: Vec<&'static str>,
+) -> impl Iterator<Item = (&'static str, Option<String>)> {
+    cflags.into_iter().map(|s| (s, None)).chain(iter::once((
+        "RTE_COMPILE_TIME_CPUFLAGS",
+        Some(itertools::join(compile_time_cpuflags, ",")),
+    )))
+}
+
+fn probe_compiler_cpu_features(flags: &[&str]) -> (Vec<&'static str>, Vec<&'static str>) {
+    let compiler = cc::Build::new().get_compiler();
+
+    let output = Command::new(compiler.path())
+        .args(flags)
+        .args(&["-dM", "-E", "-"])
+        .stdin(Stdio::null())
+        .output()
+        .unwrap_or_else(|e| panic!("failed to probe CPU flags of `{}`: {}", flags.join(" "), e));
+
+    if !output.status.success() {
+        panic!(
+            "unsupported `{}`: {}",
+            flags.join(" "),
+            String::from_utf8_lossy(&output.stderr)
+        );
+    }
+
+    let macros = String::from_utf8_lossy(&output.stdout);
+    let defined = |name: &str| macros.lines().any(|line| line.split_whitespace().nth(1) == Some(name));
+
+    let mut cflags = vec![];
+    let mut compile_time_cpuflags = vec![];
+
+    for &(name, cflag, cpuflag) in CPU_FLAGS {
+        if defined(name) {
+            cflags.push(cflag);
+            compile_time_cpuflags.extend(cpuflag);
+        }
+    }
+
+    (cflags, compile_time_cpuflags)
+}
+
+fn probe_host_cpu_features() -> (Vec<&'static str>, Vec<&'static str>) {
     let mut cflags = vec![];
     let mut compile_time_cpuflags = vec![];
 
@@ -67,8 +208,5 @@ pub fn gen_cpu_features() -> impl Iterator<Item = (&'static str, Option<String>)
         }
     }
 
-    cflags.into_iter().map(|s| (s, None)).chain(iter::once((
-        "RTE_COMPILE_TIME_CPUFLAGS",
-        Some(itertools::join(compile_time_cpuflags, ",")),
-    )))
+    (cflags, compile_time_cpuflags)
 }
@@ -2,17 +2,44 @@ use std::path::Path;
 
 use cc;
 
-use crate::gen_cpu_features;
+use crate::cargo::OUT_DIR;
+use crate::cpu::{gen_cpu_features, gen_variant_cpu_features, machine_march, CpuVariant};
+use crate::rte::RTE_MACHINE;
 
 pub fn gcc_rte_config(rte_sdk_dir: &Path) -> cc::Build {
     let mut build = cc::Build::new();
 
     build
         .include(rte_sdk_dir.join("include"))
-        .flag("-march=native")
+        .flag(&format!("-march={}", machine_march(&RTE_MACHINE)))
         .cargo_metadata(true);
 
-    for (name, value) in gen_cpu_features() {
+    define_cpu_features(&mut build, gen_cpu_features());
+
+    build
+}
+
+/// Build the C sources for a CPU variant, the `RTE_STUB_VARIANT` macro is defined as its name.
+pub fn gcc_rte_variant(rte_sdk_dir: &Path, variant: &CpuVariant) -> cc::Build {
+    let mut build = cc::Build::new();
+
+    build
+        .include(rte_sdk_dir.join("include"))
+        .define("RTE_STUB_VARIANT", variant.name)
+        .out_dir(OUT_DIR.join(variant.name))
+        .cargo_metadata(true);
+
+    for flag in variant.cflags {
+        build.flag(flag);
+    }
+
+    define_cpu_features(&mut build, gen_variant_cpu_features(variant));
+
+    build
+}
+
+fn define_cpu_features(build: &mut cc::Build, features: impl Iterator<Item = (&'static str, Option<String>)>) {
+    for (name, value) in features {
         let define = if let Some(value) = value {
             format!("-D{}={}", name, value)
         } else {
@@ -21,6 +48,4 @@ pub fn gcc_rte_config(rte_sdk_dir: &Path) -> cc::Build {
 
         build.flag(&define);
     }
-
-    build
 }
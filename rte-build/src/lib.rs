@@ -15,6 +15,6 @@ mod rte;
 
 pub use crate::build::build_dpdk;
 pub use crate::cargo::{gen_cargo_config, OUT_DIR};
-pub use crate::cpu::gen_cpu_features;
-pub use crate::gcc::gcc_rte_config;
+pub use crate::cpu::{gen_cpu_features, gen_variant_cpu_features, machine_march, CpuVariant, CPU_VARIANTS};
+pub use crate::gcc::{gcc_rte_config, gcc_rte_variant};
 pub use crate::rte::*;
@@ -19,17 +19,18 @@ fn gen_rte_binding(rte_sdk_dir: &Path, dest_path: &Path) {
     info!("generating RTE binding file base on \"{}\"", rte_header);
 
     let rte_sdk_inc_dir = rte_sdk_dir.join("include");
-    let cflags = vec!["-march=native", "-I", rte_sdk_inc_dir.to_str().unwrap()];
+    let march = format!("-march={}", machine_march(&RTE_MACHINE));
+    let cflags = vec![march.as_str(), "-I", rte_sdk_inc_dir.to_str().unwrap()];
 
     bindgen::Builder::default()
         .header(rte_header)
         .header(stub_header)
         .generate_comments(true)
         .generate_inline_functions(true)
-        .whitelist_type(r"(rte|cmdline|ether|eth|arp|vlan|vxlan)_.*")
+        .whitelist_type(r"(rte|cmdline|ether|eth|arp|vlan|vxlan|ipv4|ipv6|tcp|udp)_.*")
         .whitelist_function(r"(_rte|rte|cmdline|lcore|ether|eth|arp|is)_.*")
         .whitelist_var(
-            r"(RTE|CMDLINE|ETHER|ARP|VXLAN|BONDING|LCORE|MEMPOOL|ARP|PKT|EXT_ATTACHED|IND_ATTACHED|lcore|rte|cmdline|per_lcore)_.*",
+            r"(RTE|DEV_TX_OFFLOAD|IP_FRAG|IP_MAX|CMDLINE|ETHER|ARP|VXLAN|BONDING|LCORE|MEMPOOL|RING|ARP|PKT|EXT_ATTACHED|IND_ATTACHED|lcore|rte|cmdline|per_lcore)_.*",
         )
         .derive_copy(true)
         .derive_debug(true)
@@ -92,6 +93,21 @@ fn main() {
         .include("src")
         .compile("rte_stub");
 
+    // the vectorized stubs for the other CPUs, which are selected by `rte_sys::dispatch` at runtime
+    if RTE_ARCH.as_str() == "x86_64" {
+        for variant in CPU_VARIANTS {
+            gcc_rte_variant(&rte_sdk_dir, variant)
+                .file("src/stub_variant.c")
+                .include("src")
+                .compile(&format!("rte_stub_{}", variant.name));
+        }
+
+        println!("cargo:rustc-cfg=rte_stub_variants");
+    }
+
+    println!("cargo:rustc-check-cfg=cfg(rte_stub_variants)");
+    println!("cargo:rerun-if-env-changed=RTE_MACHINE");
+
     gen_cargo_config(
         &rte_sdk_dir,
         RTE_CORE_LIBS
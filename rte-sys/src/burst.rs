@@ -0,0 +1,146 @@
+//! Burst oriented RX/TX fast path.
+//!
+//! `rte_eth_rx_burst()`, `rte_eth_tx_burst()`, `rte_eth_tx_buffer()` and `rte_eth_tx_buffer_flush()`
+//! are `static inline` functions in `rte_ethdev.h`, so by default they are reached
+//! through the out-of-line `_rte_eth_*` trampolines in `stub.c`.
+//!
+//! With the `inline-burst` feature, they are re-implemented in Rust directly against
+//! `rte_eth_devices[port_id]`, which lets the whole burst path inline into the poll loop,
+//! leaving only the indirect call to the PMD burst function.
+//!
+use super::*;
+
+cfg_if! {
+    if #[cfg(feature = "inline-burst")] {
+        use std::hint::unreachable_unchecked;
+        use std::ptr;
+
+        #[inline(always)]
+        unsafe fn eth_dev(port_id: u16) -> &'static rte_eth_dev {
+            debug_assert!(u32::from(port_id) < RTE_MAX_ETHPORTS);
+
+            &*(ptr::addr_of!(rte_eth_devices) as *const rte_eth_dev).add(port_id as usize)
+        }
+
+        #[inline(always)]
+        unsafe fn unchecked<F>(f: Option<F>) -> F {
+            match f {
+                Some(f) => f,
+                None => unreachable_unchecked(),
+            }
+        }
+
+        /// Retrieve a burst of input packets from a receive queue of an Ethernet device.
+        #[inline(always)]
+        pub unsafe fn rx_burst(port_id: u16, queue_id: u16, rx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16 {
+            let dev = eth_dev(port_id);
+            let rxq = *(*dev.data).rx_queues.add(queue_id as usize);
+
+            let mut nb_rx = unchecked(dev.rx_pkt_burst)(rxq, rx_pkts, nb_pkts);
+
+            if CONFIG_RTE_ETHDEV_RXTX_CALLBACKS {
+                let mut cb = dev.post_rx_burst_cbs[queue_id as usize];
+
+                while !cb.is_null() {
+                    nb_rx = unchecked((*cb).fn_.rx)(port_id, queue_id, rx_pkts, nb_rx, nb_pkts, (*cb).param);
+                    cb = (*cb).next;
+                }
+            }
+
+            nb_rx
+        }
+
+        /// Send a burst of output packets on a transmit queue of an Ethernet device.
+        #[inline(always)]
+        pub unsafe fn tx_burst(port_id: u16, queue_id: u16, tx_pkts: *mut *mut rte_mbuf, mut nb_pkts: u16) -> u16 {
+            let dev = eth_dev(port_id);
+
+            if CONFIG_RTE_ETHDEV_RXTX_CALLBACKS {
+                let mut cb = dev.pre_tx_burst_cbs[queue_id as usize];
+
+                while !cb.is_null() {
+                    nb_pkts = unchecked((*cb).fn_.tx)(port_id, queue_id, tx_pkts, nb_pkts, (*cb).param);
+                    cb = (*cb).next;
+                }
+            }
+
+            let txq = *(*dev.data).tx_queues.add(queue_id as usize);
+
+            unchecked(dev.tx_pkt_burst)(txq, tx_pkts, nb_pkts)
+        }
+
+        /// Send any packets queued up for transmission on a port and HW queue.
+        #[inline(always)]
+        pub unsafe fn tx_buffer_flush(port_id: u16, queue_id: u16, buffer: *mut rte_eth_dev_tx_buffer) -> u16 {
+            let buffer = &mut *buffer;
+            let to_send = buffer.length;
+
+            if to_send == 0 {
+                return 0;
+            }
+
+            let pkts = buffer.pkts.as_mut_ptr();
+            let sent = tx_burst(port_id, queue_id, pkts, to_send);
+
+            buffer.length = 0;
+
+            // All packets sent, or to be dealt with by callback below
+            if sent != to_send {
+                unchecked(buffer.error_callback)(pkts.add(sent as usize), to_send - sent, buffer.error_userdata);
+            }
+
+            sent
+        }
+
+        /// Buffer a single packet for future transmission on a port and queue.
+        #[inline(always)]
+        pub unsafe fn tx_buffer(
+            port_id: u16,
+            queue_id: u16,
+            buffer: *mut rte_eth_dev_tx_buffer,
+            tx_pkt: *mut rte_mbuf,
+        ) -> u16 {
+            {
+                let buffer = &mut *buffer;
+
+                *buffer.pkts.as_mut_ptr().add(buffer.length as usize) = tx_pkt;
+                buffer.length += 1;
+
+                if buffer.length < buffer.size {
+                    return 0;
+                }
+            }
+
+            tx_buffer_flush(port_id, queue_id, buffer)
+        }
+    } else {
+        /// Retrieve a burst of input packets from a receive queue of an Ethernet device.
+        #[inline]
+        pub unsafe fn rx_burst(port_id: u16, queue_id: u16, rx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16 {
+            _rte_eth_rx_burst(port_id, queue_id, rx_pkts, nb_pkts)
+        }
+
+        /// Send a burst of output packets on a transmit queue of an Ethernet device.
+        #[inline]
+        pub unsafe fn tx_burst(port_id: u16, queue_id: u16, tx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16 {
+            _rte_eth_tx_burst(port_id, queue_id, tx_pkts, nb_pkts)
+        }
+
+        /// Send any packets queued up for transmission on a port and HW queue.
+        #[inline]
+        pub unsafe fn tx_buffer_flush(port_id: u16, queue_id: u16, buffer: *mut rte_eth_dev_tx_buffer) -> u16 {
+            _rte_eth_tx_buffer_flush(port_id, queue_id, buffer)
+        }
+
+        /// Buffer a single packet for future transmission on a port and queue.
+        #[inline]
+        pub unsafe fn tx_buffer(
+            port_id: u16,
+            queue_id: u16,
+            buffer: *mut rte_eth_dev_tx_buffer,
+            tx_pkt: *mut rte_mbuf,
+        ) -> u16 {
+            _rte_eth_tx_buffer(port_id, queue_id, buffer, tx_pkt)
+        }
+    }
+}
@@ -0,0 +1,115 @@
+//! Runtime dispatch of the vectorized stubs.
+//!
+//! The stubs in `stub.c` are built for `RTE_MACHINE`, which is `native` by default,
+//! so they may use the instructions that the production CPUs don't have, or miss the ones they have.
+//!
+//! On x86_64, the vectorized stubs are also built from `stub_variant.c` for the SSE4.2, AVX2 and AVX512 CPUs,
+//! and the newest variant supported by the running CPU is selected with `rte_cpu_get_flag_enabled`
+//! on the first call. Each variant only enables the instruction sets probed for it on top of `x86-64`.
+//!
+use std::mem;
+use std::os::raw::c_void;
+use std::sync::atomic::{AtomicU8, Ordering};
+
+use super::*;
+
+/// The CPU variants of the vectorized stubs, from the oldest to the newest.
+#[repr(u8)]
+#[derive(Clone, Copy, Debug, PartialEq, Eq, PartialOrd, Ord)]
+pub enum CpuVariant {
+    /// The stubs built for `RTE_MACHINE`.
+    Machine = 1,
+    /// The stubs built with `-msse4.2`.
+    Sse42,
+    /// The stubs built with `-mavx2`.
+    Avx2,
+    /// The stubs built with `-mavx512f`.
+    Avx512,
+}
+
+// zero if the running CPU has not been probed yet
+static CPU_VARIANT: AtomicU8 = AtomicU8::new(0);
+
+/// The CPU variant of the vectorized stubs used by the running CPU.
+#[inline]
+pub fn cpu_variant() -> CpuVariant {
+    match CPU_VARIANT.load(Ordering::Relaxed) {
+        0 => {
+            let variant = probe_cpu_variant();
+
+            CPU_VARIANT.store(variant as u8, Ordering::Relaxed);
+
+            variant
+        }
+        variant => unsafe { mem::transmute(variant) },
+    }
+}
+
+cfg_if! {
+    if #[cfg(rte_stub_variants)] {
+        fn probe_cpu_variant() -> CpuVariant {
+            let enabled = |flag| unsafe { rte_cpu_get_flag_enabled(flag) > 0 };
+
+            // every instruction set enabled by the compiler flags of a variant, which implies the older ones
+            let sse42 = enabled(rte_cpu_flag_t::RTE_CPUFLAG_SSE3)
+                && enabled(rte_cpu_flag_t::RTE_CPUFLAG_SSSE3)
+                && enabled(rte_cpu_flag_t::RTE_CPUFLAG_SSE4_1)
+                && enabled(rte_cpu_flag_t::RTE_CPUFLAG_SSE4_2);
+            let avx2 = sse42 && enabled(rte_cpu_flag_t::RTE_CPUFLAG_AVX) && enabled(rte_cpu_flag_t::RTE_CPUFLAG_AVX2);
+            let avx512 = avx2 && enabled(rte_cpu_flag_t::RTE_CPUFLAG_AVX512F);
+
+            if avx512 {
+                CpuVariant::Avx512
+            } else if avx2 {
+                CpuVariant::Avx2
+            } else if sse42 {
+                CpuVariant::Sse42
+            } else {
+                CpuVariant::Machine
+            }
+        }
+
+        macro_rules! dispatch {
+            ($machine:ident, $sse42:ident, $avx2:ident, $avx512:ident ( $($arg:expr),* )) => {
+                match cpu_variant() {
+                    CpuVariant::Avx512 => $avx512($($arg),*),
+                    CpuVariant::Avx2 => $avx2($($arg),*),
+                    CpuVariant::Sse42 => $sse42($($arg),*),
+                    CpuVariant::Machine => $machine($($arg),*),
+                }
+            };
+        }
+    } else {
+        fn probe_cpu_variant() -> CpuVariant {
+            CpuVariant::Machine
+        }
+
+        macro_rules! dispatch {
+            ($machine:ident, $sse42:ident, $avx2:ident, $avx512:ident ( $($arg:expr),* )) => {
+                $machine($($arg),*)
+            };
+        }
+    }
+}
+
+/// Copy bytes from one location to another, the locations must not overlap.
+#[inline]
+pub unsafe fn memcpy(dst: *mut c_void, src: *const c_void, n: usize) -> *mut c_void {
+    dispatch!(
+        _rte_memcpy,
+        _rte_memcpy_sse42,
+        _rte_memcpy_avx2,
+        _rte_memcpy_avx512(dst, src, n)
+    )
+}
+
+/// Lookup four IP addresses in an LPM table.
+#[inline]
+pub unsafe fn lpm_lookupx4(lpm: *const rte_lpm, ips: *const u32, hop: *mut u32, defv: u32) {
+    dispatch!(
+        _rte_lpm_lookupx4,
+        _rte_lpm_lookupx4_sse42,
+        _rte_lpm_lookupx4_avx2,
+        _rte_lpm_lookupx4_avx512(lpm, ips, hop, defv)
+    )
+}
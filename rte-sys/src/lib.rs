@@ -12,3 +12,6 @@ cfg_if! {
         include!("raw.rs");
     }
 }
+
+pub mod burst;
+pub mod dispatch;
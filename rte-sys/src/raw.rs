@@ -409,6 +409,69 @@ pub const RTE_MEMZONE_NAMESIZE: u32 = 32;
 pub const RTE_TAILQ_RING_NAME: &'static [u8; 9usize] = b"RTE_RING\0";
 pub const RTE_RING_MZ_PREFIX: &'static [u8; 4usize] = b"RG_\0";
 pub const RTE_RING_SZ_MASK: u32 = 2147483647;
+pub const RING_F_SP_ENQ: u32 = 1;
+pub const RING_F_SC_DEQ: u32 = 2;
+pub const RING_F_EXACT_SZ: u32 = 4;
+pub const RTE_HASH_ENTRIES_MAX: u32 = 1073741824;
+pub const RTE_HASH_NAMESIZE: u32 = 32;
+pub const RTE_HASH_LOOKUP_BULK_MAX: u32 = 64;
+pub const RTE_HASH_LOOKUP_MULTI_MAX: u32 = 64;
+pub const RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT: u32 = 1;
+pub const RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD: u32 = 2;
+pub const RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY: u32 = 4;
+pub const RTE_HASH_EXTRA_FLAGS_EXT_TABLE: u32 = 8;
+pub const RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL: u32 = 16;
+pub const RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF: u32 = 32;
+pub const RTE_LPM_NAMESIZE: u32 = 32;
+pub const RTE_LPM_MAX_DEPTH: u32 = 32;
+pub const RTE_LPM_TBL24_NUM_ENTRIES: u32 = 16777216;
+pub const RTE_LPM_TBL8_GROUP_NUM_ENTRIES: u32 = 256;
+pub const RTE_LPM_LOOKUP_SUCCESS: u32 = 16777216;
+pub const RTE_LPM6_MAX_DEPTH: u32 = 128;
+pub const RTE_LPM6_IPV6_ADDR_SIZE: u32 = 16;
+pub const RTE_LPM6_NAMESIZE: u32 = 32;
+pub const IP_FRAG_DEATH_ROW_LEN: u32 = 32;
+pub const IP_MAX_FRAG_NUM: u32 = 4;
+pub const IP_FRAG_DEATH_ROW_MBUF_LEN: u32 = 160;
+pub const RTE_DISTRIBUTOR_NAMESIZE: u32 = 32;
+pub const RTE_DIST_ALG_SINGLE: u32 = 0;
+pub const RTE_DIST_ALG_BURST: u32 = 1;
+pub const RTE_METRICS_MAX_NAME_LEN: u32 = 64;
+pub const RTE_METRICS_GLOBAL: i32 = -1;
+pub const RTE_JOBSTATS_NAMESIZE: u32 = 32;
+pub const RTE_BAD_IOVA: u64 = 18446744073709551615;
+pub const RTE_VFIO_DEFAULT_CONTAINER_FD: i32 = -1;
+pub const RTE_GRO_MAX_BURST_ITEM_NUM: u32 = 128;
+pub const RTE_GRO_TYPE_MAX_NUM: u32 = 64;
+pub const RTE_GRO_TYPE_SUPPORT_NUM: u32 = 2;
+pub const RTE_GRO_TCP_IPV4_INDEX: u32 = 0;
+pub const RTE_GRO_TCP_IPV4: u32 = 1;
+pub const RTE_GRO_IPV4_VXLAN_TCP_IPV4_INDEX: u32 = 1;
+pub const RTE_GRO_IPV4_VXLAN_TCP_IPV4: u32 = 2;
+pub const RTE_GSO_SEG_SIZE_MIN: u32 = 256;
+pub const RTE_GSO_FLAG_IPID_FIXED: u32 = 1;
+pub const DEV_TX_OFFLOAD_VLAN_INSERT: u32 = 1;
+pub const DEV_TX_OFFLOAD_IPV4_CKSUM: u32 = 2;
+pub const DEV_TX_OFFLOAD_UDP_CKSUM: u32 = 4;
+pub const DEV_TX_OFFLOAD_TCP_CKSUM: u32 = 8;
+pub const DEV_TX_OFFLOAD_SCTP_CKSUM: u32 = 16;
+pub const DEV_TX_OFFLOAD_TCP_TSO: u32 = 32;
+pub const DEV_TX_OFFLOAD_UDP_TSO: u32 = 64;
+pub const DEV_TX_OFFLOAD_OUTER_IPV4_CKSUM: u32 = 128;
+pub const DEV_TX_OFFLOAD_QINQ_INSERT: u32 = 256;
+pub const DEV_TX_OFFLOAD_VXLAN_TNL_TSO: u32 = 512;
+pub const DEV_TX_OFFLOAD_GRE_TNL_TSO: u32 = 1024;
+pub const DEV_TX_OFFLOAD_IPIP_TNL_TSO: u32 = 2048;
+pub const DEV_TX_OFFLOAD_GENEVE_TNL_TSO: u32 = 4096;
+pub const DEV_TX_OFFLOAD_MACSEC_INSERT: u32 = 8192;
+pub const DEV_TX_OFFLOAD_MT_LOCKFREE: u32 = 16384;
+pub const DEV_TX_OFFLOAD_MULTI_SEGS: u32 = 32768;
+pub const DEV_TX_OFFLOAD_MBUF_FAST_FREE: u32 = 65536;
+pub const DEV_TX_OFFLOAD_SECURITY: u32 = 131072;
+pub const DEV_TX_OFFLOAD_UDP_TNL_TSO: u32 = 262144;
+pub const DEV_TX_OFFLOAD_IP_TNL_TSO: u32 = 524288;
+pub const DEV_TX_OFFLOAD_OUTER_UDP_CKSUM: u32 = 1048576;
+pub const DEV_TX_OFFLOAD_MATCH_METADATA: u32 = 2097152;
 pub const RTE_MEMPOOL_HEADER_COOKIE1: i64 = -4982197544707871147;
 pub const RTE_MEMPOOL_HEADER_COOKIE2: i64 = -941548164385788331;
 pub const RTE_MEMPOOL_TRAILER_COOKIE: i64 = -5921418378119291987;
@@ -691,6 +754,9 @@ pub const BONDING_MODE_BROADCAST: u32 = 3;
 pub const BONDING_MODE_8023AD: u32 = 4;
 pub const BONDING_MODE_TLB: u32 = 5;
 pub const BONDING_MODE_ALB: u32 = 6;
+pub const BALANCE_XMIT_POLICY_LAYER2: u32 = 0;
+pub const BALANCE_XMIT_POLICY_LAYER23: u32 = 1;
+pub const BALANCE_XMIT_POLICY_LAYER34: u32 = 2;
 pub const ARP_HRD_ETHER: u32 = 1;
 pub const ARP_OP_REQUEST: u32 = 1;
 pub const ARP_OP_REPLY: u32 = 2;
@@ -24625,6 +24691,71 @@ extern "C" {
     #[doc = "  Delay period on success, negative value otherwise."]
     pub fn rte_eth_bond_link_up_prop_delay_get(bonded_port_id: u16) -> ::std::os::raw::c_int;
 }
+pub mod rte_bond_8023ad_agg_selection {
+    pub type Type = u32;
+    pub const AGG_BANDWIDTH: Type = 0;
+    pub const AGG_COUNT: Type = 1;
+    pub const AGG_STABLE: Type = 2;
+}
+pub type rte_eth_bond_8023ad_ext_slowrx_fn =
+    ::std::option::Option<unsafe extern "C" fn(slave_id: u16, lacp_pkt: *mut rte_mbuf)>;
+#[doc = " 802.3ad mode configuration structure."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone)]
+pub struct rte_eth_bond_8023ad_conf {
+    pub fast_periodic_ms: u32,
+    pub slow_periodic_ms: u32,
+    pub short_timeout_ms: u32,
+    pub long_timeout_ms: u32,
+    pub aggregate_wait_timeout_ms: u32,
+    pub tx_period_ms: u32,
+    pub rx_marker_period_ms: u32,
+    pub update_timeout_ms: u32,
+    pub slowrx_cb: rte_eth_bond_8023ad_ext_slowrx_fn,
+    pub agg_selection: rte_bond_8023ad_agg_selection::Type,
+}
+#[test]
+fn bindgen_test_layout_rte_eth_bond_8023ad_conf() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_eth_bond_8023ad_conf>(),
+        48usize,
+        concat!("Size of: ", stringify!(rte_eth_bond_8023ad_conf))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_eth_bond_8023ad_conf>(),
+        8usize,
+        concat!("Alignment of ", stringify!(rte_eth_bond_8023ad_conf))
+    );
+}
+extern "C" {
+    #[doc = " Obtain the current 802.3ad mode configuration of the bonded device."]
+    pub fn rte_eth_bond_8023ad_conf_get(port_id: u16, conf: *mut rte_eth_bond_8023ad_conf) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Setup the 802.3ad mode configuration, the default configuration is used if `conf` is NULL."]
+    pub fn rte_eth_bond_8023ad_setup(port_id: u16, conf: *mut rte_eth_bond_8023ad_conf) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Enable the dedicated hardware queues for the LACP control traffic on the slaves,"]
+    #[doc = " the bonded device must be stopped."]
+    pub fn rte_eth_bond_8023ad_dedicated_queues_enable(port_id: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Disable the dedicated hardware queues for the LACP control traffic on the slaves,"]
+    #[doc = " the bonded device must be stopped."]
+    pub fn rte_eth_bond_8023ad_dedicated_queues_disable(port_id: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Get the aggregator mode of the bonded device."]
+    pub fn rte_eth_bond_8023ad_agg_selection_get(port_id: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Set the aggregator mode of the bonded device."]
+    pub fn rte_eth_bond_8023ad_agg_selection_set(
+        port_id: u16,
+        agg_selection: rte_bond_8023ad_agg_selection::Type,
+    ) -> ::std::os::raw::c_int;
+}
 #[doc = " ARP header IPv4 payload."]
 #[repr(C, packed)]
 #[derive(Debug, Default, Copy, Clone, PartialEq)]
@@ -25026,6 +25157,133 @@ fn bindgen_test_layout_ipv6_hdr() {
         concat!("Offset of field: ", stringify!(ipv6_hdr), "::", stringify!(dst_addr))
     );
 }
+#[doc = " TCP Header"]
+#[repr(C, packed)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct tcp_hdr {
+    #[doc = "< TCP source port."]
+    pub src_port: u16,
+    #[doc = "< TCP destination port."]
+    pub dst_port: u16,
+    #[doc = "< TX data sequence number."]
+    pub sent_seq: u32,
+    #[doc = "< RX data acknowledgment sequence number."]
+    pub recv_ack: u32,
+    #[doc = "< Data offset."]
+    pub data_off: u8,
+    #[doc = "< TCP flags"]
+    pub tcp_flags: u8,
+    #[doc = "< RX flow control window."]
+    pub rx_win: u16,
+    #[doc = "< TCP checksum."]
+    pub cksum: u16,
+    #[doc = "< TCP urgent pointer, if any."]
+    pub tcp_urp: u16,
+}
+#[test]
+fn bindgen_test_layout_tcp_hdr() {
+    assert_eq!(
+        ::std::mem::size_of::<tcp_hdr>(),
+        20usize,
+        concat!("Size of: ", stringify!(tcp_hdr))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<tcp_hdr>(),
+        1usize,
+        concat!("Alignment of ", stringify!(tcp_hdr))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).src_port as *const _ as usize },
+        0usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(src_port))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).dst_port as *const _ as usize },
+        2usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(dst_port))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).sent_seq as *const _ as usize },
+        4usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(sent_seq))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).recv_ack as *const _ as usize },
+        8usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(recv_ack))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).data_off as *const _ as usize },
+        12usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(data_off))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).tcp_flags as *const _ as usize },
+        13usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(tcp_flags))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).rx_win as *const _ as usize },
+        14usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(rx_win))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).cksum as *const _ as usize },
+        16usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(cksum))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<tcp_hdr>())).tcp_urp as *const _ as usize },
+        18usize,
+        concat!("Offset of field: ", stringify!(tcp_hdr), "::", stringify!(tcp_urp))
+    );
+}
+#[doc = " UDP Header"]
+#[repr(C, packed)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct udp_hdr {
+    #[doc = "< UDP source port."]
+    pub src_port: u16,
+    #[doc = "< UDP destination port."]
+    pub dst_port: u16,
+    #[doc = "< UDP datagram length"]
+    pub dgram_len: u16,
+    #[doc = "< UDP datagram checksum"]
+    pub dgram_cksum: u16,
+}
+#[test]
+fn bindgen_test_layout_udp_hdr() {
+    assert_eq!(
+        ::std::mem::size_of::<udp_hdr>(),
+        8usize,
+        concat!("Size of: ", stringify!(udp_hdr))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<udp_hdr>(),
+        1usize,
+        concat!("Alignment of ", stringify!(udp_hdr))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<udp_hdr>())).src_port as *const _ as usize },
+        0usize,
+        concat!("Offset of field: ", stringify!(udp_hdr), "::", stringify!(src_port))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<udp_hdr>())).dst_port as *const _ as usize },
+        2usize,
+        concat!("Offset of field: ", stringify!(udp_hdr), "::", stringify!(dst_port))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<udp_hdr>())).dgram_len as *const _ as usize },
+        4usize,
+        concat!("Offset of field: ", stringify!(udp_hdr), "::", stringify!(dgram_len))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<udp_hdr>())).dgram_cksum as *const _ as usize },
+        6usize,
+        concat!("Offset of field: ", stringify!(udp_hdr), "::", stringify!(dgram_cksum))
+    );
+}
 #[doc = " This structure is the header of a cirbuf type."]
 #[repr(C)]
 #[derive(Debug, Copy, Clone, PartialEq)]
@@ -26276,6 +26534,25 @@ extern "C" {
 extern "C" {
     pub fn cmdline_stdin_exit(cl: *mut cmdline);
 }
+extern "C" {
+    #[doc = " Copy bytes from one location to another. The locations must not overlap."]
+    #[doc = ""]
+    #[doc = " The SSE, AVX2 or AVX512 instructions are used as `RTE_MACHINE` allows."]
+    #[doc = ""]
+    #[doc = " @param dst"]
+    #[doc = "   Pointer to the destination of the data."]
+    #[doc = " @param src"]
+    #[doc = "   Pointer to the source data."]
+    #[doc = " @param n"]
+    #[doc = "   Number of bytes to copy."]
+    #[doc = " @return"]
+    #[doc = "   Pointer to the destination data."]
+    pub fn _rte_memcpy(
+        dst: *mut ::std::os::raw::c_void,
+        src: *const ::std::os::raw::c_void,
+        n: usize,
+    ) -> *mut ::std::os::raw::c_void;
+}
 extern "C" {
     #[doc = " Seed the pseudo-random generator."]
     #[doc = ""]
@@ -26609,1280 +26886,3455 @@ extern "C" {
     pub fn _rte_rdtsc_precise() -> u64;
 }
 extern "C" {
-    #[doc = " Return a pointer to the mempool owning this object."]
-    #[doc = ""]
-    #[doc = " @param obj"]
-    #[doc = "   An object that is owned by a pool. If this is not the case,"]
-    #[doc = "   the behavior is undefined."]
-    #[doc = " @return"]
-    #[doc = "   A pointer to the mempool structure."]
-    pub fn _rte_mempool_from_obj(obj: *mut ::std::os::raw::c_void) -> *mut rte_mempool;
-}
-extern "C" {
-    #[doc = " Return the IO address of elt, which is an element of the pool mp."]
-    #[doc = ""]
-    #[doc = " @param elt"]
-    #[doc = "   A pointer (virtual address) to the element of the pool."]
-    #[doc = " @return"]
-    #[doc = "   The IO address of the elt element."]
-    #[doc = "   If the mempool was created with MEMPOOL_F_NO_IOVA_CONTIG, the"]
-    #[doc = "   returned value is RTE_BAD_IOVA."]
-    pub fn _rte_mempool_virt2iova(elt: *const ::std::os::raw::c_void) -> rte_iova_t;
-}
-extern "C" {
-    #[doc = " Return a pointer to the private data in an mempool structure."]
-    #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
-    #[doc = " @return"]
-    #[doc = "   A pointer to the private data."]
-    pub fn _rte_mempool_get_priv(mp: *mut rte_mempool) -> *mut ::std::os::raw::c_void;
-}
-extern "C" {
-    #[doc = " Flush a user-owned mempool cache to the specified mempool."]
-    #[doc = ""]
-    #[doc = " @param cache"]
-    #[doc = "   A pointer to the mempool cache."]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool."]
-    pub fn _rte_mempool_cache_flush(cache: *mut rte_mempool_cache, mp: *mut rte_mempool);
-}
-extern "C" {
-    #[doc = " Get a pointer to the per-lcore default mempool cache."]
+    #[doc = " Enqueue several objects on the ring (multi-producers safe)."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
-    #[doc = " @param lcore_id"]
-    #[doc = "   The logical core id."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects)."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to add in the ring from the obj_table."]
+    #[doc = " @param free_space"]
+    #[doc = "   if non-NULL, returns the amount of space in the ring after the"]
+    #[doc = "   enqueue operation has finished."]
     #[doc = " @return"]
-    #[doc = "   A pointer to the mempool cache or NULL if disabled or non-EAL thread."]
-    pub fn _rte_mempool_default_cache(mp: *mut rte_mempool, lcore_id: ::std::os::raw::c_uint)
-        -> *mut rte_mempool_cache;
+    #[doc = "   The number of objects enqueued, either 0 or n"]
+    pub fn _rte_ring_mp_enqueue_bulk(
+        r: *mut rte_ring,
+        obj_table: *const *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        free_space: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Put several objects back in the mempool."]
+    #[doc = " Enqueue several objects on the ring (NOT multi-producers safe)."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
     #[doc = " @param obj_table"]
     #[doc = "   A pointer to a table of void * pointers (objects)."]
     #[doc = " @param n"]
-    #[doc = "   The number of objects to add in the mempool from the obj_table."]
-    #[doc = " @param cache"]
-    #[doc = "   A pointer to a mempool cache structure. May be NULL if not needed."]
-    pub fn _rte_mempool_generic_put(
-        mp: *mut rte_mempool,
+    #[doc = "   The number of objects to add in the ring from the obj_table."]
+    #[doc = " @param free_space"]
+    #[doc = "   if non-NULL, returns the amount of space in the ring after the"]
+    #[doc = "   enqueue operation has finished."]
+    #[doc = " @return"]
+    #[doc = "   The number of objects enqueued, either 0 or n"]
+    pub fn _rte_ring_sp_enqueue_bulk(
+        r: *mut rte_ring,
         obj_table: *const *mut ::std::os::raw::c_void,
         n: ::std::os::raw::c_uint,
-        cache: *mut rte_mempool_cache,
-    );
+        free_space: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Put several objects back in the mempool."]
+    #[doc = " Enqueue several objects on the ring (multi-producers safe or not)."]
     #[doc = ""]
     #[doc = " This function calls the multi-producer or the single-producer"]
     #[doc = " version depending on the default behavior that was specified at"]
-    #[doc = " mempool creation time (see flags)."]
+    #[doc = " ring creation time (see flags)."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
     #[doc = " @param obj_table"]
     #[doc = "   A pointer to a table of void * pointers (objects)."]
     #[doc = " @param n"]
-    #[doc = "   The number of objects to add in the mempool from obj_table."]
-    pub fn _rte_mempool_put_bulk(
-        mp: *mut rte_mempool,
+    #[doc = "   The number of objects to add in the ring from the obj_table."]
+    #[doc = " @param free_space"]
+    #[doc = "   if non-NULL, returns the amount of space in the ring after the"]
+    #[doc = "   enqueue operation has finished."]
+    #[doc = " @return"]
+    #[doc = "   The number of objects enqueued, either 0 or n"]
+    pub fn _rte_ring_enqueue_bulk(
+        r: *mut rte_ring,
         obj_table: *const *mut ::std::os::raw::c_void,
         n: ::std::os::raw::c_uint,
-    );
+        free_space: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Put one object back in the mempool."]
-    #[doc = ""]
-    #[doc = " This function calls the multi-producer or the single-producer"]
-    #[doc = " version depending on the default behavior that was specified at"]
-    #[doc = " mempool creation time (see flags)."]
+    #[doc = " Dequeue several objects from a ring (multi-consumers safe)."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
-    #[doc = " @param obj"]
-    #[doc = "   A pointer to the object to be added."]
-    pub fn _rte_mempool_put(mp: *mut rte_mempool, obj: *mut ::std::os::raw::c_void);
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects) that will be filled."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to dequeue from the ring to the obj_table."]
+    #[doc = " @param available"]
+    #[doc = "   If non-NULL, returns the number of remaining ring entries after the"]
+    #[doc = "   dequeue has finished."]
+    #[doc = " @return"]
+    #[doc = "   The number of objects dequeued, either 0 or n"]
+    pub fn _rte_ring_mc_dequeue_bulk(
+        r: *mut rte_ring,
+        obj_table: *mut *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        available: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Get several objects from the mempool."]
-    #[doc = ""]
-    #[doc = " If cache is enabled, objects will be retrieved first from cache,"]
-    #[doc = " subsequently from the common pool. Note that it can return -ENOENT when"]
-    #[doc = " the local cache and common pool are empty, even if cache from other"]
-    #[doc = " lcores are full."]
+    #[doc = " Dequeue several objects from a ring (NOT multi-consumers safe)."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
     #[doc = " @param obj_table"]
     #[doc = "   A pointer to a table of void * pointers (objects) that will be filled."]
     #[doc = " @param n"]
-    #[doc = "   The number of objects to get from mempool to obj_table."]
-    #[doc = " @param cache"]
-    #[doc = "   A pointer to a mempool cache structure. May be NULL if not needed."]
+    #[doc = "   The number of objects to dequeue from the ring to the obj_table."]
+    #[doc = " @param available"]
+    #[doc = "   If non-NULL, returns the number of remaining ring entries after the"]
+    #[doc = "   dequeue has finished."]
     #[doc = " @return"]
-    #[doc = "   - 0: Success; objects taken."]
-    #[doc = "   - -ENOENT: Not enough entries in the mempool; no object is retrieved."]
-    pub fn _rte_mempool_generic_get(
-        mp: *mut rte_mempool,
+    #[doc = "   The number of objects dequeued, either 0 or n"]
+    pub fn _rte_ring_sc_dequeue_bulk(
+        r: *mut rte_ring,
         obj_table: *mut *mut ::std::os::raw::c_void,
         n: ::std::os::raw::c_uint,
-        cache: *mut rte_mempool_cache,
-    ) -> ::std::os::raw::c_int;
+        available: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Get several objects from the mempool."]
+    #[doc = " Dequeue several objects from a ring (multi-consumers safe or not)."]
     #[doc = ""]
     #[doc = " This function calls the multi-consumers or the single-consumer"]
-    #[doc = " version, depending on the default behaviour that was specified at"]
-    #[doc = " mempool creation time (see flags)."]
-    #[doc = ""]
-    #[doc = " If cache is enabled, objects will be retrieved first from cache,"]
-    #[doc = " subsequently from the common pool. Note that it can return -ENOENT when"]
-    #[doc = " the local cache and common pool are empty, even if cache from other"]
-    #[doc = " lcores are full."]
+    #[doc = " version depending on the default behavior that was specified at"]
+    #[doc = " ring creation time (see flags)."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
     #[doc = " @param obj_table"]
     #[doc = "   A pointer to a table of void * pointers (objects) that will be filled."]
     #[doc = " @param n"]
-    #[doc = "   The number of objects to get from the mempool to obj_table."]
+    #[doc = "   The number of objects to dequeue from the ring to the obj_table."]
+    #[doc = " @param available"]
+    #[doc = "   If non-NULL, returns the number of remaining ring entries after the"]
+    #[doc = "   dequeue has finished."]
     #[doc = " @return"]
-    #[doc = "   - 0: Success; objects taken"]
-    #[doc = "   - -ENOENT: Not enough entries in the mempool; no object is retrieved."]
-    pub fn _rte_mempool_get_bulk(
-        mp: *mut rte_mempool,
+    #[doc = "   The number of objects dequeued, either 0 or n"]
+    pub fn _rte_ring_dequeue_bulk(
+        r: *mut rte_ring,
         obj_table: *mut *mut ::std::os::raw::c_void,
         n: ::std::os::raw::c_uint,
-    ) -> ::std::os::raw::c_int;
+        available: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Get one object from the mempool."]
-    #[doc = ""]
-    #[doc = " This function calls the multi-consumers or the single-consumer"]
-    #[doc = " version, depending on the default behavior that was specified at"]
-    #[doc = " mempool creation (see flags)."]
-    #[doc = ""]
-    #[doc = " If cache is enabled, objects will be retrieved first from cache,"]
-    #[doc = " subsequently from the common pool. Note that it can return -ENOENT when"]
-    #[doc = " the local cache and common pool are empty, even if cache from other"]
-    #[doc = " lcores are full."]
+    #[doc = " Enqueue as many objects as possible on the ring (multi-producers safe)."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
-    #[doc = " @param obj_p"]
-    #[doc = "   A pointer to a void * pointer (object) that will be filled."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects)."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to add in the ring from the obj_table."]
+    #[doc = " @param free_space"]
+    #[doc = "   if non-NULL, returns the amount of space in the ring after the"]
+    #[doc = "   enqueue operation has finished."]
     #[doc = " @return"]
-    #[doc = "   - 0: Success; objects taken."]
-    #[doc = "   - -ENOENT: Not enough entries in the mempool; no object is retrieved."]
-    pub fn _rte_mempool_get(mp: *mut rte_mempool, obj_p: *mut *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
+    #[doc = "   Actual number of objects enqueued."]
+    pub fn _rte_ring_mp_enqueue_burst(
+        r: *mut rte_ring,
+        obj_table: *const *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        free_space: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " @warning"]
-    #[doc = " @b EXPERIMENTAL: this API may change without prior notice."]
+    #[doc = " Enqueue as many objects as possible on the ring (NOT multi-producers safe)."]
     #[doc = ""]
-    #[doc = " Get a contiguous blocks of objects from the mempool."]
-    #[doc = ""]
-    #[doc = " If cache is enabled, consider to flush it first, to reuse objects"]
-    #[doc = " as soon as possible."]
-    #[doc = ""]
-    #[doc = " The application should check that the driver supports the operation"]
-    #[doc = " by calling rte_mempool_ops_get_info() and checking that `contig_block_size`"]
-    #[doc = " is not zero."]
-    #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   A pointer to the mempool structure."]
-    #[doc = " @param first_obj_table"]
-    #[doc = "   A pointer to a pointer to the first object in each block."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects)."]
     #[doc = " @param n"]
-    #[doc = "   The number of blocks to get from mempool."]
+    #[doc = "   The number of objects to add in the ring from the obj_table."]
+    #[doc = " @param free_space"]
+    #[doc = "   if non-NULL, returns the amount of space in the ring after the"]
+    #[doc = "   enqueue operation has finished."]
     #[doc = " @return"]
-    #[doc = "   - 0: Success; blocks taken."]
-    #[doc = "   - -ENOBUFS: Not enough entries in the mempool; no object is retrieved."]
-    #[doc = "   - -EOPNOTSUPP: The mempool driver does not support block dequeue"]
-    pub fn _rte_mempool_get_contig_blocks(
-        mp: *mut rte_mempool,
-        first_obj_table: *mut *mut ::std::os::raw::c_void,
+    #[doc = "   Actual number of objects enqueued."]
+    pub fn _rte_ring_sp_enqueue_burst(
+        r: *mut rte_ring,
+        obj_table: *const *mut ::std::os::raw::c_void,
         n: ::std::os::raw::c_uint,
-    ) -> ::std::os::raw::c_int;
+        free_space: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Prefetch the first part of the mbuf"]
+    #[doc = " Enqueue as many objects as possible on the ring (multi-producers safe or not)."]
     #[doc = ""]
-    #[doc = " The first 64 bytes of the mbuf corresponds to fields that are used early"]
-    #[doc = " in the receive path. If the cache line of the architecture is higher than"]
-    #[doc = " 64B, the second part will also be prefetched."]
+    #[doc = " This function calls the multi-producer or the single-producer"]
+    #[doc = " version depending on the default behavior that was specified at"]
+    #[doc = " ring creation time (see flags)."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The pointer to the mbuf."]
-    pub fn _rte_mbuf_prefetch_part1(m: *mut rte_mbuf);
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects)."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to add in the ring from the obj_table."]
+    #[doc = " @param free_space"]
+    #[doc = "   if non-NULL, returns the amount of space in the ring after the"]
+    #[doc = "   enqueue operation has finished."]
+    #[doc = " @return"]
+    #[doc = "   Actual number of objects enqueued."]
+    pub fn _rte_ring_enqueue_burst(
+        r: *mut rte_ring,
+        obj_table: *const *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        free_space: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Prefetch the second part of the mbuf"]
+    #[doc = " Dequeue as many objects as possible from a ring (multi-consumers safe)."]
     #[doc = ""]
-    #[doc = " The next 64 bytes of the mbuf corresponds to fields that are used in the"]
-    #[doc = " transmit path. If the cache line of the architecture is higher than 64B,"]
-    #[doc = " this function does nothing as it is expected that the full mbuf is"]
-    #[doc = " already in cache."]
-    #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The pointer to the mbuf."]
-    pub fn _rte_mbuf_prefetch_part2(m: *mut rte_mbuf);
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects) that will be filled."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to dequeue from the ring to the obj_table."]
+    #[doc = " @param available"]
+    #[doc = "   If non-NULL, returns the number of remaining ring entries after the"]
+    #[doc = "   dequeue has finished."]
+    #[doc = " @return"]
+    #[doc = "   The number of objects dequeued, from 0 to n"]
+    pub fn _rte_ring_mc_dequeue_burst(
+        r: *mut rte_ring,
+        obj_table: *mut *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        available: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Return the IO address of the beginning of the mbuf data"]
+    #[doc = " Dequeue as many objects as possible from a ring (NOT multi-consumers safe)."]
     #[doc = ""]
-    #[doc = " @param mb"]
-    #[doc = "   The pointer to the mbuf."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects) that will be filled."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to dequeue from the ring to the obj_table."]
+    #[doc = " @param available"]
+    #[doc = "   If non-NULL, returns the number of remaining ring entries after the"]
+    #[doc = "   dequeue has finished."]
     #[doc = " @return"]
-    #[doc = "   The IO address of the beginning of the mbuf data"]
-    pub fn _rte_mbuf_data_iova(mb: *const rte_mbuf) -> rte_iova_t;
+    #[doc = "   The number of objects dequeued, from 0 to n"]
+    pub fn _rte_ring_sc_dequeue_burst(
+        r: *mut rte_ring,
+        obj_table: *mut *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        available: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Return the default IO address of the beginning of the mbuf data"]
+    #[doc = " Dequeue as many objects as possible from a ring (multi-consumers safe or not)."]
     #[doc = ""]
-    #[doc = " This function is used by drivers in their receive function, as it"]
-    #[doc = " returns the location where data should be written by the NIC, taking"]
-    #[doc = " the default headroom in account."]
+    #[doc = " This function calls the multi-consumers or the single-consumer"]
+    #[doc = " version depending on the default behavior that was specified at"]
+    #[doc = " ring creation time (see flags)."]
     #[doc = ""]
-    #[doc = " @param mb"]
-    #[doc = "   The pointer to the mbuf."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects) that will be filled."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to dequeue from the ring to the obj_table."]
+    #[doc = " @param available"]
+    #[doc = "   If non-NULL, returns the number of remaining ring entries after the"]
+    #[doc = "   dequeue has finished."]
     #[doc = " @return"]
-    #[doc = "   The IO address of the beginning of the mbuf data"]
-    pub fn _rte_mbuf_data_iova_default(mb: *const rte_mbuf) -> rte_iova_t;
+    #[doc = "   The number of objects dequeued, from 0 to n"]
+    pub fn _rte_ring_dequeue_burst(
+        r: *mut rte_ring,
+        obj_table: *mut *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        available: *mut ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Return the mbuf owning the data buffer address of an indirect mbuf."]
+    #[doc = " Enqueue one object on a ring (multi-producers safe)."]
     #[doc = ""]
-    #[doc = " @param mi"]
-    #[doc = "   The pointer to the indirect mbuf."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj"]
+    #[doc = "   A pointer to the object to be added."]
     #[doc = " @return"]
-    #[doc = "   The address of the direct mbuf corresponding to buffer_addr."]
-    pub fn _rte_mbuf_from_indirect(mi: *mut rte_mbuf) -> *mut rte_mbuf;
+    #[doc = "   - 0: Success; objects enqueued."]
+    #[doc = "   - -ENOBUFS: Not enough room in the ring to enqueue; no object is enqueued."]
+    pub fn _rte_ring_mp_enqueue(r: *mut rte_ring, obj: *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Return the buffer address embedded in the given mbuf."]
+    #[doc = " Enqueue one object on a ring (NOT multi-producers safe)."]
     #[doc = ""]
-    #[doc = " @param md"]
-    #[doc = "   The pointer to the mbuf."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj"]
+    #[doc = "   A pointer to the object to be added."]
     #[doc = " @return"]
-    #[doc = "   The address of the data buffer owned by the mbuf."]
-    pub fn _rte_mbuf_to_baddr(md: *mut rte_mbuf) -> *mut ::std::os::raw::c_char;
+    #[doc = "   - 0: Success; objects enqueued."]
+    #[doc = "   - -ENOBUFS: Not enough room in the ring to enqueue; no object is enqueued."]
+    pub fn _rte_ring_sp_enqueue(r: *mut rte_ring, obj: *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Return the starting address of the private data area embedded in"]
-    #[doc = " the given mbuf."]
-    #[doc = ""]
-    #[doc = " Note that no check is made to ensure that a private data area"]
-    #[doc = " actually exists in the supplied mbuf."]
+    #[doc = " Enqueue one object on a ring (multi-producers safe or not)."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The pointer to the mbuf."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj"]
+    #[doc = "   A pointer to the object to be added."]
     #[doc = " @return"]
-    #[doc = "   The starting address of the private data area of the given mbuf."]
-    pub fn _rte_mbuf_to_priv(m: *mut rte_mbuf) -> *mut ::std::os::raw::c_void;
+    #[doc = "   - 0: Success; objects enqueued."]
+    #[doc = "   - -ENOBUFS: Not enough room in the ring to enqueue; no object is enqueued."]
+    pub fn _rte_ring_enqueue(r: *mut rte_ring, obj: *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Reads the value of an mbuf's refcnt."]
-    #[doc = " @param m"]
-    #[doc = "   Mbuf to read"]
+    #[doc = " Dequeue one object from a ring (multi-consumers safe)."]
+    #[doc = ""]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_p"]
+    #[doc = "   A pointer to a void * pointer (object) that will be filled."]
     #[doc = " @return"]
-    #[doc = "   Reference count number."]
-    pub fn _rte_mbuf_refcnt_read(m: *const rte_mbuf) -> u16;
-}
-extern "C" {
-    #[doc = " Sets an mbuf's refcnt to a defined value."]
-    #[doc = " @param m"]
-    #[doc = "   Mbuf to update"]
-    #[doc = " @param new_value"]
-    #[doc = "   Value set"]
-    pub fn _rte_mbuf_refcnt_set(m: *mut rte_mbuf, new_value: u16);
+    #[doc = "   - 0: Success; objects dequeued."]
+    #[doc = "   - -ENOENT: Not enough entries in the ring to dequeue; no object is"]
+    #[doc = "     dequeued."]
+    pub fn _rte_ring_mc_dequeue(r: *mut rte_ring, obj_p: *mut *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Adds given value to an mbuf's refcnt and returns its new value."]
-    #[doc = " @param m"]
-    #[doc = "   Mbuf to update"]
-    #[doc = " @param value"]
-    #[doc = "   Value to add/subtract"]
+    #[doc = " Dequeue one object from a ring (NOT multi-consumers safe)."]
+    #[doc = ""]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_p"]
+    #[doc = "   A pointer to a void * pointer (object) that will be filled."]
     #[doc = " @return"]
-    #[doc = "   Updated value"]
-    pub fn _rte_mbuf_refcnt_update(m: *mut rte_mbuf, value: i16) -> u16;
+    #[doc = "   - 0: Success; objects dequeued."]
+    #[doc = "   - -ENOENT: Not enough entries in the ring to dequeue; no object is"]
+    #[doc = "     dequeued."]
+    pub fn _rte_ring_sc_dequeue(r: *mut rte_ring, obj_p: *mut *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Reads the refcnt of an external buffer."]
+    #[doc = " Dequeue one object from a ring (multi-consumers safe or not)."]
     #[doc = ""]
-    #[doc = " @param shinfo"]
-    #[doc = "   Shared data of the external buffer."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    #[doc = " @param obj_p"]
+    #[doc = "   A pointer to a void * pointer (object) that will be filled."]
     #[doc = " @return"]
-    #[doc = "   Reference count number."]
-    pub fn _rte_mbuf_ext_refcnt_read(shinfo: *const rte_mbuf_ext_shared_info) -> u16;
+    #[doc = "   - 0: Success; objects dequeued."]
+    #[doc = "   - -ENOENT: Not enough entries in the ring to dequeue; no object is"]
+    #[doc = "     dequeued."]
+    pub fn _rte_ring_dequeue(r: *mut rte_ring, obj_p: *mut *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Set refcnt of an external buffer."]
+    #[doc = " Return the number of entries in a ring."]
     #[doc = ""]
-    #[doc = " @param shinfo"]
-    #[doc = "   Shared data of the external buffer."]
-    #[doc = " @param new_value"]
-    #[doc = "   Value set"]
-    pub fn _rte_mbuf_ext_refcnt_set(shinfo: *mut rte_mbuf_ext_shared_info, new_value: u16);
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    pub fn _rte_ring_count(r: *const rte_ring) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Add given value to refcnt of an external buffer and return its new"]
-    #[doc = " value."]
+    #[doc = " Return the number of free entries in a ring."]
     #[doc = ""]
-    #[doc = " @param shinfo"]
-    #[doc = "   Shared data of the external buffer."]
-    #[doc = " @param value"]
-    #[doc = "   Value to add/subtract"]
-    #[doc = " @return"]
-    #[doc = "   Updated value"]
-    pub fn _rte_mbuf_ext_refcnt_update(shinfo: *mut rte_mbuf_ext_shared_info, value: i16) -> u16;
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    pub fn _rte_ring_free_count(r: *const rte_ring) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Allocate an uninitialized mbuf from mempool *mp*."]
-    #[doc = ""]
-    #[doc = " This function can be used by PMDs (especially in RX functions) to"]
-    #[doc = " allocate an uninitialized mbuf. The driver is responsible of"]
-    #[doc = " initializing all the required fields. See rte_pktmbuf_reset()."]
-    #[doc = " For standard needs, prefer rte_pktmbuf_alloc()."]
-    #[doc = ""]
-    #[doc = " The caller can expect that the following fields of the mbuf structure"]
-    #[doc = " are initialized: buf_addr, buf_iova, buf_len, refcnt=1, nb_segs=1,"]
-    #[doc = " next=NULL, pool, priv_size. The other fields must be initialized"]
-    #[doc = " by the caller."]
+    #[doc = " Test if a ring is full."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   The mempool from which mbuf is allocated."]
-    #[doc = " @return"]
-    #[doc = "   - The pointer to the new mbuf on success."]
-    #[doc = "   - NULL if allocation failed."]
-    pub fn _rte_mbuf_raw_alloc(mp: *mut rte_mempool) -> *mut rte_mbuf;
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    pub fn _rte_ring_full(r: *const rte_ring) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Put mbuf back into its original mempool."]
+    #[doc = " Test if a ring is empty."]
     #[doc = ""]
-    #[doc = " The caller must ensure that the mbuf is direct and properly"]
-    #[doc = " reinitialized (refcnt=1, next=NULL, nb_segs=1), as done by"]
-    #[doc = " rte_pktmbuf_prefree_seg()."]
-    #[doc = ""]
-    #[doc = " This function should be used with care, when optimization is"]
-    #[doc = " required. For standard needs, prefer rte_pktmbuf_free() or"]
-    #[doc = " rte_pktmbuf_free_seg()."]
-    #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The mbuf to be freed."]
-    pub fn _rte_mbuf_raw_free(m: *mut rte_mbuf);
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    pub fn _rte_ring_empty(r: *const rte_ring) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Get the data room size of mbufs stored in a pktmbuf_pool"]
+    #[doc = " Return the size of the ring."]
     #[doc = ""]
-    #[doc = " The data room size is the amount of data that can be stored in a"]
-    #[doc = " mbuf including the headroom (RTE_PKTMBUF_HEADROOM)."]
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    pub fn _rte_ring_get_size(r: *const rte_ring) -> ::std::os::raw::c_uint;
+}
+extern "C" {
+    #[doc = " Return the number of elements which can be stored in the ring."]
     #[doc = ""]
-    #[doc = " @param mp"]
-    #[doc = "   The packet mbuf pool."]
-    #[doc = " @return"]
-    #[doc = "   The data room size of mbufs stored in this mempool."]
-    pub fn _rte_pktmbuf_data_room_size(mp: *mut rte_mempool) -> u16;
+    #[doc = " @param r"]
+    #[doc = "   A pointer to the ring structure."]
+    pub fn _rte_ring_get_capacity(r: *const rte_ring) -> ::std::os::raw::c_uint;
 }
 extern "C" {
-    #[doc = " Get the application private size of mbufs stored in a pktmbuf_pool"]
+    #[doc = " Return a pointer to the mempool owning this object."]
     #[doc = ""]
-    #[doc = " The private size of mbuf is a zone located between the rte_mbuf"]
-    #[doc = " structure and the data buffer where an application can store data"]
-    #[doc = " associated to a packet."]
+    #[doc = " @param obj"]
+    #[doc = "   An object that is owned by a pool. If this is not the case,"]
+    #[doc = "   the behavior is undefined."]
+    #[doc = " @return"]
+    #[doc = "   A pointer to the mempool structure."]
+    pub fn _rte_mempool_from_obj(obj: *mut ::std::os::raw::c_void) -> *mut rte_mempool;
+}
+extern "C" {
+    #[doc = " Return the IO address of elt, which is an element of the pool mp."]
+    #[doc = ""]
+    #[doc = " @param elt"]
+    #[doc = "   A pointer (virtual address) to the element of the pool."]
+    #[doc = " @return"]
+    #[doc = "   The IO address of the elt element."]
+    #[doc = "   If the mempool was created with MEMPOOL_F_NO_IOVA_CONTIG, the"]
+    #[doc = "   returned value is RTE_BAD_IOVA."]
+    pub fn _rte_mempool_virt2iova(elt: *const ::std::os::raw::c_void) -> rte_iova_t;
+}
+extern "C" {
+    #[doc = " Return a pointer to the private data in an mempool structure."]
     #[doc = ""]
     #[doc = " @param mp"]
-    #[doc = "   The packet mbuf pool."]
+    #[doc = "   A pointer to the mempool structure."]
     #[doc = " @return"]
-    #[doc = "   The private size of mbufs stored in this mempool."]
-    pub fn _rte_pktmbuf_priv_size(mp: *mut rte_mempool) -> u16;
+    #[doc = "   A pointer to the private data."]
+    pub fn _rte_mempool_get_priv(mp: *mut rte_mempool) -> *mut ::std::os::raw::c_void;
 }
 extern "C" {
-    #[doc = " Reset the data_off field of a packet mbuf to its default value."]
+    #[doc = " Flush a user-owned mempool cache to the specified mempool."]
     #[doc = ""]
-    #[doc = " The given mbuf must have only one segment, which should be empty."]
+    #[doc = " @param cache"]
+    #[doc = "   A pointer to the mempool cache."]
+    #[doc = " @param mp"]
+    #[doc = "   A pointer to the mempool."]
+    pub fn _rte_mempool_cache_flush(cache: *mut rte_mempool_cache, mp: *mut rte_mempool);
+}
+extern "C" {
+    #[doc = " Get a pointer to the per-lcore default mempool cache."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The packet mbuf's data_off field has to be reset."]
-    pub fn _rte_pktmbuf_reset_headroom(m: *mut rte_mbuf);
+    #[doc = " @param mp"]
+    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param lcore_id"]
+    #[doc = "   The logical core id."]
+    #[doc = " @return"]
+    #[doc = "   A pointer to the mempool cache or NULL if disabled or non-EAL thread."]
+    pub fn _rte_mempool_default_cache(mp: *mut rte_mempool, lcore_id: ::std::os::raw::c_uint)
+        -> *mut rte_mempool_cache;
 }
 extern "C" {
-    #[doc = " Reset the fields of a packet mbuf to their default values."]
+    #[doc = " Put several objects back in the mempool."]
     #[doc = ""]
-    #[doc = " The given mbuf must have only one segment."]
+    #[doc = " @param mp"]
+    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects)."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to add in the mempool from the obj_table."]
+    #[doc = " @param cache"]
+    #[doc = "   A pointer to a mempool cache structure. May be NULL if not needed."]
+    pub fn _rte_mempool_generic_put(
+        mp: *mut rte_mempool,
+        obj_table: *const *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        cache: *mut rte_mempool_cache,
+    );
+}
+extern "C" {
+    #[doc = " Put several objects back in the mempool."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The packet mbuf to be resetted."]
-    pub fn _rte_pktmbuf_reset(m: *mut rte_mbuf);
+    #[doc = " This function calls the multi-producer or the single-producer"]
+    #[doc = " version depending on the default behavior that was specified at"]
+    #[doc = " mempool creation time (see flags)."]
+    #[doc = ""]
+    #[doc = " @param mp"]
+    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects)."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to add in the mempool from obj_table."]
+    pub fn _rte_mempool_put_bulk(
+        mp: *mut rte_mempool,
+        obj_table: *const *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+    );
 }
 extern "C" {
-    #[doc = " Allocate a new mbuf from a mempool."]
+    #[doc = " Put one object back in the mempool."]
     #[doc = ""]
-    #[doc = " This new mbuf contains one segment, which has a length of 0. The pointer"]
-    #[doc = " to data is initialized to have some bytes of headroom in the buffer"]
-    #[doc = " (if buffer size allows)."]
+    #[doc = " This function calls the multi-producer or the single-producer"]
+    #[doc = " version depending on the default behavior that was specified at"]
+    #[doc = " mempool creation time (see flags)."]
     #[doc = ""]
     #[doc = " @param mp"]
-    #[doc = "   The mempool from which the mbuf is allocated."]
-    #[doc = " @return"]
-    #[doc = "   - The pointer to the new mbuf on success."]
-    #[doc = "   - NULL if allocation failed."]
-    pub fn _rte_pktmbuf_alloc(mp: *mut rte_mempool) -> *mut rte_mbuf;
+    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param obj"]
+    #[doc = "   A pointer to the object to be added."]
+    pub fn _rte_mempool_put(mp: *mut rte_mempool, obj: *mut ::std::os::raw::c_void);
 }
 extern "C" {
-    #[doc = " Allocate a bulk of mbufs, initialize refcnt and reset the fields to default"]
-    #[doc = " values."]
+    #[doc = " Get several objects from the mempool."]
     #[doc = ""]
-    #[doc = "  @param pool"]
-    #[doc = "    The mempool from which mbufs are allocated."]
-    #[doc = "  @param mbufs"]
-    #[doc = "    Array of pointers to mbufs"]
-    #[doc = "  @param count"]
-    #[doc = "    Array size"]
-    #[doc = "  @return"]
-    #[doc = "   - 0: Success"]
-    #[doc = "   - -ENOENT: Not enough entries in the mempool; no mbufs are retrieved."]
-    pub fn _rte_pktmbuf_alloc_bulk(
-        pool: *mut rte_mempool,
-        mbufs: *mut *mut rte_mbuf,
-        count: ::std::os::raw::c_uint,
+    #[doc = " If cache is enabled, objects will be retrieved first from cache,"]
+    #[doc = " subsequently from the common pool. Note that it can return -ENOENT when"]
+    #[doc = " the local cache and common pool are empty, even if cache from other"]
+    #[doc = " lcores are full."]
+    #[doc = ""]
+    #[doc = " @param mp"]
+    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects) that will be filled."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to get from mempool to obj_table."]
+    #[doc = " @param cache"]
+    #[doc = "   A pointer to a mempool cache structure. May be NULL if not needed."]
+    #[doc = " @return"]
+    #[doc = "   - 0: Success; objects taken."]
+    #[doc = "   - -ENOENT: Not enough entries in the mempool; no object is retrieved."]
+    pub fn _rte_mempool_generic_get(
+        mp: *mut rte_mempool,
+        obj_table: *mut *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+        cache: *mut rte_mempool_cache,
     ) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Initialize shared data at the end of an external buffer before attaching"]
-    #[doc = " to a mbuf by ``rte_pktmbuf_attach_extbuf()``. This is not a mandatory"]
-    #[doc = " initialization but a helper function to simply spare a few bytes at the"]
-    #[doc = " end of the buffer for shared data. If shared data is allocated"]
-    #[doc = " separately, this should not be called but application has to properly"]
-    #[doc = " initialize the shared data according to its need."]
-    #[doc = ""]
-    #[doc = " Free callback and its argument is saved and the refcnt is set to 1."]
+    #[doc = " Get several objects from the mempool."]
     #[doc = ""]
-    #[doc = " @warning"]
-    #[doc = " The value of buf_len will be reduced to RTE_PTR_DIFF(shinfo, buf_addr)"]
-    #[doc = " after this initialization. This shall be used for"]
-    #[doc = " ``rte_pktmbuf_attach_extbuf()``"]
+    #[doc = " This function calls the multi-consumers or the single-consumer"]
+    #[doc = " version, depending on the default behaviour that was specified at"]
+    #[doc = " mempool creation time (see flags)."]
     #[doc = ""]
-    #[doc = " @param buf_addr"]
-    #[doc = "   The pointer to the external buffer."]
-    #[doc = " @param [in,out] buf_len"]
-    #[doc = "   The pointer to length of the external buffer. Input value must be"]
-    #[doc = "   larger than the size of ``struct rte_mbuf_ext_shared_info`` and"]
-    #[doc = "   padding for alignment. If not enough, this function will return NULL."]
-    #[doc = "   Adjusted buffer length will be returned through this pointer."]
-    #[doc = " @param free_cb"]
-    #[doc = "   Free callback function to call when the external buffer needs to be"]
-    #[doc = "   freed."]
-    #[doc = " @param fcb_opaque"]
-    #[doc = "   Argument for the free callback function."]
+    #[doc = " If cache is enabled, objects will be retrieved first from cache,"]
+    #[doc = " subsequently from the common pool. Note that it can return -ENOENT when"]
+    #[doc = " the local cache and common pool are empty, even if cache from other"]
+    #[doc = " lcores are full."]
     #[doc = ""]
+    #[doc = " @param mp"]
+    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param obj_table"]
+    #[doc = "   A pointer to a table of void * pointers (objects) that will be filled."]
+    #[doc = " @param n"]
+    #[doc = "   The number of objects to get from the mempool to obj_table."]
     #[doc = " @return"]
-    #[doc = "   A pointer to the initialized shared data on success, return NULL"]
-    #[doc = "   otherwise."]
-    pub fn _rte_pktmbuf_ext_shinfo_init_helper(
-        buf_addr: *mut ::std::os::raw::c_void,
-        buf_len: *mut u16,
-        free_cb: rte_mbuf_extbuf_free_callback_t,
-        fcb_opaque: *mut ::std::os::raw::c_void,
-    ) -> *mut rte_mbuf_ext_shared_info;
+    #[doc = "   - 0: Success; objects taken"]
+    #[doc = "   - -ENOENT: Not enough entries in the mempool; no object is retrieved."]
+    pub fn _rte_mempool_get_bulk(
+        mp: *mut rte_mempool,
+        obj_table: *mut *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Attach an external buffer to a mbuf."]
-    #[doc = ""]
-    #[doc = " User-managed anonymous buffer can be attached to an mbuf. When attaching"]
-    #[doc = " it, corresponding free callback function and its argument should be"]
-    #[doc = " provided via shinfo. This callback function will be called once all the"]
-    #[doc = " mbufs are detached from the buffer (refcnt becomes zero)."]
+    #[doc = " Get one object from the mempool."]
     #[doc = ""]
-    #[doc = " The headroom for the attaching mbuf will be set to zero and this can be"]
-    #[doc = " properly adjusted after attachment. For example, ``rte_pktmbuf_adj()``"]
-    #[doc = " or ``rte_pktmbuf_reset_headroom()`` might be used."]
+    #[doc = " This function calls the multi-consumers or the single-consumer"]
+    #[doc = " version, depending on the default behavior that was specified at"]
+    #[doc = " mempool creation (see flags)."]
     #[doc = ""]
-    #[doc = " More mbufs can be attached to the same external buffer by"]
-    #[doc = " ``rte_pktmbuf_attach()`` once the external buffer has been attached by"]
-    #[doc = " this API."]
+    #[doc = " If cache is enabled, objects will be retrieved first from cache,"]
+    #[doc = " subsequently from the common pool. Note that it can return -ENOENT when"]
+    #[doc = " the local cache and common pool are empty, even if cache from other"]
+    #[doc = " lcores are full."]
     #[doc = ""]
-    #[doc = " Detachment can be done by either ``rte_pktmbuf_detach_extbuf()`` or"]
-    #[doc = " ``rte_pktmbuf_detach()``."]
+    #[doc = " @param mp"]
+    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param obj_p"]
+    #[doc = "   A pointer to a void * pointer (object) that will be filled."]
+    #[doc = " @return"]
+    #[doc = "   - 0: Success; objects taken."]
+    #[doc = "   - -ENOENT: Not enough entries in the mempool; no object is retrieved."]
+    pub fn _rte_mempool_get(mp: *mut rte_mempool, obj_p: *mut *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " @warning"]
+    #[doc = " @b EXPERIMENTAL: this API may change without prior notice."]
     #[doc = ""]
-    #[doc = " Memory for shared data must be provided and user must initialize all of"]
-    #[doc = " the content properly, escpecially free callback and refcnt. The pointer"]
-    #[doc = " of shared data will be stored in m->shinfo."]
-    #[doc = " ``rte_pktmbuf_ext_shinfo_init_helper`` can help to simply spare a few"]
-    #[doc = " bytes at the end of buffer for the shared data, store free callback and"]
-    #[doc = " its argument and set the refcnt to 1. The following is an example:"]
+    #[doc = " Get a contiguous blocks of objects from the mempool."]
     #[doc = ""]
-    #[doc = "   struct rte_mbuf_ext_shared_info *shinfo ="]
-    #[doc = "          rte_pktmbuf_ext_shinfo_init_helper(buf_addr, &buf_len,"]
-    #[doc = "                                             free_cb, fcb_arg);"]
-    #[doc = "   rte_pktmbuf_attach_extbuf(m, buf_addr, buf_iova, buf_len, shinfo);"]
-    #[doc = "   rte_pktmbuf_reset_headroom(m);"]
-    #[doc = "   rte_pktmbuf_adj(m, data_len);"]
+    #[doc = " If cache is enabled, consider to flush it first, to reuse objects"]
+    #[doc = " as soon as possible."]
     #[doc = ""]
-    #[doc = " Attaching an external buffer is quite similar to mbuf indirection in"]
-    #[doc = " replacing buffer addresses and length of a mbuf, but a few differences:"]
-    #[doc = " - When an indirect mbuf is attached, refcnt of the direct mbuf would be"]
-    #[doc = "   2 as long as the direct mbuf itself isn't freed after the attachment."]
-    #[doc = "   In such cases, the buffer area of a direct mbuf must be read-only. But"]
-    #[doc = "   external buffer has its own refcnt and it starts from 1. Unless"]
-    #[doc = "   multiple mbufs are attached to a mbuf having an external buffer, the"]
-    #[doc = "   external buffer is writable."]
-    #[doc = " - There's no need to allocate buffer from a mempool. Any buffer can be"]
-    #[doc = "   attached with appropriate free callback and its IO address."]
-    #[doc = " - Smaller metadata is required to maintain shared data such as refcnt."]
+    #[doc = " The application should check that the driver supports the operation"]
+    #[doc = " by calling rte_mempool_ops_get_info() and checking that `contig_block_size`"]
+    #[doc = " is not zero."]
     #[doc = ""]
-    #[doc = " @warning"]
-    #[doc = " @b EXPERIMENTAL: This API may change without prior notice."]
-    #[doc = " Once external buffer is enabled by allowing experimental API,"]
-    #[doc = " ``RTE_MBUF_DIRECT()`` and ``RTE_MBUF_INDIRECT()`` are no longer"]
-    #[doc = " exclusive. A mbuf can be considered direct if it is neither indirect nor"]
-    #[doc = " having external buffer."]
-    #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The pointer to the mbuf."]
-    #[doc = " @param buf_addr"]
-    #[doc = "   The pointer to the external buffer."]
-    #[doc = " @param buf_iova"]
-    #[doc = "   IO address of the external buffer."]
-    #[doc = " @param buf_len"]
-    #[doc = "   The size of the external buffer."]
-    #[doc = " @param shinfo"]
-    #[doc = "   User-provided memory for shared data of the external buffer."]
-    pub fn _rte_pktmbuf_attach_extbuf(
-        m: *mut rte_mbuf,
-        buf_addr: *mut ::std::os::raw::c_void,
-        buf_iova: rte_iova_t,
-        buf_len: u16,
-        shinfo: *mut rte_mbuf_ext_shared_info,
-    );
+    #[doc = " @param mp"]
+    #[doc = "   A pointer to the mempool structure."]
+    #[doc = " @param first_obj_table"]
+    #[doc = "   A pointer to a pointer to the first object in each block."]
+    #[doc = " @param n"]
+    #[doc = "   The number of blocks to get from mempool."]
+    #[doc = " @return"]
+    #[doc = "   - 0: Success; blocks taken."]
+    #[doc = "   - -ENOBUFS: Not enough entries in the mempool; no object is retrieved."]
+    #[doc = "   - -EOPNOTSUPP: The mempool driver does not support block dequeue"]
+    pub fn _rte_mempool_get_contig_blocks(
+        mp: *mut rte_mempool,
+        first_obj_table: *mut *mut ::std::os::raw::c_void,
+        n: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Attach packet mbuf to another packet mbuf."]
-    #[doc = ""]
-    #[doc = " If the mbuf we are attaching to isn't a direct buffer and is attached to"]
-    #[doc = " an external buffer, the mbuf being attached will be attached to the"]
-    #[doc = " external buffer instead of mbuf indirection."]
-    #[doc = ""]
-    #[doc = " Otherwise, the mbuf will be indirectly attached. After attachment we"]
-    #[doc = " refer the mbuf we attached as 'indirect', while mbuf we attached to as"]
-    #[doc = " 'direct'.  The direct mbuf's reference counter is incremented."]
+    #[doc = " Prefetch the first part of the mbuf"]
     #[doc = ""]
-    #[doc = " Right now, not supported:"]
-    #[doc = "  - attachment for already indirect mbuf (e.g. - mi has to be direct)."]
-    #[doc = "  - mbuf we trying to attach (mi) is used by someone else"]
-    #[doc = "    e.g. it's reference counter is greater then 1."]
+    #[doc = " The first 64 bytes of the mbuf corresponds to fields that are used early"]
+    #[doc = " in the receive path. If the cache line of the architecture is higher than"]
+    #[doc = " 64B, the second part will also be prefetched."]
     #[doc = ""]
-    #[doc = " @param mi"]
-    #[doc = "   The indirect packet mbuf."]
     #[doc = " @param m"]
-    #[doc = "   The packet mbuf we're attaching to."]
-    pub fn _rte_pktmbuf_attach(mi: *mut rte_mbuf, m: *mut rte_mbuf);
+    #[doc = "   The pointer to the mbuf."]
+    pub fn _rte_mbuf_prefetch_part1(m: *mut rte_mbuf);
 }
 extern "C" {
-    #[doc = " Detach a packet mbuf from external buffer or direct buffer."]
-    #[doc = ""]
-    #[doc = "  - decrement refcnt and free the external/direct buffer if refcnt"]
-    #[doc = "    becomes zero."]
-    #[doc = "  - restore original mbuf address and length values."]
-    #[doc = "  - reset pktmbuf data and data_len to their default values."]
+    #[doc = " Prefetch the second part of the mbuf"]
     #[doc = ""]
-    #[doc = " All other fields of the given packet mbuf will be left intact."]
+    #[doc = " The next 64 bytes of the mbuf corresponds to fields that are used in the"]
+    #[doc = " transmit path. If the cache line of the architecture is higher than 64B,"]
+    #[doc = " this function does nothing as it is expected that the full mbuf is"]
+    #[doc = " already in cache."]
     #[doc = ""]
     #[doc = " @param m"]
-    #[doc = "   The indirect attached packet mbuf."]
-    pub fn _rte_pktmbuf_detach(m: *mut rte_mbuf);
+    #[doc = "   The pointer to the mbuf."]
+    pub fn _rte_mbuf_prefetch_part2(m: *mut rte_mbuf);
 }
 extern "C" {
-    #[doc = " Decrease reference counter and unlink a mbuf segment"]
-    #[doc = ""]
-    #[doc = " This function does the same than a free, except that it does not"]
-    #[doc = " return the segment to its pool."]
-    #[doc = " It decreases the reference counter, and if it reaches 0, it is"]
-    #[doc = " detached from its parent for an indirect mbuf."]
+    #[doc = " Return the IO address of the beginning of the mbuf data"]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The mbuf to be unlinked"]
+    #[doc = " @param mb"]
+    #[doc = "   The pointer to the mbuf."]
     #[doc = " @return"]
-    #[doc = "   - (m) if it is the last reference. It can be recycled or freed."]
-    #[doc = "   - (NULL) if the mbuf still has remaining references on it."]
-    pub fn _rte_pktmbuf_prefree_seg(m: *mut rte_mbuf) -> *mut rte_mbuf;
+    #[doc = "   The IO address of the beginning of the mbuf data"]
+    pub fn _rte_mbuf_data_iova(mb: *const rte_mbuf) -> rte_iova_t;
 }
 extern "C" {
-    #[doc = " Free a segment of a packet mbuf into its original mempool."]
+    #[doc = " Return the default IO address of the beginning of the mbuf data"]
     #[doc = ""]
-    #[doc = " Free an mbuf, without parsing other segments in case of chained"]
-    #[doc = " buffers."]
+    #[doc = " This function is used by drivers in their receive function, as it"]
+    #[doc = " returns the location where data should be written by the NIC, taking"]
+    #[doc = " the default headroom in account."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The packet mbuf segment to be freed."]
-    pub fn _rte_pktmbuf_free_seg(m: *mut rte_mbuf);
+    #[doc = " @param mb"]
+    #[doc = "   The pointer to the mbuf."]
+    #[doc = " @return"]
+    #[doc = "   The IO address of the beginning of the mbuf data"]
+    pub fn _rte_mbuf_data_iova_default(mb: *const rte_mbuf) -> rte_iova_t;
 }
 extern "C" {
-    #[doc = " Free a packet mbuf back into its original mempool."]
-    #[doc = ""]
-    #[doc = " Free an mbuf, and all its segments in case of chained buffers. Each"]
-    #[doc = " segment is added back into its original mempool."]
+    #[doc = " Return the mbuf owning the data buffer address of an indirect mbuf."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The packet mbuf to be freed. If NULL, the function does nothing."]
-    pub fn _rte_pktmbuf_free(m: *mut rte_mbuf);
+    #[doc = " @param mi"]
+    #[doc = "   The pointer to the indirect mbuf."]
+    #[doc = " @return"]
+    #[doc = "   The address of the direct mbuf corresponding to buffer_addr."]
+    pub fn _rte_mbuf_from_indirect(mi: *mut rte_mbuf) -> *mut rte_mbuf;
 }
 extern "C" {
-    #[doc = " Creates a \"clone\" of the given packet mbuf."]
-    #[doc = ""]
-    #[doc = " Walks through all segments of the given packet mbuf, and for each of them:"]
-    #[doc = "  - Creates a new packet mbuf from the given pool."]
-    #[doc = "  - Attaches newly created mbuf to the segment."]
-    #[doc = " Then updates pkt_len and nb_segs of the \"clone\" packet mbuf to match values"]
-    #[doc = " from the original packet mbuf."]
+    #[doc = " Return the buffer address embedded in the given mbuf."]
     #[doc = ""]
     #[doc = " @param md"]
-    #[doc = "   The packet mbuf to be cloned."]
-    #[doc = " @param mp"]
-    #[doc = "   The mempool from which the \"clone\" mbufs are allocated."]
+    #[doc = "   The pointer to the mbuf."]
     #[doc = " @return"]
-    #[doc = "   - The pointer to the new \"clone\" mbuf on success."]
-    #[doc = "   - NULL if allocation fails."]
-    pub fn _rte_pktmbuf_clone(md: *mut rte_mbuf, mp: *mut rte_mempool) -> *mut rte_mbuf;
+    #[doc = "   The address of the data buffer owned by the mbuf."]
+    pub fn _rte_mbuf_to_baddr(md: *mut rte_mbuf) -> *mut ::std::os::raw::c_char;
 }
 extern "C" {
-    #[doc = " Adds given value to the refcnt of all packet mbuf segments."]
+    #[doc = " Return the starting address of the private data area embedded in"]
+    #[doc = " the given mbuf."]
     #[doc = ""]
-    #[doc = " Walks through all segments of given packet mbuf and for each of them"]
-    #[doc = " invokes rte_mbuf_refcnt_update()."]
+    #[doc = " Note that no check is made to ensure that a private data area"]
+    #[doc = " actually exists in the supplied mbuf."]
     #[doc = ""]
     #[doc = " @param m"]
-    #[doc = "   The packet mbuf whose refcnt to be updated."]
-    #[doc = " @param v"]
-    #[doc = "   The value to add to the mbuf's segments refcnt."]
-    pub fn _rte_pktmbuf_refcnt_update(m: *mut rte_mbuf, v: i16);
+    #[doc = "   The pointer to the mbuf."]
+    #[doc = " @return"]
+    #[doc = "   The starting address of the private data area of the given mbuf."]
+    pub fn _rte_mbuf_to_priv(m: *mut rte_mbuf) -> *mut ::std::os::raw::c_void;
 }
 extern "C" {
-    #[doc = " Get the headroom in a packet mbuf."]
-    #[doc = ""]
+    #[doc = " Reads the value of an mbuf's refcnt."]
     #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
+    #[doc = "   Mbuf to read"]
     #[doc = " @return"]
-    #[doc = "   The length of the headroom."]
-    pub fn _rte_pktmbuf_headroom(m: *const rte_mbuf) -> u16;
+    #[doc = "   Reference count number."]
+    pub fn _rte_mbuf_refcnt_read(m: *const rte_mbuf) -> u16;
 }
 extern "C" {
-    #[doc = " Get the tailroom of a packet mbuf."]
-    #[doc = ""]
+    #[doc = " Sets an mbuf's refcnt to a defined value."]
     #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
-    #[doc = " @return"]
-    #[doc = "   The length of the tailroom."]
-    pub fn _rte_pktmbuf_tailroom(m: *const rte_mbuf) -> u16;
+    #[doc = "   Mbuf to update"]
+    #[doc = " @param new_value"]
+    #[doc = "   Value set"]
+    pub fn _rte_mbuf_refcnt_set(m: *mut rte_mbuf, new_value: u16);
 }
 extern "C" {
-    #[doc = " Get the last segment of the packet."]
-    #[doc = ""]
+    #[doc = " Adds given value to an mbuf's refcnt and returns its new value."]
     #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
+    #[doc = "   Mbuf to update"]
+    #[doc = " @param value"]
+    #[doc = "   Value to add/subtract"]
     #[doc = " @return"]
-    #[doc = "   The last segment of the given mbuf."]
-    pub fn _rte_pktmbuf_lastseg(m: *mut rte_mbuf) -> *mut rte_mbuf;
+    #[doc = "   Updated value"]
+    pub fn _rte_mbuf_refcnt_update(m: *mut rte_mbuf, value: i16) -> u16;
 }
 extern "C" {
-    #[doc = " Prepend len bytes to an mbuf data area."]
-    #[doc = ""]
-    #[doc = " Returns a pointer to the new"]
-    #[doc = " data start address. If there is not enough headroom in the first"]
-    #[doc = " segment, the function will return NULL, without modifying the mbuf."]
+    #[doc = " Reads the refcnt of an external buffer."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The pkt mbuf."]
-    #[doc = " @param len"]
-    #[doc = "   The amount of data to prepend (in bytes)."]
+    #[doc = " @param shinfo"]
+    #[doc = "   Shared data of the external buffer."]
     #[doc = " @return"]
-    #[doc = "   A pointer to the start of the newly prepended data, or"]
-    #[doc = "   NULL if there is not enough headroom space in the first segment"]
-    pub fn _rte_pktmbuf_prepend(m: *mut rte_mbuf, len: u16) -> *mut ::std::os::raw::c_char;
+    #[doc = "   Reference count number."]
+    pub fn _rte_mbuf_ext_refcnt_read(shinfo: *const rte_mbuf_ext_shared_info) -> u16;
 }
 extern "C" {
-    #[doc = " Append len bytes to an mbuf."]
+    #[doc = " Set refcnt of an external buffer."]
     #[doc = ""]
-    #[doc = " Append len bytes to an mbuf and return a pointer to the start address"]
-    #[doc = " of the added data. If there is not enough tailroom in the last"]
-    #[doc = " segment, the function will return NULL, without modifying the mbuf."]
+    #[doc = " @param shinfo"]
+    #[doc = "   Shared data of the external buffer."]
+    #[doc = " @param new_value"]
+    #[doc = "   Value set"]
+    pub fn _rte_mbuf_ext_refcnt_set(shinfo: *mut rte_mbuf_ext_shared_info, new_value: u16);
+}
+extern "C" {
+    #[doc = " Add given value to refcnt of an external buffer and return its new"]
+    #[doc = " value."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
-    #[doc = " @param len"]
-    #[doc = "   The amount of data to append (in bytes)."]
+    #[doc = " @param shinfo"]
+    #[doc = "   Shared data of the external buffer."]
+    #[doc = " @param value"]
+    #[doc = "   Value to add/subtract"]
     #[doc = " @return"]
-    #[doc = "   A pointer to the start of the newly appended data, or"]
-    #[doc = "   NULL if there is not enough tailroom space in the last segment"]
-    pub fn _rte_pktmbuf_append(m: *mut rte_mbuf, len: u16) -> *mut ::std::os::raw::c_char;
+    #[doc = "   Updated value"]
+    pub fn _rte_mbuf_ext_refcnt_update(shinfo: *mut rte_mbuf_ext_shared_info, value: i16) -> u16;
 }
 extern "C" {
-    #[doc = " Remove len bytes at the beginning of an mbuf."]
+    #[doc = " Allocate an uninitialized mbuf from mempool *mp*."]
     #[doc = ""]
-    #[doc = " Returns a pointer to the start address of the new data area. If the"]
-    #[doc = " length is greater than the length of the first segment, then the"]
-    #[doc = " function will fail and return NULL, without modifying the mbuf."]
+    #[doc = " This function can be used by PMDs (especially in RX functions) to"]
+    #[doc = " allocate an uninitialized mbuf. The driver is responsible of"]
+    #[doc = " initializing all the required fields. See rte_pktmbuf_reset()."]
+    #[doc = " For standard needs, prefer rte_pktmbuf_alloc()."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
-    #[doc = " @param len"]
-    #[doc = "   The amount of data to remove (in bytes)."]
+    #[doc = " The caller can expect that the following fields of the mbuf structure"]
+    #[doc = " are initialized: buf_addr, buf_iova, buf_len, refcnt=1, nb_segs=1,"]
+    #[doc = " next=NULL, pool, priv_size. The other fields must be initialized"]
+    #[doc = " by the caller."]
+    #[doc = ""]
+    #[doc = " @param mp"]
+    #[doc = "   The mempool from which mbuf is allocated."]
     #[doc = " @return"]
-    #[doc = "   A pointer to the new start of the data."]
-    pub fn _rte_pktmbuf_adj(m: *mut rte_mbuf, len: u16) -> *mut ::std::os::raw::c_char;
+    #[doc = "   - The pointer to the new mbuf on success."]
+    #[doc = "   - NULL if allocation failed."]
+    pub fn _rte_mbuf_raw_alloc(mp: *mut rte_mempool) -> *mut rte_mbuf;
 }
 extern "C" {
-    #[doc = " Remove len bytes of data at the end of the mbuf."]
+    #[doc = " Put mbuf back into its original mempool."]
     #[doc = ""]
-    #[doc = " If the length is greater than the length of the last segment, the"]
-    #[doc = " function will fail and return -1 without modifying the mbuf."]
+    #[doc = " The caller must ensure that the mbuf is direct and properly"]
+    #[doc = " reinitialized (refcnt=1, next=NULL, nb_segs=1), as done by"]
+    #[doc = " rte_pktmbuf_prefree_seg()."]
+    #[doc = ""]
+    #[doc = " This function should be used with care, when optimization is"]
+    #[doc = " required. For standard needs, prefer rte_pktmbuf_free() or"]
+    #[doc = " rte_pktmbuf_free_seg()."]
     #[doc = ""]
     #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
-    #[doc = " @param len"]
-    #[doc = "   The amount of data to remove (in bytes)."]
-    #[doc = " @return"]
-    #[doc = "   - 0: On success."]
-    #[doc = "   - -1: On error."]
-    pub fn _rte_pktmbuf_trim(m: *mut rte_mbuf, len: u16) -> ::std::os::raw::c_int;
+    #[doc = "   The mbuf to be freed."]
+    pub fn _rte_mbuf_raw_free(m: *mut rte_mbuf);
 }
 extern "C" {
-    #[doc = " Test if mbuf data is contiguous."]
+    #[doc = " Get the data room size of mbufs stored in a pktmbuf_pool"]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
+    #[doc = " The data room size is the amount of data that can be stored in a"]
+    #[doc = " mbuf including the headroom (RTE_PKTMBUF_HEADROOM)."]
+    #[doc = ""]
+    #[doc = " @param mp"]
+    #[doc = "   The packet mbuf pool."]
     #[doc = " @return"]
-    #[doc = "   - 1, if all data is contiguous (one segment)."]
-    #[doc = "   - 0, if there is several segments."]
-    pub fn _rte_pktmbuf_is_contiguous(m: *const rte_mbuf) -> ::std::os::raw::c_int;
+    #[doc = "   The data room size of mbufs stored in this mempool."]
+    pub fn _rte_pktmbuf_data_room_size(mp: *mut rte_mempool) -> u16;
 }
 extern "C" {
-    #[doc = " Read len data bytes in a mbuf at specified offset."]
+    #[doc = " Get the application private size of mbufs stored in a pktmbuf_pool"]
     #[doc = ""]
-    #[doc = " If the data is contiguous, return the pointer in the mbuf data, else"]
-    #[doc = " copy the data in the buffer provided by the user and return its"]
-    #[doc = " pointer."]
+    #[doc = " The private size of mbuf is a zone located between the rte_mbuf"]
+    #[doc = " structure and the data buffer where an application can store data"]
+    #[doc = " associated to a packet."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The pointer to the mbuf."]
-    #[doc = " @param off"]
-    #[doc = "   The offset of the data in the mbuf."]
-    #[doc = " @param len"]
-    #[doc = "   The amount of bytes to read."]
-    #[doc = " @param buf"]
-    #[doc = "   The buffer where data is copied if it is not contiguous in mbuf"]
-    #[doc = "   data. Its length should be at least equal to the len parameter."]
+    #[doc = " @param mp"]
+    #[doc = "   The packet mbuf pool."]
     #[doc = " @return"]
-    #[doc = "   The pointer to the data, either in the mbuf if it is contiguous,"]
-    #[doc = "   or in the user buffer. If mbuf is too small, NULL is returned."]
-    pub fn _rte_pktmbuf_read(
-        m: *const rte_mbuf,
-        off: u32,
-        len: u32,
-        buf: *mut ::std::os::raw::c_void,
-    ) -> *const ::std::os::raw::c_void;
+    #[doc = "   The private size of mbufs stored in this mempool."]
+    pub fn _rte_pktmbuf_priv_size(mp: *mut rte_mempool) -> u16;
 }
 extern "C" {
-    #[doc = " Chain an mbuf to another, thereby creating a segmented packet."]
-    #[doc = ""]
-    #[doc = " Note: The implementation will do a linear walk over the segments to find"]
-    #[doc = " the tail entry. For cases when there are many segments, it's better to"]
-    #[doc = " chain the entries manually."]
+    #[doc = " Reset the data_off field of a packet mbuf to its default value."]
     #[doc = ""]
-    #[doc = " @param head"]
-    #[doc = "   The head of the mbuf chain (the first packet)"]
-    #[doc = " @param tail"]
-    #[doc = "   The mbuf to put last in the chain"]
+    #[doc = " The given mbuf must have only one segment, which should be empty."]
     #[doc = ""]
-    #[doc = " @return"]
-    #[doc = "   - 0, on success."]
-    #[doc = "   - -EOVERFLOW, if the chain segment limit exceeded"]
-    pub fn _rte_pktmbuf_chain(head: *mut rte_mbuf, tail: *mut rte_mbuf) -> ::std::os::raw::c_int;
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf's data_off field has to be reset."]
+    pub fn _rte_pktmbuf_reset_headroom(m: *mut rte_mbuf);
 }
 extern "C" {
-    #[doc = " Validate general requirements for Tx offload in mbuf."]
+    #[doc = " Reset the fields of a packet mbuf to their default values."]
     #[doc = ""]
-    #[doc = " This function checks correctness and completeness of Tx offload settings."]
+    #[doc = " The given mbuf must have only one segment."]
     #[doc = ""]
     #[doc = " @param m"]
-    #[doc = "   The packet mbuf to be validated."]
-    #[doc = " @return"]
-    #[doc = "   0 if packet is valid"]
-    pub fn _rte_validate_tx_offload(m: *const rte_mbuf) -> ::std::os::raw::c_int;
+    #[doc = "   The packet mbuf to be resetted."]
+    pub fn _rte_pktmbuf_reset(m: *mut rte_mbuf);
 }
 extern "C" {
-    #[doc = " Linearize data in mbuf."]
+    #[doc = " Allocate a new mbuf from a mempool."]
     #[doc = ""]
-    #[doc = " This function moves the mbuf data in the first segment if there is enough"]
-    #[doc = " tailroom. The subsequent segments are unchained and freed."]
+    #[doc = " This new mbuf contains one segment, which has a length of 0. The pointer"]
+    #[doc = " to data is initialized to have some bytes of headroom in the buffer"]
+    #[doc = " (if buffer size allows)."]
     #[doc = ""]
-    #[doc = " @param mbuf"]
-    #[doc = "   mbuf to linearize"]
+    #[doc = " @param mp"]
+    #[doc = "   The mempool from which the mbuf is allocated."]
     #[doc = " @return"]
-    #[doc = "   - 0, on success"]
-    #[doc = "   - -1, on error"]
-    pub fn _rte_pktmbuf_linearize(mbuf: *mut rte_mbuf) -> ::std::os::raw::c_int;
+    #[doc = "   - The pointer to the new mbuf on success."]
+    #[doc = "   - NULL if allocation failed."]
+    pub fn _rte_pktmbuf_alloc(mp: *mut rte_mempool) -> *mut rte_mbuf;
 }
 extern "C" {
-    #[doc = " Retrieve a burst of input packets from a receive queue of an Ethernet"]
-    #[doc = " device. The retrieved packets are stored in *rte_mbuf* structures whose"]
-    #[doc = " pointers are supplied in the *rx_pkts* array."]
+    #[doc = " Allocate a bulk of mbufs, initialize refcnt and reset the fields to default"]
+    #[doc = " values."]
     #[doc = ""]
-    #[doc = " The rte_eth_rx_burst() function loops, parsing the RX ring of the"]
-    #[doc = " receive queue, up to *nb_pkts* packets, and for each completed RX"]
-    #[doc = " descriptor in the ring, it performs the following operations:"]
+    #[doc = "  @param pool"]
+    #[doc = "    The mempool from which mbufs are allocated."]
+    #[doc = "  @param mbufs"]
+    #[doc = "    Array of pointers to mbufs"]
+    #[doc = "  @param count"]
+    #[doc = "    Array size"]
+    #[doc = "  @return"]
+    #[doc = "   - 0: Success"]
+    #[doc = "   - -ENOENT: Not enough entries in the mempool; no mbufs are retrieved."]
+    pub fn _rte_pktmbuf_alloc_bulk(
+        pool: *mut rte_mempool,
+        mbufs: *mut *mut rte_mbuf,
+        count: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Initialize shared data at the end of an external buffer before attaching"]
+    #[doc = " to a mbuf by ``rte_pktmbuf_attach_extbuf()``. This is not a mandatory"]
+    #[doc = " initialization but a helper function to simply spare a few bytes at the"]
+    #[doc = " end of the buffer for shared data. If shared data is allocated"]
+    #[doc = " separately, this should not be called but application has to properly"]
+    #[doc = " initialize the shared data according to its need."]
     #[doc = ""]
-    #[doc = " - Initialize the *rte_mbuf* data structure associated with the"]
-    #[doc = "   RX descriptor according to the information provided by the NIC into"]
-    #[doc = "   that RX descriptor."]
+    #[doc = " Free callback and its argument is saved and the refcnt is set to 1."]
     #[doc = ""]
-    #[doc = " - Store the *rte_mbuf* data structure into the next entry of the"]
-    #[doc = "   *rx_pkts* array."]
+    #[doc = " @warning"]
+    #[doc = " The value of buf_len will be reduced to RTE_PTR_DIFF(shinfo, buf_addr)"]
+    #[doc = " after this initialization. This shall be used for"]
+    #[doc = " ``rte_pktmbuf_attach_extbuf()``"]
     #[doc = ""]
-    #[doc = " - Replenish the RX descriptor with a new *rte_mbuf* buffer"]
-    #[doc = "   allocated from the memory pool associated with the receive queue at"]
-    #[doc = "   initialization time."]
+    #[doc = " @param buf_addr"]
+    #[doc = "   The pointer to the external buffer."]
+    #[doc = " @param [in,out] buf_len"]
+    #[doc = "   The pointer to length of the external buffer. Input value must be"]
+    #[doc = "   larger than the size of ``struct rte_mbuf_ext_shared_info`` and"]
+    #[doc = "   padding for alignment. If not enough, this function will return NULL."]
+    #[doc = "   Adjusted buffer length will be returned through this pointer."]
+    #[doc = " @param free_cb"]
+    #[doc = "   Free callback function to call when the external buffer needs to be"]
+    #[doc = "   freed."]
+    #[doc = " @param fcb_opaque"]
+    #[doc = "   Argument for the free callback function."]
     #[doc = ""]
-    #[doc = " When retrieving an input packet that was scattered by the controller"]
-    #[doc = " into multiple receive descriptors, the rte_eth_rx_burst() function"]
-    #[doc = " appends the associated *rte_mbuf* buffers to the first buffer of the"]
-    #[doc = " packet."]
+    #[doc = " @return"]
+    #[doc = "   A pointer to the initialized shared data on success, return NULL"]
+    #[doc = "   otherwise."]
+    pub fn _rte_pktmbuf_ext_shinfo_init_helper(
+        buf_addr: *mut ::std::os::raw::c_void,
+        buf_len: *mut u16,
+        free_cb: rte_mbuf_extbuf_free_callback_t,
+        fcb_opaque: *mut ::std::os::raw::c_void,
+    ) -> *mut rte_mbuf_ext_shared_info;
+}
+extern "C" {
+    #[doc = " Attach an external buffer to a mbuf."]
     #[doc = ""]
-    #[doc = " The rte_eth_rx_burst() function returns the number of packets"]
-    #[doc = " actually retrieved, which is the number of *rte_mbuf* data structures"]
-    #[doc = " effectively supplied into the *rx_pkts* array."]
-    #[doc = " A return value equal to *nb_pkts* indicates that the RX queue contained"]
-    #[doc = " at least *rx_pkts* packets, and this is likely to signify that other"]
-    #[doc = " received packets remain in the input queue. Applications implementing"]
-    #[doc = " a \"retrieve as much received packets as possible\" policy can check this"]
-    #[doc = " specific case and keep invoking the rte_eth_rx_burst() function until"]
-    #[doc = " a value less than *nb_pkts* is returned."]
+    #[doc = " User-managed anonymous buffer can be attached to an mbuf. When attaching"]
+    #[doc = " it, corresponding free callback function and its argument should be"]
+    #[doc = " provided via shinfo. This callback function will be called once all the"]
+    #[doc = " mbufs are detached from the buffer (refcnt becomes zero)."]
     #[doc = ""]
-    #[doc = " This receive method has the following advantages:"]
+    #[doc = " The headroom for the attaching mbuf will be set to zero and this can be"]
+    #[doc = " properly adjusted after attachment. For example, ``rte_pktmbuf_adj()``"]
+    #[doc = " or ``rte_pktmbuf_reset_headroom()`` might be used."]
     #[doc = ""]
-    #[doc = " - It allows a run-to-completion network stack engine to retrieve and"]
-    #[doc = "   to immediately process received packets in a fast burst-oriented"]
-    #[doc = "   approach, avoiding the overhead of unnecessary intermediate packet"]
-    #[doc = "   queue/dequeue operations."]
+    #[doc = " More mbufs can be attached to the same external buffer by"]
+    #[doc = " ``rte_pktmbuf_attach()`` once the external buffer has been attached by"]
+    #[doc = " this API."]
     #[doc = ""]
-    #[doc = " - Conversely, it also allows an asynchronous-oriented processing"]
-    #[doc = "   method to retrieve bursts of received packets and to immediately"]
-    #[doc = "   queue them for further parallel processing by another logical core,"]
-    #[doc = "   for instance. However, instead of having received packets being"]
-    #[doc = "   individually queued by the driver, this approach allows the caller"]
-    #[doc = "   of the rte_eth_rx_burst() function to queue a burst of retrieved"]
-    #[doc = "   packets at a time and therefore dramatically reduce the cost of"]
-    #[doc = "   enqueue/dequeue operations per packet."]
+    #[doc = " Detachment can be done by either ``rte_pktmbuf_detach_extbuf()`` or"]
+    #[doc = " ``rte_pktmbuf_detach()``."]
     #[doc = ""]
-    #[doc = " - It allows the rte_eth_rx_burst() function of the driver to take"]
-    #[doc = "   advantage of burst-oriented hardware features (CPU cache,"]
-    #[doc = "   prefetch instructions, and so on) to minimize the number of CPU"]
-    #[doc = "   cycles per packet."]
+    #[doc = " Memory for shared data must be provided and user must initialize all of"]
+    #[doc = " the content properly, escpecially free callback and refcnt. The pointer"]
+    #[doc = " of shared data will be stored in m->shinfo."]
+    #[doc = " ``rte_pktmbuf_ext_shinfo_init_helper`` can help to simply spare a few"]
+    #[doc = " bytes at the end of buffer for the shared data, store free callback and"]
+    #[doc = " its argument and set the refcnt to 1. The following is an example:"]
     #[doc = ""]
-    #[doc = " To summarize, the proposed receive API enables many"]
-    #[doc = " burst-oriented optimizations in both synchronous and asynchronous"]
-    #[doc = " packet processing environments with no overhead in both cases."]
+    #[doc = "   struct rte_mbuf_ext_shared_info *shinfo ="]
+    #[doc = "          rte_pktmbuf_ext_shinfo_init_helper(buf_addr, &buf_len,"]
+    #[doc = "                                             free_cb, fcb_arg);"]
+    #[doc = "   rte_pktmbuf_attach_extbuf(m, buf_addr, buf_iova, buf_len, shinfo);"]
+    #[doc = "   rte_pktmbuf_reset_headroom(m);"]
+    #[doc = "   rte_pktmbuf_adj(m, data_len);"]
     #[doc = ""]
-    #[doc = " The rte_eth_rx_burst() function does not provide any error"]
-    #[doc = " notification to avoid the corresponding overhead. As a hint, the"]
-    #[doc = " upper-level application might check the status of the device link once"]
-    #[doc = " being systematically returned a 0 value for a given number of tries."]
+    #[doc = " Attaching an external buffer is quite similar to mbuf indirection in"]
+    #[doc = " replacing buffer addresses and length of a mbuf, but a few differences:"]
+    #[doc = " - When an indirect mbuf is attached, refcnt of the direct mbuf would be"]
+    #[doc = "   2 as long as the direct mbuf itself isn't freed after the attachment."]
+    #[doc = "   In such cases, the buffer area of a direct mbuf must be read-only. But"]
+    #[doc = "   external buffer has its own refcnt and it starts from 1. Unless"]
+    #[doc = "   multiple mbufs are attached to a mbuf having an external buffer, the"]
+    #[doc = "   external buffer is writable."]
+    #[doc = " - There's no need to allocate buffer from a mempool. Any buffer can be"]
+    #[doc = "   attached with appropriate free callback and its IO address."]
+    #[doc = " - Smaller metadata is required to maintain shared data such as refcnt."]
     #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "   The port identifier of the Ethernet device."]
-    #[doc = " @param queue_id"]
-    #[doc = "   The index of the receive queue from which to retrieve input packets."]
-    #[doc = "   The value must be in the range [0, nb_rx_queue - 1] previously supplied"]
-    #[doc = "   to rte_eth_dev_configure()."]
-    #[doc = " @param rx_pkts"]
-    #[doc = "   The address of an array of pointers to *rte_mbuf* structures that"]
-    #[doc = "   must be large enough to store *nb_pkts* pointers in it."]
-    #[doc = " @param nb_pkts"]
-    #[doc = "   The maximum number of packets to retrieve."]
-    #[doc = " @return"]
-    #[doc = "   The number of packets actually retrieved, which is the number"]
-    #[doc = "   of pointers to *rte_mbuf* structures effectively supplied to the"]
-    #[doc = "   *rx_pkts* array."]
-    pub fn _rte_eth_rx_burst(port_id: u16, queue_id: u16, rx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16;
-}
-extern "C" {
-    #[doc = " Get the number of used descriptors of a rx queue"]
-    #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "  The port identifier of the Ethernet device."]
-    #[doc = " @param queue_id"]
-    #[doc = "  The queue id on the specific port."]
-    #[doc = " @return"]
-    #[doc = "  The number of used descriptors in the specific queue, or:"]
-    #[doc = "     (-EINVAL) if *port_id* or *queue_id* is invalid"]
-    #[doc = "     (-ENOTSUP) if the device does not support this function"]
-    pub fn _rte_eth_rx_queue_count(port_id: u16, queue_id: u16) -> ::std::os::raw::c_int;
-}
-extern "C" {
-    #[doc = " Check if the DD bit of the specific RX descriptor in the queue has been set"]
+    #[doc = " @warning"]
+    #[doc = " @b EXPERIMENTAL: This API may change without prior notice."]
+    #[doc = " Once external buffer is enabled by allowing experimental API,"]
+    #[doc = " ``RTE_MBUF_DIRECT()`` and ``RTE_MBUF_INDIRECT()`` are no longer"]
+    #[doc = " exclusive. A mbuf can be considered direct if it is neither indirect nor"]
+    #[doc = " having external buffer."]
     #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "  The port identifier of the Ethernet device."]
-    #[doc = " @param queue_id"]
-    #[doc = "  The queue id on the specific port."]
-    #[doc = " @param offset"]
-    #[doc = "  The offset of the descriptor ID from tail."]
-    #[doc = " @return"]
-    #[doc = "  - (1) if the specific DD bit is set."]
-    #[doc = "  - (0) if the specific DD bit is not set."]
-    #[doc = "  - (-ENODEV) if *port_id* invalid."]
-    #[doc = "  - (-ENOTSUP) if the device does not support this function"]
-    pub fn _rte_eth_rx_descriptor_done(port_id: u16, queue_id: u16, offset: u16) -> ::std::os::raw::c_int;
+    #[doc = " @param m"]
+    #[doc = "   The pointer to the mbuf."]
+    #[doc = " @param buf_addr"]
+    #[doc = "   The pointer to the external buffer."]
+    #[doc = " @param buf_iova"]
+    #[doc = "   IO address of the external buffer."]
+    #[doc = " @param buf_len"]
+    #[doc = "   The size of the external buffer."]
+    #[doc = " @param shinfo"]
+    #[doc = "   User-provided memory for shared data of the external buffer."]
+    pub fn _rte_pktmbuf_attach_extbuf(
+        m: *mut rte_mbuf,
+        buf_addr: *mut ::std::os::raw::c_void,
+        buf_iova: rte_iova_t,
+        buf_len: u16,
+        shinfo: *mut rte_mbuf_ext_shared_info,
+    );
 }
 extern "C" {
-    #[doc = " Check the status of a Rx descriptor in the queue"]
-    #[doc = ""]
-    #[doc = " It should be called in a similar context than the Rx function:"]
-    #[doc = " - on a dataplane core"]
-    #[doc = " - not concurrently on the same queue"]
+    #[doc = " Attach packet mbuf to another packet mbuf."]
     #[doc = ""]
-    #[doc = " Since it's a dataplane function, no check is performed on port_id and"]
-    #[doc = " queue_id. The caller must therefore ensure that the port is enabled"]
-    #[doc = " and the queue is configured and running."]
+    #[doc = " If the mbuf we are attaching to isn't a direct buffer and is attached to"]
+    #[doc = " an external buffer, the mbuf being attached will be attached to the"]
+    #[doc = " external buffer instead of mbuf indirection."]
     #[doc = ""]
-    #[doc = " Note: accessing to a random descriptor in the ring may trigger cache"]
-    #[doc = " misses and have a performance impact."]
+    #[doc = " Otherwise, the mbuf will be indirectly attached. After attachment we"]
+    #[doc = " refer the mbuf we attached as 'indirect', while mbuf we attached to as"]
+    #[doc = " 'direct'.  The direct mbuf's reference counter is incremented."]
     #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "  A valid port identifier of the Ethernet device which."]
-    #[doc = " @param queue_id"]
-    #[doc = "  A valid Rx queue identifier on this port."]
-    #[doc = " @param offset"]
-    #[doc = "  The offset of the descriptor starting from tail (0 is the next"]
-    #[doc = "  packet to be received by the driver)."]
+    #[doc = " Right now, not supported:"]
+    #[doc = "  - attachment for already indirect mbuf (e.g. - mi has to be direct)."]
+    #[doc = "  - mbuf we trying to attach (mi) is used by someone else"]
+    #[doc = "    e.g. it's reference counter is greater then 1."]
     #[doc = ""]
-    #[doc = " @return"]
-    #[doc = "  - (RTE_ETH_RX_DESC_AVAIL): Descriptor is available for the hardware to"]
-    #[doc = "    receive a packet."]
-    #[doc = "  - (RTE_ETH_RX_DESC_DONE): Descriptor is done, it is filled by hw, but"]
-    #[doc = "    not yet processed by the driver (i.e. in the receive queue)."]
-    #[doc = "  - (RTE_ETH_RX_DESC_UNAVAIL): Descriptor is unavailable, either hold by"]
-    #[doc = "    the driver and not yet returned to hw, or reserved by the hw."]
-    #[doc = "  - (-EINVAL) bad descriptor offset."]
-    #[doc = "  - (-ENOTSUP) if the device does not support this function."]
-    #[doc = "  - (-ENODEV) bad port or queue (only if compiled with debug)."]
-    pub fn _rte_eth_rx_descriptor_status(port_id: u16, queue_id: u16, offset: u16) -> ::std::os::raw::c_int;
+    #[doc = " @param mi"]
+    #[doc = "   The indirect packet mbuf."]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf we're attaching to."]
+    pub fn _rte_pktmbuf_attach(mi: *mut rte_mbuf, m: *mut rte_mbuf);
 }
 extern "C" {
-    #[doc = " Check the status of a Tx descriptor in the queue."]
+    #[doc = " Detach a packet mbuf from external buffer or direct buffer."]
     #[doc = ""]
-    #[doc = " It should be called in a similar context than the Tx function:"]
-    #[doc = " - on a dataplane core"]
-    #[doc = " - not concurrently on the same queue"]
+    #[doc = "  - decrement refcnt and free the external/direct buffer if refcnt"]
+    #[doc = "    becomes zero."]
+    #[doc = "  - restore original mbuf address and length values."]
+    #[doc = "  - reset pktmbuf data and data_len to their default values."]
     #[doc = ""]
-    #[doc = " Since it's a dataplane function, no check is performed on port_id and"]
-    #[doc = " queue_id. The caller must therefore ensure that the port is enabled"]
-    #[doc = " and the queue is configured and running."]
+    #[doc = " All other fields of the given packet mbuf will be left intact."]
     #[doc = ""]
-    #[doc = " Note: accessing to a random descriptor in the ring may trigger cache"]
-    #[doc = " misses and have a performance impact."]
+    #[doc = " @param m"]
+    #[doc = "   The indirect attached packet mbuf."]
+    pub fn _rte_pktmbuf_detach(m: *mut rte_mbuf);
+}
+extern "C" {
+    #[doc = " Decrease reference counter and unlink a mbuf segment"]
     #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "  A valid port identifier of the Ethernet device which."]
-    #[doc = " @param queue_id"]
-    #[doc = "  A valid Tx queue identifier on this port."]
-    #[doc = " @param offset"]
-    #[doc = "  The offset of the descriptor starting from tail (0 is the place where"]
-    #[doc = "  the next packet will be send)."]
+    #[doc = " This function does the same than a free, except that it does not"]
+    #[doc = " return the segment to its pool."]
+    #[doc = " It decreases the reference counter, and if it reaches 0, it is"]
+    #[doc = " detached from its parent for an indirect mbuf."]
     #[doc = ""]
+    #[doc = " @param m"]
+    #[doc = "   The mbuf to be unlinked"]
     #[doc = " @return"]
-    #[doc = "  - (RTE_ETH_TX_DESC_FULL) Descriptor is being processed by the hw, i.e."]
-    #[doc = "    in the transmit queue."]
-    #[doc = "  - (RTE_ETH_TX_DESC_DONE) Hardware is done with this descriptor, it can"]
-    #[doc = "    be reused by the driver."]
-    #[doc = "  - (RTE_ETH_TX_DESC_UNAVAIL): Descriptor is unavailable, reserved by the"]
-    #[doc = "    driver or the hardware."]
-    #[doc = "  - (-EINVAL) bad descriptor offset."]
-    #[doc = "  - (-ENOTSUP) if the device does not support this function."]
-    #[doc = "  - (-ENODEV) bad port or queue (only if compiled with debug)."]
-    pub fn _rte_eth_tx_descriptor_status(port_id: u16, queue_id: u16, offset: u16) -> ::std::os::raw::c_int;
+    #[doc = "   - (m) if it is the last reference. It can be recycled or freed."]
+    #[doc = "   - (NULL) if the mbuf still has remaining references on it."]
+    pub fn _rte_pktmbuf_prefree_seg(m: *mut rte_mbuf) -> *mut rte_mbuf;
 }
 extern "C" {
-    #[doc = " Send a burst of output packets on a transmit queue of an Ethernet device."]
-    #[doc = ""]
-    #[doc = " The rte_eth_tx_burst() function is invoked to transmit output packets"]
-    #[doc = " on the output queue *queue_id* of the Ethernet device designated by its"]
-    #[doc = " *port_id*."]
-    #[doc = " The *nb_pkts* parameter is the number of packets to send which are"]
-    #[doc = " supplied in the *tx_pkts* array of *rte_mbuf* structures, each of them"]
-    #[doc = " allocated from a pool created with rte_pktmbuf_pool_create()."]
-    #[doc = " The rte_eth_tx_burst() function loops, sending *nb_pkts* packets,"]
-    #[doc = " up to the number of transmit descriptors available in the TX ring of the"]
-    #[doc = " transmit queue."]
-    #[doc = " For each packet to send, the rte_eth_tx_burst() function performs"]
-    #[doc = " the following operations:"]
+    #[doc = " Free a segment of a packet mbuf into its original mempool."]
     #[doc = ""]
-    #[doc = " - Pick up the next available descriptor in the transmit ring."]
+    #[doc = " Free an mbuf, without parsing other segments in case of chained"]
+    #[doc = " buffers."]
     #[doc = ""]
-    #[doc = " - Free the network buffer previously sent with that descriptor, if any."]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf segment to be freed."]
+    pub fn _rte_pktmbuf_free_seg(m: *mut rte_mbuf);
+}
+extern "C" {
+    #[doc = " Free a packet mbuf back into its original mempool."]
     #[doc = ""]
-    #[doc = " - Initialize the transmit descriptor with the information provided"]
-    #[doc = "   in the *rte_mbuf data structure."]
+    #[doc = " Free an mbuf, and all its segments in case of chained buffers. Each"]
+    #[doc = " segment is added back into its original mempool."]
     #[doc = ""]
-    #[doc = " In the case of a segmented packet composed of a list of *rte_mbuf* buffers,"]
-    #[doc = " the rte_eth_tx_burst() function uses several transmit descriptors"]
-    #[doc = " of the ring."]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf to be freed. If NULL, the function does nothing."]
+    pub fn _rte_pktmbuf_free(m: *mut rte_mbuf);
+}
+extern "C" {
+    #[doc = " Creates a \"clone\" of the given packet mbuf."]
     #[doc = ""]
-    #[doc = " The rte_eth_tx_burst() function returns the number of packets it"]
-    #[doc = " actually sent. A return value equal to *nb_pkts* means that all packets"]
-    #[doc = " have been sent, and this is likely to signify that other output packets"]
-    #[doc = " could be immediately transmitted again. Applications that implement a"]
-    #[doc = " \"send as many packets to transmit as possible\" policy can check this"]
-    #[doc = " specific case and keep invoking the rte_eth_tx_burst() function until"]
-    #[doc = " a value less than *nb_pkts* is returned."]
+    #[doc = " Walks through all segments of the given packet mbuf, and for each of them:"]
+    #[doc = "  - Creates a new packet mbuf from the given pool."]
+    #[doc = "  - Attaches newly created mbuf to the segment."]
+    #[doc = " Then updates pkt_len and nb_segs of the \"clone\" packet mbuf to match values"]
+    #[doc = " from the original packet mbuf."]
     #[doc = ""]
-    #[doc = " It is the responsibility of the rte_eth_tx_burst() function to"]
-    #[doc = " transparently free the memory buffers of packets previously sent."]
-    #[doc = " This feature is driven by the *tx_free_thresh* value supplied to the"]
-    #[doc = " rte_eth_dev_configure() function at device configuration time."]
-    #[doc = " When the number of free TX descriptors drops below this threshold, the"]
-    #[doc = " rte_eth_tx_burst() function must [attempt to] free the *rte_mbuf*  buffers"]
-    #[doc = " of those packets whose transmission was effectively completed."]
+    #[doc = " @param md"]
+    #[doc = "   The packet mbuf to be cloned."]
+    #[doc = " @param mp"]
+    #[doc = "   The mempool from which the \"clone\" mbufs are allocated."]
+    #[doc = " @return"]
+    #[doc = "   - The pointer to the new \"clone\" mbuf on success."]
+    #[doc = "   - NULL if allocation fails."]
+    pub fn _rte_pktmbuf_clone(md: *mut rte_mbuf, mp: *mut rte_mempool) -> *mut rte_mbuf;
+}
+extern "C" {
+    #[doc = " Adds given value to the refcnt of all packet mbuf segments."]
     #[doc = ""]
-    #[doc = " If the PMD is DEV_TX_OFFLOAD_MT_LOCKFREE capable, multiple threads can"]
-    #[doc = " invoke this function concurrently on the same tx queue without SW lock."]
-    #[doc = " @see rte_eth_dev_info_get, struct rte_eth_txconf::offloads"]
+    #[doc = " Walks through all segments of given packet mbuf and for each of them"]
+    #[doc = " invokes rte_mbuf_refcnt_update()."]
     #[doc = ""]
-    #[doc = " @see rte_eth_tx_prepare to perform some prior checks or adjustments"]
-    #[doc = " for offloads."]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf whose refcnt to be updated."]
+    #[doc = " @param v"]
+    #[doc = "   The value to add to the mbuf's segments refcnt."]
+    pub fn _rte_pktmbuf_refcnt_update(m: *mut rte_mbuf, v: i16);
+}
+extern "C" {
+    #[doc = " Get the headroom in a packet mbuf."]
     #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "   The port identifier of the Ethernet device."]
-    #[doc = " @param queue_id"]
-    #[doc = "   The index of the transmit queue through which output packets must be"]
-    #[doc = "   sent."]
-    #[doc = "   The value must be in the range [0, nb_tx_queue - 1] previously supplied"]
-    #[doc = "   to rte_eth_dev_configure()."]
-    #[doc = " @param tx_pkts"]
-    #[doc = "   The address of an array of *nb_pkts* pointers to *rte_mbuf* structures"]
-    #[doc = "   which contain the output packets."]
-    #[doc = " @param nb_pkts"]
-    #[doc = "   The maximum number of packets to transmit."]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
     #[doc = " @return"]
-    #[doc = "   The number of output packets actually stored in transmit descriptors of"]
-    #[doc = "   the transmit ring. The return value can be less than the value of the"]
-    #[doc = "   *tx_pkts* parameter when the transmit ring is full or has been filled up."]
-    pub fn _rte_eth_tx_burst(port_id: u16, queue_id: u16, tx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16;
+    #[doc = "   The length of the headroom."]
+    pub fn _rte_pktmbuf_headroom(m: *const rte_mbuf) -> u16;
 }
 extern "C" {
-    #[doc = " Process a burst of output packets on a transmit queue of an Ethernet device."]
+    #[doc = " Get the tailroom of a packet mbuf."]
     #[doc = ""]
-    #[doc = " The rte_eth_tx_prepare() function is invoked to prepare output packets to be"]
-    #[doc = " transmitted on the output queue *queue_id* of the Ethernet device designated"]
-    #[doc = " by its *port_id*."]
-    #[doc = " The *nb_pkts* parameter is the number of packets to be prepared which are"]
-    #[doc = " supplied in the *tx_pkts* array of *rte_mbuf* structures, each of them"]
-    #[doc = " allocated from a pool created with rte_pktmbuf_pool_create()."]
-    #[doc = " For each packet to send, the rte_eth_tx_prepare() function performs"]
-    #[doc = " the following operations:"]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
+    #[doc = " @return"]
+    #[doc = "   The length of the tailroom."]
+    pub fn _rte_pktmbuf_tailroom(m: *const rte_mbuf) -> u16;
+}
+extern "C" {
+    #[doc = " Get the last segment of the packet."]
     #[doc = ""]
-    #[doc = " - Check if packet meets devices requirements for tx offloads."]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
+    #[doc = " @return"]
+    #[doc = "   The last segment of the given mbuf."]
+    pub fn _rte_pktmbuf_lastseg(m: *mut rte_mbuf) -> *mut rte_mbuf;
+}
+extern "C" {
+    #[doc = " Prepend len bytes to an mbuf data area."]
     #[doc = ""]
-    #[doc = " - Check limitations about number of segments."]
+    #[doc = " Returns a pointer to the new"]
+    #[doc = " data start address. If there is not enough headroom in the first"]
+    #[doc = " segment, the function will return NULL, without modifying the mbuf."]
     #[doc = ""]
-    #[doc = " - Check additional requirements when debug is enabled."]
+    #[doc = " @param m"]
+    #[doc = "   The pkt mbuf."]
+    #[doc = " @param len"]
+    #[doc = "   The amount of data to prepend (in bytes)."]
+    #[doc = " @return"]
+    #[doc = "   A pointer to the start of the newly prepended data, or"]
+    #[doc = "   NULL if there is not enough headroom space in the first segment"]
+    pub fn _rte_pktmbuf_prepend(m: *mut rte_mbuf, len: u16) -> *mut ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = " Append len bytes to an mbuf."]
     #[doc = ""]
-    #[doc = " - Update and/or reset required checksums when tx offload is set for packet."]
+    #[doc = " Append len bytes to an mbuf and return a pointer to the start address"]
+    #[doc = " of the added data. If there is not enough tailroom in the last"]
+    #[doc = " segment, the function will return NULL, without modifying the mbuf."]
     #[doc = ""]
-    #[doc = " Since this function can modify packet data, provided mbufs must be safely"]
-    #[doc = " writable (e.g. modified data cannot be in shared segment)."]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
+    #[doc = " @param len"]
+    #[doc = "   The amount of data to append (in bytes)."]
+    #[doc = " @return"]
+    #[doc = "   A pointer to the start of the newly appended data, or"]
+    #[doc = "   NULL if there is not enough tailroom space in the last segment"]
+    pub fn _rte_pktmbuf_append(m: *mut rte_mbuf, len: u16) -> *mut ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = " Remove len bytes at the beginning of an mbuf."]
     #[doc = ""]
-    #[doc = " The rte_eth_tx_prepare() function returns the number of packets ready to be"]
-    #[doc = " sent. A return value equal to *nb_pkts* means that all packets are valid and"]
-    #[doc = " ready to be sent, otherwise stops processing on the first invalid packet and"]
-    #[doc = " leaves the rest packets untouched."]
+    #[doc = " Returns a pointer to the start address of the new data area. If the"]
+    #[doc = " length is greater than the length of the first segment, then the"]
+    #[doc = " function will fail and return NULL, without modifying the mbuf."]
     #[doc = ""]
-    #[doc = " When this functionality is not implemented in the driver, all packets are"]
-    #[doc = " are returned untouched."]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
+    #[doc = " @param len"]
+    #[doc = "   The amount of data to remove (in bytes)."]
+    #[doc = " @return"]
+    #[doc = "   A pointer to the new start of the data."]
+    pub fn _rte_pktmbuf_adj(m: *mut rte_mbuf, len: u16) -> *mut ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = " Remove len bytes of data at the end of the mbuf."]
     #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "   The port identifier of the Ethernet device."]
-    #[doc = "   The value must be a valid port id."]
-    #[doc = " @param queue_id"]
-    #[doc = "   The index of the transmit queue through which output packets must be"]
-    #[doc = "   sent."]
-    #[doc = "   The value must be in the range [0, nb_tx_queue - 1] previously supplied"]
-    #[doc = "   to rte_eth_dev_configure()."]
-    #[doc = " @param tx_pkts"]
-    #[doc = "   The address of an array of *nb_pkts* pointers to *rte_mbuf* structures"]
-    #[doc = "   which contain the output packets."]
-    #[doc = " @param nb_pkts"]
-    #[doc = "   The maximum number of packets to process."]
+    #[doc = " If the length is greater than the length of the last segment, the"]
+    #[doc = " function will fail and return -1 without modifying the mbuf."]
+    #[doc = ""]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
+    #[doc = " @param len"]
+    #[doc = "   The amount of data to remove (in bytes)."]
     #[doc = " @return"]
-    #[doc = "   The number of packets correct and ready to be sent. The return value can be"]
-    #[doc = "   less than the value of the *tx_pkts* parameter when some packet doesn't"]
-    #[doc = "   meet devices requirements with rte_errno set appropriately:"]
-    #[doc = "   - -EINVAL: offload flags are not correctly set"]
-    #[doc = "   - -ENOTSUP: the offload feature is not supported by the hardware"]
+    #[doc = "   - 0: On success."]
+    #[doc = "   - -1: On error."]
+    pub fn _rte_pktmbuf_trim(m: *mut rte_mbuf, len: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Test if mbuf data is contiguous."]
     #[doc = ""]
-    pub fn _rte_eth_tx_prepare(port_id: u16, queue_id: u16, tx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16;
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
+    #[doc = " @return"]
+    #[doc = "   - 1, if all data is contiguous (one segment)."]
+    #[doc = "   - 0, if there is several segments."]
+    pub fn _rte_pktmbuf_is_contiguous(m: *const rte_mbuf) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Send any packets queued up for transmission on a port and HW queue"]
+    #[doc = " Read len data bytes in a mbuf at specified offset."]
     #[doc = ""]
-    #[doc = " This causes an explicit flush of packets previously buffered via the"]
-    #[doc = " rte_eth_tx_buffer() function. It returns the number of packets successfully"]
-    #[doc = " sent to the NIC, and calls the error callback for any unsent packets. Unless"]
-    #[doc = " explicitly set up otherwise, the default callback simply frees the unsent"]
-    #[doc = " packets back to the owning mempool."]
+    #[doc = " If the data is contiguous, return the pointer in the mbuf data, else"]
+    #[doc = " copy the data in the buffer provided by the user and return its"]
+    #[doc = " pointer."]
     #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "   The port identifier of the Ethernet device."]
-    #[doc = " @param queue_id"]
-    #[doc = "   The index of the transmit queue through which output packets must be"]
-    #[doc = "   sent."]
-    #[doc = "   The value must be in the range [0, nb_tx_queue - 1] previously supplied"]
-    #[doc = "   to rte_eth_dev_configure()."]
-    #[doc = " @param buffer"]
-    #[doc = "   Buffer of packets to be transmit."]
+    #[doc = " @param m"]
+    #[doc = "   The pointer to the mbuf."]
+    #[doc = " @param off"]
+    #[doc = "   The offset of the data in the mbuf."]
+    #[doc = " @param len"]
+    #[doc = "   The amount of bytes to read."]
+    #[doc = " @param buf"]
+    #[doc = "   The buffer where data is copied if it is not contiguous in mbuf"]
+    #[doc = "   data. Its length should be at least equal to the len parameter."]
     #[doc = " @return"]
-    #[doc = "   The number of packets successfully sent to the Ethernet device. The error"]
-    #[doc = "   callback is called for any packets which could not be sent."]
-    pub fn _rte_eth_tx_buffer_flush(port_id: u16, queue_id: u16, buffer: *mut rte_eth_dev_tx_buffer) -> u16;
+    #[doc = "   The pointer to the data, either in the mbuf if it is contiguous,"]
+    #[doc = "   or in the user buffer. If mbuf is too small, NULL is returned."]
+    pub fn _rte_pktmbuf_read(
+        m: *const rte_mbuf,
+        off: u32,
+        len: u32,
+        buf: *mut ::std::os::raw::c_void,
+    ) -> *const ::std::os::raw::c_void;
 }
 extern "C" {
-    #[doc = " Buffer a single packet for future transmission on a port and queue"]
+    #[doc = " Chain an mbuf to another, thereby creating a segmented packet."]
     #[doc = ""]
-    #[doc = " This function takes a single mbuf/packet and buffers it for later"]
-    #[doc = " transmission on the particular port and queue specified. Once the buffer is"]
-    #[doc = " full of packets, an attempt will be made to transmit all the buffered"]
-    #[doc = " packets. In case of error, where not all packets can be transmitted, a"]
-    #[doc = " callback is called with the unsent packets as a parameter. If no callback"]
-    #[doc = " is explicitly set up, the unsent packets are just freed back to the owning"]
-    #[doc = " mempool. The function returns the number of packets actually sent i.e."]
-    #[doc = " 0 if no buffer flush occurred, otherwise the number of packets successfully"]
-    #[doc = " flushed"]
+    #[doc = " Note: The implementation will do a linear walk over the segments to find"]
+    #[doc = " the tail entry. For cases when there are many segments, it's better to"]
+    #[doc = " chain the entries manually."]
+    #[doc = ""]
+    #[doc = " @param head"]
+    #[doc = "   The head of the mbuf chain (the first packet)"]
+    #[doc = " @param tail"]
+    #[doc = "   The mbuf to put last in the chain"]
     #[doc = ""]
-    #[doc = " @param port_id"]
-    #[doc = "   The port identifier of the Ethernet device."]
-    #[doc = " @param queue_id"]
-    #[doc = "   The index of the transmit queue through which output packets must be"]
-    #[doc = "   sent."]
-    #[doc = "   The value must be in the range [0, nb_tx_queue - 1] previously supplied"]
-    #[doc = "   to rte_eth_dev_configure()."]
-    #[doc = " @param buffer"]
-    #[doc = "   Buffer used to collect packets to be sent."]
-    #[doc = " @param tx_pkt"]
-    #[doc = "   Pointer to the packet mbuf to be sent."]
     #[doc = " @return"]
-    #[doc = "   0 = packet has been buffered for later transmission"]
-    #[doc = "   N > 0 = packet has been buffered, and the buffer was subsequently flushed,"]
-    #[doc = "     causing N packets to be sent, and the error callback to be called for"]
-    #[doc = "     the rest."]
-    pub fn _rte_eth_tx_buffer(
-        port_id: u16,
-        queue_id: u16,
-        buffer: *mut rte_eth_dev_tx_buffer,
-        tx_pkt: *mut rte_mbuf,
-    ) -> u16;
+    #[doc = "   - 0, on success."]
+    #[doc = "   - -EOVERFLOW, if the chain segment limit exceeded"]
+    pub fn _rte_pktmbuf_chain(head: *mut rte_mbuf, tail: *mut rte_mbuf) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Extract VLAN tag information into mbuf"]
+    #[doc = " Validate general requirements for Tx offload in mbuf."]
     #[doc = ""]
-    #[doc = " Software version of VLAN stripping"]
+    #[doc = " This function checks correctness and completeness of Tx offload settings."]
     #[doc = ""]
     #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
+    #[doc = "   The packet mbuf to be validated."]
     #[doc = " @return"]
-    #[doc = "   - 0: Success"]
-    #[doc = "   - 1: not a vlan packet"]
-    pub fn _rte_vlan_strip(m: *mut rte_mbuf) -> ::std::os::raw::c_int;
+    #[doc = "   0 if packet is valid"]
+    pub fn _rte_validate_tx_offload(m: *const rte_mbuf) -> ::std::os::raw::c_int;
 }
 extern "C" {
-    #[doc = " Insert VLAN tag into mbuf."]
+    #[doc = " Linearize data in mbuf."]
     #[doc = ""]
-    #[doc = " Software version of VLAN unstripping"]
+    #[doc = " This function moves the mbuf data in the first segment if there is enough"]
+    #[doc = " tailroom. The subsequent segments are unchained and freed."]
     #[doc = ""]
-    #[doc = " @param m"]
-    #[doc = "   The packet mbuf."]
+    #[doc = " @param mbuf"]
+    #[doc = "   mbuf to linearize"]
     #[doc = " @return"]
-    #[doc = "   - 0: On success"]
-    #[doc = "   -EPERM: mbuf is is shared overwriting would be unsafe"]
-    #[doc = "   -ENOSPC: not enough headroom in mbuf"]
-    pub fn _rte_vlan_insert(m: *mut *mut rte_mbuf) -> ::std::os::raw::c_int;
-}
-pub type __builtin_va_list = [__va_list_tag; 1usize];
-#[repr(C)]
-#[derive(Debug, Copy, Clone, PartialEq)]
-pub struct __va_list_tag {
-    pub gp_offset: ::std::os::raw::c_uint,
-    pub fp_offset: ::std::os::raw::c_uint,
-    pub overflow_arg_area: *mut ::std::os::raw::c_void,
-    pub reg_save_area: *mut ::std::os::raw::c_void,
+    #[doc = "   - 0, on success"]
+    #[doc = "   - -1, on error"]
+    pub fn _rte_pktmbuf_linearize(mbuf: *mut rte_mbuf) -> ::std::os::raw::c_int;
 }
-#[test]
-fn bindgen_test_layout___va_list_tag() {
-    assert_eq!(
-        ::std::mem::size_of::<__va_list_tag>(),
-        24usize,
-        concat!("Size of: ", stringify!(__va_list_tag))
-    );
-    assert_eq!(
-        ::std::mem::align_of::<__va_list_tag>(),
-        8usize,
-        concat!("Alignment of ", stringify!(__va_list_tag))
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<__va_list_tag>())).gp_offset as *const _ as usize },
-        0usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(__va_list_tag),
-            "::",
-            stringify!(gp_offset)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<__va_list_tag>())).fp_offset as *const _ as usize },
-        4usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(__va_list_tag),
+extern "C" {
+    #[doc = " Retrieve a burst of input packets from a receive queue of an Ethernet"]
+    #[doc = " device. The retrieved packets are stored in *rte_mbuf* structures whose"]
+    #[doc = " pointers are supplied in the *rx_pkts* array."]
+    #[doc = ""]
+    #[doc = " The rte_eth_rx_burst() function loops, parsing the RX ring of the"]
+    #[doc = " receive queue, up to *nb_pkts* packets, and for each completed RX"]
+    #[doc = " descriptor in the ring, it performs the following operations:"]
+    #[doc = ""]
+    #[doc = " - Initialize the *rte_mbuf* data structure associated with the"]
+    #[doc = "   RX descriptor according to the information provided by the NIC into"]
+    #[doc = "   that RX descriptor."]
+    #[doc = ""]
+    #[doc = " - Store the *rte_mbuf* data structure into the next entry of the"]
+    #[doc = "   *rx_pkts* array."]
+    #[doc = ""]
+    #[doc = " - Replenish the RX descriptor with a new *rte_mbuf* buffer"]
+    #[doc = "   allocated from the memory pool associated with the receive queue at"]
+    #[doc = "   initialization time."]
+    #[doc = ""]
+    #[doc = " When retrieving an input packet that was scattered by the controller"]
+    #[doc = " into multiple receive descriptors, the rte_eth_rx_burst() function"]
+    #[doc = " appends the associated *rte_mbuf* buffers to the first buffer of the"]
+    #[doc = " packet."]
+    #[doc = ""]
+    #[doc = " The rte_eth_rx_burst() function returns the number of packets"]
+    #[doc = " actually retrieved, which is the number of *rte_mbuf* data structures"]
+    #[doc = " effectively supplied into the *rx_pkts* array."]
+    #[doc = " A return value equal to *nb_pkts* indicates that the RX queue contained"]
+    #[doc = " at least *rx_pkts* packets, and this is likely to signify that other"]
+    #[doc = " received packets remain in the input queue. Applications implementing"]
+    #[doc = " a \"retrieve as much received packets as possible\" policy can check this"]
+    #[doc = " specific case and keep invoking the rte_eth_rx_burst() function until"]
+    #[doc = " a value less than *nb_pkts* is returned."]
+    #[doc = ""]
+    #[doc = " This receive method has the following advantages:"]
+    #[doc = ""]
+    #[doc = " - It allows a run-to-completion network stack engine to retrieve and"]
+    #[doc = "   to immediately process received packets in a fast burst-oriented"]
+    #[doc = "   approach, avoiding the overhead of unnecessary intermediate packet"]
+    #[doc = "   queue/dequeue operations."]
+    #[doc = ""]
+    #[doc = " - Conversely, it also allows an asynchronous-oriented processing"]
+    #[doc = "   method to retrieve bursts of received packets and to immediately"]
+    #[doc = "   queue them for further parallel processing by another logical core,"]
+    #[doc = "   for instance. However, instead of having received packets being"]
+    #[doc = "   individually queued by the driver, this approach allows the caller"]
+    #[doc = "   of the rte_eth_rx_burst() function to queue a burst of retrieved"]
+    #[doc = "   packets at a time and therefore dramatically reduce the cost of"]
+    #[doc = "   enqueue/dequeue operations per packet."]
+    #[doc = ""]
+    #[doc = " - It allows the rte_eth_rx_burst() function of the driver to take"]
+    #[doc = "   advantage of burst-oriented hardware features (CPU cache,"]
+    #[doc = "   prefetch instructions, and so on) to minimize the number of CPU"]
+    #[doc = "   cycles per packet."]
+    #[doc = ""]
+    #[doc = " To summarize, the proposed receive API enables many"]
+    #[doc = " burst-oriented optimizations in both synchronous and asynchronous"]
+    #[doc = " packet processing environments with no overhead in both cases."]
+    #[doc = ""]
+    #[doc = " The rte_eth_rx_burst() function does not provide any error"]
+    #[doc = " notification to avoid the corresponding overhead. As a hint, the"]
+    #[doc = " upper-level application might check the status of the device link once"]
+    #[doc = " being systematically returned a 0 value for a given number of tries."]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "   The port identifier of the Ethernet device."]
+    #[doc = " @param queue_id"]
+    #[doc = "   The index of the receive queue from which to retrieve input packets."]
+    #[doc = "   The value must be in the range [0, nb_rx_queue - 1] previously supplied"]
+    #[doc = "   to rte_eth_dev_configure()."]
+    #[doc = " @param rx_pkts"]
+    #[doc = "   The address of an array of pointers to *rte_mbuf* structures that"]
+    #[doc = "   must be large enough to store *nb_pkts* pointers in it."]
+    #[doc = " @param nb_pkts"]
+    #[doc = "   The maximum number of packets to retrieve."]
+    #[doc = " @return"]
+    #[doc = "   The number of packets actually retrieved, which is the number"]
+    #[doc = "   of pointers to *rte_mbuf* structures effectively supplied to the"]
+    #[doc = "   *rx_pkts* array."]
+    pub fn _rte_eth_rx_burst(port_id: u16, queue_id: u16, rx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16;
+}
+extern "C" {
+    #[doc = " Get the number of used descriptors of a rx queue"]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "  The port identifier of the Ethernet device."]
+    #[doc = " @param queue_id"]
+    #[doc = "  The queue id on the specific port."]
+    #[doc = " @return"]
+    #[doc = "  The number of used descriptors in the specific queue, or:"]
+    #[doc = "     (-EINVAL) if *port_id* or *queue_id* is invalid"]
+    #[doc = "     (-ENOTSUP) if the device does not support this function"]
+    pub fn _rte_eth_rx_queue_count(port_id: u16, queue_id: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Check if the DD bit of the specific RX descriptor in the queue has been set"]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "  The port identifier of the Ethernet device."]
+    #[doc = " @param queue_id"]
+    #[doc = "  The queue id on the specific port."]
+    #[doc = " @param offset"]
+    #[doc = "  The offset of the descriptor ID from tail."]
+    #[doc = " @return"]
+    #[doc = "  - (1) if the specific DD bit is set."]
+    #[doc = "  - (0) if the specific DD bit is not set."]
+    #[doc = "  - (-ENODEV) if *port_id* invalid."]
+    #[doc = "  - (-ENOTSUP) if the device does not support this function"]
+    pub fn _rte_eth_rx_descriptor_done(port_id: u16, queue_id: u16, offset: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Check the status of a Rx descriptor in the queue"]
+    #[doc = ""]
+    #[doc = " It should be called in a similar context than the Rx function:"]
+    #[doc = " - on a dataplane core"]
+    #[doc = " - not concurrently on the same queue"]
+    #[doc = ""]
+    #[doc = " Since it's a dataplane function, no check is performed on port_id and"]
+    #[doc = " queue_id. The caller must therefore ensure that the port is enabled"]
+    #[doc = " and the queue is configured and running."]
+    #[doc = ""]
+    #[doc = " Note: accessing to a random descriptor in the ring may trigger cache"]
+    #[doc = " misses and have a performance impact."]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "  A valid port identifier of the Ethernet device which."]
+    #[doc = " @param queue_id"]
+    #[doc = "  A valid Rx queue identifier on this port."]
+    #[doc = " @param offset"]
+    #[doc = "  The offset of the descriptor starting from tail (0 is the next"]
+    #[doc = "  packet to be received by the driver)."]
+    #[doc = ""]
+    #[doc = " @return"]
+    #[doc = "  - (RTE_ETH_RX_DESC_AVAIL): Descriptor is available for the hardware to"]
+    #[doc = "    receive a packet."]
+    #[doc = "  - (RTE_ETH_RX_DESC_DONE): Descriptor is done, it is filled by hw, but"]
+    #[doc = "    not yet processed by the driver (i.e. in the receive queue)."]
+    #[doc = "  - (RTE_ETH_RX_DESC_UNAVAIL): Descriptor is unavailable, either hold by"]
+    #[doc = "    the driver and not yet returned to hw, or reserved by the hw."]
+    #[doc = "  - (-EINVAL) bad descriptor offset."]
+    #[doc = "  - (-ENOTSUP) if the device does not support this function."]
+    #[doc = "  - (-ENODEV) bad port or queue (only if compiled with debug)."]
+    pub fn _rte_eth_rx_descriptor_status(port_id: u16, queue_id: u16, offset: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Check the status of a Tx descriptor in the queue."]
+    #[doc = ""]
+    #[doc = " It should be called in a similar context than the Tx function:"]
+    #[doc = " - on a dataplane core"]
+    #[doc = " - not concurrently on the same queue"]
+    #[doc = ""]
+    #[doc = " Since it's a dataplane function, no check is performed on port_id and"]
+    #[doc = " queue_id. The caller must therefore ensure that the port is enabled"]
+    #[doc = " and the queue is configured and running."]
+    #[doc = ""]
+    #[doc = " Note: accessing to a random descriptor in the ring may trigger cache"]
+    #[doc = " misses and have a performance impact."]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "  A valid port identifier of the Ethernet device which."]
+    #[doc = " @param queue_id"]
+    #[doc = "  A valid Tx queue identifier on this port."]
+    #[doc = " @param offset"]
+    #[doc = "  The offset of the descriptor starting from tail (0 is the place where"]
+    #[doc = "  the next packet will be send)."]
+    #[doc = ""]
+    #[doc = " @return"]
+    #[doc = "  - (RTE_ETH_TX_DESC_FULL) Descriptor is being processed by the hw, i.e."]
+    #[doc = "    in the transmit queue."]
+    #[doc = "  - (RTE_ETH_TX_DESC_DONE) Hardware is done with this descriptor, it can"]
+    #[doc = "    be reused by the driver."]
+    #[doc = "  - (RTE_ETH_TX_DESC_UNAVAIL): Descriptor is unavailable, reserved by the"]
+    #[doc = "    driver or the hardware."]
+    #[doc = "  - (-EINVAL) bad descriptor offset."]
+    #[doc = "  - (-ENOTSUP) if the device does not support this function."]
+    #[doc = "  - (-ENODEV) bad port or queue (only if compiled with debug)."]
+    pub fn _rte_eth_tx_descriptor_status(port_id: u16, queue_id: u16, offset: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Send a burst of output packets on a transmit queue of an Ethernet device."]
+    #[doc = ""]
+    #[doc = " The rte_eth_tx_burst() function is invoked to transmit output packets"]
+    #[doc = " on the output queue *queue_id* of the Ethernet device designated by its"]
+    #[doc = " *port_id*."]
+    #[doc = " The *nb_pkts* parameter is the number of packets to send which are"]
+    #[doc = " supplied in the *tx_pkts* array of *rte_mbuf* structures, each of them"]
+    #[doc = " allocated from a pool created with rte_pktmbuf_pool_create()."]
+    #[doc = " The rte_eth_tx_burst() function loops, sending *nb_pkts* packets,"]
+    #[doc = " up to the number of transmit descriptors available in the TX ring of the"]
+    #[doc = " transmit queue."]
+    #[doc = " For each packet to send, the rte_eth_tx_burst() function performs"]
+    #[doc = " the following operations:"]
+    #[doc = ""]
+    #[doc = " - Pick up the next available descriptor in the transmit ring."]
+    #[doc = ""]
+    #[doc = " - Free the network buffer previously sent with that descriptor, if any."]
+    #[doc = ""]
+    #[doc = " - Initialize the transmit descriptor with the information provided"]
+    #[doc = "   in the *rte_mbuf data structure."]
+    #[doc = ""]
+    #[doc = " In the case of a segmented packet composed of a list of *rte_mbuf* buffers,"]
+    #[doc = " the rte_eth_tx_burst() function uses several transmit descriptors"]
+    #[doc = " of the ring."]
+    #[doc = ""]
+    #[doc = " The rte_eth_tx_burst() function returns the number of packets it"]
+    #[doc = " actually sent. A return value equal to *nb_pkts* means that all packets"]
+    #[doc = " have been sent, and this is likely to signify that other output packets"]
+    #[doc = " could be immediately transmitted again. Applications that implement a"]
+    #[doc = " \"send as many packets to transmit as possible\" policy can check this"]
+    #[doc = " specific case and keep invoking the rte_eth_tx_burst() function until"]
+    #[doc = " a value less than *nb_pkts* is returned."]
+    #[doc = ""]
+    #[doc = " It is the responsibility of the rte_eth_tx_burst() function to"]
+    #[doc = " transparently free the memory buffers of packets previously sent."]
+    #[doc = " This feature is driven by the *tx_free_thresh* value supplied to the"]
+    #[doc = " rte_eth_dev_configure() function at device configuration time."]
+    #[doc = " When the number of free TX descriptors drops below this threshold, the"]
+    #[doc = " rte_eth_tx_burst() function must [attempt to] free the *rte_mbuf*  buffers"]
+    #[doc = " of those packets whose transmission was effectively completed."]
+    #[doc = ""]
+    #[doc = " If the PMD is DEV_TX_OFFLOAD_MT_LOCKFREE capable, multiple threads can"]
+    #[doc = " invoke this function concurrently on the same tx queue without SW lock."]
+    #[doc = " @see rte_eth_dev_info_get, struct rte_eth_txconf::offloads"]
+    #[doc = ""]
+    #[doc = " @see rte_eth_tx_prepare to perform some prior checks or adjustments"]
+    #[doc = " for offloads."]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "   The port identifier of the Ethernet device."]
+    #[doc = " @param queue_id"]
+    #[doc = "   The index of the transmit queue through which output packets must be"]
+    #[doc = "   sent."]
+    #[doc = "   The value must be in the range [0, nb_tx_queue - 1] previously supplied"]
+    #[doc = "   to rte_eth_dev_configure()."]
+    #[doc = " @param tx_pkts"]
+    #[doc = "   The address of an array of *nb_pkts* pointers to *rte_mbuf* structures"]
+    #[doc = "   which contain the output packets."]
+    #[doc = " @param nb_pkts"]
+    #[doc = "   The maximum number of packets to transmit."]
+    #[doc = " @return"]
+    #[doc = "   The number of output packets actually stored in transmit descriptors of"]
+    #[doc = "   the transmit ring. The return value can be less than the value of the"]
+    #[doc = "   *tx_pkts* parameter when the transmit ring is full or has been filled up."]
+    pub fn _rte_eth_tx_burst(port_id: u16, queue_id: u16, tx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16;
+}
+extern "C" {
+    #[doc = " Process a burst of output packets on a transmit queue of an Ethernet device."]
+    #[doc = ""]
+    #[doc = " The rte_eth_tx_prepare() function is invoked to prepare output packets to be"]
+    #[doc = " transmitted on the output queue *queue_id* of the Ethernet device designated"]
+    #[doc = " by its *port_id*."]
+    #[doc = " The *nb_pkts* parameter is the number of packets to be prepared which are"]
+    #[doc = " supplied in the *tx_pkts* array of *rte_mbuf* structures, each of them"]
+    #[doc = " allocated from a pool created with rte_pktmbuf_pool_create()."]
+    #[doc = " For each packet to send, the rte_eth_tx_prepare() function performs"]
+    #[doc = " the following operations:"]
+    #[doc = ""]
+    #[doc = " - Check if packet meets devices requirements for tx offloads."]
+    #[doc = ""]
+    #[doc = " - Check limitations about number of segments."]
+    #[doc = ""]
+    #[doc = " - Check additional requirements when debug is enabled."]
+    #[doc = ""]
+    #[doc = " - Update and/or reset required checksums when tx offload is set for packet."]
+    #[doc = ""]
+    #[doc = " Since this function can modify packet data, provided mbufs must be safely"]
+    #[doc = " writable (e.g. modified data cannot be in shared segment)."]
+    #[doc = ""]
+    #[doc = " The rte_eth_tx_prepare() function returns the number of packets ready to be"]
+    #[doc = " sent. A return value equal to *nb_pkts* means that all packets are valid and"]
+    #[doc = " ready to be sent, otherwise stops processing on the first invalid packet and"]
+    #[doc = " leaves the rest packets untouched."]
+    #[doc = ""]
+    #[doc = " When this functionality is not implemented in the driver, all packets are"]
+    #[doc = " are returned untouched."]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "   The port identifier of the Ethernet device."]
+    #[doc = "   The value must be a valid port id."]
+    #[doc = " @param queue_id"]
+    #[doc = "   The index of the transmit queue through which output packets must be"]
+    #[doc = "   sent."]
+    #[doc = "   The value must be in the range [0, nb_tx_queue - 1] previously supplied"]
+    #[doc = "   to rte_eth_dev_configure()."]
+    #[doc = " @param tx_pkts"]
+    #[doc = "   The address of an array of *nb_pkts* pointers to *rte_mbuf* structures"]
+    #[doc = "   which contain the output packets."]
+    #[doc = " @param nb_pkts"]
+    #[doc = "   The maximum number of packets to process."]
+    #[doc = " @return"]
+    #[doc = "   The number of packets correct and ready to be sent. The return value can be"]
+    #[doc = "   less than the value of the *tx_pkts* parameter when some packet doesn't"]
+    #[doc = "   meet devices requirements with rte_errno set appropriately:"]
+    #[doc = "   - -EINVAL: offload flags are not correctly set"]
+    #[doc = "   - -ENOTSUP: the offload feature is not supported by the hardware"]
+    #[doc = ""]
+    pub fn _rte_eth_tx_prepare(port_id: u16, queue_id: u16, tx_pkts: *mut *mut rte_mbuf, nb_pkts: u16) -> u16;
+}
+extern "C" {
+    #[doc = " Send any packets queued up for transmission on a port and HW queue"]
+    #[doc = ""]
+    #[doc = " This causes an explicit flush of packets previously buffered via the"]
+    #[doc = " rte_eth_tx_buffer() function. It returns the number of packets successfully"]
+    #[doc = " sent to the NIC, and calls the error callback for any unsent packets. Unless"]
+    #[doc = " explicitly set up otherwise, the default callback simply frees the unsent"]
+    #[doc = " packets back to the owning mempool."]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "   The port identifier of the Ethernet device."]
+    #[doc = " @param queue_id"]
+    #[doc = "   The index of the transmit queue through which output packets must be"]
+    #[doc = "   sent."]
+    #[doc = "   The value must be in the range [0, nb_tx_queue - 1] previously supplied"]
+    #[doc = "   to rte_eth_dev_configure()."]
+    #[doc = " @param buffer"]
+    #[doc = "   Buffer of packets to be transmit."]
+    #[doc = " @return"]
+    #[doc = "   The number of packets successfully sent to the Ethernet device. The error"]
+    #[doc = "   callback is called for any packets which could not be sent."]
+    pub fn _rte_eth_tx_buffer_flush(port_id: u16, queue_id: u16, buffer: *mut rte_eth_dev_tx_buffer) -> u16;
+}
+extern "C" {
+    #[doc = " Buffer a single packet for future transmission on a port and queue"]
+    #[doc = ""]
+    #[doc = " This function takes a single mbuf/packet and buffers it for later"]
+    #[doc = " transmission on the particular port and queue specified. Once the buffer is"]
+    #[doc = " full of packets, an attempt will be made to transmit all the buffered"]
+    #[doc = " packets. In case of error, where not all packets can be transmitted, a"]
+    #[doc = " callback is called with the unsent packets as a parameter. If no callback"]
+    #[doc = " is explicitly set up, the unsent packets are just freed back to the owning"]
+    #[doc = " mempool. The function returns the number of packets actually sent i.e."]
+    #[doc = " 0 if no buffer flush occurred, otherwise the number of packets successfully"]
+    #[doc = " flushed"]
+    #[doc = ""]
+    #[doc = " @param port_id"]
+    #[doc = "   The port identifier of the Ethernet device."]
+    #[doc = " @param queue_id"]
+    #[doc = "   The index of the transmit queue through which output packets must be"]
+    #[doc = "   sent."]
+    #[doc = "   The value must be in the range [0, nb_tx_queue - 1] previously supplied"]
+    #[doc = "   to rte_eth_dev_configure()."]
+    #[doc = " @param buffer"]
+    #[doc = "   Buffer used to collect packets to be sent."]
+    #[doc = " @param tx_pkt"]
+    #[doc = "   Pointer to the packet mbuf to be sent."]
+    #[doc = " @return"]
+    #[doc = "   0 = packet has been buffered for later transmission"]
+    #[doc = "   N > 0 = packet has been buffered, and the buffer was subsequently flushed,"]
+    #[doc = "     causing N packets to be sent, and the error callback to be called for"]
+    #[doc = "     the rest."]
+    pub fn _rte_eth_tx_buffer(
+        port_id: u16,
+        queue_id: u16,
+        buffer: *mut rte_eth_dev_tx_buffer,
+        tx_pkt: *mut rte_mbuf,
+    ) -> u16;
+}
+extern "C" {
+    #[doc = " Extract VLAN tag information into mbuf"]
+    #[doc = ""]
+    #[doc = " Software version of VLAN stripping"]
+    #[doc = ""]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
+    #[doc = " @return"]
+    #[doc = "   - 0: Success"]
+    #[doc = "   - 1: not a vlan packet"]
+    pub fn _rte_vlan_strip(m: *mut rte_mbuf) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Insert VLAN tag into mbuf."]
+    #[doc = ""]
+    #[doc = " Software version of VLAN unstripping"]
+    #[doc = ""]
+    #[doc = " @param m"]
+    #[doc = "   The packet mbuf."]
+    #[doc = " @return"]
+    #[doc = "   - 0: On success"]
+    #[doc = "   -EPERM: mbuf is is shared overwriting would be unsafe"]
+    #[doc = "   -ENOSPC: not enough headroom in mbuf"]
+    pub fn _rte_vlan_insert(m: *mut *mut rte_mbuf) -> ::std::os::raw::c_int;
+}
+pub type __builtin_va_list = [__va_list_tag; 1usize];
+#[repr(C)]
+#[derive(Debug, Copy, Clone, PartialEq)]
+pub struct __va_list_tag {
+    pub gp_offset: ::std::os::raw::c_uint,
+    pub fp_offset: ::std::os::raw::c_uint,
+    pub overflow_arg_area: *mut ::std::os::raw::c_void,
+    pub reg_save_area: *mut ::std::os::raw::c_void,
+}
+#[test]
+fn bindgen_test_layout___va_list_tag() {
+    assert_eq!(
+        ::std::mem::size_of::<__va_list_tag>(),
+        24usize,
+        concat!("Size of: ", stringify!(__va_list_tag))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<__va_list_tag>(),
+        8usize,
+        concat!("Alignment of ", stringify!(__va_list_tag))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<__va_list_tag>())).gp_offset as *const _ as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(__va_list_tag),
+            "::",
+            stringify!(gp_offset)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<__va_list_tag>())).fp_offset as *const _ as usize },
+        4usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(__va_list_tag),
+            "::",
+            stringify!(fp_offset)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<__va_list_tag>())).overflow_arg_area as *const _ as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(__va_list_tag),
+            "::",
+            stringify!(overflow_arg_area)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<__va_list_tag>())).reg_save_area as *const _ as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(__va_list_tag),
+            "::",
+            stringify!(reg_save_area)
+        )
+    );
+}
+impl Default for __va_list_tag {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[doc = "< class handle."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_class {
+    pub _address: u8,
+}
+#[doc = " Signature of key that is stored internally."]
+pub type hash_sig_t = u32;
+#[doc = " Type of function that can be used for calculating the hash value."]
+pub type rte_hash_function = ::std::option::Option<
+    unsafe extern "C" fn(key: *const ::std::os::raw::c_void, key_len: u32, init_val: u32) -> u32,
+>;
+#[doc = " Type of function used to compare the hash key."]
+pub type rte_hash_cmp_eq_t = ::std::option::Option<
+    unsafe extern "C" fn(
+        key1: *const ::std::os::raw::c_void,
+        key2: *const ::std::os::raw::c_void,
+        key_len: usize,
+    ) -> ::std::os::raw::c_int,
+>;
+#[doc = " Parameters used when creating the hash table."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_hash_parameters {
+    #[doc = "< Name of the hash."]
+    pub name: *const ::std::os::raw::c_char,
+    #[doc = "< Total hash table entries."]
+    pub entries: u32,
+    #[doc = "< Unused field. Should be set to 0"]
+    pub reserved: u32,
+    #[doc = "< Length of hash key."]
+    pub key_len: u32,
+    #[doc = "< Primary Hash function used to calculate hash."]
+    pub hash_func: rte_hash_function,
+    #[doc = "< Init value used by hash_func."]
+    pub hash_func_init_val: u32,
+    #[doc = "< NUMA Socket ID for memory."]
+    pub socket_id: ::std::os::raw::c_int,
+    #[doc = "< Indicate if additional parameters are present."]
+    pub extra_flag: u8,
+}
+#[test]
+fn bindgen_test_layout_rte_hash_parameters() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_hash_parameters>(),
+        48usize,
+        concat!("Size of: ", stringify!(rte_hash_parameters))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_hash_parameters>(),
+        8usize,
+        concat!("Alignment of ", stringify!(rte_hash_parameters))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<rte_hash_parameters>())).hash_func as *const _ as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(rte_hash_parameters),
             "::",
-            stringify!(fp_offset)
+            stringify!(hash_func)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<rte_hash_parameters>())).extra_flag as *const _ as usize },
+        40usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(rte_hash_parameters),
+            "::",
+            stringify!(extra_flag)
         )
     );
+}
+impl Default for rte_hash_parameters {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[doc = " @internal A hash table structure."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_hash {
+    _unused: [u8; 0],
+}
+extern "C" {
+    #[doc = " Create a new hash table."]
+    pub fn rte_hash_create(params: *const rte_hash_parameters) -> *mut rte_hash;
+}
+extern "C" {
+    #[doc = " Find an existing hash table object and return a pointer to it."]
+    pub fn rte_hash_find_existing(name: *const ::std::os::raw::c_char) -> *mut rte_hash;
+}
+extern "C" {
+    #[doc = " De-allocate all memory used by hash table."]
+    pub fn rte_hash_free(h: *mut rte_hash);
+}
+extern "C" {
+    #[doc = " Reset all hash structure, by zeroing all entries"]
+    pub fn rte_hash_reset(h: *mut rte_hash);
+}
+extern "C" {
+    #[doc = " Return the number of keys in the hash table"]
+    pub fn rte_hash_count(h: *const rte_hash) -> i32;
+}
+extern "C" {
+    #[doc = " Add a key-value pair to an existing hash table."]
+    #[doc = " This operation is not multi-thread safe"]
+    #[doc = " and should only be called from one thread by default."]
+    #[doc = " Thread safety can be enabled by setting flag during"]
+    #[doc = " table creation."]
+    #[doc = " If the key exists already in the table, this API updates its value"]
+    #[doc = " with 'data' passed in this API."]
+    pub fn rte_hash_add_key_data(h: *const rte_hash, key: *const ::std::os::raw::c_void, data: *mut ::std::os::raw::c_void) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Add a key-value pair with a pre-computed hash value"]
+    #[doc = " to an existing hash table."]
+    pub fn rte_hash_add_key_with_hash_data(
+        h: *const rte_hash,
+        key: *const ::std::os::raw::c_void,
+        sig: hash_sig_t,
+        data: *mut ::std::os::raw::c_void,
+    ) -> i32;
+}
+extern "C" {
+    #[doc = " Add a key to an existing hash table. This operation is not multi-thread safe"]
+    #[doc = " and should only be called from one thread by default."]
+    pub fn rte_hash_add_key(h: *const rte_hash, key: *const ::std::os::raw::c_void) -> i32;
+}
+extern "C" {
+    #[doc = " Add a key to an existing hash table."]
+    #[doc = " This operation is not multi-thread safe"]
+    #[doc = " and should only be called from one thread by default."]
+    pub fn rte_hash_add_key_with_hash(h: *const rte_hash, key: *const ::std::os::raw::c_void, sig: hash_sig_t) -> i32;
+}
+extern "C" {
+    #[doc = " Remove a key from an existing hash table."]
+    #[doc = " This operation is not multi-thread safe"]
+    #[doc = " and should only be called from one thread by default."]
+    #[doc = " If RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL is enabled,"]
+    #[doc = " the key index returned by rte_hash_add_key_xxx APIs will not be"]
+    #[doc = " freed by this API. rte_hash_free_key_with_position API must be called"]
+    #[doc = " additionally to free the index associated with the key."]
+    pub fn rte_hash_del_key(h: *const rte_hash, key: *const ::std::os::raw::c_void) -> i32;
+}
+extern "C" {
+    #[doc = " Remove a key from an existing hash table."]
+    pub fn rte_hash_del_key_with_hash(h: *const rte_hash, key: *const ::std::os::raw::c_void, sig: hash_sig_t) -> i32;
+}
+extern "C" {
+    #[doc = " Find a key in the hash table given the position."]
+    pub fn rte_hash_get_key_with_position(
+        h: *const rte_hash,
+        position: i32,
+        key: *mut *mut ::std::os::raw::c_void,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Free a hash key in the hash table given the position"]
+    #[doc = " of the key. This operation is not multi-thread safe and should"]
+    #[doc = " only be called from one thread by default. Thread safety"]
+    #[doc = " can be enabled by setting flag during table creation."]
+    #[doc = " If RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL or"]
+    #[doc = " RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF is enabled,"]
+    #[doc = " the key index returned by rte_hash_del_key_xxx APIs must be freed"]
+    #[doc = " using this API. This API should be called after all the readers"]
+    #[doc = " have stopped referencing the entry corresponding to this key."]
+    pub fn rte_hash_free_key_with_position(h: *const rte_hash, position: i32) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Find a key-value pair in the hash table."]
+    #[doc = " This operation is multi-thread safe with regarding to other lookup threads."]
+    #[doc = " Read-write concurrency can be enabled by setting flag during"]
+    #[doc = " table creation."]
+    pub fn rte_hash_lookup_data(
+        h: *const rte_hash,
+        key: *const ::std::os::raw::c_void,
+        data: *mut *mut ::std::os::raw::c_void,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Find a key-value pair with a pre-computed hash value"]
+    #[doc = " to an existing hash table."]
+    pub fn rte_hash_lookup_with_hash_data(
+        h: *const rte_hash,
+        key: *const ::std::os::raw::c_void,
+        sig: hash_sig_t,
+        data: *mut *mut ::std::os::raw::c_void,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Find a key in the hash table."]
+    pub fn rte_hash_lookup(h: *const rte_hash, key: *const ::std::os::raw::c_void) -> i32;
+}
+extern "C" {
+    #[doc = " Find a key in the hash table."]
+    pub fn rte_hash_lookup_with_hash(h: *const rte_hash, key: *const ::std::os::raw::c_void, sig: hash_sig_t) -> i32;
+}
+extern "C" {
+    #[doc = " Calc a hash value by key."]
+    pub fn rte_hash_hash(h: *const rte_hash, key: *const ::std::os::raw::c_void) -> hash_sig_t;
+}
+extern "C" {
+    #[doc = " Find multiple keys in the hash table."]
+    #[doc = " This operation is multi-thread safe with regarding to other lookup threads."]
+    #[doc = " Read-write concurrency can be enabled by setting flag during"]
+    #[doc = " table creation."]
+    #[doc = " @return"]
+    #[doc = "   -EINVAL if there's an error, otherwise number of successful lookups."]
+    pub fn rte_hash_lookup_bulk_data(
+        h: *const rte_hash,
+        keys: *mut *const ::std::os::raw::c_void,
+        num_keys: u32,
+        hit_mask: *mut u64,
+        data: *mut *mut ::std::os::raw::c_void,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Find multiple keys in the hash table."]
+    pub fn rte_hash_lookup_bulk(
+        h: *const rte_hash,
+        keys: *mut *const ::std::os::raw::c_void,
+        num_keys: u32,
+        positions: *mut i32,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Iterate through the hash table, returning key-value pairs."]
+    #[doc = " @return"]
+    #[doc = "   Position where key was stored, if successful."]
+    #[doc = "   - -EINVAL if the parameters are invalid."]
+    #[doc = "   - -ENOENT if end of the hash table."]
+    pub fn rte_hash_iterate(
+        h: *const rte_hash,
+        key: *mut *const ::std::os::raw::c_void,
+        data: *mut *mut ::std::os::raw::c_void,
+        next: *mut u32,
+    ) -> i32;
+}
+extern "C" {
+    #[doc = " Calculate CRC32 hash on user-supplied byte array."]
+    pub fn _rte_hash_crc(data: *const ::std::os::raw::c_void, data_len: u32, init_val: u32) -> u32;
+}
+extern "C" {
+    #[doc = " The most generic version, hashes an arbitrary sequence"]
+    #[doc = " of bytes.  No alignment or length assumptions are made about"]
+    #[doc = " the input key."]
+    pub fn _rte_jhash(key: *const ::std::os::raw::c_void, length: u32, initval: u32) -> u32;
+}
+#[doc = " LPM configuration structure."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone)]
+pub struct rte_lpm_config {
+    #[doc = "< Max number of rules."]
+    pub max_rules: u32,
+    #[doc = "< Number of tbl8s to allocate."]
+    pub number_tbl8s: u32,
+    #[doc = "< This field is currently unused."]
+    pub flags: ::std::os::raw::c_int,
+}
+#[test]
+fn bindgen_test_layout_rte_lpm_config() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_lpm_config>(),
+        12usize,
+        concat!("Size of: ", stringify!(rte_lpm_config))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_lpm_config>(),
+        4usize,
+        concat!("Alignment of ", stringify!(rte_lpm_config))
+    );
+}
+#[doc = " @internal LPM structure."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_lpm {
+    _unused: [u8; 0],
+}
+extern "C" {
+    #[doc = " Create an LPM object."]
+    pub fn rte_lpm_create(
+        name: *const ::std::os::raw::c_char,
+        socket_id: ::std::os::raw::c_int,
+        config: *const rte_lpm_config,
+    ) -> *mut rte_lpm;
+}
+extern "C" {
+    #[doc = " Find an existing LPM object and return a pointer to it."]
+    pub fn rte_lpm_find_existing(name: *const ::std::os::raw::c_char) -> *mut rte_lpm;
+}
+extern "C" {
+    #[doc = " Free an LPM object."]
+    pub fn rte_lpm_free(lpm: *mut rte_lpm);
+}
+extern "C" {
+    #[doc = " Add a rule to the LPM table."]
+    pub fn rte_lpm_add(lpm: *mut rte_lpm, ip: u32, depth: u8, next_hop: u32) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Check if a rule is present in the LPM table,"]
+    #[doc = " and provide its next hop if it is."]
+    pub fn rte_lpm_is_rule_present(
+        lpm: *mut rte_lpm,
+        ip: u32,
+        depth: u8,
+        next_hop: *mut u32,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Delete a rule from the LPM table."]
+    pub fn rte_lpm_delete(lpm: *mut rte_lpm, ip: u32, depth: u8) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Delete all rules from the LPM table."]
+    pub fn rte_lpm_delete_all(lpm: *mut rte_lpm);
+}
+#[doc = " LPM6 configuration structure."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone)]
+pub struct rte_lpm6_config {
+    #[doc = "< Max number of rules."]
+    pub max_rules: u32,
+    #[doc = "< Number of tbl8s to allocate."]
+    pub number_tbl8s: u32,
+    #[doc = "< This field is currently unused."]
+    pub flags: ::std::os::raw::c_int,
+}
+#[test]
+fn bindgen_test_layout_rte_lpm6_config() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_lpm6_config>(),
+        12usize,
+        concat!("Size of: ", stringify!(rte_lpm6_config))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_lpm6_config>(),
+        4usize,
+        concat!("Alignment of ", stringify!(rte_lpm6_config))
+    );
+}
+#[doc = " @internal LPM6 structure."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_lpm6 {
+    _unused: [u8; 0],
+}
+extern "C" {
+    #[doc = " Create an LPM6 object."]
+    pub fn rte_lpm6_create(
+        name: *const ::std::os::raw::c_char,
+        socket_id: ::std::os::raw::c_int,
+        config: *const rte_lpm6_config,
+    ) -> *mut rte_lpm6;
+}
+extern "C" {
+    #[doc = " Find an existing LPM6 object and return a pointer to it."]
+    pub fn rte_lpm6_find_existing(name: *const ::std::os::raw::c_char) -> *mut rte_lpm6;
+}
+extern "C" {
+    #[doc = " Free an LPM6 object."]
+    pub fn rte_lpm6_free(lpm: *mut rte_lpm6);
+}
+extern "C" {
+    #[doc = " Add a rule to the LPM6 table."]
+    pub fn rte_lpm6_add(
+        lpm: *mut rte_lpm6,
+        ip: *mut u8,
+        depth: u8,
+        next_hop: u32,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Check if a rule is present in the LPM6 table,"]
+    #[doc = " and provide its next hop if it is."]
+    pub fn rte_lpm6_is_rule_present(
+        lpm: *mut rte_lpm6,
+        ip: *mut u8,
+        depth: u8,
+        next_hop: *mut u32,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Delete a rule from the LPM6 table."]
+    pub fn rte_lpm6_delete(lpm: *mut rte_lpm6, ip: *mut u8, depth: u8) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Delete a rule from the LPM6 table."]
+    pub fn rte_lpm6_delete_bulk_func(
+        lpm: *mut rte_lpm6,
+        ips: *mut [u8; 16usize],
+        depths: *mut u8,
+        n: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Delete all rules from the LPM6 table."]
+    pub fn rte_lpm6_delete_all(lpm: *mut rte_lpm6);
+}
+extern "C" {
+    #[doc = " Lookup an IP into the LPM6 table."]
+    pub fn rte_lpm6_lookup(
+        lpm: *const rte_lpm6,
+        ip: *mut u8,
+        next_hop: *mut u32,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Lookup multiple IP addresses in an LPM6 table."]
+    pub fn rte_lpm6_lookup_bulk_func(
+        lpm: *const rte_lpm6,
+        ips: *mut [u8; 16usize],
+        next_hops: *mut i32,
+        n: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Lookup an IP into the LPM table."]
+    pub fn _rte_lpm_lookup(lpm: *mut rte_lpm, ip: u32, next_hop: *mut u32) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Lookup multiple IP addresses in an LPM table."]
+    pub fn _rte_lpm_lookup_bulk(
+        lpm: *const rte_lpm,
+        ips: *const u32,
+        next_hops: *mut u32,
+        n: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Lookup four IP addresses in an LPM table."]
+    pub fn _rte_lpm_lookupx4(lpm: *const rte_lpm, ips: *const u32, hop: *mut u32, defv: u32);
+}
+#[doc = " Structure containing header lengths associated to a packet, filled"]
+#[doc = " by rte_net_get_ptype()."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_net_hdr_lens {
+    pub l2_len: u8,
+    pub l3_len: u8,
+    pub l4_len: u8,
+    pub tunnel_len: u8,
+    pub inner_l2_len: u8,
+    pub inner_l3_len: u8,
+    pub inner_l4_len: u8,
+}
+#[test]
+fn bindgen_test_layout_rte_net_hdr_lens() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_net_hdr_lens>(),
+        7usize,
+        concat!("Size of: ", stringify!(rte_net_hdr_lens))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_net_hdr_lens>(),
+        1usize,
+        concat!("Alignment of ", stringify!(rte_net_hdr_lens))
+    );
+}
+extern "C" {
+    #[doc = " Parse an Ethernet packet to get its packet type."]
+    pub fn rte_net_get_ptype(m: *const rte_mbuf, hdr_lens: *mut rte_net_hdr_lens, layers: u32) -> u32;
+}
+#[doc = " A structure which is used to create GRO context objects or tell"]
+#[doc = " rte_gro_reassemble_burst() what reassembly rules are demanded."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_gro_param {
+    #[doc = "< desired GRO types"]
+    pub gro_types: u64,
+    #[doc = "< max flow number"]
+    pub max_flow_num: u16,
+    #[doc = "< max packet number per flow"]
+    pub max_item_per_flow: u16,
+    #[doc = "< socket index for allocating GRO related data structures,"]
+    #[doc = " like reassembly tables. When use rte_gro_reassemble_burst(),"]
+    #[doc = " applications don't need to set this value."]
+    pub socket_id: u16,
+}
+#[test]
+fn bindgen_test_layout_rte_gro_param() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_gro_param>(),
+        16usize,
+        concat!("Size of: ", stringify!(rte_gro_param))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_gro_param>(),
+        8usize,
+        concat!("Alignment of ", stringify!(rte_gro_param))
+    );
+}
+extern "C" {
+    #[doc = " Create a GRO context object, which is used to merge packets in"]
+    #[doc = " rte_gro_reassemble()."]
+    pub fn rte_gro_ctx_create(param: *const rte_gro_param) -> *mut ::std::os::raw::c_void;
+}
+extern "C" {
+    #[doc = " Destroy a GRO context object."]
+    pub fn rte_gro_ctx_destroy(ctx: *mut ::std::os::raw::c_void);
+}
+extern "C" {
+    #[doc = " This is one of the main reassembly APIs, which merges numbers of"]
+    #[doc = " packets at a time. It doesn't check if input packets have correct"]
+    #[doc = " checksums and doesn't re-calculate checksums for merged packets."]
+    pub fn rte_gro_reassemble_burst(pkts: *mut *mut rte_mbuf, nb_pkts: u16, param: *const rte_gro_param) -> u16;
+}
+extern "C" {
+    #[doc = " Reassembly function, which tries to merge input packets with the"]
+    #[doc = " existed packets in the reassembly tables of a given GRO context."]
+    pub fn rte_gro_reassemble(pkts: *mut *mut rte_mbuf, nb_pkts: u16, ctx: *mut ::std::os::raw::c_void) -> u16;
+}
+extern "C" {
+    #[doc = " This function flushes the timeout packets from the reassembly tables"]
+    #[doc = " of desired GRO types."]
+    pub fn rte_gro_timeout_flush(
+        ctx: *mut ::std::os::raw::c_void,
+        timeout_cycles: u64,
+        gro_types: u64,
+        out: *mut *mut rte_mbuf,
+        max_nb_out: u16,
+    ) -> u16;
+}
+extern "C" {
+    #[doc = " This function returns the number of packets in all reassembly tables"]
+    #[doc = " of a given GRO context."]
+    pub fn rte_gro_get_pkt_count(ctx: *mut ::std::os::raw::c_void) -> u64;
+}
+#[doc = " GSO context structure."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_gso_ctx {
+    #[doc = "< MBUF pool for allocating direct buffers, which are used"]
+    #[doc = " to store packet headers for GSO segments."]
+    pub direct_pool: *mut rte_mempool,
+    #[doc = "< MBUF pool for allocating indirect buffers, which are used"]
+    #[doc = " to locate packet payloads for GSO segments."]
+    pub indirect_pool: *mut rte_mempool,
+    #[doc = "< the bit mask of required GSO types."]
+    pub gso_types: u64,
+    #[doc = "< maximum size of an output GSO segment, including packet"]
+    #[doc = " header and payload, measured in bytes."]
+    pub gso_size: u16,
+    #[doc = "< flag that indicates the final status of the IPv4 ID for"]
+    #[doc = " output GSO segments."]
+    pub flag: u8,
+}
+#[test]
+fn bindgen_test_layout_rte_gso_ctx() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_gso_ctx>(),
+        32usize,
+        concat!("Size of: ", stringify!(rte_gso_ctx))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_gso_ctx>(),
+        8usize,
+        concat!("Alignment of ", stringify!(rte_gso_ctx))
+    );
+}
+impl Default for rte_gso_ctx {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+extern "C" {
+    #[doc = " Segmentation function, which supports processing of both single- and"]
+    #[doc = " multi- MBUF packets."]
+    pub fn rte_gso_segment(
+        pkt: *mut rte_mbuf,
+        ctx: *const rte_gso_ctx,
+        pkts_out: *mut *mut rte_mbuf,
+        nb_pkts_out: u16,
+    ) -> ::std::os::raw::c_int;
+}
+#[doc = " IPv6 fragment extension header"]
+#[repr(C, packed)]
+#[derive(Debug, Default, Copy, Clone)]
+pub struct ipv6_extension_fragment {
+    #[doc = "< Next header type"]
+    pub next_header: u8,
+    #[doc = "< Reserved"]
+    pub reserved: u8,
+    #[doc = "< All fragmentation data"]
+    pub frag_data: u16,
+    #[doc = "< Packet ID"]
+    pub id: u32,
+}
+#[test]
+fn bindgen_test_layout_ipv6_extension_fragment() {
+    assert_eq!(
+        ::std::mem::size_of::<ipv6_extension_fragment>(),
+        8usize,
+        concat!("Size of: ", stringify!(ipv6_extension_fragment))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<ipv6_extension_fragment>(),
+        1usize,
+        concat!("Alignment of ", stringify!(ipv6_extension_fragment))
+    );
+}
+#[doc = " fragmentation table"]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_ip_frag_tbl {
+    _unused: [u8; 0],
+}
+#[doc = " mbufs to be freed"]
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct rte_ip_frag_death_row {
+    #[doc = "< number of mbufs currently on death row"]
+    pub cnt: u32,
+    #[doc = "< mbufs to be freed"]
+    pub row: [*mut rte_mbuf; 160usize],
+}
+#[test]
+fn bindgen_test_layout_rte_ip_frag_death_row() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_ip_frag_death_row>(),
+        1288usize,
+        concat!("Size of: ", stringify!(rte_ip_frag_death_row))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_ip_frag_death_row>(),
+        8usize,
+        concat!("Alignment of ", stringify!(rte_ip_frag_death_row))
+    );
+}
+impl Default for rte_ip_frag_death_row {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+extern "C" {
+    #[doc = " Create a new IP fragmentation table."]
+    pub fn rte_ip_frag_table_create(
+        bucket_num: u32,
+        bucket_entries: u32,
+        max_entries: u32,
+        max_cycles: u64,
+        socket_id: ::std::os::raw::c_int,
+    ) -> *mut rte_ip_frag_tbl;
+}
+extern "C" {
+    #[doc = " Free allocated IP fragmentation table."]
+    pub fn rte_ip_frag_table_destroy(tbl: *mut rte_ip_frag_tbl);
+}
+extern "C" {
+    #[doc = " This function implements the fragmentation of IPv6 packets."]
+    pub fn rte_ipv6_fragment_packet(
+        pkt_in: *mut rte_mbuf,
+        pkts_out: *mut *mut rte_mbuf,
+        nb_pkts_out: u16,
+        mtu_size: u16,
+        pool_direct: *mut rte_mempool,
+        pool_indirect: *mut rte_mempool,
+    ) -> i32;
+}
+extern "C" {
+    #[doc = " This function implements reassembly of fragmented IPv6 packets."]
+    #[doc = " Incoming mbuf should have its l2_len/l3_len fields setup correctly."]
+    pub fn rte_ipv6_frag_reassemble_packet(
+        tbl: *mut rte_ip_frag_tbl,
+        dr: *mut rte_ip_frag_death_row,
+        mb: *mut rte_mbuf,
+        tms: u64,
+        ip_hdr: *mut ipv6_hdr,
+        frag_hdr: *mut ipv6_extension_fragment,
+    ) -> *mut rte_mbuf;
+}
+extern "C" {
+    #[doc = " IPv4 fragmentation."]
+    pub fn rte_ipv4_fragment_packet(
+        pkt_in: *mut rte_mbuf,
+        pkts_out: *mut *mut rte_mbuf,
+        nb_pkts_out: u16,
+        mtu_size: u16,
+        pool_direct: *mut rte_mempool,
+        pool_indirect: *mut rte_mempool,
+    ) -> i32;
+}
+extern "C" {
+    #[doc = " This function implements reassembly of fragmented IPv4 packets."]
+    #[doc = " Incoming mbufs should have its l2_len/l3_len fields setup correctly."]
+    pub fn rte_ipv4_frag_reassemble_packet(
+        tbl: *mut rte_ip_frag_tbl,
+        dr: *mut rte_ip_frag_death_row,
+        mb: *mut rte_mbuf,
+        tms: u64,
+        ip_hdr: *mut ipv4_hdr,
+    ) -> *mut rte_mbuf;
+}
+extern "C" {
+    #[doc = " Free mbufs on a given death row."]
+    pub fn rte_ip_frag_free_death_row(dr: *mut rte_ip_frag_death_row, prefetch: u32);
+}
+extern "C" {
+    #[doc = " Dump fragmentation table statistics to file."]
+    pub fn rte_ip_frag_table_statistics_dump(f: *mut FILE, tbl: *const rte_ip_frag_tbl);
+}
+extern "C" {
+    #[doc = " Delete expired fragments"]
+    pub fn rte_frag_table_del_expired_entries(
+        tbl: *mut rte_ip_frag_tbl,
+        dr: *mut rte_ip_frag_death_row,
+        tms: u64,
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_distributor {
+    _unused: [u8; 0],
+}
+extern "C" {
+    #[doc = " Function to create a new distributor instance"]
+    #[doc = ""]
+    #[doc = " Reserves the memory needed for the distributor operation and"]
+    #[doc = " initializes the distributor to work with the configured number of workers."]
+    pub fn rte_distributor_create(
+        name: *const ::std::os::raw::c_char,
+        socket_id: ::std::os::raw::c_uint,
+        num_workers: ::std::os::raw::c_uint,
+        alg_type: ::std::os::raw::c_uint,
+    ) -> *mut rte_distributor;
+}
+extern "C" {
+    #[doc = " Process a set of packets by distributing them among workers that request"]
+    #[doc = " packets. The distributor will ensure that no two packets that have the"]
+    #[doc = " same flow id, or tag, in the mbuf will be processed on different cores at"]
+    #[doc = " the same time."]
+    pub fn rte_distributor_process(
+        d: *mut rte_distributor,
+        mbufs: *mut *mut rte_mbuf,
+        num_mbufs: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Get a set of mbufs that have been returned to the distributor by workers"]
+    pub fn rte_distributor_returned_pkts(
+        d: *mut rte_distributor,
+        mbufs: *mut *mut rte_mbuf,
+        max_mbufs: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Flush the distributor component, so that there are no in-flight or"]
+    #[doc = " backlogged packets awaiting processing"]
+    pub fn rte_distributor_flush(d: *mut rte_distributor) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Clears the array of returned packets used as the source for the"]
+    #[doc = " rte_distributor_returned_pkts() API call."]
+    pub fn rte_distributor_clear_returns(d: *mut rte_distributor);
+}
+extern "C" {
+    #[doc = " API called by a worker to get new packets to process. Any previous packets"]
+    #[doc = " given to the worker is assumed to have completed processing, and may be"]
+    #[doc = " optionally returned to the distributor via the oldpkt parameter."]
+    pub fn rte_distributor_get_pkt(
+        d: *mut rte_distributor,
+        worker_id: ::std::os::raw::c_uint,
+        pkts: *mut *mut rte_mbuf,
+        oldpkt: *mut *mut rte_mbuf,
+        retcount: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " API called by a worker to return a completed packet without requesting a"]
+    #[doc = " new packet, for example, because a worker thread is shutting down"]
+    pub fn rte_distributor_return_pkt(
+        d: *mut rte_distributor,
+        worker_id: ::std::os::raw::c_uint,
+        oldpkt: *mut *mut rte_mbuf,
+        num: ::std::os::raw::c_int,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " API called by a worker to request a new packet to process."]
+    #[doc = " Any previous packets given to the worker are assumed to have completed"]
+    #[doc = " processing, and may be optionally returned to the distributor via"]
+    #[doc = " the oldpkt parameter."]
+    pub fn rte_distributor_request_pkt(
+        d: *mut rte_distributor,
+        worker_id: ::std::os::raw::c_uint,
+        oldpkt: *mut *mut rte_mbuf,
+        count: ::std::os::raw::c_uint,
+    );
+}
+extern "C" {
+    #[doc = " API called by a worker to check for new packets that were previously"]
+    #[doc = " requested by a call to rte_distributor_request_pkt(). It does not wait"]
+    #[doc = " for the new packet to be available, but returns if there is no packet."]
+    pub fn rte_distributor_poll_pkt(
+        d: *mut rte_distributor,
+        worker_id: ::std::os::raw::c_uint,
+        mbufs: *mut *mut rte_mbuf,
+    ) -> ::std::os::raw::c_int;
+}
+#[doc = " Metric name."]
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct rte_metric_name {
+    #[doc = " String describing metric"]
+    pub name: [::std::os::raw::c_char; 64usize],
+}
+#[test]
+fn bindgen_test_layout_rte_metric_name() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_metric_name>(),
+        64usize,
+        concat!("Size of: ", stringify!(rte_metric_name))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_metric_name>(),
+        1usize,
+        concat!("Alignment of ", stringify!(rte_metric_name))
+    );
+}
+impl Default for rte_metric_name {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[doc = " Metric value structure."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_metric_value {
+    #[doc = " Numeric identifier of metric."]
+    pub key: u16,
+    #[doc = " Value for metric"]
+    pub value: u64,
+}
+#[test]
+fn bindgen_test_layout_rte_metric_value() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_metric_value>(),
+        16usize,
+        concat!("Size of: ", stringify!(rte_metric_value))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_metric_value>(),
+        8usize,
+        concat!("Alignment of ", stringify!(rte_metric_value))
+    );
+}
+extern "C" {
+    #[doc = " Initializes metric module. This function must be called from"]
+    #[doc = " a primary process before metrics are used."]
+    pub fn rte_metrics_init(socket_id: ::std::os::raw::c_int);
+}
+extern "C" {
+    #[doc = " Get metric name-key lookup table."]
+    pub fn rte_metrics_get_names(names: *mut rte_metric_name, capacity: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Get metric value table."]
+    pub fn rte_metrics_get_values(
+        port_id: ::std::os::raw::c_int,
+        values: *mut rte_metric_value,
+        capacity: u16,
+    ) -> ::std::os::raw::c_int;
+}
+#[doc = " Note: This function pointer is for future flow based latency stats"]
+#[doc = " implementation."]
+pub type rte_latency_stats_flow_type_fn = ::std::option::Option<
+    unsafe extern "C" fn(pkt: *mut rte_mbuf, user_cb: *mut ::std::os::raw::c_void) -> u16,
+>;
+extern "C" {
+    #[doc = "  Registers Rx/Tx callbacks for each active port, queue."]
+    pub fn rte_latencystats_init(samp_intvl: u64, user_cb: rte_latency_stats_flow_type_fn) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Calculates the latency and jitter values internally, exposing the updated"]
+    #[doc = " values via *rte_metrics* or the rte_latencystats_get() API."]
+    pub fn rte_latencystats_update() -> i32;
+}
+extern "C" {
+    #[doc = " Removes registered Rx/Tx callbacks for each active port, queue."]
+    pub fn rte_latencystats_uninit() -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieve names of latency statistics"]
+    pub fn rte_latencystats_get_names(names: *mut rte_metric_name, size: u16) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieve latency statistics."]
+    pub fn rte_latencystats_get(values: *mut rte_metric_value, size: u16) -> ::std::os::raw::c_int;
+}
+#[doc = "  Bitrate statistics data structure."]
+#[doc = "  This data structure is intentionally opaque."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_stats_bitrates {
+    _unused: [u8; 0],
+}
+extern "C" {
+    #[doc = " Allocate a bitrate statistics structure"]
+    pub fn rte_stats_bitrate_create() -> *mut rte_stats_bitrates;
+}
+extern "C" {
+    #[doc = " Register bitrate statistics with the metric library."]
+    pub fn rte_stats_bitrate_reg(bitrate_data: *mut rte_stats_bitrates) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Calculate statistics for current time window. The period with which"]
+    #[doc = " this function is called should be the intended sampling window width."]
+    pub fn rte_stats_bitrate_calc(bitrate_data: *mut rte_stats_bitrates, port_id: u16) -> ::std::os::raw::c_int;
+}
+#[doc = " Flow rule attributes."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_attr {
+    #[doc = "< Priority group."]
+    pub group: u32,
+    #[doc = "< Rule priority level within group."]
+    pub priority: u32,
+    pub _bitfield_1: __BindgenBitfieldUnit<[u8; 4usize], u32>,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_attr() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_attr>(),
+        12usize,
+        concat!("Size of: ", stringify!(rte_flow_attr))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_flow_attr>(),
+        4usize,
+        concat!("Alignment of ", stringify!(rte_flow_attr))
+    );
+}
+impl rte_flow_attr {
+    #[inline]
+    pub fn ingress(&self) -> u32 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(0usize, 1u8) as u32) }
+    }
+    #[inline]
+    pub fn set_ingress(&mut self, val: u32) {
+        unsafe {
+            let val: u32 = ::std::mem::transmute(val);
+            self._bitfield_1.set(0usize, 1u8, val as u64)
+        }
+    }
+    #[inline]
+    pub fn egress(&self) -> u32 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(1usize, 1u8) as u32) }
+    }
+    #[inline]
+    pub fn set_egress(&mut self, val: u32) {
+        unsafe {
+            let val: u32 = ::std::mem::transmute(val);
+            self._bitfield_1.set(1usize, 1u8, val as u64)
+        }
+    }
+    #[inline]
+    pub fn transfer(&self) -> u32 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(2usize, 1u8) as u32) }
+    }
+    #[inline]
+    pub fn set_transfer(&mut self, val: u32) {
+        unsafe {
+            let val: u32 = ::std::mem::transmute(val);
+            self._bitfield_1.set(2usize, 1u8, val as u64)
+        }
+    }
+}
+pub mod rte_flow_item_type {
+    #[doc = " Matching pattern item types."]
+    pub type Type = u32;
+    #[doc = " [META]"]
+    #[doc = ""]
+    #[doc = " End marker for item lists. Prevents further processing of items,"]
+    #[doc = " thereby ending the pattern."]
+    pub const RTE_FLOW_ITEM_TYPE_END: Type = 0;
+    #[doc = " [META]"]
+    #[doc = ""]
+    #[doc = " Used as a placeholder for convenience. It is ignored and simply"]
+    #[doc = " discarded by PMDs."]
+    pub const RTE_FLOW_ITEM_TYPE_VOID: Type = 1;
+    pub const RTE_FLOW_ITEM_TYPE_INVERT: Type = 2;
+    pub const RTE_FLOW_ITEM_TYPE_ANY: Type = 3;
+    pub const RTE_FLOW_ITEM_TYPE_PF: Type = 4;
+    pub const RTE_FLOW_ITEM_TYPE_VF: Type = 5;
+    pub const RTE_FLOW_ITEM_TYPE_PHY_PORT: Type = 6;
+    pub const RTE_FLOW_ITEM_TYPE_PORT_ID: Type = 7;
+    pub const RTE_FLOW_ITEM_TYPE_RAW: Type = 8;
+    #[doc = " Matches an Ethernet header."]
+    pub const RTE_FLOW_ITEM_TYPE_ETH: Type = 9;
+    #[doc = " Matches an 802.1Q/ad VLAN tag."]
+    pub const RTE_FLOW_ITEM_TYPE_VLAN: Type = 10;
+    #[doc = " Matches an IPv4 header."]
+    pub const RTE_FLOW_ITEM_TYPE_IPV4: Type = 11;
+    #[doc = " Matches an IPv6 header."]
+    pub const RTE_FLOW_ITEM_TYPE_IPV6: Type = 12;
+    pub const RTE_FLOW_ITEM_TYPE_ICMP: Type = 13;
+    #[doc = " Matches a UDP header."]
+    pub const RTE_FLOW_ITEM_TYPE_UDP: Type = 14;
+    #[doc = " Matches a TCP header."]
+    pub const RTE_FLOW_ITEM_TYPE_TCP: Type = 15;
+    pub const RTE_FLOW_ITEM_TYPE_SCTP: Type = 16;
+    pub const RTE_FLOW_ITEM_TYPE_VXLAN: Type = 17;
+}
+#[doc = " Matching pattern item definition."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_flow_item {
+    #[doc = "< Item type."]
+    pub type_: rte_flow_item_type::Type,
+    #[doc = "< Pointer to item specification structure."]
+    pub spec: *const ::std::os::raw::c_void,
+    #[doc = "< Defines an inclusive range (spec to last)."]
+    pub last: *const ::std::os::raw::c_void,
+    #[doc = "< Bit-mask applied to spec and last."]
+    pub mask: *const ::std::os::raw::c_void,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_item() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_item>(),
+        32usize,
+        concat!("Size of: ", stringify!(rte_flow_item))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_flow_item>(),
+        8usize,
+        concat!("Alignment of ", stringify!(rte_flow_item))
+    );
+}
+impl Default for rte_flow_item {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[doc = " RTE_FLOW_ITEM_TYPE_ETH"]
+#[doc = ""]
+#[doc = " Matches an Ethernet header."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_item_eth {
+    #[doc = "< Destination MAC."]
+    pub dst: ether_addr,
+    #[doc = "< Source MAC."]
+    pub src: ether_addr,
+    #[doc = "< EtherType or TPID."]
+    pub type_: u16,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_item_eth() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_item_eth>(),
+        14usize,
+        concat!("Size of: ", stringify!(rte_flow_item_eth))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_flow_item_eth>(),
+        2usize,
+        concat!("Alignment of ", stringify!(rte_flow_item_eth))
+    );
+}
+#[doc = " RTE_FLOW_ITEM_TYPE_VLAN"]
+#[doc = ""]
+#[doc = " Matches an 802.1Q/ad VLAN tag."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_item_vlan {
+    #[doc = "< Tag control information."]
+    pub tci: u16,
+    #[doc = "< Inner EtherType or TPID."]
+    pub inner_type: u16,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_item_vlan() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_item_vlan>(),
+        4usize,
+        concat!("Size of: ", stringify!(rte_flow_item_vlan))
+    );
+}
+#[doc = " RTE_FLOW_ITEM_TYPE_IPV4"]
+#[doc = ""]
+#[doc = " Matches an IPv4 header."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_item_ipv4 {
+    #[doc = "< IPv4 header definition."]
+    pub hdr: ipv4_hdr,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_item_ipv4() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_item_ipv4>(),
+        20usize,
+        concat!("Size of: ", stringify!(rte_flow_item_ipv4))
+    );
+}
+#[doc = " RTE_FLOW_ITEM_TYPE_IPV6."]
+#[doc = ""]
+#[doc = " Matches an IPv6 header."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_item_ipv6 {
+    #[doc = "< IPv6 header definition."]
+    pub hdr: ipv6_hdr,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_item_ipv6() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_item_ipv6>(),
+        40usize,
+        concat!("Size of: ", stringify!(rte_flow_item_ipv6))
+    );
+}
+#[doc = " RTE_FLOW_ITEM_TYPE_UDP."]
+#[doc = ""]
+#[doc = " Matches a UDP header."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_item_udp {
+    #[doc = "< UDP header definition."]
+    pub hdr: udp_hdr,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_item_udp() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_item_udp>(),
+        8usize,
+        concat!("Size of: ", stringify!(rte_flow_item_udp))
+    );
+}
+#[doc = " RTE_FLOW_ITEM_TYPE_TCP."]
+#[doc = ""]
+#[doc = " Matches a TCP header."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_item_tcp {
+    #[doc = "< TCP header definition."]
+    pub hdr: tcp_hdr,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_item_tcp() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_item_tcp>(),
+        20usize,
+        concat!("Size of: ", stringify!(rte_flow_item_tcp))
+    );
+}
+pub mod rte_flow_action_type {
+    #[doc = " Action types."]
+    pub type Type = u32;
+    #[doc = " End marker for action lists. Prevents further processing of"]
+    #[doc = " actions, thereby ending the list."]
+    pub const RTE_FLOW_ACTION_TYPE_END: Type = 0;
+    #[doc = " Used as a placeholder for convenience. It is ignored and simply"]
+    #[doc = " discarded by PMDs."]
+    pub const RTE_FLOW_ACTION_TYPE_VOID: Type = 1;
+    pub const RTE_FLOW_ACTION_TYPE_PASSTHRU: Type = 2;
+    pub const RTE_FLOW_ACTION_TYPE_JUMP: Type = 3;
+    #[doc = " Attaches an integer value to packets and sets PKT_RX_FDIR and"]
+    #[doc = " PKT_RX_FDIR_ID mbuf flags."]
+    pub const RTE_FLOW_ACTION_TYPE_MARK: Type = 4;
+    #[doc = " Flags packets. Similar to MARK without a specific value; only"]
+    #[doc = " sets the PKT_RX_FDIR mbuf flag."]
+    pub const RTE_FLOW_ACTION_TYPE_FLAG: Type = 5;
+    #[doc = " Assigns packets to a given queue index."]
+    pub const RTE_FLOW_ACTION_TYPE_QUEUE: Type = 6;
+    #[doc = " Drops packets."]
+    pub const RTE_FLOW_ACTION_TYPE_DROP: Type = 7;
+    #[doc = " Enables counters for this flow rule."]
+    pub const RTE_FLOW_ACTION_TYPE_COUNT: Type = 8;
+    #[doc = " Similar to QUEUE, except RSS is additionally performed on packets"]
+    #[doc = " to spread them among several queues according to the provided"]
+    #[doc = " parameters."]
+    pub const RTE_FLOW_ACTION_TYPE_RSS: Type = 9;
+}
+#[doc = " Definition of a single action."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_flow_action {
+    #[doc = "< Action type."]
+    pub type_: rte_flow_action_type::Type,
+    #[doc = "< Pointer to action configuration object."]
+    pub conf: *const ::std::os::raw::c_void,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_action() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_action>(),
+        16usize,
+        concat!("Size of: ", stringify!(rte_flow_action))
+    );
+}
+impl Default for rte_flow_action {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[doc = " RTE_FLOW_ACTION_TYPE_MARK"]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_action_mark {
+    #[doc = "< Integer value to return with packets."]
+    pub id: u32,
+}
+#[doc = " RTE_FLOW_ACTION_TYPE_QUEUE"]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_action_queue {
+    #[doc = "< Queue index to use."]
+    pub index: u16,
+}
+#[doc = " RTE_FLOW_ACTION_TYPE_COUNT"]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_action_count {
+    pub _bitfield_1: __BindgenBitfieldUnit<[u8; 4usize], u32>,
+    #[doc = "< Counter ID."]
+    pub id: u32,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_action_count() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_action_count>(),
+        8usize,
+        concat!("Size of: ", stringify!(rte_flow_action_count))
+    );
+}
+impl rte_flow_action_count {
+    #[inline]
+    pub fn shared(&self) -> u32 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(0usize, 1u8) as u32) }
+    }
+    #[inline]
+    pub fn set_shared(&mut self, val: u32) {
+        unsafe {
+            let val: u32 = ::std::mem::transmute(val);
+            self._bitfield_1.set(0usize, 1u8, val as u64)
+        }
+    }
+}
+#[doc = " RTE_FLOW_ACTION_TYPE_RSS"]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_flow_action_rss {
+    #[doc = "< RSS hash function to apply."]
+    pub func: rte_eth_hash_function::Type,
+    #[doc = " Packet encapsulation level RSS hash @p types apply to."]
+    pub level: u32,
+    #[doc = "< Specific RSS hash types (see ETH_RSS_*)."]
+    pub types: u64,
+    #[doc = "< Hash key length in bytes."]
+    pub key_len: u32,
+    #[doc = "< Number of entries in @p queue."]
+    pub queue_num: u32,
+    #[doc = "< Hash key."]
+    pub key: *const u8,
+    #[doc = "< Queue indices to use."]
+    pub queue: *const u16,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_action_rss() {
     assert_eq!(
-        unsafe { &(*(::std::ptr::null::<__va_list_tag>())).overflow_arg_area as *const _ as usize },
+        ::std::mem::size_of::<rte_flow_action_rss>(),
+        40usize,
+        concat!("Size of: ", stringify!(rte_flow_action_rss))
+    );
+}
+impl Default for rte_flow_action_rss {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[doc = " Opaque type returned after successfully creating a flow."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_flow {
+    _unused: [u8; 0],
+}
+#[doc = " RTE_FLOW_ACTION_TYPE_COUNT (query)"]
+#[doc = ""]
+#[doc = " Query structure to retrieve and reset flow rule counters."]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct rte_flow_query_count {
+    pub _bitfield_1: __BindgenBitfieldUnit<[u8; 4usize], u32>,
+    #[doc = "< Number of hits for this rule."]
+    pub hits: u64,
+    #[doc = "< Number of bytes through this rule."]
+    pub bytes: u64,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_query_count() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_query_count>(),
+        24usize,
+        concat!("Size of: ", stringify!(rte_flow_query_count))
+    );
+}
+impl rte_flow_query_count {
+    #[inline]
+    pub fn hits_set(&self) -> u32 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(0usize, 1u8) as u32) }
+    }
+    #[inline]
+    pub fn bytes_set(&self) -> u32 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(1usize, 1u8) as u32) }
+    }
+    #[inline]
+    pub fn reset(&self) -> u32 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(2usize, 1u8) as u32) }
+    }
+    #[inline]
+    pub fn set_reset(&mut self, val: u32) {
+        unsafe {
+            let val: u32 = ::std::mem::transmute(val);
+            self._bitfield_1.set(2usize, 1u8, val as u64)
+        }
+    }
+}
+pub mod rte_flow_error_type {
+    #[doc = " Verbose error types."]
+    pub type Type = u32;
+    #[doc = "< No error."]
+    pub const RTE_FLOW_ERROR_TYPE_NONE: Type = 0;
+    #[doc = "< Cause unspecified."]
+    pub const RTE_FLOW_ERROR_TYPE_UNSPECIFIED: Type = 1;
+    #[doc = "< Flow rule (handle)."]
+    pub const RTE_FLOW_ERROR_TYPE_HANDLE: Type = 2;
+    #[doc = "< Group field."]
+    pub const RTE_FLOW_ERROR_TYPE_ATTR_GROUP: Type = 3;
+    #[doc = "< Priority field."]
+    pub const RTE_FLOW_ERROR_TYPE_ATTR_PRIORITY: Type = 4;
+    #[doc = "< Ingress field."]
+    pub const RTE_FLOW_ERROR_TYPE_ATTR_INGRESS: Type = 5;
+    #[doc = "< Egress field."]
+    pub const RTE_FLOW_ERROR_TYPE_ATTR_EGRESS: Type = 6;
+    #[doc = "< Transfer field."]
+    pub const RTE_FLOW_ERROR_TYPE_ATTR_TRANSFER: Type = 7;
+    #[doc = "< Attributes structure."]
+    pub const RTE_FLOW_ERROR_TYPE_ATTR: Type = 8;
+    #[doc = "< Pattern length."]
+    pub const RTE_FLOW_ERROR_TYPE_ITEM_NUM: Type = 9;
+    #[doc = "< Item specification."]
+    pub const RTE_FLOW_ERROR_TYPE_ITEM_SPEC: Type = 10;
+    #[doc = "< Item specification range."]
+    pub const RTE_FLOW_ERROR_TYPE_ITEM_LAST: Type = 11;
+    #[doc = "< Item specification mask."]
+    pub const RTE_FLOW_ERROR_TYPE_ITEM_MASK: Type = 12;
+    #[doc = "< Specific pattern item."]
+    pub const RTE_FLOW_ERROR_TYPE_ITEM: Type = 13;
+    #[doc = "< Number of actions."]
+    pub const RTE_FLOW_ERROR_TYPE_ACTION_NUM: Type = 14;
+    #[doc = "< Action configuration."]
+    pub const RTE_FLOW_ERROR_TYPE_ACTION_CONF: Type = 15;
+    #[doc = "< Specific action."]
+    pub const RTE_FLOW_ERROR_TYPE_ACTION: Type = 16;
+}
+#[doc = " Verbose error structure definition."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_flow_error {
+    #[doc = "< Cause field and error types."]
+    pub type_: rte_flow_error_type::Type,
+    #[doc = "< Object responsible for the error."]
+    pub cause: *const ::std::os::raw::c_void,
+    #[doc = "< Human-readable error message."]
+    pub message: *const ::std::os::raw::c_char,
+}
+#[test]
+fn bindgen_test_layout_rte_flow_error() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_flow_error>(),
+        24usize,
+        concat!("Size of: ", stringify!(rte_flow_error))
+    );
+}
+impl Default for rte_flow_error {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+extern "C" {
+    #[doc = " Check whether a flow rule can be created on a given port."]
+    pub fn rte_flow_validate(
+        port_id: u16,
+        attr: *const rte_flow_attr,
+        pattern: *const rte_flow_item,
+        actions: *const rte_flow_action,
+        error: *mut rte_flow_error,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Create a flow rule on a given port."]
+    pub fn rte_flow_create(
+        port_id: u16,
+        attr: *const rte_flow_attr,
+        pattern: *const rte_flow_item,
+        actions: *const rte_flow_action,
+        error: *mut rte_flow_error,
+    ) -> *mut rte_flow;
+}
+extern "C" {
+    #[doc = " Destroy a flow rule on a given port."]
+    pub fn rte_flow_destroy(port_id: u16, flow: *mut rte_flow, error: *mut rte_flow_error) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Destroy all flow rules associated with a port."]
+    pub fn rte_flow_flush(port_id: u16, error: *mut rte_flow_error) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Query an existing flow rule."]
+    pub fn rte_flow_query(
+        port_id: u16,
+        flow: *mut rte_flow,
+        action: *const rte_flow_action,
+        data: *mut ::std::os::raw::c_void,
+        error: *mut rte_flow_error,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Restrict ingress traffic to the defined flow rules."]
+    pub fn rte_flow_isolate(
+        port_id: u16,
+        set: ::std::os::raw::c_int,
+        error: *mut rte_flow_error,
+    ) -> ::std::os::raw::c_int;
+}
+#[doc = " eBPF instruction format"]
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct ebpf_insn {
+    pub code: u8,
+    pub _bitfield_1: __BindgenBitfieldUnit<[u8; 1usize], u8>,
+    pub off: i16,
+    pub imm: i32,
+}
+#[test]
+fn bindgen_test_layout_ebpf_insn() {
+    assert_eq!(
+        ::std::mem::size_of::<ebpf_insn>(),
         8usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(__va_list_tag),
-            "::",
-            stringify!(overflow_arg_area)
-        )
+        concat!("Size of: ", stringify!(ebpf_insn))
     );
+}
+pub mod rte_bpf_arg_type {
+    #[doc = " Possible types for function/BPF program arguments."]
+    pub type Type = u32;
+    #[doc = "< undefined"]
+    pub const RTE_BPF_ARG_UNDEF: Type = 0;
+    #[doc = "< scalar value"]
+    pub const RTE_BPF_ARG_RAW: Type = 1;
+    #[doc = "< pointer to data buffer"]
+    pub const RTE_BPF_ARG_PTR: Type = 16;
+    #[doc = "< pointer to rte_mbuf"]
+    pub const RTE_BPF_ARG_PTR_MBUF: Type = 17;
+    pub const RTE_BPF_ARG_RESERVED: Type = 64;
+}
+#[doc = " function argument information"]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_bpf_arg {
+    pub type_: rte_bpf_arg_type::Type,
+    #[doc = " for ptr type - max size of data buffer it points to"]
+    #[doc = " for raw type - the size (in bytes) of the value"]
+    pub size: usize,
+    #[doc = "< for mbuf ptr type, max size of rte_mbuf data buffer"]
+    pub buf_size: usize,
+}
+#[test]
+fn bindgen_test_layout_rte_bpf_arg() {
     assert_eq!(
-        unsafe { &(*(::std::ptr::null::<__va_list_tag>())).reg_save_area as *const _ as usize },
-        16usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(__va_list_tag),
-            "::",
-            stringify!(reg_save_area)
-        )
+        ::std::mem::size_of::<rte_bpf_arg>(),
+        24usize,
+        concat!("Size of: ", stringify!(rte_bpf_arg))
     );
 }
-impl Default for __va_list_tag {
+impl Default for rte_bpf_arg {
     fn default() -> Self {
         unsafe { ::std::mem::zeroed() }
     }
 }
-#[doc = "< class handle."]
+#[doc = " definition for external symbols available in the BPF program."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_bpf_xsym {
+    _unused: [u8; 0],
+}
+#[doc = " Input parameters for loading eBPF code."]
 #[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_bpf_prm {
+    #[doc = "< array of eBPF instructions"]
+    pub ins: *const ebpf_insn,
+    #[doc = "< number of instructions in ins"]
+    pub nb_ins: u32,
+    #[doc = "< array of external symbols that eBPF code is allowed to reference"]
+    pub xsym: *const rte_bpf_xsym,
+    #[doc = "< number of elements in xsym"]
+    pub nb_xsym: u32,
+    #[doc = "< eBPF program input arg description"]
+    pub prog_arg: rte_bpf_arg,
+}
+#[test]
+fn bindgen_test_layout_rte_bpf_prm() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_bpf_prm>(),
+        56usize,
+        concat!("Size of: ", stringify!(rte_bpf_prm))
+    );
+}
+impl Default for rte_bpf_prm {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[doc = " Information about compiled into native ISA eBPF code."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_bpf_jit {
+    #[doc = "< JIT-ed native code"]
+    pub func: ::std::option::Option<unsafe extern "C" fn(arg1: *mut ::std::os::raw::c_void) -> u64>,
+    #[doc = "< size of JIT-ed code"]
+    pub sz: usize,
+}
+impl Default for rte_bpf_jit {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct rte_bpf {
+    _unused: [u8; 0],
+}
+extern "C" {
+    #[doc = " De-allocate all memory used by this eBPF execution context."]
+    pub fn rte_bpf_destroy(bpf: *mut rte_bpf);
+}
+extern "C" {
+    #[doc = " Create a new eBPF execution context and load given BPF code into it."]
+    pub fn rte_bpf_load(prm: *const rte_bpf_prm) -> *mut rte_bpf;
+}
+extern "C" {
+    #[doc = " Create a new eBPF execution context and load BPF code from given ELF"]
+    #[doc = " file into it."]
+    pub fn rte_bpf_elf_load(
+        prm: *const rte_bpf_prm,
+        fname: *const ::std::os::raw::c_char,
+        sname: *const ::std::os::raw::c_char,
+    ) -> *mut rte_bpf;
+}
+extern "C" {
+    #[doc = " Execute given BPF bytecode."]
+    pub fn rte_bpf_exec(bpf: *const rte_bpf, ctx: *mut ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[doc = " Execute given BPF bytecode over a set of input contexts."]
+    pub fn rte_bpf_exec_burst(
+        bpf: *const rte_bpf,
+        ctx: *mut *mut ::std::os::raw::c_void,
+        rc: *mut u64,
+        num: u32,
+    ) -> u32;
+}
+extern "C" {
+    #[doc = " Provide information about natively compiled code for given BPF handle."]
+    pub fn rte_bpf_get_jit(bpf: *const rte_bpf, jit: *mut rte_bpf_jit) -> ::std::os::raw::c_int;
+}
+pub type rte_job_update_period_cb_t =
+    ::std::option::Option<unsafe extern "C" fn(job: *mut rte_jobstats, job_value: i64)>;
+#[repr(C)]
+#[repr(align(64))]
+#[derive(Copy, Clone)]
+pub struct rte_jobstats {
+    #[doc = "< Estimated period of execution."]
+    pub period: u64,
+    #[doc = "< Minimum period."]
+    pub min_period: u64,
+    #[doc = "< Maximum period."]
+    pub max_period: u64,
+    #[doc = "< Desired value for this job."]
+    pub target: i64,
+    #[doc = "< Period update callback."]
+    pub update_period_cb: rte_job_update_period_cb_t,
+    #[doc = "< Job execution time."]
+    pub exec_time: u64,
+    #[doc = "< Minimum execution time."]
+    pub min_exec_time: u64,
+    #[doc = "< Maximum execution time."]
+    pub max_exec_time: u64,
+    #[doc = "< Execute count."]
+    pub exec_cnt: u64,
+    #[doc = "< Name of this job"]
+    pub name: [::std::os::raw::c_char; 32usize],
+    #[doc = "< Job stats context object that is executing this job."]
+    pub context: *mut rte_jobstats_context,
+}
+#[test]
+fn bindgen_test_layout_rte_jobstats() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_jobstats>(),
+        128usize,
+        concat!("Size of: ", stringify!(rte_jobstats))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_jobstats>(),
+        64usize,
+        concat!("Alignment of ", stringify!(rte_jobstats))
+    );
+}
+impl Default for rte_jobstats {
+    fn default() -> Self {
+        unsafe { ::std::mem::zeroed() }
+    }
+}
+#[repr(C)]
+#[repr(align(64))]
 #[derive(Debug, Default, Copy, Clone, PartialEq)]
-pub struct rte_class {
-    pub _address: u8,
+pub struct rte_jobstats_context {
+    #[doc = "< Current state time stamp."]
+    pub state_time: u64,
+    #[doc = "< Count of executed jobs in this loop."]
+    pub loop_executed_jobs: u64,
+    #[doc = "< Total time taken to execute jobs, not including management time."]
+    pub exec_time: u64,
+    #[doc = "< Minimum loop execute time."]
+    pub min_exec_time: u64,
+    #[doc = "< Maximum loop execute time."]
+    pub max_exec_time: u64,
+    #[doc = " Sum of time that is not the execute time (ex: from job finish to next"]
+    #[doc = " job start)."]
+    #[doc = ""]
+    #[doc = " This time might be considered as overhead of library + job scheduling."]
+    pub management_time: u64,
+    #[doc = "< Minimum management time"]
+    pub min_management_time: u64,
+    #[doc = "< Maximum management time"]
+    pub max_management_time: u64,
+    #[doc = "< Time stamp of the start of the loop."]
+    pub start_time: u64,
+    #[doc = "< Count of executed jobs."]
+    pub job_exec_cnt: u64,
+    #[doc = "< Total count of executed loops with at least one executed job."]
+    pub loop_cnt: u64,
+}
+#[test]
+fn bindgen_test_layout_rte_jobstats_context() {
+    assert_eq!(
+        ::std::mem::size_of::<rte_jobstats_context>(),
+        128usize,
+        concat!("Size of: ", stringify!(rte_jobstats_context))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<rte_jobstats_context>(),
+        64usize,
+        concat!("Alignment of ", stringify!(rte_jobstats_context))
+    );
+}
+extern "C" {
+    #[doc = " Initialize given context object with default values."]
+    pub fn rte_jobstats_context_init(ctx: *mut rte_jobstats_context) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Mark that new set of jobs start executing."]
+    pub fn rte_jobstats_context_start(ctx: *mut rte_jobstats_context);
+}
+extern "C" {
+    #[doc = " Mark that there is no more jobs ready to execute in this turn. Calculate"]
+    #[doc = " stats for this loop turn."]
+    pub fn rte_jobstats_context_finish(ctx: *mut rte_jobstats_context);
+}
+extern "C" {
+    #[doc = " Function resets job context statistics."]
+    pub fn rte_jobstats_context_reset(ctx: *mut rte_jobstats_context);
+}
+extern "C" {
+    #[doc = " Initialize given job stats object."]
+    pub fn rte_jobstats_init(
+        job: *mut rte_jobstats,
+        name: *const ::std::os::raw::c_char,
+        min_period: u64,
+        max_period: u64,
+        initial_period: u64,
+        target: i64,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Set job desired target value. Difference between target and job value"]
+    #[doc = " value must be used to properly adjust job execute period value."]
+    pub fn rte_jobstats_set_target(job: *mut rte_jobstats, target: i64);
+}
+extern "C" {
+    #[doc = " Mark that \\a job is starting of its execution in context \\a ctx Job"]
+    #[doc = " time statistics are updated by management time."]
+    pub fn rte_jobstats_start(ctx: *mut rte_jobstats_context, job: *mut rte_jobstats) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Mark that \\a job is aborted, the time since it was started is counted"]
+    #[doc = " as the management time of its context."]
+    pub fn rte_jobstats_abort(job: *mut rte_jobstats) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Mark that \\a job finished its execution. Context in which it was"]
+    #[doc = " executing will receive stat update. After this function call stats"]
+    #[doc = " are updated by execution time."]
+    pub fn rte_jobstats_finish(job: *mut rte_jobstats, job_value: i64) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Set execute period of a \\a job."]
+    pub fn rte_jobstats_set_period(job: *mut rte_jobstats, period: u64, saturate: u8);
+}
+extern "C" {
+    #[doc = " Function resets job statistics."]
+    pub fn rte_jobstats_reset(job: *mut rte_jobstats);
+}
+extern "C" {
+    #[doc = " Register external memory chunk with DPDK."]
+    #[doc = ""]
+    #[doc = " @note Using this API is mutually exclusive with ``rte_malloc`` family of"]
+    #[doc = "   API's."]
+    #[doc = ""]
+    #[doc = " @note This API will not perform any DMA mapping. It is expected that user"]
+    #[doc = "   will do that themselves."]
+    pub fn rte_extmem_register(
+        va_addr: *mut ::std::os::raw::c_void,
+        len: usize,
+        iova_addrs: *mut rte_iova_t,
+        n_pages: ::std::os::raw::c_uint,
+        page_sz: usize,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Unregister external memory chunk with DPDK."]
+    pub fn rte_extmem_unregister(va_addr: *mut ::std::os::raw::c_void, len: usize) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Attach to external memory chunk registered in another process."]
+    pub fn rte_extmem_attach(va_addr: *mut ::std::os::raw::c_void, len: usize) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Detach from external memory chunk registered in another process."]
+    pub fn rte_extmem_detach(va_addr: *mut ::std::os::raw::c_void, len: usize) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Check whether a VFIO-related kmod is enabled."]
+    pub fn rte_vfio_is_enabled(modname: *const ::std::os::raw::c_char) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Perform DMA mapping for devices in a container."]
+    pub fn rte_vfio_container_dma_map(
+        container_fd: ::std::os::raw::c_int,
+        vaddr: u64,
+        iova: u64,
+        len: u64,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Perform DMA unmapping for devices in a container."]
+    pub fn rte_vfio_container_dma_unmap(
+        container_fd: ::std::os::raw::c_int,
+        vaddr: u64,
+        iova: u64,
+        len: u64,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    pub fn _rte_memcpy_sse42(
+        dst: *mut ::std::os::raw::c_void,
+        src: *const ::std::os::raw::c_void,
+        n: usize,
+    ) -> *mut ::std::os::raw::c_void;
+}
+extern "C" {
+    pub fn _rte_memcpy_avx2(
+        dst: *mut ::std::os::raw::c_void,
+        src: *const ::std::os::raw::c_void,
+        n: usize,
+    ) -> *mut ::std::os::raw::c_void;
+}
+extern "C" {
+    pub fn _rte_memcpy_avx512(
+        dst: *mut ::std::os::raw::c_void,
+        src: *const ::std::os::raw::c_void,
+        n: usize,
+    ) -> *mut ::std::os::raw::c_void;
+}
+extern "C" {
+    pub fn _rte_lpm_lookupx4_sse42(lpm: *const rte_lpm, ips: *const u32, hop: *mut u32, defv: u32);
+}
+extern "C" {
+    pub fn _rte_lpm_lookupx4_avx2(lpm: *const rte_lpm, ips: *const u32, hop: *mut u32, defv: u32);
+}
+extern "C" {
+    pub fn _rte_lpm_lookupx4_avx512(lpm: *const rte_lpm, ips: *const u32, hop: *mut u32, defv: u32);
 }
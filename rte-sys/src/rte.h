@@ -17,6 +17,7 @@
 #include <rte_malloc.h>
 #include <rte_memcpy.h>
 #include <rte_memory.h>
+#include <rte_vfio.h>
 #include <rte_per_lcore.h>
 #include <rte_prefetch.h>
 #include <rte_spinlock.h>
@@ -26,6 +27,20 @@
 #include <rte_ring.h>
 #include <rte_mempool.h>
 #include <rte_mbuf.h>
+#include <rte_hash.h>
+#include <rte_hash_crc.h>
+#include <rte_jhash.h>
+#include <rte_lpm.h>
+#include <rte_lpm6.h>
+#include <rte_gro.h>
+#include <rte_gso.h>
+#include <rte_ip_frag.h>
+#include <rte_distributor.h>
+#include <rte_metrics.h>
+#include <rte_latencystats.h>
+#include <rte_bitrate.h>
+#include <rte_bpf.h>
+#include <rte_jobstats.h>
 
 #include <rte_timer.h>
 #include <rte_malloc.h>
@@ -37,8 +52,10 @@
 #include <rte_interrupts.h>
 #include <rte_pci.h>
 #include <rte_ethdev.h>
+#include <rte_flow.h>
 #include <rte_kni.h>
 #include <rte_eth_bond.h>
+#include <rte_eth_bond_8023ad.h>
 
 #include <rte_ether.h>
 #include <rte_arp.h>
@@ -47,6 +64,7 @@
 #include <rte_tcp.h>
 #include <rte_udp.h>
 #include <rte_sctp.h>
+#include <rte_net.h>
 
 #include <cmdline_rdline.h>
 #include <cmdline_parse.h>
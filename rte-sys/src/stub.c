@@ -1,5 +1,10 @@
 #include "rte.h"
 
+void *
+_rte_memcpy(void *dst, const void *src, size_t n) {
+    return rte_memcpy(dst, src, n);
+}
+
 void
 _rte_srand(uint64_t seedval) {
     rte_srand(seedval);
@@ -175,6 +180,126 @@ _rte_rdtsc_precise(void) {
     return rte_rdtsc_precise();
 }
 
+unsigned int
+_rte_ring_mp_enqueue_bulk(struct rte_ring *r, void * const *obj_table, unsigned int n, unsigned int *free_space) {
+    return rte_ring_mp_enqueue_bulk(r, obj_table, n, free_space);
+}
+
+unsigned int
+_rte_ring_sp_enqueue_bulk(struct rte_ring *r, void * const *obj_table, unsigned int n, unsigned int *free_space) {
+    return rte_ring_sp_enqueue_bulk(r, obj_table, n, free_space);
+}
+
+unsigned int
+_rte_ring_enqueue_bulk(struct rte_ring *r, void * const *obj_table, unsigned int n, unsigned int *free_space) {
+    return rte_ring_enqueue_bulk(r, obj_table, n, free_space);
+}
+
+unsigned int
+_rte_ring_mc_dequeue_bulk(struct rte_ring *r, void **obj_table, unsigned int n, unsigned int *available) {
+    return rte_ring_mc_dequeue_bulk(r, obj_table, n, available);
+}
+
+unsigned int
+_rte_ring_sc_dequeue_bulk(struct rte_ring *r, void **obj_table, unsigned int n, unsigned int *available) {
+    return rte_ring_sc_dequeue_bulk(r, obj_table, n, available);
+}
+
+unsigned int
+_rte_ring_dequeue_bulk(struct rte_ring *r, void **obj_table, unsigned int n, unsigned int *available) {
+    return rte_ring_dequeue_bulk(r, obj_table, n, available);
+}
+
+unsigned int
+_rte_ring_mp_enqueue_burst(struct rte_ring *r, void * const *obj_table, unsigned int n, unsigned int *free_space) {
+    return rte_ring_mp_enqueue_burst(r, obj_table, n, free_space);
+}
+
+unsigned int
+_rte_ring_sp_enqueue_burst(struct rte_ring *r, void * const *obj_table, unsigned int n, unsigned int *free_space) {
+    return rte_ring_sp_enqueue_burst(r, obj_table, n, free_space);
+}
+
+unsigned int
+_rte_ring_enqueue_burst(struct rte_ring *r, void * const *obj_table, unsigned int n, unsigned int *free_space) {
+    return rte_ring_enqueue_burst(r, obj_table, n, free_space);
+}
+
+unsigned int
+_rte_ring_mc_dequeue_burst(struct rte_ring *r, void **obj_table, unsigned int n, unsigned int *available) {
+    return rte_ring_mc_dequeue_burst(r, obj_table, n, available);
+}
+
+unsigned int
+_rte_ring_sc_dequeue_burst(struct rte_ring *r, void **obj_table, unsigned int n, unsigned int *available) {
+    return rte_ring_sc_dequeue_burst(r, obj_table, n, available);
+}
+
+unsigned int
+_rte_ring_dequeue_burst(struct rte_ring *r, void **obj_table, unsigned int n, unsigned int *available) {
+    return rte_ring_dequeue_burst(r, obj_table, n, available);
+}
+
+int
+_rte_ring_mp_enqueue(struct rte_ring *r, void *obj) {
+    return rte_ring_mp_enqueue(r, obj);
+}
+
+int
+_rte_ring_sp_enqueue(struct rte_ring *r, void *obj) {
+    return rte_ring_sp_enqueue(r, obj);
+}
+
+int
+_rte_ring_enqueue(struct rte_ring *r, void *obj) {
+    return rte_ring_enqueue(r, obj);
+}
+
+int
+_rte_ring_mc_dequeue(struct rte_ring *r, void **obj_p) {
+    return rte_ring_mc_dequeue(r, obj_p);
+}
+
+int
+_rte_ring_sc_dequeue(struct rte_ring *r, void **obj_p) {
+    return rte_ring_sc_dequeue(r, obj_p);
+}
+
+int
+_rte_ring_dequeue(struct rte_ring *r, void **obj_p) {
+    return rte_ring_dequeue(r, obj_p);
+}
+
+unsigned
+_rte_ring_count(const struct rte_ring *r) {
+    return rte_ring_count(r);
+}
+
+unsigned
+_rte_ring_free_count(const struct rte_ring *r) {
+    return rte_ring_free_count(r);
+}
+
+int
+_rte_ring_full(const struct rte_ring *r) {
+    return rte_ring_full(r);
+}
+
+int
+_rte_ring_empty(const struct rte_ring *r) {
+    return rte_ring_empty(r);
+}
+
+unsigned int
+_rte_ring_get_size(const struct rte_ring *r) {
+    return rte_ring_get_size(r);
+}
+
+unsigned int
+_rte_ring_get_capacity(const struct rte_ring *r) {
+    return rte_ring_get_capacity(r);
+}
+
 struct rte_mempool *
 _rte_mempool_from_obj(void *obj) {
     return rte_mempool_from_obj(obj);
@@ -508,3 +633,28 @@ int
 _rte_vlan_insert(struct rte_mbuf **m) {
     return rte_vlan_insert(m);
 }
+
+uint32_t
+_rte_hash_crc(const void *data, uint32_t data_len, uint32_t init_val) {
+    return rte_hash_crc(data, data_len, init_val);
+}
+
+uint32_t
+_rte_jhash(const void *key, uint32_t length, uint32_t initval) {
+    return rte_jhash(key, length, initval);
+}
+
+int
+_rte_lpm_lookup(struct rte_lpm *lpm, uint32_t ip, uint32_t *next_hop) {
+    return rte_lpm_lookup(lpm, ip, next_hop);
+}
+
+int
+_rte_lpm_lookup_bulk(const struct rte_lpm *lpm, const uint32_t *ips, uint32_t *next_hops, unsigned n) {
+    return rte_lpm_lookup_bulk(lpm, ips, next_hops, n);
+}
+
+void
+_rte_lpm_lookupx4(const struct rte_lpm *lpm, const uint32_t ips[4], uint32_t hop[4], uint32_t defv) {
+    rte_lpm_lookupx4(lpm, vect_loadu_sil128((const xmm_t *)ips), hop, defv);
+}
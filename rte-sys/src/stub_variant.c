@@ -0,0 +1,30 @@
+/*
+ * The vectorized stubs, which are built once for each CPU variant with
+ * `-march=<variant>` and `-DRTE_STUB_VARIANT=<name>`, see `rte_build::CPU_VARIANTS`.
+ *
+ * Only the headers of the stubs are included, so that no other code,
+ * e.g. the constructors in the headers, is built with the instructions of a newer CPU.
+ */
+#include <rte_config.h>
+
+/* `rte_memcpy()` only uses AVX512 if it is enabled explicitly */
+#if defined(RTE_MACHINE_CPUFLAG_AVX512F) && !defined(RTE_MEMCPY_AVX512)
+#define RTE_MEMCPY_AVX512
+#endif
+
+#include <rte_memcpy.h>
+#include <rte_lpm.h>
+
+#define _STUB_VARIANT(name, variant) name ## _ ## variant
+#define STUB_VARIANT(name, variant) _STUB_VARIANT(name, variant)
+#define STUB(name) STUB_VARIANT(name, RTE_STUB_VARIANT)
+
+void *
+STUB(_rte_memcpy)(void *dst, const void *src, size_t n) {
+    return rte_memcpy(dst, src, n);
+}
+
+void
+STUB(_rte_lpm_lookupx4)(const struct rte_lpm *lpm, const uint32_t ips[4], uint32_t hop[4], uint32_t defv) {
+    rte_lpm_lookupx4(lpm, vect_loadu_sil128((const xmm_t *)ips), hop, defv);
+}
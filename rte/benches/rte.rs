@@ -0,0 +1,380 @@
+//! Benchmarks of the fast path.
+//!
+//! The packets are received from and sent to the `net_null` and `net_ring` virtual devices,
+//! so no NIC is needed. Each benchmark is warmed up, then measured in several samples,
+//! and the median, minimum and maximum cycles per operation (or per packet) are reported.
+//!
+//! ```
+//! $ cargo bench --bench rte -- [FILTER]
+//! ```
+//!
+//! The EAL arguments could be overridden with `RTE_BENCH_EAL_ARGS`,
+//! and the KNI benchmark is only run if `RTE_BENCH_KNI` is set, which needs the `rte_kni` module.
+extern crate rte;
+
+use std::cmp;
+use std::env;
+use std::hint::black_box;
+use std::mem::ManuallyDrop;
+use std::ptr;
+
+use rte::bitmap::Bitmap;
+use rte::ethdev::{self, EthDevice};
+use rte::mbuf::{self, MBuf, MBufBatch, MBufPool};
+use rte::mempool::MemoryPool;
+use rte::spinlock::{self, RecursiveSpinLock, RecursiveTmSpinLock, SpinLock, TmSpinLock};
+use rte::*;
+
+const MAX_PKT_BURST: usize = 32;
+
+const NB_MBUF: u32 = 8192;
+
+const MEMPOOL_CACHE_SZ: u32 = 256;
+
+const NB_RXD: u16 = 128;
+const NB_TXD: u16 = 512;
+
+const DEFAULT_EAL_ARGS: &str = "-l 0 --no-pci --no-huge -m 256 --vdev=net_null0 --vdev=net_ring0 --log-level 4";
+
+const WARMUP_MS: u64 = 300;
+const SAMPLE_MS: u64 = 50;
+const SAMPLES: usize = 20;
+
+const BITMAP_BITS: u32 = 4096;
+
+struct Bencher {
+    filter: Option<String>,
+    hz: u64,
+}
+
+impl Bencher {
+    fn new(filter: Option<String>) -> Self {
+        Bencher {
+            filter,
+            hz: get_tsc_hz(),
+        }
+    }
+
+    fn enabled(&self, name: &str) -> bool {
+        self.filter
+            .as_ref()
+            .map_or(true, |filter| name.contains(filter.as_str()))
+    }
+
+    /// Measure a routine, which returns the number of operations or packets it processed.
+    fn bench<F: FnMut() -> usize>(&self, name: &str, mut routine: F) {
+        if !self.enabled(name) {
+            return;
+        }
+
+        // warm up the caches and the branch predictor, and estimate the iterations of a sample
+        let warmup = self.hz * WARMUP_MS / 1000;
+        let start = rdtsc_precise();
+        let mut iters = 0;
+
+        while rdtsc_precise() - start < warmup {
+            black_box(routine());
+            iters += 1;
+        }
+
+        let iters = cmp::max(1, iters * SAMPLE_MS / WARMUP_MS);
+        let mut samples = Vec::with_capacity(SAMPLES);
+
+        for _ in 0..SAMPLES {
+            let mut ops = 0;
+            let start = rdtsc_precise();
+
+            for _ in 0..iters {
+                ops += black_box(routine());
+            }
+
+            let cycles = rdtsc_precise() - start;
+
+            if ops > 0 {
+                samples.push(cycles as f64 / ops as f64);
+            }
+        }
+
+        if samples.is_empty() {
+            println!("{:<32} nothing processed", name);
+
+            return;
+        }
+
+        samples.sort_by(|a, b| a.partial_cmp(b).unwrap());
+
+        let median = samples[samples.len() / 2];
+
+        println!(
+            "{:<32} {:>10.1} cycles {:>10.2} ns {:>10.2} Mops/s   [{:.1} .. {:.1}]",
+            name,
+            median,
+            median * 1e9 / self.hz as f64,
+            self.hz as f64 / median / 1e6,
+            samples[0],
+            samples[samples.len() - 1],
+        );
+    }
+}
+
+fn setup_port(name: &str, pool: &mut MemoryPool) -> PortId {
+    let dev = ethdev::port_by_name(name).expect(&format!("port `{}` not found, add `--vdev={}`", name, name));
+
+    dev.configure(1, 1, &ethdev::EthConf::default())
+        .expect("fail to configure device");
+    dev.rx_queue_setup(0, NB_RXD, None, pool)
+        .expect("fail to setup device rx queue");
+    dev.tx_queue_setup(0, NB_TXD, None)
+        .expect("fail to setup device tx queue");
+    dev.start().expect("fail to start device");
+
+    dev
+}
+
+// allocate a full batch of mbufs, or an empty one if the mempool is exhausted
+fn alloc_batch(pool: &mut MemoryPool) -> MBufBatch<MAX_PKT_BURST> {
+    let mut mbufs: [Option<MBuf>; MAX_PKT_BURST] = Default::default();
+    let mut batch = MBufBatch::new();
+
+    if pool.alloc_bulk(&mut mbufs).is_ok() {
+        for m in mbufs.iter_mut().flat_map(Option::take) {
+            let _ = batch.push(m);
+        }
+    }
+
+    batch
+}
+
+fn bench_ethdev(b: &Bencher, pool: &mut MemoryPool, null: PortId, ring: PortId) {
+    b.bench("ethdev/null/rx_burst", || {
+        let mut pkts = MBufBatch::<MAX_PKT_BURST>::new();
+
+        null.rx_burst(0, &mut pkts)
+    });
+
+    b.bench("ethdev/null/tx_burst", || {
+        let mut pkts = alloc_batch(pool);
+
+        null.tx_burst(0, &mut pkts)
+    });
+
+    // the rx and tx queues of `net_ring` share the same ring
+    let mut pkts = alloc_batch(pool);
+
+    b.bench("ethdev/ring/loopback", || {
+        ring.tx_burst(0, &mut pkts);
+        ring.rx_burst(0, &mut pkts)
+    });
+
+    // drain the packets left in the ring
+    while ring.rx_burst(0, &mut pkts) > 0 {
+        pkts.clear();
+    }
+}
+
+fn bench_mempool(b: &Bencher, pool: &mut MemoryPool) {
+    // the handles are stale once they are put back, so they are never dropped but put back by hand
+    let mut objs = ManuallyDrop::new(
+        pool.local_cache()
+            .get_array::<MBuf, _, MAX_PKT_BURST>()
+            .expect("fail to get mbufs"),
+    );
+    let mut held = true;
+
+    b.bench("mempool/get_bulk+put_bulk", || {
+        if held {
+            pool.put_bulk(&*objs);
+        }
+
+        held = pool.get_bulk(&mut *objs).is_ok();
+
+        if held {
+            objs.len()
+        } else {
+            0
+        }
+    });
+
+    if held {
+        pool.put_bulk(&*objs);
+    }
+
+    let mut cache = pool.local_cache();
+
+    b.bench("mempool/get_array+put_array", || {
+        let objs = cache.get_array::<MBuf, _, MAX_PKT_BURST>().expect("fail to get mbufs");
+
+        cache.put_array(objs);
+
+        MAX_PKT_BURST
+    });
+
+    b.bench("mbuf/alloc+free", || {
+        drop(pool.alloc().expect("fail to alloc mbuf"));
+
+        1
+    });
+
+    b.bench("mbuf/alloc_bulk+free_bulk", || {
+        let mut pkts: [Option<MBuf>; MAX_PKT_BURST] = Default::default();
+
+        pool.alloc_bulk(&mut pkts).expect("fail to alloc mbufs");
+
+        mbuf::free_bulk(pkts.iter_mut().flat_map(Option::take));
+
+        MAX_PKT_BURST
+    });
+}
+
+fn bench_bitmap(b: &Bencher) {
+    let size = Bitmap::memory_footprint(BITMAP_BITS);
+    let mem = malloc::zmalloc("bitmap", size as usize, ffi::RTE_CACHE_LINE_SIZE) as *mut u8;
+
+    {
+        let mut bitmap = Bitmap::init(BITMAP_BITS, mem, size).expect("fail to init bitmap");
+
+        // one bit set in every 8 slabs
+        for pos in (0..BITMAP_BITS).step_by(512) {
+            bitmap.set(pos);
+        }
+
+        b.bench("bitmap/scan", || bitmap.scan().map_or(0, |_| 1));
+    }
+
+    malloc::free(mem as *mut _);
+}
+
+fn bench_spinlock(b: &Bencher) {
+    let mut lock = SpinLock::new();
+
+    b.bench("spinlock/lock", || {
+        drop(black_box(lock.lock()));
+
+        1
+    });
+
+    b.bench("spinlock/trylock", || lock.trylock().map_or(0, |_| 1));
+
+    let mut lock = RecursiveSpinLock::new();
+
+    b.bench("spinlock/recursive_lock", || {
+        drop(black_box(lock.lock()));
+
+        1
+    });
+
+    // without the RTM instructions, the `_tm` locks fall back to the spinlocks
+    let suffix = if spinlock::tm_supported() { "" } else { " (no rtm)" };
+
+    let mut lock = TmSpinLock::new();
+
+    b.bench(&format!("spinlock/lock_tm{}", suffix), || {
+        drop(black_box(lock.lock()));
+
+        1
+    });
+
+    b.bench(&format!("spinlock/trylock_tm{}", suffix), || {
+        lock.trylock().map_or(0, |_| 1)
+    });
+
+    let mut lock = RecursiveTmSpinLock::new();
+
+    b.bench(&format!("spinlock/recursive_lock_tm{}", suffix), || {
+        drop(black_box(lock.lock()));
+
+        1
+    });
+}
+
+// receive a burst, rewrite the ethernet addresses and send it back like `l2fwd`
+fn bench_l2fwd(b: &Bencher, null: PortId) {
+    let addrs = [0x02u8, 0, 0, 0, 0, 0x01, 0x02, 0, 0, 0, 0, 0x02];
+
+    b.bench("l2fwd/null", || {
+        let mut pkts = MBufBatch::<MAX_PKT_BURST>::new();
+        let nb_rx = null.rx_burst(0, &mut pkts);
+
+        for m in pkts.iter_mut() {
+            unsafe { ptr::copy_nonoverlapping(addrs.as_ptr(), m.mtod::<u8>().as_ptr(), addrs.len()) }
+        }
+
+        null.tx_burst(0, &mut pkts);
+
+        nb_rx
+    });
+}
+
+// send the bursts to the kernel and receive the packets back from it
+fn bench_kni(b: &Bencher, pool: &mut MemoryPool) {
+    if env::var_os("RTE_BENCH_KNI").is_none() || !b.enabled("kni/") {
+        return;
+    }
+
+    kni::init(1).expect("fail to init KNI, is the `rte_kni` module loaded?");
+
+    let mut conf = kni::KniDeviceConf::default();
+
+    conf.name = "vEthBench";
+    conf.mbuf_size = mbuf::RTE_MBUF_DEFAULT_BUF_SIZE;
+
+    let mut dev = kni::alloc(pool, &conf, None).expect("fail to alloc KNI device");
+
+    b.bench("kni/tx_burst+rx_burst", || {
+        let mut pkts = alloc_batch(pool);
+        let nb_tx = dev.tx_burst(&mut pkts);
+
+        pkts.clear();
+
+        let nb_rx = dev.rx_burst(&mut pkts);
+        let _ = dev.handle_requests();
+
+        nb_tx + nb_rx
+    });
+
+    dev.release().expect("fail to release KNI device");
+
+    kni::close();
+}
+
+fn main() {
+    let eal_args = env::var("RTE_BENCH_EAL_ARGS").unwrap_or_else(|_| DEFAULT_EAL_ARGS.to_owned());
+    let eal_args = Some(String::from("bench"))
+        .into_iter()
+        .chain(eal_args.split_whitespace().map(String::from))
+        .collect::<Vec<_>>();
+
+    // `cargo bench` passes `--bench` and the filter
+    let filter = env::args().skip(1).find(|arg| !arg.starts_with("--"));
+
+    eal::init(&eal_args).expect("fail to initial EAL");
+
+    let mut pool = mbuf::pool_create(
+        "bench_pool",
+        NB_MBUF,
+        MEMPOOL_CACHE_SZ,
+        0,
+        mbuf::RTE_MBUF_DEFAULT_BUF_SIZE as u16,
+        rte::socket_id() as i32,
+    )
+    .expect("fail to initial mbuf pool");
+
+    let null = setup_port("net_null0", &mut pool);
+    let ring = setup_port("net_ring0", &mut pool);
+
+    let b = Bencher::new(filter);
+
+    bench_ethdev(&b, &mut pool, null, ring);
+    bench_mempool(&b, &mut pool);
+    bench_bitmap(&b);
+    bench_spinlock(&b);
+    bench_l2fwd(&b, null);
+    bench_kni(&b, &mut pool);
+
+    for dev in &[null, ring] {
+        dev.stop();
+        dev.close();
+    }
+
+    eal::cleanup().expect("fail to cleanup EAL");
+}
@@ -12,13 +12,6 @@ fn main() {
 
     info!("using DPDK @ {:?}", rte_sdk_dir);
 
-    gcc_rte_config(&rte_sdk_dir)
-        .file("examples/l2fwd/l2fwd_core.c")
-        .compile("libl2fwd_core.a");
-    gcc_rte_config(&rte_sdk_dir)
-        .file("examples/kni/kni_core.c")
-        .compile("libkni_core.a");
-
     gen_cargo_config(
         &rte_sdk_dir,
         RTE_CORE_LIBS
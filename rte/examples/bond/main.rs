@@ -1,6 +1,7 @@
 #[macro_use]
 extern crate log;
 extern crate cfile;
+extern crate getopts;
 extern crate libc;
 extern crate nix;
 extern crate pretty_env_logger;
@@ -10,17 +11,19 @@ use std::cell::RefCell;
 use std::env;
 use std::mem;
 use std::net;
+use std::process;
 use std::ptr::NonNull;
 use std::rc::Rc;
+use std::str::FromStr;
 use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
 
 use rte::arp::{ARP_HRD_ETHER, ARP_OP_REPLY, ARP_OP_REQUEST};
-use rte::bond::BondedDevice;
+use rte::bond::{BondMode, BondedDevice, TransmitPolicy};
 use rte::ethdev::EthDevice;
 use rte::ether::{ETHER_TYPE_IPv4, ETHER_ADDR_LEN, ETHER_TYPE_ARP};
-use rte::lcore::RTE_MAX_LCORE;
-use rte::mbuf::MBufPool;
+use rte::mbuf::{MBufBatch, MBufPool};
 use rte::memory::AsMutRef;
+use rte::stats::CacheAligned;
 use rte::*;
 
 const EXIT_FAILURE: i32 = -1;
@@ -43,20 +46,27 @@ const MEMPOOL_CACHE_SZ: u32 = PKT_BURST_SZ;
 const RTE_RX_DESC_DEFAULT: u16 = 128;
 const RTE_TX_DESC_DEFAULT: u16 = 512;
 
+struct Options {
+    mode: BondMode,
+    xmit_policy: Option<TransmitPolicy>,
+    nb_queues: u16,
+    dedicated_queues: bool,
+}
+
+// The packets received in total, the ARP and IPv4 packets, counted by the lcore of a queue
+type QueueCounters = CacheAligned<[AtomicUsize; 3]>;
+
 struct AppConfig {
     lcore_main_is_running: AtomicBool,
-    lcore_main_core_id: lcore::Id,
+    // the lcore of worker `i` polls the RX/TX queue `i` of the bonded port
+    lcore_main_core_ids: Vec<lcore::Id>,
     bond_ip: net::Ipv4Addr,
     bond_mac_addr: ether::EtherAddr,
     bonded_port_id: PortId,
+    // the TX queue of the command line, which is not shared with the workers
+    ctrl_queue_id: QueueId,
     pktmbuf_pool: mempool::MemoryPool,
-    port_packets: [AtomicUsize; 4],
-}
-
-impl Default for AppConfig {
-    fn default() -> Self {
-        unsafe { mem::zeroed() }
-    }
+    port_packets: Vec<QueueCounters>,
 }
 
 impl AppConfig {
@@ -65,20 +75,136 @@ impl AppConfig {
     }
 
     fn start(&self) {
-        launch::remote_launch(lcore_main, Some(self), self.lcore_main_core_id).expect("Cannot launch task");
-
         self.lcore_main_is_running.store(true, Ordering::Relaxed);
 
+        for &lcore_id in &self.lcore_main_core_ids {
+            launch::remote_launch(lcore_main, Some(self), lcore_id).expect("Cannot launch task");
+        }
+
         info!(
-            "Starting lcore_main on core {} Our IP {}",
-            self.lcore_main_core_id, self.bond_ip
+            "Starting lcore_main on cores {:?} Our IP {}",
+            self.lcore_main_core_ids, self.bond_ip
         );
     }
 
     fn stop(&self) {
         self.lcore_main_is_running.store(false, Ordering::Relaxed);
 
-        self.lcore_main_core_id.wait();
+        for lcore_id in &self.lcore_main_core_ids {
+            lcore_id.wait();
+        }
+    }
+}
+
+fn parse_mode(s: &str) -> Option<BondMode> {
+    match s {
+        "rr" | "0" => Some(BondMode::RouncRobin),
+        "backup" | "1" => Some(BondMode::ActiveBackup),
+        "balance" | "2" => Some(BondMode::Balance),
+        "broadcast" | "3" => Some(BondMode::Broadcast),
+        "8023ad" | "lacp" | "4" => Some(BondMode::AutoNeg),
+        "tlb" | "5" => Some(BondMode::AdaptiveTLB),
+        "alb" | "6" => Some(BondMode::AdaptiveLB),
+        _ => None,
+    }
+}
+
+fn parse_xmit_policy(s: &str) -> Option<TransmitPolicy> {
+    match s {
+        "l2" => Some(TransmitPolicy::Layer2),
+        "l23" => Some(TransmitPolicy::Layer23),
+        "l34" => Some(TransmitPolicy::Layer34),
+        _ => None,
+    }
+}
+
+fn prepare_args(args: &mut Vec<String>) -> (Vec<String>, Vec<String>) {
+    let program = String::from(args[0].as_str());
+
+    if let Some(pos) = args.iter().position(|arg| arg == "--") {
+        let (eal_args, opt_args) = args.split_at_mut(pos);
+
+        opt_args[0] = program;
+
+        (eal_args.to_vec(), opt_args.to_vec())
+    } else {
+        (args.clone(), vec![program])
+    }
+}
+
+fn parse_args(args: &[String]) -> Options {
+    let mut opts = getopts::Options::new();
+    let program = args[0].clone();
+
+    opts.optopt(
+        "m",
+        "mode",
+        "bonding mode: rr, backup, balance, broadcast, 8023ad, tlb or alb (default alb)",
+        "MODE",
+    );
+    opts.optopt(
+        "x",
+        "xmit-policy",
+        "transmit policy of balance and 8023ad modes: l2, l23 or l34",
+        "POLICY",
+    );
+    opts.optopt(
+        "q",
+        "queues",
+        "number of RX/TX queues, one worker lcore per queue (default 1)",
+        "NUM",
+    );
+    opts.optflag(
+        "d",
+        "dedicated-queues",
+        "handle LACP in dedicated slave queues in 8023ad mode",
+    );
+    opts.optflag("h", "help", "print this help menu");
+
+    let matches = match opts.parse(&args[1..]) {
+        Ok(m) => m,
+        Err(err) => {
+            println!("Invalid arguments, {}", err);
+
+            process::exit(-1);
+        }
+    };
+
+    if matches.opt_present("h") {
+        print!(
+            "{}",
+            opts.usage(&format!("Usage: {} [EAL options] -- [options]", program))
+        );
+
+        process::exit(0);
+    }
+
+    let mode = matches
+        .opt_str("m")
+        .map(|s| parse_mode(&s).expect("invalid bonding mode"))
+        .unwrap_or(BondMode::AdaptiveLB);
+    let xmit_policy = matches
+        .opt_str("x")
+        .map(|s| parse_xmit_policy(&s).expect("invalid transmit policy"));
+    let nb_queues = matches
+        .opt_str("q")
+        .map(|s| u16::from_str(&s).expect("invalid number of queues"))
+        .unwrap_or(1);
+    let dedicated_queues = matches.opt_present("d");
+
+    if nb_queues == 0 {
+        eal::exit(EXIT_FAILURE, "Need at least one queue\n");
+    }
+
+    if dedicated_queues && mode != BondMode::AutoNeg {
+        eal::exit(EXIT_FAILURE, "The dedicated queues are only used in 8023ad mode\n");
+    }
+
+    Options {
+        mode,
+        xmit_policy,
+        nb_queues,
+        dedicated_queues,
     }
 }
 
@@ -108,23 +234,35 @@ fn slave_port_init(port_id: ethdev::PortId, port_conf: &ethdev::EthConf, pktmbuf
 
 fn bond_port_init(
     slave_count: u16,
+    opts: &Options,
     port_conf: &ethdev::EthConf,
     pktmbuf_pool: &mut mempool::MemoryPool,
 ) -> ethdev::PortId {
-    let dev = bond::create("bond0", bond::BondMode::AdaptiveLB, 0).expect("Faled to create bond port");
+    let dev = bond::create("bond0", opts.mode, 0).expect("Faled to create bond port");
 
     let bonded_port_id = dev;
 
-    dev.configure(1, 1, &port_conf)
+    if let Some(policy) = opts.xmit_policy {
+        dev.set_xmit_policy(policy)
+            .expect(&format!("fail to set transmit policy: port={}", bonded_port_id));
+    }
+
+    // the slaves are reconfigured with the same number of queues when the bonded port is started,
+    // and one more TX queue is used by the command line
+    dev.configure(opts.nb_queues, opts.nb_queues + 1, &port_conf)
         .expect(&format!("fail to configure device: port={}", bonded_port_id));
 
-    // init one RX queue
-    dev.rx_queue_setup(0, RTE_RX_DESC_DEFAULT, None, pktmbuf_pool)
-        .expect(&format!("fail to setup device rx queue: port={}", bonded_port_id));
+    // init one RX queue for each worker
+    for queue_id in 0..opts.nb_queues {
+        dev.rx_queue_setup(queue_id, RTE_RX_DESC_DEFAULT, None, pktmbuf_pool)
+            .expect(&format!("fail to setup device rx queue: port={}", bonded_port_id));
+    }
 
-    // init one TX queue on each port
-    dev.tx_queue_setup(0, RTE_TX_DESC_DEFAULT, None)
-        .expect(&format!("fail to setup device tx queue: port={}", bonded_port_id));
+    // init one TX queue for each worker and the command line
+    for queue_id in 0..opts.nb_queues + 1 {
+        dev.tx_queue_setup(queue_id, RTE_TX_DESC_DEFAULT, None)
+            .expect(&format!("fail to setup device tx queue: port={}", bonded_port_id));
+    }
 
     for slave_port_id in 0..slave_count {
         dev.add_slave(slave_port_id).expect(&format!(
@@ -133,6 +271,12 @@ fn bond_port_init(
         ));
     }
 
+    // steer the LACPDUs to the dedicated queues of the slaves, so they are not handled in the bursts of workers
+    if opts.dedicated_queues {
+        dev.enable_dedicated_queues()
+            .expect(&format!("fail to enable dedicated queues: port={}", bonded_port_id));
+    }
+
     // Start device
     dev.start()
         .expect(&format!("fail to start device: port={}", bonded_port_id));
@@ -162,17 +306,86 @@ fn strip_vlan_hdr(ether_hdr: *const ether::EtherHdr) -> (*const libc::c_void, u1
     }
 }
 
-// Main thread that does the work, reading from INPUT_PORT and writing to OUTPUT_PORT
-fn lcore_main(app_conf: Option<&AppConfig>) -> i32 {
-    debug!("lcore_main is starting @ lcore {}", lcore::current().unwrap());
+// Reply the ARP requests and the IP packets to our IP, return true if the packet should be sent back
+fn handle_packet(app_conf: &AppConfig, m: &mbuf::MBuf, counters: &QueueCounters) -> bool {
+    let bond_ip = u32::from(app_conf.bond_ip).to_be();
+    let mut p = m.mtod::<ether::EtherHdr>();
+    let ether_hdr = unsafe { p.as_mut() };
+    let (next_hdr, next_proto) = strip_vlan_hdr(ether_hdr);
+
+    match next_proto {
+        ether::ETHER_TYPE_ARP_BE => {
+            counters[1].fetch_add(1, Ordering::Relaxed);
+
+            if let Some(mut arp_hdr) = (next_hdr as *mut arp::ArpHdr).as_mut_ref() {
+                if arp_hdr.arp_data.arp_tip == bond_ip {
+                    debug!(
+                        "received ARP {:x} packet from {}",
+                        arp_hdr.arp_op.to_le(),
+                        ether::EtherAddr::from(arp_hdr.arp_data.arp_sha)
+                    );
+
+                    if arp_hdr.arp_op == (ARP_OP_REQUEST as u16).to_be() {
+                        arp_hdr.arp_op = (ARP_OP_REPLY as u16).to_be();
+
+                        ether::EtherAddr::copy(&ether_hdr.s_addr.addr_bytes, &mut ether_hdr.d_addr.addr_bytes);
+                        ether::EtherAddr::copy(&app_conf.bond_mac_addr, &mut ether_hdr.s_addr.addr_bytes);
+
+                        ether::EtherAddr::copy(
+                            &arp_hdr.arp_data.arp_sha.addr_bytes,
+                            &mut arp_hdr.arp_data.arp_tha.addr_bytes,
+                        );
+                        ether::EtherAddr::copy(&app_conf.bond_mac_addr, &mut arp_hdr.arp_data.arp_sha.addr_bytes);
+
+                        arp_hdr.arp_data.arp_tip = arp_hdr.arp_data.arp_sip;
+                        arp_hdr.arp_data.arp_sip = bond_ip;
+
+                        return true;
+                    }
+                }
+            }
+        }
+        ether::ETHER_TYPE_IPV4_BE => {
+            counters[2].fetch_add(1, Ordering::Relaxed);
+
+            if let Some(mut ipv4_hdr) = (next_hdr as *mut ip::Ipv4Hdr).as_mut_ref() {
+                if ipv4_hdr.dst_addr == bond_ip {
+                    debug!("received IP packet from {}", net::Ipv4Addr::from(ipv4_hdr.src_addr));
+
+                    ether::EtherAddr::copy(&ether_hdr.s_addr.addr_bytes, &mut ether_hdr.d_addr.addr_bytes);
+                    ether::EtherAddr::copy(&app_conf.bond_mac_addr, &mut ether_hdr.s_addr.addr_bytes);
+
+                    ipv4_hdr.dst_addr = ipv4_hdr.src_addr;
+                    ipv4_hdr.src_addr = bond_ip;
+
+                    return true;
+                }
+            }
+        }
+        _ => {}
+    }
 
+    false
+}
+
+// Main thread that does the work, reading from and writing to its own queue of the bonded port
+fn lcore_main(app_conf: Option<&AppConfig>) -> i32 {
     let app_conf = app_conf.unwrap();
+    let lcore_id = lcore::current().unwrap();
+    let queue_id = app_conf
+        .lcore_main_core_ids
+        .iter()
+        .position(|&id| id == lcore_id)
+        .unwrap();
+    let counters = &app_conf.port_packets[queue_id];
+    let queue_id = queue_id as QueueId;
     let dev = app_conf.bonded_port_id;
-    let mut pkts: [Option<mbuf::MBuf>; MAX_PKT_BURST] = unsafe { mem::zeroed() };
-    let bond_ip = u32::from(app_conf.bond_ip).to_be();
+
+    debug!("lcore_main is starting @ lcore {} for queue {}", lcore_id, queue_id);
 
     while app_conf.lcore_main_is_running.load(Ordering::Relaxed) {
-        let rx_cnt = dev.rx_burst(0, &mut pkts[..]);
+        let mut pkts = MBufBatch::<MAX_PKT_BURST>::new();
+        let rx_cnt = dev.rx_burst(queue_id, &mut pkts);
 
         // If didn't receive any packets, wait and go to next iteration
         if rx_cnt == 0 {
@@ -181,76 +394,26 @@ fn lcore_main(app_conf: Option<&AppConfig>) -> i32 {
             continue;
         }
 
-        debug!("received {} packets from bonded port {}", rx_cnt, dev.portid());
-
-        app_conf.port_packets[0].fetch_add(rx_cnt, Ordering::Relaxed);
-
-        // Search incoming data for ARP packets and prepare response
-        for pkt in pkts.into_iter().take(rx_cnt) {
-            if let Some(m) = pkt {
-                let mut p = m.mtod::<ether::EtherHdr>();
-                let ether_hdr = unsafe { p.as_mut() };
-                let (next_hdr, next_proto) = strip_vlan_hdr(ether_hdr);
-
-                match next_proto {
-                    ether::ETHER_TYPE_ARP_BE => {
-                        app_conf.port_packets[1].fetch_add(1, Ordering::Relaxed);
-
-                        if let Some(mut arp_hdr) = (next_hdr as *mut arp::ArpHdr).as_mut_ref() {
-                            if arp_hdr.arp_data.arp_tip == bond_ip {
-                                debug!(
-                                    "received ARP {:x} packet from {}",
-                                    arp_hdr.arp_op.to_le(),
-                                    ether::EtherAddr::from(arp_hdr.arp_data.arp_sha)
-                                );
-
-                                if arp_hdr.arp_op == (ARP_OP_REQUEST as u16).to_be() {
-                                    arp_hdr.arp_op = (ARP_OP_REPLY as u16).to_be();
-
-                                    ether::EtherAddr::copy(
-                                        &ether_hdr.s_addr.addr_bytes,
-                                        &mut ether_hdr.d_addr.addr_bytes,
-                                    );
-                                    ether::EtherAddr::copy(&app_conf.bond_mac_addr, &mut ether_hdr.s_addr.addr_bytes);
-
-                                    ether::EtherAddr::copy(
-                                        &arp_hdr.arp_data.arp_sha.addr_bytes,
-                                        &mut arp_hdr.arp_data.arp_tha.addr_bytes,
-                                    );
-                                    ether::EtherAddr::copy(
-                                        &app_conf.bond_mac_addr,
-                                        &mut arp_hdr.arp_data.arp_sha.addr_bytes,
-                                    );
-
-                                    arp_hdr.arp_data.arp_tip = arp_hdr.arp_data.arp_sip;
-                                    arp_hdr.arp_data.arp_sip = bond_ip;
-
-                                    let _ = dev.tx_burst(0, &mut [m]);
-                                }
-                            }
-                        }
-                    }
-                    ether::ETHER_TYPE_IPV4_BE => {
-                        app_conf.port_packets[2].fetch_add(1, Ordering::Relaxed);
-
-                        if let Some(mut ipv4_hdr) = (next_hdr as *mut ip::Ipv4Hdr).as_mut_ref() {
-                            if ipv4_hdr.dst_addr == bond_ip {
-                                debug!("received IP packet from {}", net::Ipv4Addr::from(ipv4_hdr.src_addr));
+        debug!(
+            "received {} packets from bonded port {} queue {}",
+            rx_cnt,
+            dev.portid(),
+            queue_id
+        );
 
-                                ether::EtherAddr::copy(&ether_hdr.s_addr.addr_bytes, &mut ether_hdr.d_addr.addr_bytes);
-                                ether::EtherAddr::copy(&app_conf.bond_mac_addr, &mut ether_hdr.s_addr.addr_bytes);
+        counters[0].fetch_add(rx_cnt, Ordering::Relaxed);
 
-                                ipv4_hdr.dst_addr = ipv4_hdr.src_addr;
-                                ipv4_hdr.src_addr = bond_ip;
+        // Search incoming data for ARP packets and prepare response, the others are freed in bulk
+        let mut replies = MBufBatch::<MAX_PKT_BURST>::new();
 
-                                let _ = dev.tx_burst(0, &mut [m]);
-                            }
-                        }
-                    }
-                    _ => {}
-                }
+        for m in pkts.drain() {
+            if handle_packet(app_conf, &m, counters) {
+                let _ = replies.push(m);
             }
         }
+
+        // send the responses in one burst, the unsent ones are freed with the batch
+        dev.tx_burst(queue_id, &mut replies);
     }
 
     debug!("BYE lcore_main");
@@ -301,7 +464,12 @@ impl CmdActionResult {
                 arp_hdr.arp_data.arp_sip = u32::from(app_conf.bond_ip).to_be();
                 arp_hdr.arp_data.arp_tip = u32::from(ip).to_be();
 
-                if app_conf.bonded_port_id.tx_burst(0, &mut [m]) == 1 {
+                // the request is freed with the batch if it isn't sent
+                let mut pkts = MBufBatch::<1>::new();
+
+                let _ = pkts.push(m);
+
+                if app_conf.bonded_port_id.tx_burst(app_conf.ctrl_queue_id, &mut pkts) == 1 {
                     debug!("send ARP request to {}", ip);
                 }
             }
@@ -317,8 +485,8 @@ impl CmdActionResult {
 
         if app_conf.is_running() {
             cl.println(&format!(
-                "lcore_main already running on core: {}",
-                app_conf.lcore_main_core_id
+                "lcore_main already running on cores: {:?}",
+                app_conf.lcore_main_core_ids
             ))
             .unwrap();
         } else {
@@ -332,15 +500,18 @@ impl CmdActionResult {
 
         if !app_conf.is_running() {
             cl.println(&format!(
-                "lcore_main not running on core: {}",
-                app_conf.lcore_main_core_id
+                "lcore_main not running on cores: {:?}",
+                app_conf.lcore_main_core_ids
             ))
             .unwrap();
         } else {
             app_conf.stop();
 
-            cl.println(&format!("lcore_main stopped on core: {}", app_conf.lcore_main_core_id))
-                .unwrap();
+            cl.println(&format!(
+                "lcore_main stopped on cores: {:?}",
+                app_conf.lcore_main_core_ids
+            ))
+            .unwrap();
         }
     }
 
@@ -364,25 +535,60 @@ impl CmdActionResult {
 
             cl.println(&format!("Slave {}, MAC={}, {}", slave.portid(), slave.mac_addr(), role))
                 .unwrap();
+
+            // the slaves are balanced well if their counters grow at a similar rate
+            if let Ok(stats) = slave.stats() {
+                cl.println(&format!(
+                    "    RX: {} packets {} bytes, missed: {}, errors: {}; TX: {} packets {} bytes, errors: {}",
+                    stats.ipackets,
+                    stats.ibytes,
+                    stats.imissed,
+                    stats.ierrors,
+                    stats.opackets,
+                    stats.obytes,
+                    stats.oerrors
+                ))
+                .unwrap();
+            }
+        }
+
+        let mut total = [0; 3];
+
+        for (queue_id, counters) in app_conf.port_packets.iter().enumerate() {
+            let counters = [
+                counters[0].load(Ordering::Relaxed),
+                counters[1].load(Ordering::Relaxed),
+                counters[2].load(Ordering::Relaxed),
+            ];
+
+            cl.println(&format!(
+                "Queue {}, packets received:Tot: {}, Arp: {}, IPv4: {}",
+                queue_id, counters[0], counters[1], counters[2]
+            ))
+            .unwrap();
+
+            for (total, n) in total.iter_mut().zip(&counters) {
+                *total += n;
+            }
         }
 
         cl.println(&format!(
             "Active_slaves: {}, packets received:Tot: {}, Arp: {}, IPv4: {}",
             active_slaves.len(),
-            app_conf.port_packets[0].load(Ordering::Relaxed),
-            app_conf.port_packets[1].load(Ordering::Relaxed),
-            app_conf.port_packets[2].load(Ordering::Relaxed)
+            total[0],
+            total[1],
+            total[2]
         ))
         .unwrap();
     }
 
     fn help(&mut self, cl: &cmdline::CmdLine, _: Option<Rc<RefCell<AppConfig>>>) {
         cl.println(
-            r#"ALB - link bonding mode 6 example
+            r#"Link bonding example
     send IP    - sends one ARPrequest thru bonding for IP.
     start      - starts listening ARPs.
     stop       - stops lcore_main.
-    show       - shows some bond info: ex. active slaves etc.
+    show       - shows some bond info: ex. active slaves, slave and queue stats etc.
     help       - prints help.
     quit       - terminate all threads and quit."#,
         )
@@ -447,7 +653,7 @@ fn prompt(app_conf: AppConfig) {
     let cmds = &[&cmd_send, &cmd_start, &cmd_stop, &cmd_show, &cmd_help, &cmd_quit];
 
     cmdline::new(cmds)
-        .open_stdin("bond6> ")
+        .open_stdin("bond> ")
         .expect("fail to open stdin")
         .interact();
 }
@@ -456,10 +662,14 @@ fn prompt(app_conf: AppConfig) {
 fn main() {
     pretty_env_logger::init();
 
-    let args: Vec<String> = env::args().collect();
+    let mut args: Vec<String> = env::args().collect();
+
+    let (eal_args, opt_args) = prepare_args(&mut args);
+
+    let opts = parse_args(&opt_args);
 
     // init EAL
-    eal::init(&args).expect("Cannot init EAL");
+    eal::init(&eal_args).expect("Cannot init EAL");
 
     let stdout = cfile::stdout().unwrap();
 
@@ -502,7 +712,7 @@ fn main() {
         slave_port_init(portid, &port_conf, &mut pktmbuf_pool);
     }
 
-    let bonded_dev = bond_port_init(nb_ports, &port_conf, &mut pktmbuf_pool);
+    let bonded_dev = bond_port_init(nb_ports, &opts, &port_conf, &mut pktmbuf_pool);
 
     // check state of lcores
     lcore::foreach_slave(|lcore_id| {
@@ -511,21 +721,26 @@ fn main() {
         }
     });
 
-    // start lcore main on core != master_core - ARP response thread
-    let slave_core_id = lcore::current().unwrap().next().unwrap();
+    // start lcore main on cores != master_core - ARP response threads, one for each queue
+    let slave_core_ids: Vec<_> = lcore::enabled()
+        .into_iter()
+        .filter(|lcore_id| !lcore_id.is_master())
+        .take(opts.nb_queues as usize)
+        .collect();
 
-    if slave_core_id == 0 || slave_core_id >= RTE_MAX_LCORE {
-        eal::exit(-libc::EPERM, "missing slave core");
+    if slave_core_ids.len() < opts.nb_queues as usize {
+        eal::exit(-libc::EPERM, "missing slave cores, need one for each queue");
     }
 
     let app_conf = AppConfig {
         bond_ip: net::Ipv4Addr::new(10, 0, 0, 7),
         bond_mac_addr: bonded_dev.mac_addr(),
         bonded_port_id: bonded_dev.portid(),
-        lcore_main_is_running: AtomicBool::new(true),
-        lcore_main_core_id: slave_core_id,
+        ctrl_queue_id: opts.nb_queues,
+        lcore_main_is_running: AtomicBool::new(false),
+        lcore_main_core_ids: slave_core_ids,
+        port_packets: (0..opts.nb_queues).map(|_| Default::default()).collect(),
         pktmbuf_pool,
-        ..AppConfig::default()
     };
 
     app_conf.start();
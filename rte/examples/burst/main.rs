@@ -0,0 +1,176 @@
+//! Micro benchmark for the RX/TX burst fast path.
+//!
+//! It compares the out-of-line `_rte_eth_rx_burst`/`_rte_eth_tx_burst` stubs
+//! against `ffi::burst`, which is re-implemented in Rust with the `inline-burst` feature.
+//!
+//! ```
+//! $ cargo run --release --features inline-burst --example burst -- -l 0 --vdev=net_null0 -- -n 10000000
+//! ```
+#[macro_use]
+extern crate log;
+extern crate getopts;
+extern crate pretty_env_logger;
+extern crate rte;
+
+use std::env;
+use std::path::Path;
+use std::process;
+use std::ptr;
+use std::str::FromStr;
+
+use rte::ethdev::{EthDevice, EthDeviceInfo};
+use rte::mbuf::RawMBufPtr;
+use rte::*;
+
+const MAX_PKT_BURST: usize = 32;
+
+const NB_MBUF: u32 = 8192;
+
+const MEMPOOL_CACHE_SZ: u32 = 256;
+
+const NB_RXD: u16 = 128;
+const NB_TXD: u16 = 512;
+
+const DEFAULT_ITERATIONS: usize = 1_000_000;
+
+fn prepare_args(args: &mut Vec<String>) -> (Vec<String>, Vec<String>) {
+    let program = String::from(Path::new(&args[0]).file_name().unwrap().to_str().unwrap());
+
+    if let Some(pos) = args.iter().position(|arg| arg == "--") {
+        let (eal_args, opt_args) = args.split_at_mut(pos);
+
+        opt_args[0] = program;
+
+        (eal_args.to_vec(), opt_args.to_vec())
+    } else {
+        (args.clone(), vec![program])
+    }
+}
+
+fn parse_args(args: &[String]) -> usize {
+    let mut opts = getopts::Options::new();
+    let program = args[0].clone();
+
+    opts.optopt("n", "", "number of bursts to measure (default 1000000)", "NUM");
+    opts.optflag("h", "help", "print this help menu");
+
+    let matches = match opts.parse(&args[1..]) {
+        Ok(m) => m,
+        Err(err) => {
+            println!("Invalid arguments, {}", err);
+
+            process::exit(-1);
+        }
+    };
+
+    if matches.opt_present("h") {
+        print!("{}", opts.usage(&format!("Usage: {} [EAL options] -- [options]", program)));
+
+        process::exit(0);
+    }
+
+    matches
+        .opt_str("n")
+        .map(|n| usize::from_str(&n).expect("invalid number of bursts"))
+        .unwrap_or(DEFAULT_ITERATIONS)
+}
+
+// Measure the average cycles of a rx + tx burst round trip
+fn measure<F>(iterations: usize, mut round_trip: F) -> (u64, usize)
+where
+    F: FnMut(&mut [RawMBufPtr; MAX_PKT_BURST]) -> usize,
+{
+    let mut pkts = [ptr::null_mut(); MAX_PKT_BURST];
+    let mut nb_pkts = 0;
+
+    // warm up the caches and the branch predictor
+    for _ in 0..iterations / 10 {
+        round_trip(&mut pkts);
+    }
+
+    let start = rdtsc_precise();
+
+    for _ in 0..iterations {
+        nb_pkts += round_trip(&mut pkts);
+    }
+
+    ((rdtsc_precise() - start) / iterations as u64, nb_pkts)
+}
+
+fn main() {
+    pretty_env_logger::init();
+
+    let mut args: Vec<String> = env::args().collect();
+
+    let (eal_args, opt_args) = prepare_args(&mut args);
+
+    let iterations = parse_args(&opt_args);
+
+    eal::init(&eal_args).expect("fail to initial EAL");
+
+    let mut pktmbuf_pool = mbuf::pool_create(
+        "mbuf_pool",
+        NB_MBUF,
+        MEMPOOL_CACHE_SZ,
+        0,
+        mbuf::RTE_MBUF_DEFAULT_BUF_SIZE as u16,
+        rte::socket_id() as i32,
+    )
+    .expect("fail to initial mbuf pool");
+
+    let dev: PortId = ethdev::devices().next().unwrap_or_else(|| {
+        eal::exit(-1, "No available ports, e.g. add `--vdev=net_null0`.\n");
+
+        unreachable!()
+    });
+
+    info!("benchmark port #{} with `{}` driver", dev, dev.info().driver_name());
+
+    dev.configure(1, 1, &ethdev::EthConf::default())
+        .expect("fail to configure device");
+    dev.rx_queue_setup(0, NB_RXD, None, &mut pktmbuf_pool)
+        .expect("fail to setup device rx queue");
+    dev.tx_queue_setup(0, NB_TXD, None)
+        .expect("fail to setup device tx queue");
+    dev.start().expect("fail to start device");
+
+    let (stub_cycles, stub_pkts) = measure(iterations, |pkts| unsafe {
+        let nb_rx = ffi::_rte_eth_rx_burst(dev, 0, pkts.as_mut_ptr(), MAX_PKT_BURST as u16);
+        let nb_tx = ffi::_rte_eth_tx_burst(dev, 0, pkts.as_mut_ptr(), nb_rx);
+
+        for &m in &pkts[nb_tx as usize..nb_rx as usize] {
+            ffi::_rte_pktmbuf_free(m);
+        }
+
+        nb_rx as usize
+    });
+
+    let (burst_cycles, burst_pkts) = measure(iterations, |pkts| unsafe {
+        let nb_rx = ffi::burst::rx_burst(dev, 0, pkts.as_mut_ptr(), MAX_PKT_BURST as u16);
+        let nb_tx = ffi::burst::tx_burst(dev, 0, pkts.as_mut_ptr(), nb_rx);
+
+        for &m in &pkts[nb_tx as usize..nb_rx as usize] {
+            ffi::_rte_pktmbuf_free(m);
+        }
+
+        nb_rx as usize
+    });
+
+    dev.stop();
+    dev.close();
+
+    println!(
+        "stub.c trampolines:   {:6} cycles/burst, {} packets",
+        stub_cycles, stub_pkts
+    );
+    println!(
+        "ffi::burst ({}): {:6} cycles/burst, {} packets",
+        if cfg!(feature = "inline-burst") { "inline" } else { "stub  " },
+        burst_cycles,
+        burst_pkts
+    );
+    println!(
+        "delta:                {:6} cycles/burst",
+        stub_cycles as i64 - burst_cycles as i64
+    );
+}
@@ -98,26 +98,20 @@ fn slave_main(app_cfg: Option<&mut AppConfig>) -> i32 {
                 }
 
                 let txq = &mut app_port.txq;
+                let cnt_unsent = txq.buf_frames.len();
 
                 // Incoming frames
-                let cnt_recv_frames = dev.rx_burst(0, &mut txq.buf_frames[txq.cnt_unsent..]);
+                let cnt_recv_frames = dev.rx_burst(0, &mut txq.buf_frames);
 
                 if cnt_recv_frames > 0 {
-                    let frames = &txq.buf_frames[txq.cnt_unsent..txq.cnt_unsent + cnt_recv_frames];
-                    for frame in frames {
-                        process_frame(&app_port.mac_addr, frame.as_ref().unwrap());
+                    for frame in &txq.buf_frames[cnt_unsent..] {
+                        process_frame(&app_port.mac_addr, frame);
                     }
-
-                    txq.cnt_unsent += cnt_recv_frames
                 }
 
-                // Outgoing frames
-                if txq.cnt_unsent > 0 {
-                    let cnt_sent = dev.tx_burst(0, &mut txq.buf_frames[..txq.cnt_unsent]);
-
-                    for i in cnt_sent..txq.cnt_unsent {
-                        txq.buf_frames[i - cnt_sent] = txq.buf_frames[i].take();
-                    }
+                // Outgoing frames, the unsent frames are kept in the batch
+                if !txq.buf_frames.is_empty() {
+                    dev.tx_burst(0, &mut txq.buf_frames);
                 }
             }
         }
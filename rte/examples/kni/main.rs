@@ -17,12 +17,19 @@ use std::process;
 use std::ptr;
 use std::result;
 use std::str::FromStr;
+use std::sync::atomic::{AtomicBool, Ordering};
 
 use nix::sys::signal;
 
 use rte::ethdev::EthDevice;
+use rte::exception::ExceptionPath;
 use rte::ffi::{ETHER_MAX_LEN, RTE_MAX_ETHPORTS, RTE_PKTMBUF_HEADROOM};
+use rte::idle::{IdleBackoff, IdlePolicy};
 use rte::lcore::RTE_MAX_LCORE;
+use rte::mbuf::{self, MBuf, MBufBatch};
+use rte::stats::{Counter, PerLcore};
+use rte::utils::AsRaw;
+use rte::virtio_user;
 use rte::*;
 
 const EXIT_FAILURE: i32 = -1;
@@ -37,10 +44,10 @@ const MBUF_DATA_SZ: u32 = MAX_PACKET_SZ + RTE_PKTMBUF_HEADROOM;
 const NB_MBUF: u32 = 8192;
 
 // How many packets to attempt to read from NIC in one go
-const PKT_BURST_SZ: u32 = 32;
+const PKT_BURST_SZ: usize = 32;
 
 // How many objects (mbufs) to keep in per-lcore mempool cache
-const MEMPOOL_CACHE_SZ: u32 = PKT_BURST_SZ;
+const MEMPOOL_CACHE_SZ: u32 = PKT_BURST_SZ as u32;
 
 // Number of RX ring descriptors
 const NB_RXD: u16 = 128;
@@ -56,15 +63,42 @@ const KNI_ENET_FCS_SIZE: u32 = 4;
 
 const KNI_MAX_KTHREAD: usize = 32;
 
+// Max number of flows coalesced at once by GRO
+const GRO_MAX_FLOW_NUM: u16 = PKT_BURST_SZ as u16;
+
+// Max number of TCP segments coalesced into a packet by GRO
+const GRO_MAX_ITEM_PER_FLOW: u16 = 32;
+
+// How long the TCP segments are held to be coalesced by GRO, in microseconds
+const GRO_FLUSH_TIMEOUT_US: u64 = 10;
+
+// Max size of a GSO segment, the MTU of port with the ethernet header
+const GSO_SEG_SZ: u16 = (ETHER_MAX_LEN - KNI_ENET_FCS_SIZE) as u16;
+
+// Max number of GSO segments of a packet from KNI, which is at most MAX_PACKET_SZ bytes
+const GSO_MAX_SEGS: usize = 4;
+
+// How many GSO segments to burst tx to NIC in one go
+const GSO_BURST_SZ: usize = PKT_BURST_SZ * GSO_MAX_SEGS;
+
+const MAX_PORTS: usize = RTE_MAX_ETHPORTS as usize;
+
+static KNI_STOP: AtomicBool = AtomicBool::new(false);
+
+// The configuration shared with the signal handler
+static mut KNI_CONF: *const Conf = ptr::null();
+
 #[repr(C)]
 #[derive(Clone, Debug)]
 struct kni_port_params {
     // Port ID
     port_id: libc::uint8_t,
-    // lcore ID for RX
-    lcore_rx: libc::c_uint,
-    // lcore ID for TX
-    lcore_tx: libc::c_uint,
+    // Number of RX/TX queue pairs, each polled by its own RX and TX lcore
+    nb_queues: libc::uint32_t,
+    // lcore ID for RX of each queue
+    lcore_rx: [libc::c_uint; KNI_MAX_KTHREAD],
+    // lcore ID for TX of each queue
+    lcore_tx: [libc::c_uint; KNI_MAX_KTHREAD],
     // Number of lcores for KNI multi kernel threads
     nb_lcore_k: libc::uint32_t,
     // Number of KNI devices to be created
@@ -73,6 +107,8 @@ struct kni_port_params {
     lcore_k: [libc::c_uint; KNI_MAX_KTHREAD],
     // KNI context pointers
     kni: [kni::RawKniDevicePtr; KNI_MAX_KTHREAD],
+    // The virtio_user port of the exception path, instead of KNI
+    virtio_user_port: PortId,
 }
 
 struct Conf {
@@ -81,18 +117,35 @@ struct Conf {
 
     promiscuous_on: bool,
 
+    // exchange packets with the kernel through virtio_user and vhost-net instead of KNI
+    virtio_user: bool,
+
+    // coalesce the TCP segments from NIC with GRO before sending them to KNI
+    gro: bool,
+
+    // segment the TCP packets from KNI with GSO before sending them to NIC
+    gso: bool,
+
+    // mbuf pools of the GSO segments, for the headers and the payload
+    gso_direct_pool: mempool::RawMemoryPoolPtr,
+    gso_indirect_pool: mempool::RawMemoryPoolPtr,
+
     port_params: [Option<kni_port_params>; RTE_MAX_ETHPORTS as usize],
+
+    stats: PerLcore<LcoreStats>,
 }
 
 impl fmt::Debug for Conf {
     fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
         for conf in self.port_params.iter().flatten() {
             try!(write!(f, "Port ID: {}\n", conf.port_id));
-            try!(write!(
-                f,
-                "  Rx lcore ID: {}, Tx lcore ID: {}\n",
-                conf.lcore_rx, conf.lcore_tx
-            ));
+            for queue_id in 0..conf.nb_queues as usize {
+                try!(write!(
+                    f,
+                    "  Queue {}, Rx lcore ID: {}, Tx lcore ID: {}\n",
+                    queue_id, conf.lcore_rx[queue_id], conf.lcore_tx[queue_id]
+                ));
+            }
 
             for lcore_id in &conf.lcore_k[..conf.nb_lcore_k as usize] {
                 try!(write!(f, "    Kernel thread lcore ID: {}\n", lcore_id));
@@ -109,11 +162,14 @@ impl Conf {
     }
 
     fn parse_config(&mut self, arg: &str) -> result::Result<(), String> {
-        let mut fields = arg
-            .split(',')
-            .map(|s| u32::from_str(s).expect("Invalid config parameters"));
+        // the RX and TX lcores of each queue are separated by `:`
+        let mut fields = arg.split(',').map(|s| {
+            s.split(':')
+                .map(|s| u32::from_str(s).expect("Invalid config parameters"))
+                .collect::<Vec<_>>()
+        });
 
-        let port_id = try!(fields.next().ok_or("Invalid config parameter, missed port_id field"));
+        let port_id = try!(fields.next().ok_or("Invalid config parameter, missed port_id field"))[0];
 
         if port_id > RTE_MAX_ETHPORTS {
             return Err(format!(
@@ -129,17 +185,38 @@ impl Conf {
         let mut param: kni_port_params = unsafe { mem::zeroed() };
 
         param.port_id = port_id as u8;
-        param.lcore_rx = try!(fields.next().ok_or("Invalid config parameter, missed lcore_rx field"));
-        param.lcore_tx = try!(fields.next().ok_or("Invalid config parameter, missed lcore_tx field"));
 
-        if param.lcore_rx >= RTE_MAX_LCORE || param.lcore_tx >= RTE_MAX_LCORE {
+        let lcores_rx = try!(fields.next().ok_or("Invalid config parameter, missed lcore_rx field"));
+        let lcores_tx = try!(fields.next().ok_or("Invalid config parameter, missed lcore_tx field"));
+
+        if lcores_rx.len() != lcores_tx.len() || lcores_rx.len() > KNI_MAX_KTHREAD {
             return Err(format!(
-                "lcore_rx {} or lcore_tx {} ID could not exceed the maximum {}",
-                param.lcore_rx, param.lcore_tx, RTE_MAX_LCORE
+                "lcore_rx {:?} and lcore_tx {:?} should have the same number of queues, at most {}",
+                lcores_rx, lcores_tx, KNI_MAX_KTHREAD
             ));
         }
 
-        let lcores: Vec<u32> = fields.collect();
+        for (&lcore_rx, &lcore_tx) in lcores_rx.iter().zip(lcores_tx.iter()) {
+            if lcore_rx >= RTE_MAX_LCORE || lcore_tx >= RTE_MAX_LCORE {
+                return Err(format!(
+                    "lcore_rx {} or lcore_tx {} ID could not exceed the maximum {}",
+                    lcore_rx, lcore_tx, RTE_MAX_LCORE
+                ));
+            }
+        }
+
+        param.nb_queues = lcores_rx.len() as u32;
+        param.lcore_rx[..lcores_rx.len()].copy_from_slice(&lcores_rx);
+        param.lcore_tx[..lcores_tx.len()].copy_from_slice(&lcores_tx);
+
+        let lcores: Vec<u32> = fields.flatten().collect();
+
+        if lcores.len() > KNI_MAX_KTHREAD {
+            return Err(format!(
+                "lcore_kthread could not exceed the maximum {}",
+                KNI_MAX_KTHREAD
+            ));
+        }
 
         unsafe {
             ptr::copy_nonoverlapping(lcores.as_ptr(), param.lcore_k.as_mut_ptr(), lcores.len());
@@ -156,22 +233,24 @@ impl Conf {
 extern "C" fn handle_sigint(sig: libc::c_int) {
     match signal::Signal::from_c_int(sig).unwrap() {
         // When we receive a USR1 signal, print stats
-        signal::SIGUSR1 => unsafe {
-            kni_print_stats();
-        },
+        signal::SIGUSR1 => {
+            if let Some(conf) = unsafe { KNI_CONF.as_ref() } {
+                kni_print_stats(conf);
+            }
+        }
         // When we receive a USR2 signal, reset stats
         signal::SIGUSR2 => {
-            unsafe {
-                kni_stats = mem::zeroed();
+            if let Some(conf) = unsafe { KNI_CONF.as_ref() } {
+                for stats in conf.stats.iter().flat_map(|stats| stats.iter()) {
+                    stats.reset();
+                }
             }
 
             println!("**Statistics have been reset**");
         }
         // When we receive a TERM or SIGINT signal, stop kni processing
         signal::SIGINT | signal::SIGTERM => {
-            unsafe {
-                kni_stop = 1;
-            }
+            KNI_STOP.store(true, Ordering::Relaxed);
 
             println!("SIGINT or SIGTERM is received, and the KNI processing is going to stop\n");
         }
@@ -227,11 +306,18 @@ fn parse_args(args: &Vec<String>) -> result::Result<Conf, String> {
     opts.optflag("h", "help", "print this help menu");
     opts.optopt("p", "", "hexadecimal bitmask of ports to configure", "PORTMASK");
     opts.optflag("P", "", "enable promiscuous mode");
+    opts.optflag(
+        "",
+        "virtio-user",
+        "exchange packets with the kernel through virtio_user and vhost-net instead of KNI",
+    );
+    opts.optflag("", "gro", "coalesce TCP segments with GRO before sending to KNI");
+    opts.optflag("", "gso", "segment TCP packets with GSO after receiving from KNI");
     opts.optmulti(
         "c",
         "config",
         "port and lcore configurations",
-        "port,lcore_rx,lcore_tx,lcore_kthread...",
+        "port,lcore_rx[:lcore_rx...],lcore_tx[:lcore_tx...],lcore_kthread...",
     );
 
     let matches = match opts.parse(&args[1..]) {
@@ -261,6 +347,14 @@ fn parse_args(args: &Vec<String>) -> result::Result<Conf, String> {
     }
 
     conf.promiscuous_on = matches.opt_present("P");
+    conf.virtio_user = matches.opt_present("virtio-user");
+    conf.gro = matches.opt_present("gro");
+    conf.gso = matches.opt_present("gso");
+
+    // GRO doesn't update the TCP checksums of the coalesced packets, which vhost-net checks, unlike KNI
+    if conf.virtio_user && conf.gro {
+        return Err("--gro can't be used with --virtio-user".to_owned());
+    }
 
     for arg in matches.opt_strs("c") {
         try!(conf.parse_config(&arg));
@@ -277,29 +371,89 @@ fn init_kni(conf: &Conf) -> Result<()> {
         .port_params
         .iter()
         .flatten()
-        .fold(0, |acc, param| acc + cmp::max(param.nb_lcore_k, 1));
+        .fold(0, |acc, param| acc + cmp::max(param.nb_lcore_k, param.nb_queues));
 
     // Invoke rte KNI init to preallocate the ports
     kni::init(num_of_kni_ports as usize)
 }
 
 // Initialise a single port on an Ethernet device
-fn init_port(conf: &Conf, dev: ethdev::PortId, port_conf: &ethdev::EthConf, pktmbuf_pool: &mut mempool::MemoryPool) {
+// The number of RX/TX queue pairs and the configuration of a port
+fn port_conf(conf: &Conf, dev: ethdev::PortId) -> (u16, ethdev::EthConf) {
+    let portid = dev.portid();
+    let nb_queues = conf.port_params[portid as usize]
+        .as_ref()
+        .map_or(1, |param| param.nb_queues as u16);
+    let info = dev.info();
+
+    if nb_queues > info.max_rx_queues || nb_queues > info.max_tx_queues {
+        eal::exit(
+            EXIT_FAILURE,
+            &format!(
+                "port {} supports at most {} RX and {} TX queues\n",
+                portid, info.max_rx_queues, info.max_tx_queues
+            ),
+        );
+    }
+
+    // spread the packets to the RX queues with RSS
+    let mut port_conf = if nb_queues > 1 {
+        ethdev::EthConf {
+            rx_adv_conf: Some(ethdev::RxAdvConf {
+                rss_conf: Some(ethdev::EthRssConf {
+                    key: None,
+                    hash: ethdev::RssHashFunc::ETH_RSS_IP
+                        & ethdev::RssHashFunc::from_bits_truncate(info.flow_type_rss_offloads),
+                }),
+                ..ethdev::RxAdvConf::default()
+            }),
+            ..ethdev::EthConf::default()
+        }
+    } else {
+        ethdev::EthConf::default()
+    };
+
+    // the GSO segments keep the headers of the original packet, so the NIC computes their checksums
+    if conf.gso {
+        let offloads = (rte::ffi::DEV_TX_OFFLOAD_IPV4_CKSUM | ffi::DEV_TX_OFFLOAD_TCP_CKSUM) as u64;
+
+        if (info.tx_offload_capa & offloads) != offloads {
+            eal::exit(
+                EXIT_FAILURE,
+                &format!("port {} doesn't support the TX checksum offload for GSO\n", portid),
+            );
+        }
+
+        port_conf.txmode = Some(ethdev::EthTxMode {
+            offloads,
+            ..ethdev::EthTxMode::default()
+        });
+    }
+
+    (nb_queues, port_conf)
+}
+
+// Setup one RX and TX queue for each pair of RX and TX lcores
+fn setup_queues(dev: ethdev::PortId, nb_queues: u16, pktmbuf_pool: &mut mempool::MemoryPool) -> Result<()> {
+    for queue_id in 0..nb_queues {
+        dev.rx_queue_setup(queue_id, NB_RXD, None, pktmbuf_pool)?;
+        dev.tx_queue_setup(queue_id, NB_TXD, None)?;
+    }
+
+    Ok(())
+}
+
+fn init_port(conf: &Conf, dev: ethdev::PortId, pktmbuf_pool: &mut mempool::MemoryPool) {
     let portid = dev.portid();
+    let (nb_queues, port_conf) = port_conf(conf, dev);
 
     // Initialise device and RX/TX queues
-    info!("Initialising port {} ...", portid);
+    info!("Initialising port {} with {} queues ...", portid, nb_queues);
 
-    dev.configure(1, 1, &port_conf)
+    dev.configure(nb_queues, nb_queues, &port_conf)
         .expect(&format!("fail to configure device: port={}", portid));
 
-    // init one RX queue
-    dev.rx_queue_setup(0, NB_RXD, None, pktmbuf_pool)
-        .expect(&format!("fail to setup device rx queue: port={}", portid));
-
-    // init one TX queue on each port
-    dev.tx_queue_setup(0, NB_TXD, None)
-        .expect(&format!("fail to setup device tx queue: port={}", portid));
+    setup_queues(dev, nb_queues, pktmbuf_pool).expect(&format!("fail to setup device queues: port={}", portid));
 
     // Start device
     dev.start().expect(&format!("fail to start device: port={}", portid));
@@ -322,21 +476,31 @@ extern "C" fn kni_change_mtu(port_id: u16, new_mtu: libc::c_uint) -> libc::c_int
         return -libc::EINVAL;
     }
 
+    let conf = match unsafe { KNI_CONF.as_ref() } {
+        Some(conf) => conf,
+        None => return -libc::EINVAL,
+    };
+
     if new_mtu > ETHER_MAX_LEN {
         let dev = port_id as ethdev::PortId;
 
         dev.stop();
 
-        // Set new MTU
-        let mut port_conf = ethdev::EthConf::default();
-
-        let mut rxmode: ethdev::EthRxMode = Default::default();
+        // Set new MTU, and keep the queues, RSS and TX offloads of the port
+        let (nb_queues, mut port_conf) = port_conf(conf, dev);
+        let mut rxmode = port_conf.rxmode.unwrap_or_default();
 
         rxmode.max_rx_pkt_len = new_mtu + KNI_ENET_HEADER_SIZE + KNI_ENET_FCS_SIZE;
 
         port_conf.rxmode = Some(rxmode);
 
-        if let Err(err) = dev.configure(1, 1, &port_conf) {
+        let res = dev.configure(nb_queues, nb_queues, &port_conf).and_then(|_| {
+            let mut pktmbuf_pool = mempool::MemoryPool::lookup("mbuf_pool")?;
+
+            setup_queues(dev, nb_queues, &mut pktmbuf_pool)
+        });
+
+        if let Err(err) = res {
             error!("Fail to reconfigure port {}, {}", port_id, err);
 
             if let Some(&RteError(errno)) = err.downcast_ref::<RteError>() {
@@ -412,10 +576,11 @@ fn kni_alloc(conf: &mut Conf, dev: ethdev::PortId, pktmbuf_pool: &mut mempool::M
     let portid = dev.portid();
 
     if let Some(ref mut param) = conf.port_params[portid as usize] {
-        param.nb_kni = cmp::max(param.nb_lcore_k, 1);
+        // one KNI device for each kernel thread, and at least one for each queue
+        param.nb_kni = cmp::max(param.nb_lcore_k, param.nb_queues);
 
         for i in 0..param.nb_kni {
-            let name = if param.nb_lcore_k > 0 {
+            let name = if param.nb_kni > 1 || param.nb_lcore_k > 0 {
                 format!("vEth{}_{}", portid, i)
             } else {
                 format!("vEth{}", portid)
@@ -472,6 +637,67 @@ fn kni_free_kni(conf: &Conf, dev: ethdev::PortId) {
     }
 }
 
+// The name of virtio_user device of a port
+fn virtio_user_name(dev: ethdev::PortId) -> String {
+    format!("virtio_user{}", dev)
+}
+
+// Create a virtio_user port as the exception path of a port, with a queue pair for each queue
+fn virtio_user_alloc(conf: &mut Conf, dev: ethdev::PortId, pktmbuf_pool: &mut mempool::MemoryPool) {
+    let portid = dev.portid();
+
+    if let Some(ref mut param) = conf.port_params[portid as usize] {
+        let nb_queues = param.nb_queues as u16;
+        let name = virtio_user_name(portid);
+        let iface = format!("vEth{}", portid);
+
+        let port = virtio_user::create(
+            &name,
+            &virtio_user::VirtioUserConf {
+                iface: &iface,
+                queues: nb_queues,
+                queue_size: NB_TXD,
+                mac: Some(dev.mac_addr()),
+                ..virtio_user::VirtioUserConf::default()
+            },
+        )
+        .expect(&format!("Fail to create virtio_user for port: {}", portid));
+
+        port.configure(nb_queues, nb_queues, &ethdev::EthConf::default())
+            .expect(&format!("fail to configure virtio_user: port={}", port));
+
+        for queue_id in 0..nb_queues {
+            port.rx_queue_setup(queue_id, NB_RXD, None, pktmbuf_pool)
+                .expect(&format!(
+                    "fail to setup virtio_user rx queue: port={}, queue={}",
+                    port, queue_id
+                ));
+
+            port.tx_queue_setup(queue_id, NB_TXD, None).expect(&format!(
+                "fail to setup virtio_user tx queue: port={}, queue={}",
+                port, queue_id
+            ));
+        }
+
+        port.start()
+            .expect(&format!("fail to start virtio_user: port={}", port));
+
+        param.virtio_user_port = port;
+
+        debug!("created virtio_user `{}` as port #{} for port #{}", iface, port, portid);
+    }
+}
+
+fn virtio_user_free(conf: &Conf, dev: ethdev::PortId) {
+    if let Some(ref param) = conf.port_params[dev as usize] {
+        if let Err(err) = virtio_user::destroy(&virtio_user_name(dev), param.virtio_user_port) {
+            warn!("fail to remove virtio_user of port {}, {}", dev, err);
+        }
+
+        dev.stop();
+    }
+}
+
 // Check the link status of all ports in up to 9s, and print them finally
 fn check_all_ports_link_status(enabled_devices: &Vec<ethdev::PortId>) {
     print!("Checking link status");
@@ -480,7 +706,7 @@ fn check_all_ports_link_status(enabled_devices: &Vec<ethdev::PortId>) {
     const MAX_CHECK_TIME: usize = 90;
 
     for _ in 0..MAX_CHECK_TIME {
-        if unsafe { kni_stop != 0 } {
+        if KNI_STOP.load(Ordering::Relaxed) {
             break;
         }
 
@@ -513,69 +739,321 @@ fn check_all_ports_link_status(enabled_devices: &Vec<ethdev::PortId>) {
     }
 }
 
-#[repr(C)]
-struct Struct_kni_interface_stats {
+// Structure type for recording kni interface specific stats
+#[derive(Default)]
+struct KniInterfaceStats {
     // number of pkts received from NIC, and sent to KNI
-    rx_packets: libc::uint64_t,
+    rx_packets: Counter,
 
     // number of pkts received from NIC, but failed to send to KNI
-    rx_dropped: libc::uint64_t,
+    rx_dropped: Counter,
 
     // number of pkts received from KNI, and sent to NIC
-    tx_packets: libc::uint64_t,
+    tx_packets: Counter,
 
     // number of pkts received from KNI, but failed to send to NIC
-    tx_dropped: libc::uint64_t,
+    tx_dropped: Counter,
+}
+
+impl KniInterfaceStats {
+    fn reset(&self) {
+        self.rx_packets.reset();
+        self.rx_dropped.reset();
+        self.tx_packets.reset();
+        self.tx_dropped.reset();
+    }
+}
+
+// The stats of all the ports, updated by a lcore
+type LcoreStats = [KniInterfaceStats; MAX_PORTS];
+
+// Print out statistics on packets handled
+fn kni_print_stats(conf: &Conf) {
+    println!(
+        "\n**KNI example application statistics**\n\
+         ======  ==============  ============  ============  ============  ============\n \
+         Port    Lcore(RX/TX)    rx_packets    rx_dropped    tx_packets    tx_dropped\n\
+         ------  --------------  ------------  ------------  ------------  ------------"
+    );
+
+    for (portid, param) in conf.port_params.iter().enumerate() {
+        if let Some(ref param) = *param {
+            let nb_queues = param.nb_queues as usize;
+            let lcores = |lcores: &[libc::c_uint]| lcores.iter().map(|id| id.to_string()).collect::<Vec<_>>().join(":");
+
+            println!(
+                "{:>7} {:>10}/{:>2} {:>13} {:>13} {:>13} {:>13}",
+                portid,
+                lcores(&param.lcore_rx[..nb_queues]),
+                lcores(&param.lcore_tx[..nb_queues]),
+                conf.stats.sum(|stats| stats[portid].rx_packets.get()),
+                conf.stats.sum(|stats| stats[portid].rx_dropped.get()),
+                conf.stats.sum(|stats| stats[portid].tx_packets.get()),
+                conf.stats.sum(|stats| stats[portid].tx_dropped.get()),
+            );
+        }
+    }
+
+    println!("======  ==============  ============  ============  ============  ============");
 }
 
-#[link(name = "kni_core")]
-extern "C" {
-    static mut kni_stop: libc::c_int;
+// The KNI devices served by a queue
+fn kni_of_queue(param: &kni_port_params, queue_id: QueueId) -> impl Iterator<Item = &kni::RawKniDevicePtr> {
+    param.kni[..param.nb_kni as usize]
+        .iter()
+        .skip(queue_id as usize)
+        .step_by(param.nb_queues as usize)
+}
+
+// Run a lcore loop with the KNI devices served by a queue, which are released by `kni_free_kni`
+fn with_kni_of_queue<F: FnOnce(&[kni::KniDevice]) -> i32>(param: &kni_port_params, queue_id: QueueId, f: F) -> i32 {
+    let knis = kni_of_queue(param, queue_id)
+        .map(|&kni| kni::KniDevice::from_raw(kni))
+        .collect::<Vec<_>>();
+
+    let ret = f(&knis);
+
+    for kni in knis {
+        kni.into_raw();
+    }
+
+    ret
+}
+
+// Burst rx from an eth queue and enqueue mbufs into the KNI rx_q
+fn kni_ingress<E: ExceptionPath>(
+    conf: &Conf,
+    param: &kni_port_params,
+    queue_id: QueueId,
+    exceptions: &[E],
+    stats: &LcoreStats,
+) -> i32 {
+    let port_id = param.port_id as PortId;
+    let stats = &stats[port_id as usize];
+    let mut pkts = MBufBatch::<PKT_BURST_SZ>::new();
+    // pause between the polls when idle
+    let mut idle = IdleBackoff::new(IdlePolicy::default());
+    // one GRO context for each exception path, which receives the coalesced packets of its flows
+    let gro_param = gro::GroParam {
+        max_flow_num: GRO_MAX_FLOW_NUM,
+        max_item_per_flow: GRO_MAX_ITEM_PER_FLOW,
+        ..gro::GroParam::default()
+    };
+    let mut gros = exceptions
+        .iter()
+        .map(|_| {
+            if conf.gro {
+                Some(gro::GroContext::create(&gro_param).expect("fail to create GRO context"))
+            } else {
+                None
+            }
+        })
+        .collect::<Vec<_>>();
+    let gro_timeout = GRO_FLUSH_TIMEOUT_US * get_tsc_hz() / 1_000_000;
+
+    while !KNI_STOP.load(Ordering::Relaxed) {
+        let mut nb_rx_total = 0;
+
+        for (kni, gro) in exceptions.iter().zip(gros.iter_mut()) {
+            // Burst rx from eth
+            let nb_rx = port_id.rx_burst(queue_id, &mut pkts);
+
+            nb_rx_total += nb_rx;
+
+            // Coalesce the TCP segments, and flush the packets held long enough
+            if let Some(ref mut gro) = *gro {
+                for m in pkts.iter_mut() {
+                    m.parse_packet_type();
+                }
+
+                gro.reassemble(&mut pkts);
+                gro.timeout_flush(gro_timeout, &mut pkts);
+
+                // keep polling until the held packets are flushed
+                nb_rx_total += gro.pkt_count();
+            }
+
+            // Burst tx to kni
+            let num = kni.tx_burst(&mut pkts);
+
+            stats.rx_packets.add(num as u64);
+
+            let _ = kni.handle_requests();
+
+            if !pkts.is_empty() {
+                // Free mbufs not tx to kni interface
+                stats.rx_dropped.add(pkts.len() as u64);
+
+                pkts.clear();
+            }
+        }
+
+        idle.poll(nb_rx_total);
+    }
+
+    0
+}
+
+// Request the segmentation of a TCP packet larger than the GSO segment,
+// and the checksum offload of its segments.
+fn kni_prepare_gso(gso: &gso::GsoContext, m: &mut MBuf) {
+    if m.pkt_len() <= gso.gso_size() {
+        return;
+    }
+
+    let ptype = m.parse_packet_type();
+
+    if ptype.is_ipv4() && ptype.is_tcp() && !ptype.is_tunnel() {
+        let (l2_len, l3_len) = (m.l2_len(), m.l3_len());
+
+        m.set_tx_cksum(l2_len, l3_len, true, mbuf::L4Cksum::Tcp);
+
+        let flags = m.offload() | mbuf::OffloadFlags::PKT_TX_TCP_SEG;
+
+        m.set_offload(flags);
+    }
+}
+
+// Burst tx to an eth queue, and free the mbufs not sent
+fn kni_tx_burst<const N: usize>(
+    port_id: PortId,
+    queue_id: QueueId,
+    pkts: &mut MBufBatch<N>,
+    stats: &KniInterfaceStats,
+) {
+    let nb_tx = port_id.tx_burst(queue_id, pkts);
+
+    stats.tx_packets.add(nb_tx as u64);
+
+    if !pkts.is_empty() {
+        // Free mbufs not tx to NIC
+        stats.tx_dropped.add(pkts.len() as u64);
+
+        pkts.clear();
+    }
+}
+
+// Dequeue mbufs from the KNI tx_q and burst tx to an eth queue
+fn kni_egress<E: ExceptionPath>(
+    conf: &Conf,
+    param: &kni_port_params,
+    queue_id: QueueId,
+    exceptions: &[E],
+    stats: &LcoreStats,
+) -> i32 {
+    let port_id = param.port_id as PortId;
+    let stats = &stats[port_id as usize];
+    let mut pkts = MBufBatch::<PKT_BURST_SZ>::new();
+    let mut segs = MBufBatch::<GSO_BURST_SZ>::new();
+    // pause between the polls when idle
+    let mut idle = IdleBackoff::new(IdlePolicy::default());
+    let gso = if conf.gso {
+        Some(gso::GsoContext::new(
+            &mempool::MemoryPool::from(conf.gso_direct_pool),
+            &mempool::MemoryPool::from(conf.gso_indirect_pool),
+            gso::GsoTypes::TCP_TSO,
+            GSO_SEG_SZ,
+        ))
+    } else {
+        None
+    };
+
+    while !KNI_STOP.load(Ordering::Relaxed) {
+        let mut nb_rx_total = 0;
+
+        for kni in exceptions {
+            // Burst rx from kni
+            let num = kni.rx_burst(&mut pkts);
 
-    static mut kni_port_params_array: *const *mut kni_port_params;
+            nb_rx_total += num;
 
-    static mut kni_stats: [Struct_kni_interface_stats; RTE_MAX_ETHPORTS as usize];
+            if let Some(ref gso) = gso {
+                // Segment the large TCP packets
+                for mut m in pkts.drain() {
+                    kni_prepare_gso(gso, &mut m);
 
-    fn kni_print_stats();
+                    if gso.segment(m, &mut segs).is_err() {
+                        stats.tx_dropped.incr();
+                    }
+                }
 
-    fn kni_ingress(param: *const kni_port_params) -> libc::c_int;
+                // Set the pseudo-header checksums of segments, and drop the invalid ones
+                let nb_prep = port_id.tx_prepare(queue_id, &mut segs);
+
+                if nb_prep < segs.len() {
+                    stats.tx_dropped.add((segs.len() - nb_prep) as u64);
+
+                    segs.truncate(nb_prep);
+                }
+
+                kni_tx_burst(port_id, queue_id, &mut segs, stats);
+            } else {
+                // Burst tx to eth
+                kni_tx_burst(port_id, queue_id, &mut pkts, stats);
+            }
+        }
 
-    fn kni_egress(param: *const kni_port_params) -> libc::c_int;
+        idle.poll(nb_rx_total);
+    }
+
+    0
 }
 
 fn main_loop(conf: Option<&Conf>) -> i32 {
     enum LcoreType<'a> {
-        Rx(&'a kni_port_params),
-        Tx(&'a kni_port_params),
+        Rx(&'a kni_port_params, QueueId),
+        Tx(&'a kni_port_params, QueueId),
     };
 
+    let conf = conf.unwrap();
     let lcore_id = lcore::current().unwrap();
+    let stats = conf.stats.get(lcore_id);
     let mut lcore_type: Option<LcoreType> = None;
 
-    for portid in ethdev::devices() {
-        if let Some(ref param) = conf.unwrap().port_params[portid as usize] {
-            if lcore_id == param.lcore_rx {
-                lcore_type = Some(LcoreType::Rx(param));
-                break;
-            }
-
-            if lcore_id == param.lcore_tx {
-                lcore_type = Some(LcoreType::Tx(param));
-                break;
+    'ports: for portid in ethdev::devices() {
+        if let Some(ref param) = conf.port_params[portid as usize] {
+            for queue_id in 0..param.nb_queues as usize {
+                if lcore_id == param.lcore_rx[queue_id] {
+                    lcore_type = Some(LcoreType::Rx(param, queue_id as QueueId));
+                    break 'ports;
+                }
+
+                if lcore_id == param.lcore_tx[queue_id] {
+                    lcore_type = Some(LcoreType::Tx(param, queue_id as QueueId));
+                    break 'ports;
+                }
             }
         }
     }
 
     match lcore_type {
-        Some(LcoreType::Rx(param)) => {
-            info!("Lcore {} is reading from port {}", param.lcore_rx, param.port_id);
+        Some(LcoreType::Rx(param, queue_id)) => {
+            info!(
+                "Lcore {} is reading from port {} queue {}",
+                lcore_id, param.port_id, queue_id
+            );
 
-            unsafe { kni_ingress(param) }
+            if conf.virtio_user {
+                let virtio_user = virtio_user::VirtioUser::new(param.virtio_user_port, queue_id);
+
+                kni_ingress(conf, param, queue_id, &[virtio_user], stats)
+            } else {
+                with_kni_of_queue(param, queue_id, |knis| kni_ingress(conf, param, queue_id, knis, stats))
+            }
         }
-        Some(LcoreType::Tx(param)) => {
-            info!("Lcore {} is writing from port {}", param.lcore_tx, param.port_id);
+        Some(LcoreType::Tx(param, queue_id)) => {
+            info!(
+                "Lcore {} is writing to port {} queue {}",
+                lcore_id, param.port_id, queue_id
+            );
+
+            if conf.virtio_user {
+                let virtio_user = virtio_user::VirtioUser::new(param.virtio_user_port, queue_id);
 
-            unsafe { kni_egress(param) }
+                kni_egress(conf, param, queue_id, &[virtio_user], stats)
+            } else {
+                with_kni_of_queue(param, queue_id, |knis| kni_egress(conf, param, queue_id, knis, stats))
+            }
         }
         _ => {
             info!("Lcore {} has nothing to do", lcore_id);
@@ -602,10 +1080,6 @@ fn main() {
     // Parse application arguments (after the EAL ones)
     let mut conf = parse_args(&opt_args).expect("Could not parse input parameters");
 
-    unsafe {
-        kni_port_params_array = conf.port_params.as_ptr() as *const _;
-    }
-
     // create the mbuf pool
     let mut pktmbuf_pool = mbuf::pool_create(
         "mbuf_pool",
@@ -617,6 +1091,22 @@ fn main() {
     )
     .expect("fail to initial mbuf pool");
 
+    // the GSO segments are direct mbufs of the headers, chained to the indirect mbufs of the payload
+    if conf.gso {
+        let pool = mbuf::pool_create(
+            "gso_indirect_pool",
+            NB_MBUF,
+            MEMPOOL_CACHE_SZ,
+            0,
+            0,
+            rte::socket_id() as i32,
+        )
+        .expect("fail to initial GSO indirect mbuf pool");
+
+        conf.gso_direct_pool = pktmbuf_pool.as_raw();
+        conf.gso_indirect_pool = pool.as_raw();
+    }
+
     let enabled_devices: Vec<ethdev::PortId> = ethdev::devices()
         .filter(|dev| ((1 << dev.portid()) & conf.enabled_port_mask) != 0)
         .collect();
@@ -626,28 +1116,46 @@ fn main() {
     }
 
     // Initialize KNI subsystem
-    init_kni(&conf).expect("initial KNI");
+    if !conf.virtio_user {
+        init_kni(&conf).expect("initial KNI");
+    }
 
     // Initialise each port
-    let port_conf = ethdev::EthConf::default();
-
     for dev in &enabled_devices {
-        init_port(&conf, dev.portid(), &port_conf, &mut pktmbuf_pool);
+        init_port(&conf, dev.portid(), &mut pktmbuf_pool);
 
-        kni_alloc(&mut conf, dev.portid(), &mut pktmbuf_pool);
+        if conf.virtio_user {
+            virtio_user_alloc(&mut conf, dev.portid(), &mut pktmbuf_pool);
+        } else {
+            kni_alloc(&mut conf, dev.portid(), &mut pktmbuf_pool);
+        }
     }
 
     check_all_ports_link_status(&enabled_devices);
 
+    unsafe {
+        KNI_CONF = &conf;
+    }
+
     // launch per-lcore init on every lcore
     launch::mp_remote_launch(main_loop, Some(&conf), false).unwrap();
 
     launch::mp_wait_lcore();
 
-    // Release resources
-    for dev in &enabled_devices {
-        kni_free_kni(&conf, dev.portid());
+    unsafe {
+        KNI_CONF = ptr::null();
     }
 
-    kni::close();
+    // Release resources
+    if conf.virtio_user {
+        for dev in &enabled_devices {
+            virtio_user_free(&conf, dev.portid());
+        }
+    } else {
+        for dev in &enabled_devices {
+            kni_free_kni(&conf, dev.portid());
+        }
+
+        kni::close();
+    }
 }
@@ -0,0 +1,359 @@
+//! The L2 forwarding data plane.
+//!
+//! Each lcore polls its RX ports, rewrites the MAC addresses of a whole burst at once,
+//! and buffers the packets to the TX queue of the destination port.
+//!
+use std::cmp;
+use std::sync::atomic::{AtomicBool, Ordering};
+
+#[cfg(target_arch = "x86")]
+use std::arch::x86::*;
+#[cfg(target_arch = "x86_64")]
+use std::arch::x86_64::*;
+
+use rte::ethdev::{EthDevice, RawTxBufferPtr, TxFlush, TxFlushPolicy};
+use rte::ffi::RTE_MAX_ETHPORTS;
+use rte::idle::{IdleBackoff, IdlePolicy};
+use rte::mbuf::{MBuf, MBufBatch};
+use rte::metrics::LatencyTracker;
+use rte::prefetch::prefetch0;
+use rte::stats::{Counter, PerLcore};
+use rte::*;
+
+pub const MAX_PKT_BURST: usize = 32;
+
+pub const MAX_PORTS: usize = RTE_MAX_ETHPORTS as usize;
+
+// Prefetch the packet data N+3 ahead of the one being rewritten
+const PREFETCH_OFFSET: usize = 3;
+
+// The number of packets rewritten per iteration
+const REWRITE_BATCH: usize = 4;
+
+pub static FORCE_QUIT: AtomicBool = AtomicBool::new(false);
+
+/// Per-port statistics struct
+#[derive(Default)]
+pub struct PortStatistics {
+    pub tx: Counter,
+    pub rx: Counter,
+    pub dropped: Counter,
+}
+
+/// The statistics of all the ports, updated by a lcore.
+pub type LcoreStatistics = [PortStatistics; MAX_PORTS];
+
+pub struct L2fwd {
+    /// mask of enabled ports
+    pub enabled_port_mask: u32,
+    /// ethernet addresses of ports
+    pub ports_eth_addr: [ether::EtherAddr; MAX_PORTS],
+    /// the destination port of each port
+    pub dst_ports: [PortId; MAX_PORTS],
+    pub tx_buffers: [RawTxBufferPtr; MAX_PORTS],
+    pub stats: PerLcore<LcoreStatistics>,
+    /// the statistics refresh period in TSC cycles, 0 to disable
+    pub timer_period: u64,
+    /// when to flush the TX buffers before they are full
+    pub tx_flush: TxFlushPolicy,
+    /// back off and sleep on RX interrupts when idle
+    pub idle: bool,
+    /// the RX to TX latency of ports, if it is tracked
+    pub latency: [Option<&'static LatencyTracker>; MAX_PORTS],
+}
+
+/// Rewrite the Ethernet addresses of packets forwarding to the same destination port.
+///
+/// The destination address is set to 02:00:00:00:00:xx, where xx is the destination port,
+/// and the source address to the address of destination port.
+#[derive(Clone, Copy)]
+pub struct MacRewrite {
+    // d_addr and s_addr, followed by 4 bytes kept from the packet
+    addrs: [u8; 16],
+}
+
+impl MacRewrite {
+    pub fn new(dst_port: PortId, eth_addr: &ether::EtherAddr) -> Self {
+        let mut addrs = [0; 16];
+
+        addrs[0] = 0x02;
+        addrs[5] = dst_port as u8;
+        addrs[6..12].copy_from_slice(eth_addr.octets());
+
+        MacRewrite { addrs }
+    }
+
+    /// Rewrite the Ethernet header of a packet.
+    ///
+    /// It loads and stores the first 16 bytes of packet data, which always fit in the mbuf data room.
+    #[inline(always)]
+    pub fn apply(&self, m: &MBuf) {
+        #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+        unsafe {
+            let (addrs, mask) = self.vectors();
+            let p = m.mtod::<__m128i>().as_ptr();
+
+            _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(p), mask), addrs));
+        }
+
+        #[cfg(not(any(target_arch = "x86", target_arch = "x86_64")))]
+        unsafe {
+            ::std::ptr::copy_nonoverlapping(self.addrs.as_ptr(), m.mtod::<u8>().as_ptr(), 12);
+        }
+    }
+
+    /// Rewrite the Ethernet headers of 4 packets, the loads are issued before any store.
+    #[inline(always)]
+    pub fn apply_x4(&self, pkts: &[MBuf]) {
+        debug_assert_eq!(pkts.len(), REWRITE_BATCH);
+
+        #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+        unsafe {
+            let (addrs, mask) = self.vectors();
+
+            let p0 = pkts[0].mtod::<__m128i>().as_ptr();
+            let p1 = pkts[1].mtod::<__m128i>().as_ptr();
+            let p2 = pkts[2].mtod::<__m128i>().as_ptr();
+            let p3 = pkts[3].mtod::<__m128i>().as_ptr();
+
+            let h0 = _mm_loadu_si128(p0);
+            let h1 = _mm_loadu_si128(p1);
+            let h2 = _mm_loadu_si128(p2);
+            let h3 = _mm_loadu_si128(p3);
+
+            _mm_storeu_si128(p0, _mm_or_si128(_mm_and_si128(h0, mask), addrs));
+            _mm_storeu_si128(p1, _mm_or_si128(_mm_and_si128(h1, mask), addrs));
+            _mm_storeu_si128(p2, _mm_or_si128(_mm_and_si128(h2, mask), addrs));
+            _mm_storeu_si128(p3, _mm_or_si128(_mm_and_si128(h3, mask), addrs));
+        }
+
+        #[cfg(not(any(target_arch = "x86", target_arch = "x86_64")))]
+        {
+            for m in pkts {
+                self.apply(m)
+            }
+        }
+    }
+
+    #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+    #[inline(always)]
+    unsafe fn vectors(&self) -> (__m128i, __m128i) {
+        (
+            _mm_loadu_si128(self.addrs.as_ptr() as *const __m128i),
+            _mm_set_epi32(-1, 0, 0, 0),
+        )
+    }
+}
+
+/// Print out statistics on packets dropped
+pub fn print_stats(fwd: &L2fwd) {
+    let mut total_packets_dropped = 0;
+    let mut total_packets_tx = 0;
+    let mut total_packets_rx = 0;
+
+    // Clear screen and move to top left
+    print!("\x1b[2J\x1b[1;1H");
+
+    print!("\nPort statistics ====================================");
+
+    for portid in 0..MAX_PORTS {
+        // skip disabled ports
+        if (fwd.enabled_port_mask & (1 << portid)) == 0 {
+            continue;
+        }
+
+        let tx = fwd.stats.sum(|stats| stats[portid].tx.get());
+        let rx = fwd.stats.sum(|stats| stats[portid].rx.get());
+        let dropped = fwd.stats.sum(|stats| stats[portid].dropped.get());
+
+        print!(
+            "\nStatistics for port {} ------------------------------\
+             \nPackets sent: {:>24}\
+             \nPackets received: {:>20}\
+             \nPackets dropped: {:>21}",
+            portid, tx, rx, dropped
+        );
+
+        if let Some(tracker) = fwd.latency[portid] {
+            let ns = |q| tracker.quantile_ns(q).map_or("-".to_owned(), |ns| ns.to_string());
+
+            print!(
+                "\nLatency p50 (ns): {:>20}\
+                 \nLatency p99 (ns): {:>20}",
+                ns(0.5),
+                ns(0.99)
+            );
+        }
+
+        total_packets_dropped += dropped;
+        total_packets_tx += tx;
+        total_packets_rx += rx;
+    }
+
+    println!(
+        "\nAggregate statistics ===============================\
+         \nTotal packets sent: {:>18}\
+         \nTotal packets received: {:>14}\
+         \nTotal packets dropped: {:>15}\
+         \n====================================================",
+        total_packets_tx, total_packets_rx, total_packets_dropped
+    );
+
+    for lcore in profile::report() {
+        if let Some(lcore_id) = lcore.lcore_id {
+            println!(
+                "Lcore {}: busy {:.1}% of {} cycles",
+                lcore_id,
+                lcore.load.busy_ratio() * 100.0,
+                lcore.load.busy_cycles + lcore.load.idle_cycles
+            );
+        }
+
+        for span in &lcore.spans {
+            println!(
+                "  {:<8} {:>12} packets {:>8.1} cycles/packet (p50 {}, p99 {})",
+                span.name,
+                span.packets,
+                span.cycles_per_packet(),
+                span.p50.unwrap_or(0),
+                span.p99.unwrap_or(0)
+            );
+        }
+    }
+}
+
+// Rewrite and buffer a burst of packets received from `portid`.
+#[inline(always)]
+fn forward_burst(
+    fwd: &L2fwd,
+    stats: &LcoreStatistics,
+    portid: PortId,
+    pkts: &mut MBufBatch<MAX_PKT_BURST>,
+    tx_flush: &mut TxFlush,
+) {
+    let dst_port = fwd.dst_ports[portid as usize];
+    let rewrite = MacRewrite::new(dst_port, &fwd.ports_eth_addr[dst_port as usize]);
+    let nb_rx = pkts.len();
+
+    for m in &pkts[..cmp::min(PREFETCH_OFFSET, nb_rx)] {
+        prefetch0(m.mtod::<u8>().as_ptr());
+    }
+
+    let mut i = 0;
+
+    while i + REWRITE_BATCH <= nb_rx {
+        for m in &pkts[cmp::min(i + PREFETCH_OFFSET, nb_rx)..cmp::min(i + REWRITE_BATCH + PREFETCH_OFFSET, nb_rx)] {
+            prefetch0(m.mtod::<u8>().as_ptr());
+        }
+
+        rewrite.apply_x4(&pkts[i..i + REWRITE_BATCH]);
+
+        i += REWRITE_BATCH;
+    }
+
+    for m in &pkts[i..] {
+        rewrite.apply(m);
+    }
+
+    let buffer = unsafe { &mut *fwd.tx_buffers[dst_port as usize] };
+    let mut sent = 0;
+
+    for m in pkts.drain() {
+        sent += tx_flush.tx_buffer(&dst_port, 0, buffer, m);
+    }
+
+    if sent > 0 {
+        stats[dst_port as usize].tx.add(sent as u64);
+    }
+}
+
+/// main processing loop
+pub fn main_loop(fwd: &L2fwd, rx_ports: &[PortId]) -> i32 {
+    let lcore_id = lcore::current().unwrap();
+    let stats = fwd.stats.get(lcore_id);
+    let mut tx_flushes = vec![TxFlush::new(fwd.tx_flush); rx_ports.len()];
+    let mut prev_tsc = rdtsc();
+    let mut timer_tsc = 0;
+    let mut pkts = MBufBatch::<MAX_PKT_BURST>::new();
+    let mut idle = if fwd.idle {
+        let mut idle = IdleBackoff::new(IdlePolicy::default());
+
+        for &portid in rx_ports {
+            if let Err(err) = idle.add_rx_queue(portid, 0) {
+                warn!(
+                    "lcore {} fail to register RX interrupt of port {}, {}",
+                    lcore_id, portid, err
+                );
+            }
+        }
+
+        Some(idle)
+    } else {
+        None
+    };
+
+    while !FORCE_QUIT.load(Ordering::Relaxed) {
+        let turn = profile_loop!();
+        let cur_tsc = rdtsc();
+        let mut nb_rx_total = 0;
+
+        // Read packet from RX queues
+        for (&portid, tx_flush) in rx_ports.iter().zip(tx_flushes.iter_mut()) {
+            let nb_rx = {
+                let mut span = profile!("rx");
+                let nb_rx = portid.rx_burst(0, &mut pkts);
+
+                span.set_packets(nb_rx as u64);
+
+                nb_rx
+            };
+
+            nb_rx_total += nb_rx;
+
+            if nb_rx > 0 {
+                let _span = profile!("forward", nb_rx);
+
+                stats[portid as usize].rx.add(nb_rx as u64);
+
+                forward_burst(fwd, stats, portid, &mut pkts, tx_flush);
+            }
+
+            // TX burst queue drain, on idle poll or when the latency budget is spent
+            let dst_port = fwd.dst_ports[portid as usize];
+            let buffer = unsafe { &mut *fwd.tx_buffers[dst_port as usize] };
+
+            let mut span = profile!("tx");
+            let sent = tx_flush.poll(&dst_port, 0, buffer, nb_rx == 0, cur_tsc);
+
+            span.set_packets(sent as u64);
+
+            if sent > 0 {
+                stats[dst_port as usize].tx.add(sent as u64);
+            }
+        }
+
+        // if timer is enabled, do this only on master core
+        if fwd.timer_period > 0 && lcore_id.is_master() {
+            // advance the timer
+            timer_tsc += cur_tsc - prev_tsc;
+
+            // if timer has reached its timeout
+            if timer_tsc >= fwd.timer_period {
+                print_stats(fwd);
+
+                // reset the timer
+                timer_tsc = 0;
+            }
+        }
+
+        prev_tsc = cur_tsc;
+
+        turn.done(nb_rx_total as u64);
+
+        if let Some(ref mut idle) = idle {
+            idle.poll(nb_rx_total);
+        }
+    }
+
+    0
+}
@@ -6,6 +6,8 @@ extern crate nix;
 extern crate pretty_env_logger;
 extern crate rte;
 
+mod forward;
+
 use std::clone::Clone;
 use std::env;
 use std::io;
@@ -14,18 +16,18 @@ use std::mem;
 use std::path::Path;
 use std::process;
 use std::str::FromStr;
+use std::sync::atomic::Ordering;
 
 use nix::sys::signal;
 
 use rte::ethdev::{EthDevice, EthDeviceInfo, TxBuffer};
-use rte::ffi::RTE_MAX_ETHPORTS;
 use rte::lcore::RTE_MAX_LCORE;
 use rte::memory::AsMutRef;
 use rte::*;
 
-const EXIT_FAILURE: i32 = -1;
+use forward::{L2fwd, FORCE_QUIT, MAX_PKT_BURST};
 
-const MAX_PKT_BURST: usize = 32;
+const EXIT_FAILURE: i32 = -1;
 
 const MAX_RX_QUEUE_PER_LCORE: u32 = 16;
 
@@ -33,6 +35,8 @@ const MAX_RX_QUEUE_PER_LCORE: u32 = 16;
 const TIMER_MILLISECOND: i64 = 2000000; /* around 1ms at 2 Ghz */
 const MAX_TIMER_PERIOD: u32 = 86400; /* 1 day max */
 
+const MAX_TX_LATENCY_US: u32 = 1_000_000; /* 1s max */
+
 const NB_MBUF: u32 = 2048;
 
 // Configurable number of RX/TX ring descriptors
@@ -42,7 +46,7 @@ const RTE_TEST_TX_DESC_DEFAULT: u16 = 512;
 
 struct LcoreQueueConf {
     n_rx_port: u32,
-    rx_port_list: [u32; MAX_RX_QUEUE_PER_LCORE as usize],
+    rx_port_list: [PortId; MAX_RX_QUEUE_PER_LCORE as usize],
 }
 
 struct Conf {
@@ -50,6 +54,8 @@ struct Conf {
     nb_txd: u16,
 
     queue_conf: [LcoreQueueConf; RTE_MAX_LCORE as usize],
+
+    fwd: L2fwd,
 }
 
 impl Default for Conf {
@@ -73,7 +79,7 @@ fn print_usage(program: &String, opts: getopts::Options) -> ! {
 }
 
 // Parse the argument given in the command line of the application
-fn parse_args(args: &Vec<String>) -> (u32, u32, u32) {
+fn parse_args(args: &Vec<String>) -> (u32, u32, u32, u32, bool, bool) {
     let mut opts = getopts::Options::new();
     let program = args[0].clone();
 
@@ -86,6 +92,15 @@ fn parse_args(args: &Vec<String>) -> (u32, u32, u32) {
          86400 maximum)",
         "PERIOD",
     );
+    opts.optopt(
+        "L",
+        "",
+        "buffered TX packets will be flushed within LATENCY microseconds, \
+         or on idle RX polls (100 default, 0 to flush on every poll)",
+        "LATENCY",
+    );
+    opts.optflag("I", "", "pause and sleep on RX interrupts when idle");
+    opts.optflag("S", "", "report the p50/p99 RX to TX latency of ports");
     opts.optflag("h", "help", "print this help menu");
 
     let matches = match opts.parse(&args[1..]) {
@@ -104,6 +119,7 @@ fn parse_args(args: &Vec<String>) -> (u32, u32, u32) {
     let mut enabled_port_mask: u32 = 0; // mask of enabled ports
     let mut rx_queue_per_lcore: u32 = 1;
     let mut timer_period_seconds: u32 = 10; // default period is 10 seconds
+    let mut tx_latency_us: u32 = 100; // default TX latency is 100us
 
     if let Some(arg) = matches.opt_str("p") {
         match u32::from_str_radix(arg.as_str(), 16) {
@@ -138,7 +154,28 @@ fn parse_args(args: &Vec<String>) -> (u32, u32, u32) {
         }
     }
 
-    (enabled_port_mask, rx_queue_per_lcore, timer_period_seconds)
+    if let Some(arg) = matches.opt_str("L") {
+        match u32::from_str(arg.as_str()) {
+            Ok(us) if us < MAX_TX_LATENCY_US => tx_latency_us = us,
+            _ => {
+                println!("invalid TX latency, {}", arg);
+
+                print_usage(&program, opts);
+            }
+        }
+    }
+
+    let idle = matches.opt_present("I");
+    let latency = matches.opt_present("S");
+
+    (
+        enabled_port_mask,
+        rx_queue_per_lcore,
+        timer_period_seconds,
+        tx_latency_us,
+        idle,
+        latency,
+    )
 }
 
 // Check the link status of all ports in up to 9s, and print them finally
@@ -149,7 +186,7 @@ fn check_all_ports_link_status(enabled_devices: &Vec<ethdev::PortId>) {
     const MAX_CHECK_TIME: usize = 90;
 
     for _ in 0..MAX_CHECK_TIME {
-        if unsafe { l2fwd_force_quit != 0 } {
+        if FORCE_QUIT.load(Ordering::Relaxed) {
             break;
         }
 
@@ -182,26 +219,10 @@ fn check_all_ports_link_status(enabled_devices: &Vec<ethdev::PortId>) {
     }
 }
 
-#[link(name = "l2fwd_core")]
-extern "C" {
-    static mut l2fwd_force_quit: libc::c_int;
-
-    static mut l2fwd_enabled_port_mask: libc::uint32_t;
-
-    static mut l2fwd_ports_eth_addr: [[libc::uint8_t; 6usize]; RTE_MAX_ETHPORTS as usize];
-
-    static mut l2fwd_dst_ports: [libc::uint32_t; RTE_MAX_ETHPORTS as usize];
-
-    static mut l2fwd_tx_buffers: [*mut rte::ffi::rte_eth_dev_tx_buffer; RTE_MAX_ETHPORTS as usize];
-
-    static mut l2fwd_timer_period: libc::int64_t;
-
-    fn l2fwd_main_loop(rx_port_list: *const libc::uint32_t, n_rx_port: libc::c_uint) -> libc::c_int;
-}
-
 fn l2fwd_launch_one_lcore(conf: Option<&Conf>) -> i32 {
+    let conf = conf.unwrap();
     let lcore_id = lcore::current().unwrap();
-    let qconf = &conf.unwrap().queue_conf[*lcore_id as usize];
+    let qconf = &conf.queue_conf[*lcore_id as usize];
 
     if qconf.n_rx_port == 0 {
         info!("lcore {} has nothing to do", lcore_id);
@@ -215,16 +236,16 @@ fn l2fwd_launch_one_lcore(conf: Option<&Conf>) -> i32 {
         info!(" -- lcoreid={} portid={}", lcore_id, portid);
     }
 
-    unsafe { l2fwd_main_loop(qconf.rx_port_list.as_ptr(), qconf.n_rx_port) }
+    forward::main_loop(&conf.fwd, &qconf.rx_port_list[..qconf.n_rx_port as usize])
 }
 
 extern "C" fn handle_sigint(sig: libc::c_int) {
     match signal::Signal::from_c_int(sig).unwrap() {
-        signal::SIGINT | signal::SIGTERM => unsafe {
+        signal::SIGINT | signal::SIGTERM => {
             println!("Signal {} received, preparing to exit...", sig);
 
-            l2fwd_force_quit = 1;
-        },
+            FORCE_QUIT.store(true, Ordering::Relaxed);
+        }
         _ => info!("unexpect signo: {}", sig),
     }
 }
@@ -268,18 +289,22 @@ fn main() {
 
     debug!("eal args: {:?}, l2fwd args: {:?}", eal_args, opt_args);
 
-    let (enabled_port_mask, rx_queue_per_lcore, timer_period_seconds) = parse_args(&opt_args);
+    let (enabled_port_mask, rx_queue_per_lcore, timer_period_seconds, tx_latency_us, idle, latency) =
+        parse_args(&opt_args);
 
-    unsafe {
-        l2fwd_enabled_port_mask = enabled_port_mask;
-        l2fwd_timer_period = timer_period_seconds as i64 * TIMER_MILLISECOND * 1000;
-    }
+    let mut conf = Conf::default();
+
+    conf.fwd.enabled_port_mask = enabled_port_mask;
+    conf.fwd.timer_period = timer_period_seconds as u64 * TIMER_MILLISECOND as u64 * 1000;
 
     // init EAL
     eal::init(&eal_args).expect("fail to initial EAL");
 
+    conf.fwd.tx_flush = ethdev::TxFlushPolicy::with_latency_us(tx_latency_us as u64);
+    conf.fwd.idle = idle;
+
     // create the mbuf pool
-    let mut l2fwd_pktmbuf_pool = mbuf::pool_create(
+    let l2fwd_pktmbuf_pool = mbuf::pool_create(
         "mbuf_pool",
         NB_MBUF,
         32,
@@ -305,10 +330,8 @@ fn main() {
         let portid = dev.portid();
 
         if (nb_ports_in_mask % 2) != 0 {
-            unsafe {
-                l2fwd_dst_ports[portid as usize] = last_port as u32;
-                l2fwd_dst_ports[last_port as usize] = portid as u32;
-            }
+            conf.fwd.dst_ports[portid as usize] = last_port;
+            conf.fwd.dst_ports[last_port as usize] = portid;
         } else {
             last_port = portid;
         }
@@ -323,14 +346,11 @@ fn main() {
     if (nb_ports_in_mask % 2) != 0 {
         println!("Notice: odd number of ports in portmask.");
 
-        unsafe {
-            l2fwd_dst_ports[last_port as usize] = last_port as u32;
-        }
+        conf.fwd.dst_ports[last_port as usize] = last_port;
     }
 
-    let mut conf = Conf::default();
-
     let mut rx_lcore_id = lcore::id(0);
+    let mut rx_lcores = [rx_lcore_id; forward::MAX_PORTS];
 
     // Initialize the port/queue configuration of each logical core
     for dev in &enabled_devices {
@@ -349,54 +369,70 @@ fn main() {
         // Assigned a new logical core in the loop above.
         let qconf = &mut conf.queue_conf[*rx_lcore_id as usize];
 
-        qconf.rx_port_list[qconf.n_rx_port as usize] = portid as u32;
+        qconf.rx_port_list[qconf.n_rx_port as usize] = portid;
         qconf.n_rx_port += 1;
 
+        rx_lcores[portid as usize] = rx_lcore_id;
+
         println!("Lcore {}: RX port {}", rx_lcore_id, portid);
     }
 
-    let port_conf = ethdev::EthConf::default();
+    let mut port_conf = ethdev::EthConf::default();
 
-    // Initialise each port
-    for dev in &enabled_devices {
-        let portid = dev.portid() as usize;
+    if idle {
+        let mut intr_conf = ffi::rte_intr_conf::default();
 
-        // init port
-        print!("Initializing port {}... ", portid);
+        intr_conf.set_rxq(1);
 
-        dev.configure(1, 1, &port_conf)
-            .expect(&format!("fail to configure device: port={}", portid));
+        port_conf.intr_conf = Some(intr_conf);
+    }
 
-        let mac_addr = dev.mac_addr();
+    // Initialise and start all the ports with one RX and TX queue in parallel
+    println!("Initializing {} ports... ", enabled_devices.len());
+
+    ethdev::setup_ports(
+        &enabled_devices,
+        &ethdev::PortSetup {
+            nb_rx_queue: 1,
+            nb_tx_queue: 1,
+            conf: &port_conf,
+            nb_rx_desc: conf.nb_rxd,
+            nb_tx_desc: conf.nb_txd,
+            rx_conf: None,
+            tx_conf: None,
+            mb_pool: &l2fwd_pktmbuf_pool,
+            start: true,
+        },
+    )
+    .expect("fail to setup devices");
 
-        unsafe {
-            l2fwd_ports_eth_addr[portid] = *mac_addr.octets();
-        }
+    for dev in &enabled_devices {
+        let portid = dev.portid() as usize;
 
-        // init one RX queue
-        dev.rx_queue_setup(0, conf.nb_rxd, None, &mut l2fwd_pktmbuf_pool)
-            .expect(&format!("fail to setup device rx queue: port={}", portid));
+        let mac_addr = dev.mac_addr();
 
-        // init one TX queue on each port
-        dev.tx_queue_setup(0, conf.nb_txd, None)
-            .expect(&format!("fail to setup device tx queue: port={}", portid));
+        conf.fwd.ports_eth_addr[portid] = mac_addr;
 
         // Initialize TX buffers
         let buf = ethdev::alloc_buffer(MAX_PKT_BURST, dev.socket_id())
             .as_mut_ref()
             .expect(&format!("fail to allocate buffer for tx: port={}", portid));
 
-        buf.count_err_packets()
+        // the buffer is only flushed by the lcore polling the port forwarding to it
+        let tx_lcore_id = rx_lcores[conf.fwd.dst_ports[portid] as usize];
+
+        // the stats live in the configuration, which outlives the buffers
+        unsafe { buf.count_err_packets(conf.fwd.stats.get(tx_lcore_id)[portid].dropped.as_atomic()) }
             .expect(&format!("failt to set error callback for tx buffer: port={}", portid));
 
-        unsafe {
-            l2fwd_tx_buffers[portid] = buf;
-        }
+        conf.fwd.tx_buffers[portid] = buf;
 
-        // Start device
-        dev.start().expect(&format!("fail to start device: port={}", portid));
+        if latency {
+            let tracker = metrics::LatencyTracker::install(portid as ethdev::PortId, 1, 1)
+                .expect(&format!("fail to track latency: port={}", portid));
 
-        println!("Done: ");
+            conf.fwd.latency[portid] = Some(tracker);
+        }
 
         dev.promiscuous_enable();
 
@@ -423,7 +459,7 @@ fn main() {
         dev.close();
         println!(" Done");
 
-        if let Some(buf) = (unsafe { l2fwd_tx_buffers[dev.portid() as usize] }).as_mut_ref() {
+        if let Some(buf) = conf.fwd.tx_buffers[dev.portid() as usize].as_mut_ref() {
             buf.free();
         }
     }
@@ -0,0 +1,302 @@
+//! The L3 forwarding data plane.
+//!
+//! Each lcore polls its RX ports, routes a whole burst with the LPM tables,
+//! the IPv4 destinations are looked up four at once,
+//! then it decrements the TTL, rewrites the Ethernet addresses,
+//! and buffers the packets to its own TX queue of the destination port.
+//!
+use std::mem;
+use std::sync::atomic::{AtomicBool, Ordering};
+
+use rte::ethdev::{self, EthDevice, RawTxBufferPtr, TxBuffer, TxFlush, TxFlushPolicy};
+use rte::ether::{EtherHdr, EthernetView, ETHER_TYPE_IPV4_BE, ETHER_TYPE_IPV6_BE};
+use rte::ffi::RTE_MAX_ETHPORTS;
+use rte::ip::{self, Ipv4Hdr, Ipv4View, Ipv6Hdr, Ipv6View};
+use rte::lpm::{Lpm4, Lpm6, NextHop};
+use rte::mbuf::{MBuf, MBufBatch};
+use rte::memory::AsMutRef;
+use rte::prefetch::prefetch0;
+use rte::stats::{Counter, PerLcore};
+use rte::*;
+
+pub const MAX_PKT_BURST: usize = 32;
+
+pub const MAX_PORTS: usize = RTE_MAX_ETHPORTS as usize;
+
+/// The next hop of unroutable packets.
+pub const BAD_PORT: NextHop = 0xffff;
+
+// Prefetch the packet headers N+3 ahead of the one being classified
+const PREFETCH_OFFSET: usize = 3;
+
+pub static FORCE_QUIT: AtomicBool = AtomicBool::new(false);
+
+/// Per-port statistics struct
+#[derive(Default)]
+pub struct PortStatistics {
+    pub tx: Counter,
+    pub rx: Counter,
+    pub dropped: Counter,
+}
+
+/// The statistics of all the ports, updated by a lcore.
+pub type LcoreStatistics = [PortStatistics; MAX_PORTS];
+
+pub struct L3fwd {
+    /// mask of enabled ports
+    pub enabled_port_mask: u32,
+    /// ethernet addresses of ports
+    pub ports_eth_addr: [ether::EtherAddr; MAX_PORTS],
+    /// ethernet addresses of the next hop of ports
+    pub dest_eth_addr: [ether::EtherAddr; MAX_PORTS],
+    pub lpm4: Lpm4,
+    pub lpm6: Lpm6,
+    pub stats: PerLcore<LcoreStatistics>,
+    /// the statistics refresh period in TSC cycles, 0 to disable
+    pub timer_period: u64,
+    /// when to flush the TX buffers before they are full
+    pub tx_flush: TxFlushPolicy,
+}
+
+impl L3fwd {
+    fn is_enabled(&self, port: NextHop) -> bool {
+        port < 32 && (self.enabled_port_mask & (1 << port)) != 0
+    }
+}
+
+/// Print out statistics on packets dropped
+pub fn print_stats(fwd: &L3fwd) {
+    let mut total_packets_dropped = 0;
+    let mut total_packets_tx = 0;
+    let mut total_packets_rx = 0;
+
+    // Clear screen and move to top left
+    print!("\x1b[2J\x1b[1;1H");
+
+    print!("\nPort statistics ====================================");
+
+    for portid in 0..MAX_PORTS {
+        // skip disabled ports
+        if !fwd.is_enabled(portid as NextHop) {
+            continue;
+        }
+
+        let tx = fwd.stats.sum(|stats| stats[portid].tx.get());
+        let rx = fwd.stats.sum(|stats| stats[portid].rx.get());
+        let dropped = fwd.stats.sum(|stats| stats[portid].dropped.get());
+
+        print!(
+            "\nStatistics for port {} ------------------------------\
+             \nPackets sent: {:>24}\
+             \nPackets received: {:>20}\
+             \nPackets dropped: {:>21}",
+            portid, tx, rx, dropped
+        );
+
+        total_packets_dropped += dropped;
+        total_packets_tx += tx;
+        total_packets_rx += rx;
+    }
+
+    println!(
+        "\nAggregate statistics ===============================\
+         \nTotal packets sent: {:>18}\
+         \nTotal packets received: {:>14}\
+         \nTotal packets dropped: {:>15}\
+         \n====================================================",
+        total_packets_tx, total_packets_rx, total_packets_dropped
+    );
+}
+
+// Find the next hop of each packet in the burst.
+#[inline(always)]
+fn route_burst(fwd: &L3fwd, pkts: &[MBuf], hops: &mut [NextHop; MAX_PKT_BURST]) {
+    let mut dst4 = [0u32; MAX_PKT_BURST];
+    let mut idx4 = [0usize; MAX_PKT_BURST];
+    let mut nb_ipv4 = 0;
+
+    for m in &pkts[..PREFETCH_OFFSET.min(pkts.len())] {
+        prefetch0(m.mtod::<u8>().as_ptr());
+    }
+
+    for (i, m) in pkts.iter().enumerate() {
+        if let Some(m) = pkts.get(i + PREFETCH_OFFSET) {
+            prefetch0(m.mtod::<u8>().as_ptr());
+        }
+
+        hops[i] = BAD_PORT;
+
+        let eth = match EthernetView::parse(m) {
+            Some(eth) => eth,
+            None => continue,
+        };
+
+        match eth.ether_type {
+            ETHER_TYPE_IPV4_BE => {
+                // a sanity check of IPv4 header, as the RFC 1812 section 5.2.2 without the checksum,
+                // which is left to the NIC.
+                if let Some(hdr) = Ipv4View::parse(m, eth.payload_offset()) {
+                    dst4[nb_ipv4] = u32::from(hdr.dst());
+                    idx4[nb_ipv4] = i;
+                    nb_ipv4 += 1;
+                }
+            }
+            ETHER_TYPE_IPV6_BE => {
+                if let Some(hdr) = Ipv6View::parse(m, eth.payload_offset()) {
+                    hops[i] = fwd.lpm6.lookup(&hdr.dst_addr).unwrap_or(BAD_PORT);
+                }
+            }
+            _ => {}
+        }
+    }
+
+    let mut n = 0;
+
+    while n + 4 <= nb_ipv4 {
+        let dst = [dst4[n], dst4[n + 1], dst4[n + 2], dst4[n + 3]];
+        let next = fwd.lpm4.lookup_x4(&dst, BAD_PORT);
+
+        for j in 0..4 {
+            hops[idx4[n + j]] = next[j];
+        }
+
+        n += 4;
+    }
+
+    for j in n..nb_ipv4 {
+        hops[idx4[j]] = fwd.lpm4.lookup(dst4[j]).unwrap_or(BAD_PORT);
+    }
+}
+
+// Decrement the TTL or hop limit, and rewrite the Ethernet addresses to the next hop.
+#[inline(always)]
+fn prepare_forward(fwd: &L3fwd, m: &mut MBuf, port: NextHop) -> bool {
+    const L3_OFFSET: usize = mem::size_of::<EtherHdr>();
+
+    // the routed packets have been parsed by `route_burst`
+    let is_ipv4 = m
+        .header::<EtherHdr>(0)
+        .map_or(false, |eth| eth.ether_type == ETHER_TYPE_IPV4_BE);
+
+    let alive = if is_ipv4 {
+        m.header_mut::<Ipv4Hdr>(L3_OFFSET).map_or(false, ip::ipv4_dec_ttl)
+    } else {
+        match m.header_mut::<Ipv6Hdr>(L3_OFFSET) {
+            Some(hdr) if hdr.hop_limits > 1 => {
+                hdr.hop_limits -= 1;
+                true
+            }
+            _ => false,
+        }
+    };
+
+    if alive {
+        if let Some(eth) = m.header_mut::<EtherHdr>(0) {
+            eth.d_addr.addr_bytes = *fwd.dest_eth_addr[port as usize].octets();
+            eth.s_addr.addr_bytes = *fwd.ports_eth_addr[port as usize].octets();
+        }
+    }
+
+    alive
+}
+
+/// main processing loop
+pub fn main_loop(fwd: &L3fwd, rx_ports: &[PortId]) -> i32 {
+    let lcore_id = lcore::current().unwrap();
+    let stats = fwd.stats.get(lcore_id);
+    // each lcore owns a TX queue on every port
+    let tx_queue = lcore_id.index() as QueueId;
+    let mut tx_buffers: [RawTxBufferPtr; MAX_PORTS] = [::std::ptr::null_mut(); MAX_PORTS];
+    let mut tx_flushes = (0..MAX_PORTS).map(|_| TxFlush::new(fwd.tx_flush)).collect::<Vec<_>>();
+    let mut prev_tsc = rdtsc();
+    let mut timer_tsc = 0;
+    let mut pkts = MBufBatch::<MAX_PKT_BURST>::new();
+    let mut hops = [BAD_PORT; MAX_PKT_BURST];
+
+    for portid in ethdev::devices().filter(|&portid| fwd.is_enabled(NextHop::from(portid))) {
+        let buf = ethdev::alloc_buffer(MAX_PKT_BURST, lcore_id.socket_id())
+            .as_mut_ref()
+            .expect(&format!("fail to allocate buffer for tx: port={}", portid));
+
+        // the stats outlive the buffers, which are freed before the loop returns
+        unsafe { buf.count_err_packets(stats[portid as usize].dropped.as_atomic()) }
+            .expect(&format!("fail to set error callback for tx buffer: port={}", portid));
+
+        tx_buffers[portid as usize] = buf;
+    }
+
+    while !FORCE_QUIT.load(Ordering::Relaxed) {
+        let cur_tsc = rdtsc();
+        let mut nb_rx_total = 0;
+
+        // Read packet from RX queues
+        for &portid in rx_ports {
+            let nb_rx = portid.rx_burst(0, &mut pkts);
+
+            if nb_rx == 0 {
+                continue;
+            }
+
+            nb_rx_total += nb_rx;
+
+            stats[portid as usize].rx.add(nb_rx as u64);
+
+            route_burst(fwd, &pkts, &mut hops);
+
+            for (mut m, &port) in pkts.drain().zip(hops.iter()) {
+                if fwd.is_enabled(port) && prepare_forward(fwd, &mut m, port) {
+                    let buffer = unsafe { &mut *tx_buffers[port as usize] };
+                    let sent = tx_flushes[port as usize].tx_buffer(&(port as PortId), tx_queue, buffer, m);
+
+                    if sent > 0 {
+                        stats[port as usize].tx.add(sent as u64);
+                    }
+                } else {
+                    stats[portid as usize].dropped.incr();
+                }
+            }
+        }
+
+        // TX burst queue drain, on idle poll or when the latency budget is spent
+        for (portid, buffer) in tx_buffers.iter().enumerate() {
+            if let Some(buffer) = unsafe { buffer.as_mut() } {
+                let sent = tx_flushes[portid].poll(&(portid as PortId), tx_queue, buffer, nb_rx_total == 0, cur_tsc);
+
+                if sent > 0 {
+                    stats[portid].tx.add(sent as u64);
+                }
+            }
+        }
+
+        // if timer is enabled, do this only on master core
+        if fwd.timer_period > 0 && lcore_id.is_master() {
+            // advance the timer
+            timer_tsc += cur_tsc - prev_tsc;
+
+            // if timer has reached its timeout
+            if timer_tsc >= fwd.timer_period {
+                print_stats(fwd);
+
+                // reset the timer
+                timer_tsc = 0;
+            }
+        }
+
+        prev_tsc = cur_tsc;
+    }
+
+    // send the packets still buffered, freeing a buffer would leak them
+    for (portid, buffer) in tx_buffers.iter().enumerate() {
+        if let Some(buffer) = unsafe { buffer.as_mut() } {
+            let sent = (portid as PortId).tx_buffer_flush(tx_queue, buffer);
+
+            if sent > 0 {
+                stats[portid].tx.add(sent as u64);
+            }
+
+            buffer.free();
+        }
+    }
+
+    0
+}
@@ -0,0 +1,441 @@
+#[macro_use]
+extern crate log;
+extern crate getopts;
+extern crate libc;
+extern crate nix;
+extern crate pretty_env_logger;
+extern crate rte;
+
+mod forward;
+
+use std::env;
+use std::io;
+use std::io::prelude::*;
+use std::mem;
+use std::net::{Ipv4Addr, Ipv6Addr};
+use std::path::Path;
+use std::process;
+use std::str::FromStr;
+use std::sync::atomic::Ordering;
+
+use nix::sys::signal;
+
+use rte::ethdev::EthDevice;
+use rte::lcore::RTE_MAX_LCORE;
+use rte::lpm::{Lpm4, Lpm6, NextHop};
+use rte::stats::PerLcore;
+use rte::*;
+
+use forward::{L3fwd, FORCE_QUIT, MAX_PORTS};
+
+const EXIT_FAILURE: i32 = -1;
+
+const MAX_RX_QUEUE_PER_LCORE: u32 = 16;
+
+// A tsc-based timer responsible for triggering statistics printout
+const TIMER_MILLISECOND: i64 = 2000000; /* around 1ms at 2 Ghz */
+const MAX_TIMER_PERIOD: u32 = 86400; /* 1 day max */
+
+const MAX_TX_LATENCY_US: u32 = 1_000_000; /* 1s max */
+
+const NB_MBUF: u32 = 8192;
+
+// Configurable number of RX/TX ring descriptors
+
+const RTE_TEST_RX_DESC_DEFAULT: u16 = 1024;
+const RTE_TEST_TX_DESC_DEFAULT: u16 = 1024;
+
+// The size of LPM tables
+const IPV4_L3FWD_LPM_MAX_RULES: u32 = 1024;
+const IPV4_L3FWD_LPM_NUMBER_TBL8S: u32 = 1 << 8;
+const IPV6_L3FWD_LPM_MAX_RULES: u32 = 1024;
+const IPV6_L3FWD_LPM_NUMBER_TBL8S: u32 = 1 << 16;
+
+#[derive(Clone, Copy)]
+struct LcoreQueueConf {
+    n_rx_port: u32,
+    rx_port_list: [PortId; MAX_RX_QUEUE_PER_LCORE as usize],
+}
+
+struct Conf {
+    nb_rxd: u16,
+    nb_txd: u16,
+
+    queue_conf: [LcoreQueueConf; RTE_MAX_LCORE as usize],
+
+    fwd: L3fwd,
+}
+
+// display usage
+fn print_usage(program: &String, opts: getopts::Options) -> ! {
+    let brief = format!("Usage: {} [EAL options] -- [options]", program);
+
+    print!("{}", opts.usage(&brief));
+
+    process::exit(-1);
+}
+
+// Parse the argument given in the command line of the application
+fn parse_args(args: &Vec<String>) -> (u32, u32, u32, u32) {
+    let mut opts = getopts::Options::new();
+    let program = args[0].clone();
+
+    opts.optopt("p", "", "hexadecimal bitmask of ports to configure", "PORTMASK");
+    opts.optopt("q", "", "number of queue (=ports) per lcore (default is 1)", "NQ");
+    opts.optopt(
+        "T",
+        "",
+        "statistics will be refreshed each PERIOD seconds (0 to disable, 10 default, \
+         86400 maximum)",
+        "PERIOD",
+    );
+    opts.optopt(
+        "L",
+        "",
+        "buffered TX packets will be flushed within LATENCY microseconds, \
+         or on idle RX polls (100 default, 0 to flush on every poll)",
+        "LATENCY",
+    );
+    opts.optflag("h", "help", "print this help menu");
+
+    let matches = match opts.parse(&args[1..]) {
+        Ok(m) => m,
+        Err(err) => {
+            println!("Invalid L3FWD arguments, {}", err);
+
+            print_usage(&program, opts);
+        }
+    };
+
+    if matches.opt_present("h") {
+        print_usage(&program, opts);
+    }
+
+    let mut enabled_port_mask: u32 = 0; // mask of enabled ports
+    let mut rx_queue_per_lcore: u32 = 1;
+    let mut timer_period_seconds: u32 = 10; // default period is 10 seconds
+    let mut tx_latency_us: u32 = 100; // default TX latency is 100us
+
+    if let Some(arg) = matches.opt_str("p") {
+        match u32::from_str_radix(arg.as_str(), 16) {
+            Ok(mask) if mask != 0 => enabled_port_mask = mask,
+            _ => {
+                println!("invalid portmask, {}", arg);
+
+                print_usage(&program, opts);
+            }
+        }
+    }
+
+    if let Some(arg) = matches.opt_str("q") {
+        match u32::from_str(arg.as_str()) {
+            Ok(n) if 0 < n && n < MAX_RX_QUEUE_PER_LCORE => rx_queue_per_lcore = n,
+            _ => {
+                println!("invalid queue number, {}", arg);
+
+                print_usage(&program, opts);
+            }
+        }
+    }
+
+    if let Some(arg) = matches.opt_str("T") {
+        match u32::from_str(arg.as_str()) {
+            Ok(t) if t < MAX_TIMER_PERIOD => timer_period_seconds = t,
+            _ => {
+                println!("invalid timer period, {}", arg);
+
+                print_usage(&program, opts);
+            }
+        }
+    }
+
+    if let Some(arg) = matches.opt_str("L") {
+        match u32::from_str(arg.as_str()) {
+            Ok(us) if us < MAX_TX_LATENCY_US => tx_latency_us = us,
+            _ => {
+                println!("invalid TX latency, {}", arg);
+
+                print_usage(&program, opts);
+            }
+        }
+    }
+
+    (
+        enabled_port_mask,
+        rx_queue_per_lcore,
+        timer_period_seconds,
+        tx_latency_us,
+    )
+}
+
+// Route 198.18.<port>.0/24 and 2001:200:0:<port>::/48 to each enabled port.
+fn setup_routes(fwd: &mut L3fwd, enabled_devices: &[PortId]) {
+    for &portid in enabled_devices {
+        let ipv4 = Ipv4Addr::new(198, 18, portid as u8, 0);
+        let ipv6 = Ipv6Addr::new(0x2001, 0x200, 0, portid, 0, 0, 0, 0);
+
+        fwd.lpm4
+            .add(ipv4, 24, NextHop::from(portid))
+            .expect(&format!("fail to add route {}/24 to port {}", ipv4, portid));
+        fwd.lpm6
+            .add(&ipv6, 48, NextHop::from(portid))
+            .expect(&format!("fail to add route {}/48 to port {}", ipv6, portid));
+
+        println!("LPM: route {}/24 and {}/48 to port {}", ipv4, ipv6, portid);
+    }
+}
+
+// Check the link status of all ports in up to 9s, and print them finally
+fn check_all_ports_link_status(enabled_devices: &Vec<ethdev::PortId>) {
+    print!("Checking link status");
+
+    const CHECK_INTERVAL: u32 = 100;
+    const MAX_CHECK_TIME: usize = 90;
+
+    for _ in 0..MAX_CHECK_TIME {
+        if FORCE_QUIT.load(Ordering::Relaxed) {
+            break;
+        }
+
+        if enabled_devices.iter().all(|dev| dev.link_nowait().up) {
+            break;
+        }
+
+        delay_ms(CHECK_INTERVAL);
+
+        print!(".");
+
+        io::stdout().flush().unwrap();
+    }
+
+    println!("Done:");
+
+    for dev in enabled_devices {
+        let link = dev.link();
+
+        if link.up {
+            println!(
+                "  Port {} Link Up - speed {} Mbps - {}",
+                dev.portid(),
+                link.speed,
+                if link.duplex { "full-duplex" } else { "half-duplex" }
+            )
+        } else {
+            println!("  Port {} Link Down", dev.portid());
+        }
+    }
+}
+
+fn l3fwd_launch_one_lcore(conf: Option<&Conf>) -> i32 {
+    let conf = conf.unwrap();
+    let lcore_id = lcore::current().unwrap();
+    let qconf = &conf.queue_conf[*lcore_id as usize];
+
+    if qconf.n_rx_port == 0 {
+        info!("lcore {} has nothing to do", lcore_id);
+
+        return -1;
+    }
+
+    info!("entering main loop on lcore {}", lcore_id);
+
+    for portid in &qconf.rx_port_list[..qconf.n_rx_port as usize] {
+        info!(" -- lcoreid={} portid={}", lcore_id, portid);
+    }
+
+    forward::main_loop(&conf.fwd, &qconf.rx_port_list[..qconf.n_rx_port as usize])
+}
+
+extern "C" fn handle_sigint(sig: libc::c_int) {
+    match signal::Signal::from_c_int(sig).unwrap() {
+        signal::SIGINT | signal::SIGTERM => {
+            println!("Signal {} received, preparing to exit...", sig);
+
+            FORCE_QUIT.store(true, Ordering::Relaxed);
+        }
+        _ => info!("unexpect signo: {}", sig),
+    }
+}
+
+fn handle_signals() -> nix::Result<()> {
+    let sig_action = signal::SigAction::new(
+        signal::SigHandler::Handler(handle_sigint),
+        signal::SaFlags::empty(),
+        signal::SigSet::empty(),
+    );
+    unsafe {
+        signal::sigaction(signal::SIGINT, &sig_action)?;
+        signal::sigaction(signal::SIGTERM, &sig_action)?;
+    }
+
+    Ok(())
+}
+
+fn prepare_args(args: &mut Vec<String>) -> (Vec<String>, Vec<String>) {
+    let program = String::from(Path::new(&args[0]).file_name().unwrap().to_str().unwrap());
+
+    if let Some(pos) = args.iter().position(|arg| arg == "--") {
+        let (eal_args, opt_args) = args.split_at_mut(pos);
+
+        opt_args[0] = program;
+
+        (eal_args.to_vec(), opt_args.to_vec())
+    } else {
+        (args[..1].to_vec(), args.clone())
+    }
+}
+
+fn main() {
+    pretty_env_logger::init();
+
+    handle_signals().expect("fail to handle signals");
+
+    let mut args: Vec<String> = env::args().collect();
+
+    let (eal_args, opt_args) = prepare_args(&mut args);
+
+    debug!("eal args: {:?}, l3fwd args: {:?}", eal_args, opt_args);
+
+    let (enabled_port_mask, rx_queue_per_lcore, timer_period_seconds, tx_latency_us) = parse_args(&opt_args);
+
+    // init EAL
+    eal::init(&eal_args).expect("fail to initial EAL");
+
+    let socket_id = rte::socket_id() as i32;
+
+    let mut conf = Conf {
+        nb_rxd: RTE_TEST_RX_DESC_DEFAULT,
+        nb_txd: RTE_TEST_TX_DESC_DEFAULT,
+        queue_conf: unsafe { mem::zeroed() },
+        fwd: L3fwd {
+            enabled_port_mask,
+            ports_eth_addr: [ether::EtherAddr::default(); MAX_PORTS],
+            dest_eth_addr: [ether::EtherAddr::default(); MAX_PORTS],
+            lpm4: Lpm4::create(
+                "IPV4_L3FWD_LPM",
+                socket_id,
+                IPV4_L3FWD_LPM_MAX_RULES,
+                IPV4_L3FWD_LPM_NUMBER_TBL8S,
+            )
+            .expect("fail to create the IPv4 LPM table"),
+            lpm6: Lpm6::create(
+                "IPV6_L3FWD_LPM",
+                socket_id,
+                IPV6_L3FWD_LPM_MAX_RULES,
+                IPV6_L3FWD_LPM_NUMBER_TBL8S,
+            )
+            .expect("fail to create the IPv6 LPM table"),
+            stats: PerLcore::new(),
+            timer_period: timer_period_seconds as u64 * TIMER_MILLISECOND as u64 * 1000,
+            tx_flush: ethdev::TxFlushPolicy::with_latency_us(tx_latency_us as u64),
+        },
+    };
+
+    // create the mbuf pool
+    let mut l3fwd_pktmbuf_pool = mbuf::pool_create(
+        "mbuf_pool",
+        NB_MBUF,
+        256,
+        0,
+        mbuf::RTE_MBUF_DEFAULT_BUF_SIZE as u16,
+        socket_id,
+    )
+    .unwrap();
+
+    let enabled_devices: Vec<ethdev::PortId> = ethdev::devices()
+        .filter(|dev| ((1 << dev.portid()) & enabled_port_mask) != 0)
+        .collect();
+
+    if enabled_devices.is_empty() {
+        eal::exit(EXIT_FAILURE, "All available ports are disabled. Please set portmask.\n");
+    }
+
+    setup_routes(&mut conf.fwd, &enabled_devices);
+
+    let mut rx_lcore_id = lcore::id(0);
+
+    // Initialize the port/queue configuration of each logical core
+    for dev in &enabled_devices {
+        let portid = dev.portid();
+
+        loop {
+            if let Some(id) = rx_lcore_id.next() {
+                if conf.queue_conf[*rx_lcore_id as usize].n_rx_port == rx_queue_per_lcore {
+                    rx_lcore_id = id
+                }
+            }
+
+            break;
+        }
+
+        // Assigned a new logical core in the loop above.
+        let qconf = &mut conf.queue_conf[*rx_lcore_id as usize];
+
+        qconf.rx_port_list[qconf.n_rx_port as usize] = portid;
+        qconf.n_rx_port += 1;
+
+        println!("Lcore {}: RX port {}", rx_lcore_id, portid);
+    }
+
+    // each lcore has its own TX queue on every port, indexed by the lcore index
+    let nb_tx_queue = lcore::count() as u16;
+    let port_conf = ethdev::EthConf::default();
+
+    // Initialise each port
+    for dev in &enabled_devices {
+        let portid = dev.portid() as usize;
+
+        // init port
+        print!("Initializing port {}... ", portid);
+
+        dev.configure(1, nb_tx_queue, &port_conf)
+            .expect(&format!("fail to configure device: port={}", portid));
+
+        let mac_addr = dev.mac_addr();
+
+        conf.fwd.ports_eth_addr[portid] = mac_addr;
+        conf.fwd.dest_eth_addr[portid] = ether::EtherAddr::new(0x02, 0, 0, 0, 0, portid as u8);
+
+        // init one RX queue
+        dev.rx_queue_setup(0, conf.nb_rxd, None, &mut l3fwd_pktmbuf_pool)
+            .expect(&format!("fail to setup device rx queue: port={}", portid));
+
+        // init one TX queue per lcore on each port
+        for queue_id in 0..nb_tx_queue {
+            dev.tx_queue_setup(queue_id, conf.nb_txd, None)
+                .expect(&format!("fail to setup device tx queue: port={}", portid));
+        }
+
+        // Start device
+        dev.start().expect(&format!("fail to start device: port={}", portid));
+
+        println!("Done: ");
+
+        dev.promiscuous_enable();
+
+        println!(
+            "  Port {}, MAC address: {} (promiscuous {})",
+            portid,
+            mac_addr,
+            dev.is_promiscuous_enabled()
+                .map(|enabled| if enabled { "enabled" } else { "disabled" })
+                .expect(&format!("fail to enable promiscuous mode for device: port={}", portid))
+        );
+    }
+
+    check_all_ports_link_status(&enabled_devices);
+
+    // launch per-lcore init on every lcore
+    launch::mp_remote_launch(l3fwd_launch_one_lcore, Some(&conf), false).unwrap();
+
+    launch::mp_wait_lcore();
+
+    for dev in &enabled_devices {
+        print!("Closing port {}...", dev.portid());
+        dev.stop();
+        dev.close();
+        println!(" Done");
+    }
+
+    println!("Bye...");
+}
@@ -1,8 +1,12 @@
+use std::convert::TryFrom;
 use std::mem;
+use std::ptr;
+
+use failure::Error;
 
 use ffi;
 
-use errors::Result;
+use errors::{ErrorKind, Result, RteError};
 use ethdev;
 use ether;
 use memory::SocketId;
@@ -90,15 +94,17 @@ impl From<u8> for BondMode {
 }
 
 /// Balance Mode Transmit Policies
+///
+/// The policy is also used to distribute the packets across the slaves in the 802.3AD mode.
 #[repr(u8)]
-#[derive(Copy, Clone, Eq, PartialEq)]
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
 pub enum TransmitPolicy {
     /// Layer 2 (Ethernet MAC)
-    Layer2,
+    Layer2 = ffi::BALANCE_XMIT_POLICY_LAYER2 as u8,
     /// Layer 2+3 (Ethernet MAC + IP Addresses) transmit load balancing
-    Layer23,
+    Layer23 = ffi::BALANCE_XMIT_POLICY_LAYER23 as u8,
     /// Layer 3+4 (IP Addresses + UDP Ports) transmit load balancing
-    Layer34,
+    Layer34 = ffi::BALANCE_XMIT_POLICY_LAYER34 as u8,
 }
 
 impl From<u8> for TransmitPolicy {
@@ -107,6 +113,105 @@ impl From<u8> for TransmitPolicy {
     }
 }
 
+/// The aggregator selection mode of 802.3AD mode
+#[repr(u32)]
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+pub enum AggSelection {
+    /// Select the aggregator with the highest bandwidth.
+    Bandwidth = ffi::rte_bond_8023ad_agg_selection::AGG_BANDWIDTH,
+    /// Select the aggregator with the most slaves.
+    Count = ffi::rte_bond_8023ad_agg_selection::AGG_COUNT,
+    /// Keep the selected aggregator as long as it still has a slave (default).
+    Stable = ffi::rte_bond_8023ad_agg_selection::AGG_STABLE,
+}
+
+impl TryFrom<u32> for AggSelection {
+    type Error = Error;
+
+    fn try_from(v: u32) -> Result<Self> {
+        match v {
+            ffi::rte_bond_8023ad_agg_selection::AGG_BANDWIDTH => Ok(AggSelection::Bandwidth),
+            ffi::rte_bond_8023ad_agg_selection::AGG_COUNT => Ok(AggSelection::Count),
+            ffi::rte_bond_8023ad_agg_selection::AGG_STABLE => Ok(AggSelection::Stable),
+            _ => Err(ErrorKind::InvalidArg("agg_selection", v as usize).into()),
+        }
+    }
+}
+
+/// The LACP timers of 802.3AD mode in milliseconds.
+#[derive(Copy, Clone, Debug)]
+pub struct LacpConf {
+    /// The periodic transmission interval of LACPDU in the fast mode.
+    pub fast_periodic_ms: u32,
+    /// The periodic transmission interval of LACPDU in the slow mode.
+    pub slow_periodic_ms: u32,
+    /// The timeout of the partner in the short timeout mode.
+    pub short_timeout_ms: u32,
+    /// The timeout of the partner in the long timeout mode.
+    pub long_timeout_ms: u32,
+    /// The wait time before the aggregator enables the slaves attached to it.
+    pub aggregate_wait_timeout_ms: u32,
+    /// The minimum interval between two LACPDUs.
+    pub tx_period_ms: u32,
+    /// The interval of the marker protocol.
+    pub rx_marker_period_ms: u32,
+    /// The interval of the state machines, which handle the LACPDUs.
+    pub update_timeout_ms: u32,
+    /// The aggregator selection mode.
+    pub agg_selection: AggSelection,
+}
+
+impl Default for LacpConf {
+    fn default() -> Self {
+        LacpConf {
+            fast_periodic_ms: 900,
+            slow_periodic_ms: 29000,
+            short_timeout_ms: 3000,
+            long_timeout_ms: 90000,
+            aggregate_wait_timeout_ms: 2000,
+            tx_period_ms: 500,
+            rx_marker_period_ms: 2000,
+            update_timeout_ms: 100,
+            agg_selection: AggSelection::Stable,
+        }
+    }
+}
+
+impl TryFrom<ffi::rte_eth_bond_8023ad_conf> for LacpConf {
+    type Error = Error;
+
+    fn try_from(conf: ffi::rte_eth_bond_8023ad_conf) -> Result<Self> {
+        Ok(LacpConf {
+            fast_periodic_ms: conf.fast_periodic_ms,
+            slow_periodic_ms: conf.slow_periodic_ms,
+            short_timeout_ms: conf.short_timeout_ms,
+            long_timeout_ms: conf.long_timeout_ms,
+            aggregate_wait_timeout_ms: conf.aggregate_wait_timeout_ms,
+            tx_period_ms: conf.tx_period_ms,
+            rx_marker_period_ms: conf.rx_marker_period_ms,
+            update_timeout_ms: conf.update_timeout_ms,
+            agg_selection: AggSelection::try_from(conf.agg_selection)?,
+        })
+    }
+}
+
+impl From<LacpConf> for ffi::rte_eth_bond_8023ad_conf {
+    fn from(conf: LacpConf) -> Self {
+        ffi::rte_eth_bond_8023ad_conf {
+            fast_periodic_ms: conf.fast_periodic_ms,
+            slow_periodic_ms: conf.slow_periodic_ms,
+            short_timeout_ms: conf.short_timeout_ms,
+            long_timeout_ms: conf.long_timeout_ms,
+            aggregate_wait_timeout_ms: conf.aggregate_wait_timeout_ms,
+            tx_period_ms: conf.tx_period_ms,
+            rx_marker_period_ms: conf.rx_marker_period_ms,
+            update_timeout_ms: conf.update_timeout_ms,
+            slowrx_cb: None,
+            agg_selection: conf.agg_selection as u32,
+        }
+    }
+}
+
 /// Create a bonded rte_eth_dev device
 pub fn create(name: &str, mode: BondMode, socket_id: SocketId) -> Result<ethdev::PortId> {
     let port_id = unsafe { ffi::rte_eth_bond_create(try!(to_cptr!(name)), mode as u8, socket_id as u8) };
@@ -156,6 +261,36 @@ pub trait BondedDevice {
     /// Set the transmit policy for bonded device to use when it is operating in balance mode,
     /// this parameter is otherwise ignored in other modes of operation.
     fn set_xmit_policy(&self, policy: TransmitPolicy) -> Result<&Self>;
+
+    /// Get the link status monitoring interval in milliseconds of the slaves without the link status interrupt.
+    fn link_monitoring(&self) -> Result<u32>;
+
+    /// Set the link status monitoring interval in milliseconds of the slaves without the link status interrupt.
+    fn set_link_monitoring(&self, interval_ms: u32) -> Result<&Self>;
+
+    /// Get the LACP configuration of bonded device in 802.3AD mode.
+    fn lacp_conf(&self) -> Result<LacpConf>;
+
+    /// Tune the LACP timers of bonded device in 802.3AD mode, or restore the default ones if `None`.
+    fn set_lacp_conf(&self, conf: Option<&LacpConf>) -> Result<&Self>;
+
+    /// Handle the LACP control traffic in a dedicated RX/TX queue of each slave,
+    /// which is steered by a flow rule, instead of the bursts of the data path.
+    ///
+    /// It must be called after the slaves are added and before the bonded device is started,
+    /// and the slaves must support one more queue and the flow rule of slow protocols.
+    fn enable_dedicated_queues(&self) -> Result<&Self>;
+
+    /// Handle the LACP control traffic in the bursts of the data path.
+    ///
+    /// It must be called when the bonded device is stopped.
+    fn disable_dedicated_queues(&self) -> Result<&Self>;
+
+    /// Get the aggregator selection mode of bonded device in 802.3AD mode.
+    fn agg_selection(&self) -> Result<AggSelection>;
+
+    /// Set the aggregator selection mode of bonded device in 802.3AD mode.
+    fn set_agg_selection(&self, agg_selection: AggSelection) -> Result<&Self>;
 }
 
 impl BondedDevice for ethdev::PortId {
@@ -208,7 +343,7 @@ impl BondedDevice for ethdev::PortId {
     fn active_slaves(&self) -> Result<Vec<ethdev::PortId>> {
         let mut slaves = [0u16; ffi::RTE_MAX_ETHPORTS as usize];
 
-        let num = unsafe { ffi::rte_eth_bond_slaves_get(*self, slaves.as_mut_ptr(), slaves.len() as u16) };
+        let num = unsafe { ffi::rte_eth_bond_active_slaves_get(*self, slaves.as_mut_ptr(), slaves.len() as u16) };
 
         rte_check!(num; ok => {
             Vec::from(&slaves[..num as usize])
@@ -238,4 +373,61 @@ impl BondedDevice for ethdev::PortId {
             ffi::rte_eth_bond_xmit_policy_set(*self, policy as u8)
         }; ok => { self })
     }
+
+    fn link_monitoring(&self) -> Result<u32> {
+        let interval = unsafe { ffi::rte_eth_bond_link_monitoring_get(*self) };
+
+        rte_check!(interval; ok => { interval as u32 })
+    }
+
+    fn set_link_monitoring(&self, interval_ms: u32) -> Result<&Self> {
+        rte_check!(unsafe {
+            ffi::rte_eth_bond_link_monitoring_set(*self, interval_ms)
+        }; ok => { self })
+    }
+
+    fn lacp_conf(&self) -> Result<LacpConf> {
+        let mut conf = ffi::rte_eth_bond_8023ad_conf::default();
+
+        rte_check!(unsafe {
+            ffi::rte_eth_bond_8023ad_conf_get(*self, &mut conf)
+        }; ok => { LacpConf::try_from(conf)? })
+    }
+
+    fn set_lacp_conf(&self, conf: Option<&LacpConf>) -> Result<&Self> {
+        let mut conf = conf.map(|conf| ffi::rte_eth_bond_8023ad_conf::from(*conf));
+
+        rte_check!(unsafe {
+            ffi::rte_eth_bond_8023ad_setup(*self, conf.as_mut().map_or(ptr::null_mut(), |conf| conf as *mut _))
+        }; ok => { self })
+    }
+
+    fn enable_dedicated_queues(&self) -> Result<&Self> {
+        rte_check!(unsafe {
+            ffi::rte_eth_bond_8023ad_dedicated_queues_enable(*self)
+        }; ok => { self })
+    }
+
+    fn disable_dedicated_queues(&self) -> Result<&Self> {
+        rte_check!(unsafe {
+            ffi::rte_eth_bond_8023ad_dedicated_queues_disable(*self)
+        }; ok => { self })
+    }
+
+    fn agg_selection(&self) -> Result<AggSelection> {
+        let agg_selection = unsafe { ffi::rte_eth_bond_8023ad_agg_selection_get(*self) };
+
+        // the mode is returned on success, which isn't always zero
+        if agg_selection < 0 {
+            Err(RteError(agg_selection).into())
+        } else {
+            AggSelection::try_from(agg_selection as u32)
+        }
+    }
+
+    fn set_agg_selection(&self, agg_selection: AggSelection) -> Result<&Self> {
+        rte_check!(unsafe {
+            ffi::rte_eth_bond_8023ad_agg_selection_set(*self, agg_selection as u32)
+        }; ok => { self })
+    }
 }
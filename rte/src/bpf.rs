@@ -0,0 +1,143 @@
+//!
+//! RTE BPF
+//!
+//! Load and run the eBPF programs, e.g. a packet filter compiled with `clang -target bpf`.
+//!
+//! The program is JIT compiled to the native code if it is supported,
+//! otherwise it is interpreted.
+//!
+use std::ffi::CString;
+use std::os::raw::c_void;
+use std::os::unix::ffi::OsStrExt;
+use std::path::Path;
+use std::ptr::{self, NonNull};
+
+use ffi;
+
+use errors::{AsResult, Result};
+use mbuf::{MBuf, RTE_MBUF_DEFAULT_BUF_SIZE};
+use utils::{AsCString, AsRaw};
+
+/// The eBPF instruction.
+pub type Insn = ffi::ebpf_insn;
+
+/// The argument of program.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum Arg {
+    /// A pointer to the packet data of at most `size` bytes.
+    Data(usize),
+    /// A pointer to the mbuf, the program could read the packet with the mbuf helpers.
+    MBuf,
+}
+
+impl Arg {
+    fn as_raw(self) -> ffi::rte_bpf_arg {
+        match self {
+            Arg::Data(size) => ffi::rte_bpf_arg {
+                type_: ffi::rte_bpf_arg_type::RTE_BPF_ARG_PTR,
+                size,
+                buf_size: 0,
+            },
+            Arg::MBuf => ffi::rte_bpf_arg {
+                type_: ffi::rte_bpf_arg_type::RTE_BPF_ARG_PTR_MBUF,
+                size: ::std::mem::size_of::<ffi::rte_mbuf>(),
+                buf_size: RTE_MBUF_DEFAULT_BUF_SIZE as usize,
+            },
+        }
+    }
+}
+
+type JitFunc = unsafe extern "C" fn(*mut c_void) -> u64;
+
+/// A loaded eBPF program, which could be run by multiple lcores at the same time.
+pub struct Bpf {
+    raw: NonNull<ffi::rte_bpf>,
+    arg: Arg,
+    jit: Option<JitFunc>,
+}
+
+unsafe impl Send for Bpf {}
+
+unsafe impl Sync for Bpf {}
+
+impl Drop for Bpf {
+    fn drop(&mut self) {
+        unsafe { ffi::rte_bpf_destroy(self.raw.as_ptr()) }
+    }
+}
+
+impl Bpf {
+    /// Load a program from the instructions.
+    pub fn load(ins: &[Insn], arg: Arg) -> Result<Self> {
+        let prm = ffi::rte_bpf_prm {
+            ins: ins.as_ptr(),
+            nb_ins: ins.len() as u32,
+            xsym: ptr::null(),
+            nb_xsym: 0,
+            prog_arg: arg.as_raw(),
+        };
+
+        unsafe { ffi::rte_bpf_load(&prm) }
+            .as_result()
+            .map(|raw| Bpf::new(raw, arg))
+    }
+
+    /// Load a program from the section `sname` of an ELF file.
+    pub fn load_elf<P: AsRef<Path>, S: AsRef<str>>(path: P, sname: S, arg: Arg) -> Result<Self> {
+        let prm = ffi::rte_bpf_prm {
+            prog_arg: arg.as_raw(),
+            ..Default::default()
+        };
+        let fname = CString::new(path.as_ref().as_os_str().as_bytes())?;
+        let sname = sname.as_cstring();
+
+        unsafe { ffi::rte_bpf_elf_load(&prm, fname.as_ptr(), sname.as_ptr()) }
+            .as_result()
+            .map(|raw| Bpf::new(raw, arg))
+    }
+
+    fn new(raw: NonNull<ffi::rte_bpf>, arg: Arg) -> Self {
+        let mut jit = ffi::rte_bpf_jit::default();
+        let jit = if unsafe { ffi::rte_bpf_get_jit(raw.as_ptr(), &mut jit) } == 0 {
+            jit.func
+        } else {
+            None
+        };
+
+        Bpf { raw, arg, jit }
+    }
+
+    /// The program is JIT compiled.
+    pub fn is_jited(&self) -> bool {
+        self.jit.is_some()
+    }
+
+    /// Run the program with a packet, and return the result of program.
+    #[inline]
+    pub fn exec(&self, m: &MBuf) -> u64 {
+        let ctx = match self.arg {
+            Arg::Data(_) => m.mtod::<c_void>().as_ptr(),
+            Arg::MBuf => m.as_raw() as *mut c_void,
+        };
+
+        unsafe {
+            if let Some(func) = self.jit {
+                func(ctx)
+            } else {
+                ffi::rte_bpf_exec(self.raw.as_ptr(), ctx)
+            }
+        }
+    }
+
+    /// Run the program with a burst of packets, and save the result of each packet to `rc`.
+    ///
+    /// It returns the number of packets with the non-zero results, e.g. matched by a filter.
+    #[inline]
+    pub fn exec_burst(&self, pkts: &[MBuf], rc: &mut [u64]) -> usize {
+        pkts.iter().zip(rc.iter_mut()).fold(0, |n, (m, rc)| {
+            *rc = self.exec(m);
+
+            n + (*rc != 0) as usize
+        })
+    }
+}
@@ -0,0 +1,499 @@
+//!
+//! Packet Capture
+//!
+//! A `Tap` on the data plane clones the packets with `rte_pktmbuf_clone`,
+//! and enqueues the clones to a ring without waiting.
+//! The packets are dropped rather than blocking the data plane,
+//! when the clone pool is exhausted or the ring is full.
+//!
+//! A `Sink` on a control plane lcore dequeues the clones,
+//! and writes them to a pcapng file through a memory-mapped window.
+//!
+//! ```no_run
+//! # use rte::capture::Sink;
+//! # use rte::mempool::MemoryPool;
+//! # fn run(pool: MemoryPool) -> rte::errors::Result<()> {
+//! let mut sink = Sink::create("capture", 4096, 0, "/tmp/capture.pcapng")?;
+//! let mut tap = sink.tap(pool, None);
+//!
+//! // on the data plane, after each RX burst
+//! // tap.capture(&pkts);
+//!
+//! // on the control plane
+//! sink.poll()?;
+//! # Ok(())
+//! # }
+//! ```
+//!
+use std::cmp;
+use std::collections::HashMap;
+use std::fs::{File, OpenOptions};
+use std::io;
+use std::mem;
+use std::os::unix::io::AsRawFd;
+use std::path::Path;
+use std::ptr;
+use std::slice;
+use std::sync::Arc;
+use std::time::{SystemTime, UNIX_EPOCH};
+
+use libc;
+
+use ffi;
+
+use bpf::Bpf;
+use common::{get_tsc_hz, rdtsc};
+use errors::Result;
+use mbuf::{MBuf, MBufBatch, MBufPool};
+use memory::SocketId;
+use mempool::MemoryPool;
+use ring::{Dequeuer, Enqueuer, MpscRing, RingFlags, Single};
+use stats::{CacheAligned, Counter};
+use utils::AsRaw;
+
+/// The maximum number of packets cloned or written at once.
+pub const CAPTURE_BURST: usize = 32;
+
+/// The default maximum length of the captured packets.
+pub const DEFAULT_SNAPLEN: u32 = 0xffff;
+
+// The size of memory-mapped window of the capture file.
+const MMAP_WINDOW: usize = 4 << 20;
+
+/// The statistics of a tap.
+#[derive(Debug, Default)]
+pub struct TapStats {
+    /// The packets enqueued to the ring.
+    pub captured: Counter,
+    /// The packets not matched by the filter.
+    pub filtered: Counter,
+    /// The packets dropped since the clone pool is exhausted or the ring is full.
+    pub dropped: Counter,
+}
+
+/// The data plane of capture, which is used by a single lcore.
+pub struct Tap {
+    ring: Enqueuer<MBuf>,
+    pool: MemoryPool,
+    filter: Option<Arc<Bpf>>,
+    stats: Arc<CacheAligned<TapStats>>,
+}
+
+unsafe impl Send for Tap {}
+
+impl Tap {
+    /// The statistics of tap, which could be read by other lcores.
+    pub fn stats(&self) -> Arc<CacheAligned<TapStats>> {
+        self.stats.clone()
+    }
+
+    /// Clone the packets matched by the filter, and enqueue them to the sink.
+    ///
+    /// The packets are still owned by the caller, it returns the number of packets captured.
+    #[inline]
+    pub fn capture(&mut self, pkts: &[MBuf]) -> usize {
+        let now = rdtsc();
+        let mut rc = [1u64; CAPTURE_BURST];
+        let mut clones = MBufBatch::<CAPTURE_BURST>::new();
+        let mut captured = 0;
+
+        for pkts in pkts.chunks(CAPTURE_BURST) {
+            if let Some(ref filter) = self.filter {
+                let matched = filter.exec_burst(pkts, &mut rc);
+
+                self.stats.filtered.add((pkts.len() - matched) as u64);
+            }
+
+            for (m, &rc) in pkts.iter().zip(rc.iter()) {
+                if rc == 0 {
+                    continue;
+                }
+
+                match self.pool.clone(m) {
+                    Ok(mut clone) => {
+                        clone.timestamp = now;
+
+                        let _ = clones.push(clone);
+                    }
+                    Err(_) => self.stats.dropped.incr(),
+                }
+            }
+
+            let n = self.ring.enqueue_batch(&mut clones);
+
+            if !clones.is_empty() {
+                self.stats.dropped.add(clones.len() as u64);
+
+                clones.clear();
+            }
+
+            captured += n;
+        }
+
+        self.stats.captured.add(captured as u64);
+
+        captured
+    }
+}
+
+/// The control plane of capture, which writes the captured packets to a pcapng file.
+///
+/// The clones left in the ring are freed when the sink is dropped, so its taps should be dropped first.
+pub struct Sink {
+    tx: Enqueuer<MBuf>,
+    rx: Dequeuer<MBuf, Single>,
+    writer: PcapngWriter,
+}
+
+// the clones are only dequeued by the sink, which owns the single consumer of ring
+unsafe impl Send for Sink {}
+
+impl Drop for Sink {
+    fn drop(&mut self) {
+        let mut pkts = MBufBatch::<CAPTURE_BURST>::new();
+
+        while self.rx.dequeue_batch(&mut pkts) > 0 {
+            pkts.clear();
+        }
+    }
+}
+
+impl Sink {
+    /// Create a sink with a ring of `count` packets, and the pcapng file at `path`.
+    pub fn create<S: AsRef<str>, P: AsRef<Path>>(name: S, count: usize, socket_id: SocketId, path: P) -> Result<Self> {
+        let (tx, rx) = MpscRing::create(name, count, socket_id, RingFlags::empty())?.split();
+        let writer = PcapngWriter::create(path, DEFAULT_SNAPLEN)?;
+
+        Ok(Sink { tx, rx, writer })
+    }
+
+    /// Create a tap of the sink, which clones the packets from `pool` if they are matched by the `filter`.
+    pub fn tap(&self, pool: MemoryPool, filter: Option<Arc<Bpf>>) -> Tap {
+        Tap {
+            ring: self.tx.clone(),
+            pool,
+            filter,
+            stats: Default::default(),
+        }
+    }
+
+    /// The pcapng writer.
+    pub fn writer(&mut self) -> &mut PcapngWriter {
+        &mut self.writer
+    }
+
+    /// Write the captured packets, at most a ring of packets at once.
+    ///
+    /// It returns the number of packets written.
+    pub fn poll(&mut self) -> Result<usize> {
+        let mut pkts = MBufBatch::<CAPTURE_BURST>::new();
+        let mut written = 0;
+
+        while written < self.rx.capacity() {
+            let n = self.rx.dequeue_batch(&mut pkts);
+
+            if n == 0 {
+                break;
+            }
+
+            for m in pkts.drain() {
+                self.writer.write_packet(&m)?;
+            }
+
+            written += n;
+        }
+
+        Ok(written)
+    }
+}
+
+/// A pcapng writer with an interface per port.
+///
+/// The timestamps of packets are the TSC cycles in `mbuf.timestamp`,
+/// which are converted to nanoseconds since the epoch.
+pub struct PcapngWriter {
+    file: MmapFile,
+    snaplen: u32,
+    interfaces: HashMap<u16, u32>,
+    base_ns: u64,
+    base_tsc: u64,
+    tsc_hz: u64,
+}
+
+// pcapng block types
+const SHB_TYPE: u32 = 0x0A0D_0D0A;
+const IDB_TYPE: u32 = 0x0000_0001;
+const EPB_TYPE: u32 = 0x0000_0006;
+
+const BYTE_ORDER_MAGIC: u32 = 0x1A2B_3C4D;
+const LINKTYPE_ETHERNET: u16 = 1;
+
+// the option of interface description block, the timestamp resolution is 10^-9 s
+const OPT_IF_TSRESOL: u16 = 9;
+const TSRESOL_NS: u8 = 9;
+
+impl PcapngWriter {
+    /// Create a pcapng file, the packets are truncated to `snaplen` bytes.
+    pub fn create<P: AsRef<Path>>(path: P, snaplen: u32) -> Result<Self> {
+        let mut writer = PcapngWriter {
+            file: MmapFile::create(path)?,
+            snaplen,
+            interfaces: HashMap::new(),
+            base_ns: SystemTime::now()
+                .duration_since(UNIX_EPOCH)
+                .map(|d| d.as_secs() * 1_000_000_000 + u64::from(d.subsec_nanos()))
+                .unwrap_or(0),
+            base_tsc: rdtsc(),
+            tsc_hz: get_tsc_hz(),
+        };
+
+        writer.write_section_header()?;
+
+        Ok(writer)
+    }
+
+    /// Write a packet as an enhanced packet block of the interface of its port.
+    pub fn write_packet(&mut self, m: &MBuf) -> Result<()> {
+        let if_id = self.interface(m.port)?;
+        let ts = self.timestamp_ns(m.timestamp);
+        let orig_len = m.pkt_len() as u32;
+        let cap_len = cmp::min(orig_len, self.snaplen);
+        let padded_len = (cap_len + 3) & !3;
+        let block_len = 32 + padded_len;
+
+        let mut hdr = [0u32; 7];
+
+        hdr[0] = EPB_TYPE;
+        hdr[1] = block_len;
+        hdr[2] = if_id;
+        hdr[3] = (ts >> 32) as u32;
+        hdr[4] = ts as u32;
+        hdr[5] = cap_len;
+        hdr[6] = orig_len;
+
+        self.file.write(as_bytes(&hdr))?;
+
+        let mut left = cap_len as usize;
+        let mut seg = m.as_raw() as *const ffi::rte_mbuf;
+
+        unsafe {
+            while left > 0 && !seg.is_null() {
+                let data = ((*seg).buf_addr as *const u8).add(usize::from((*seg).data_off));
+                let len = cmp::min(left, usize::from((*seg).data_len));
+
+                self.file.write(slice::from_raw_parts(data, len))?;
+
+                left -= len;
+                seg = (*seg).next;
+            }
+        }
+
+        self.file.fill((padded_len - cap_len) as usize + left)?;
+        self.file.write(as_bytes(&[block_len]))?;
+
+        Ok(())
+    }
+
+    /// Flush the written blocks to the file.
+    pub fn flush(&mut self) -> Result<()> {
+        self.file.sync().map_err(From::from)
+    }
+
+    fn write_section_header(&mut self) -> Result<()> {
+        let block_len = 28u32;
+        let mut block = Block::default();
+
+        block.u32(SHB_TYPE).u32(block_len).u32(BYTE_ORDER_MAGIC);
+        block.u16(1).u16(0); // version 1.0
+        block.u64(u64::max_value()); // the section length isn't specified
+        block.u32(block_len);
+
+        self.file.write(block.as_bytes()).map_err(From::from)
+    }
+
+    // the interface of a port, the interface description block is written when it is first used
+    fn interface(&mut self, port_id: u16) -> Result<u32> {
+        if let Some(&if_id) = self.interfaces.get(&port_id) {
+            return Ok(if_id);
+        }
+
+        let block_len = 32u32;
+        let mut block = Block::default();
+
+        block.u32(IDB_TYPE).u32(block_len);
+        block.u16(LINKTYPE_ETHERNET).u16(0).u32(self.snaplen);
+        block.u16(OPT_IF_TSRESOL).u16(1).put(&[TSRESOL_NS, 0, 0, 0]);
+        block.u32(0); // opt_endofopt
+        block.u32(block_len);
+
+        self.file.write(block.as_bytes())?;
+
+        let if_id = self.interfaces.len() as u32;
+
+        self.interfaces.insert(port_id, if_id);
+
+        Ok(if_id)
+    }
+
+    fn timestamp_ns(&self, tsc: u64) -> u64 {
+        let elapsed = tsc.wrapping_sub(self.base_tsc) as i64 as i128;
+
+        (i128::from(self.base_ns) + elapsed * 1_000_000_000 / i128::from(self.tsc_hz)) as u64
+    }
+}
+
+// A block of the header fields in the host byte order, which is the byte order of the section.
+#[derive(Default)]
+struct Block {
+    buf: [u8; 32],
+    len: usize,
+}
+
+impl Block {
+    fn put(&mut self, b: &[u8]) -> &mut Self {
+        self.buf[self.len..self.len + b.len()].copy_from_slice(b);
+        self.len += b.len();
+        self
+    }
+
+    fn u16(&mut self, v: u16) -> &mut Self {
+        self.put(&v.to_ne_bytes())
+    }
+
+    fn u32(&mut self, v: u32) -> &mut Self {
+        self.put(&v.to_ne_bytes())
+    }
+
+    fn u64(&mut self, v: u64) -> &mut Self {
+        self.put(&v.to_ne_bytes())
+    }
+
+    fn as_bytes(&self) -> &[u8] {
+        &self.buf[..self.len]
+    }
+}
+
+fn as_bytes(v: &[u32]) -> &[u8] {
+    unsafe { slice::from_raw_parts(v.as_ptr() as *const u8, v.len() * mem::size_of::<u32>()) }
+}
+
+// A file written sequentially through a memory-mapped window, which is moved forward when it is full.
+struct MmapFile {
+    file: File,
+    map: *mut u8,
+    offset: u64,
+    pos: usize,
+}
+
+// the window is only accessed through the owner of file
+unsafe impl Send for MmapFile {}
+
+impl Drop for MmapFile {
+    fn drop(&mut self) {
+        let _ = self.unmap();
+        let _ = self.file.set_len(self.offset + self.pos as u64);
+    }
+}
+
+impl MmapFile {
+    fn create<P: AsRef<Path>>(path: P) -> io::Result<Self> {
+        let file = OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create(true)
+            .truncate(true)
+            .open(path)?;
+
+        let mut f = MmapFile {
+            file,
+            map: ptr::null_mut(),
+            offset: 0,
+            pos: 0,
+        };
+
+        f.map()?;
+
+        Ok(f)
+    }
+
+    fn write(&mut self, mut buf: &[u8]) -> io::Result<()> {
+        while !buf.is_empty() {
+            if self.pos == MMAP_WINDOW {
+                self.unmap()?;
+                self.offset += MMAP_WINDOW as u64;
+                self.pos = 0;
+                self.map()?;
+            }
+
+            let n = cmp::min(buf.len(), MMAP_WINDOW - self.pos);
+
+            unsafe { ptr::copy_nonoverlapping(buf.as_ptr(), self.map.add(self.pos), n) };
+
+            self.pos += n;
+            buf = &buf[n..];
+        }
+
+        Ok(())
+    }
+
+    fn fill(&mut self, mut n: usize) -> io::Result<()> {
+        const ZEROS: [u8; 64] = [0; 64];
+
+        while n > 0 {
+            let len = cmp::min(n, ZEROS.len());
+
+            self.write(&ZEROS[..len])?;
+
+            n -= len;
+        }
+
+        Ok(())
+    }
+
+    fn sync(&mut self) -> io::Result<()> {
+        if self.map.is_null() || unsafe { libc::msync(self.map as *mut _, self.pos, libc::MS_ASYNC) } == 0 {
+            Ok(())
+        } else {
+            Err(io::Error::last_os_error())
+        }
+    }
+
+    fn map(&mut self) -> io::Result<()> {
+        self.file.set_len(self.offset + MMAP_WINDOW as u64)?;
+
+        let p = unsafe {
+            libc::mmap(
+                ptr::null_mut(),
+                MMAP_WINDOW,
+                libc::PROT_READ | libc::PROT_WRITE,
+                libc::MAP_SHARED,
+                self.file.as_raw_fd(),
+                self.offset as libc::off_t,
+            )
+        };
+
+        if p == libc::MAP_FAILED {
+            Err(io::Error::last_os_error())
+        } else {
+            self.map = p as *mut u8;
+
+            Ok(())
+        }
+    }
+
+    fn unmap(&mut self) -> io::Result<()> {
+        if self.map.is_null() {
+            return Ok(());
+        }
+
+        let ret = unsafe { libc::munmap(self.map as *mut _, MMAP_WINDOW) };
+
+        self.map = ptr::null_mut();
+
+        if ret == 0 {
+            Ok(())
+        } else {
+            Err(io::Error::last_os_error())
+        }
+    }
+}
@@ -0,0 +1,31 @@
+//!
+//! CPU flags of the running CPU
+//!
+//! The vectorized stubs are built for several CPU variants on x86_64,
+//! and the newest one supported by the running CPU is used, see `cpu_variant`.
+//!
+use std::ffi::CStr;
+
+use ffi;
+
+pub use ffi::dispatch::{cpu_variant, CpuVariant};
+pub use ffi::rte_cpu_flag_t::*;
+
+/// The CPU flag ID, e.g. `RTE_CPUFLAG_AVX2`.
+pub type CpuFlag = ffi::rte_cpu_flag_t::Type;
+
+/// Test if the running CPU has a feature.
+pub fn enabled(flag: CpuFlag) -> bool {
+    unsafe { ffi::rte_cpu_get_flag_enabled(flag) > 0 }
+}
+
+/// The name of a CPU flag, or `None` if the flag is invalid.
+pub fn name(flag: CpuFlag) -> Option<&'static str> {
+    let name = unsafe { ffi::rte_cpu_get_flag_name(flag) };
+
+    if name.is_null() {
+        None
+    } else {
+        unsafe { CStr::from_ptr(name) }.to_str().ok()
+    }
+}
@@ -4,9 +4,12 @@ use std::mem;
 use std::os::raw::c_char;
 use std::path::PathBuf;
 use std::ptr;
+use std::sync::atomic::{AtomicBool, Ordering};
 
 use ffi::{self, rte_proc_type_t::*};
+use itertools;
 
+use common::malloc;
 use errors::{AsResult, Result};
 use utils::AsCString;
 
@@ -114,12 +117,313 @@ pub fn init<S: fmt::Debug + AsRef<str>>(args: &[S]) -> Result<i32> {
 
     debug!("EAL parsed {} arguments", parsed);
 
-    parsed.as_result().map(|_| parsed)
+    parsed.as_result().map(|_| {
+        malloc::record_heap_ranges();
+
+        INITIALIZED.store(true, Ordering::Release);
+
+        parsed
+    })
+}
+
+static INITIALIZED: AtomicBool = AtomicBool::new(false);
+
+/// Test if the EAL is initialized, and its huge-page memory could be allocated.
+pub fn initialized() -> bool {
+    INITIALIZED.load(Ordering::Acquire)
+}
+
+/// A typed builder of the EAL arguments.
+///
+/// The startup time is dominated by mapping and zeroing the hugepages,
+/// which could be reduced by reserving less memory up front, e.g. with `socket_limit` and `in_memory`.
+///
+/// ```no_run
+/// # extern crate rte;
+/// # use rte::eal;
+/// # fn main() {
+/// eal::Builder::new("l2fwd")
+///     .lcores("0-3")
+///     .in_memory()
+///     .socket_mem(&[512])
+///     .socket_limit(&[1024])
+///     .vdev("net_null0")
+///     .init()
+///     .expect("fail to initial EAL");
+/// # }
+/// ```
+#[derive(Clone, Debug, Default)]
+pub struct Builder {
+    program: String,
+    lcores: Option<String>,
+    master_lcore: Option<u32>,
+    memory_channels: Option<u32>,
+    memory: Option<usize>,
+    socket_mem: Vec<usize>,
+    socket_limit: Vec<usize>,
+    in_memory: bool,
+    legacy_mem: bool,
+    no_huge: bool,
+    huge_dir: Option<PathBuf>,
+    huge_unlink: bool,
+    single_file_segments: bool,
+    file_prefix: Option<String>,
+    proc_type: Option<ProcType>,
+    no_pci: bool,
+    pci_whitelist: Vec<String>,
+    pci_blacklist: Vec<String>,
+    vdevs: Vec<String>,
+    log_level: Option<u32>,
+    args: Vec<String>,
+}
+
+impl Builder {
+    /// Create a builder for the program, which is used as `argv[0]`.
+    pub fn new<S: Into<String>>(program: S) -> Self {
+        Builder {
+            program: program.into(),
+            ..Default::default()
+        }
+    }
+
+    /// The list of lcores to run on, e.g. `0-3,8`.
+    pub fn lcores<S: Into<String>>(mut self, lcores: S) -> Self {
+        self.lcores = Some(lcores.into());
+        self
+    }
+
+    /// The lcore ID of master lcore.
+    pub fn master_lcore(mut self, lcore_id: u32) -> Self {
+        self.master_lcore = Some(lcore_id);
+        self
+    }
+
+    /// The number of memory channels.
+    pub fn memory_channels(mut self, n: u32) -> Self {
+        self.memory_channels = Some(n);
+        self
+    }
+
+    /// The memory in megabytes to preallocate, regardless of the NUMA sockets.
+    pub fn memory(mut self, mb: usize) -> Self {
+        self.memory = Some(mb);
+        self
+    }
+
+    /// The memory in megabytes to preallocate on each NUMA socket.
+    pub fn socket_mem(mut self, mb: &[usize]) -> Self {
+        self.socket_mem = mb.to_vec();
+        self
+    }
+
+    /// The upper limit of memory in megabytes on each NUMA socket, which is allocated on demand.
+    ///
+    /// It is not supported with the legacy memory mode.
+    pub fn socket_limit(mut self, mb: &[usize]) -> Self {
+        self.socket_limit = mb.to_vec();
+        self
+    }
+
+    /// Don't create any shared data structures and hugepage files, which implies `no_shconf`.
+    ///
+    /// The secondary processes could not attach to it.
+    pub fn in_memory(mut self) -> Self {
+        self.in_memory = true;
+        self
+    }
+
+    /// Map all the hugepages at startup and never release them, instead of allocating memory on demand.
+    pub fn legacy_mem(mut self, legacy: bool) -> Self {
+        self.legacy_mem = legacy;
+        self
+    }
+
+    /// Use the anonymous memory instead of hugepages, which implies `no_shconf`.
+    pub fn no_huge(mut self) -> Self {
+        self.no_huge = true;
+        self
+    }
+
+    /// The directory where the hugetlbfs is mounted.
+    pub fn huge_dir<P: Into<PathBuf>>(mut self, dir: P) -> Self {
+        self.huge_dir = Some(dir.into());
+        self
+    }
+
+    /// Unlink the hugepage files after mapping them.
+    pub fn huge_unlink(mut self) -> Self {
+        self.huge_unlink = true;
+        self
+    }
+
+    /// Put all the hugepages of a memseg list into a single file.
+    pub fn single_file_segments(mut self) -> Self {
+        self.single_file_segments = true;
+        self
+    }
+
+    /// The prefix of hugepage files and runtime directory, which is shared by the primary and secondary processes.
+    pub fn file_prefix<S: Into<String>>(mut self, prefix: S) -> Self {
+        self.file_prefix = Some(prefix.into());
+        self
+    }
+
+    /// The type of process, e.g. `ProcType::Secondary` for a hot standby attached to the primary process.
+    pub fn proc_type(mut self, proc_type: ProcType) -> Self {
+        self.proc_type = Some(proc_type);
+        self
+    }
+
+    /// Disable the PCI bus.
+    pub fn no_pci(mut self) -> Self {
+        self.no_pci = true;
+        self
+    }
+
+    /// Only use the PCI device, e.g. `0000:02:00.0`.
+    pub fn pci_whitelist<S: Into<String>>(mut self, dev: S) -> Self {
+        self.pci_whitelist.push(dev.into());
+        self
+    }
+
+    /// Skip the PCI device, e.g. `0000:02:00.0`.
+    pub fn pci_blacklist<S: Into<String>>(mut self, dev: S) -> Self {
+        self.pci_blacklist.push(dev.into());
+        self
+    }
+
+    /// Add a virtual device, e.g. `net_ring0`.
+    pub fn vdev<S: Into<String>>(mut self, dev: S) -> Self {
+        self.vdevs.push(dev.into());
+        self
+    }
+
+    /// The global log level.
+    pub fn log_level(mut self, level: u32) -> Self {
+        self.log_level = Some(level);
+        self
+    }
+
+    /// Append the other EAL arguments.
+    pub fn args<I, S>(mut self, args: I) -> Self
+    where
+        I: IntoIterator<Item = S>,
+        S: Into<String>,
+    {
+        self.args.extend(args.into_iter().map(|arg| arg.into()));
+        self
+    }
+
+    /// Build the EAL arguments, including `argv[0]`.
+    pub fn build(&self) -> Vec<String> {
+        let join = |mb: &[usize]| itertools::join(mb, ",");
+        let mut args = vec![self.program.clone()];
+
+        if let Some(ref lcores) = self.lcores {
+            args.push(format!("-l{}", lcores));
+        }
+        if let Some(lcore_id) = self.master_lcore {
+            args.push(format!("--master-lcore={}", lcore_id));
+        }
+        if let Some(n) = self.memory_channels {
+            args.push(format!("-n{}", n));
+        }
+        if let Some(mb) = self.memory {
+            args.push(format!("-m{}", mb));
+        }
+        if !self.socket_mem.is_empty() {
+            args.push(format!("--socket-mem={}", join(&self.socket_mem)));
+        }
+        if !self.socket_limit.is_empty() {
+            args.push(format!("--socket-limit={}", join(&self.socket_limit)));
+        }
+        if self.in_memory {
+            args.push("--in-memory".to_owned());
+        }
+        if self.legacy_mem {
+            args.push("--legacy-mem".to_owned());
+        }
+        if self.no_huge {
+            args.push("--no-huge".to_owned());
+        }
+        if let Some(ref dir) = self.huge_dir {
+            args.push(format!("--huge-dir={}", dir.display()));
+        }
+        if self.huge_unlink {
+            args.push("--huge-unlink".to_owned());
+        }
+        if self.single_file_segments {
+            args.push("--single-file-segments".to_owned());
+        }
+        if let Some(ref prefix) = self.file_prefix {
+            args.push(format!("--file-prefix={}", prefix));
+        }
+        if let Some(proc_type) = self.proc_type {
+            args.push(format!(
+                "--proc-type={}",
+                match proc_type {
+                    ProcType::Primary => "primary",
+                    ProcType::Secondary => "secondary",
+                    _ => "auto",
+                }
+            ));
+        }
+        if self.no_pci {
+            args.push("--no-pci".to_owned());
+        }
+        for dev in &self.pci_whitelist {
+            args.push(format!("-w{}", dev));
+        }
+        for dev in &self.pci_blacklist {
+            args.push(format!("-b{}", dev));
+        }
+        for dev in &self.vdevs {
+            args.push(format!("--vdev={}", dev));
+        }
+        if let Some(level) = self.log_level {
+            args.push(format!("--log-level={}", level));
+        }
+
+        args.extend(self.args.iter().cloned());
+        args
+    }
+
+    /// Initialize the EAL with the arguments.
+    pub fn init(&self) -> Result<i32> {
+        init(&self.build())
+    }
+}
+
+/// Look up a shared object of the primary process, or create it if not found in the primary process.
+///
+/// A secondary process, e.g. a hot standby started with `ProcType::Auto` and the same `file_prefix`,
+/// takes over the mempools, rings and memzones of the primary process without re-initializing them.
+pub fn lookup_or_create<T, L, C>(lookup: L, create: C) -> Result<T>
+where
+    L: FnOnce() -> Result<T>,
+    C: FnOnce() -> Result<T>,
+{
+    match process_type() {
+        ProcType::Secondary => lookup(),
+        _ => lookup().or_else(|_| create()),
+    }
 }
 
 /// Clean up the Environment Abstraction Layer (EAL)
+///
+/// The later allocations of `malloc::RteAllocator` are served by the system allocator,
+/// while the memory allocated before is still freed to the huge-page heap.
 pub fn cleanup() -> Result<()> {
-    unsafe { ffi::rte_eal_cleanup() }.as_result().map(|_| ())
+    INITIALIZED.store(false, Ordering::Release);
+
+    unsafe { ffi::rte_eal_cleanup() }
+        .as_result()
+        .map(|_| ())
+        .map_err(|err| {
+            INITIALIZED.store(true, Ordering::Release);
+
+            err
+        })
 }
 
 /// Function to terminate the application immediately,
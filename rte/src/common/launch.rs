@@ -46,6 +46,12 @@ pub fn remote_launch<T>(callback: LcoreFunc<T>, arg: Option<T>, slave_id: lcore:
     unsafe { ffi::rte_eal_remote_launch(Some(lcore_stub::<T>), ctxt, *slave_id) }
         .as_result()
         .map(|_| ())
+        .map_err(|err| {
+            // the lcore is busy and will never take the context
+            drop(unsafe { Box::from_raw(ctxt as *mut LcoreContext<T>) });
+
+            err
+        })
 }
 
 /// Launch a function on all lcores.
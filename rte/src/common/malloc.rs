@@ -1,12 +1,20 @@
+#[cfg(feature = "allocator-api")]
+use std::alloc::{AllocError, Allocator};
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::cmp;
 use std::mem;
-use std::os::raw::c_void;
+use std::os::raw::{c_int, c_void};
 use std::os::unix::io::AsRawFd;
-use std::ptr;
+use std::ptr::{self, NonNull};
+use std::sync::atomic::{AtomicUsize, Ordering};
 
 use cfile;
 
 use ffi;
 
+use eal;
+use memory::{SocketId, SOCKET_ID_ANY};
+
 #[macro_export]
 macro_rules! rte_new {
     ($t:ty) => {
@@ -134,3 +142,196 @@ pub fn dump_stats<S: AsRawFd>(s: &S, tag: Option<&str>) {
         }
     }
 }
+
+const MAX_HEAP_RANGES: usize = ffi::RTE_MAX_MEMSEG_LISTS as usize;
+
+#[allow(clippy::declare_interior_mutable_const)]
+const NO_ADDR: AtomicUsize = AtomicUsize::new(0);
+
+// The virtual areas reserved for the memseg lists, they are recorded when the EAL is initialized,
+// so the memory of the huge-page heap is still recognized by its address after the EAL is cleaned up.
+static HEAP_STARTS: [AtomicUsize; MAX_HEAP_RANGES] = [NO_ADDR; MAX_HEAP_RANGES];
+static HEAP_ENDS: [AtomicUsize; MAX_HEAP_RANGES] = [NO_ADDR; MAX_HEAP_RANGES];
+static HEAP_RANGES: AtomicUsize = AtomicUsize::new(0);
+
+/// Record the virtual areas of the huge-page memory, called once the EAL is initialized.
+pub(crate) fn record_heap_ranges() {
+    unsafe extern "C" fn record(msl: *const ffi::rte_memseg_list, _arg: *mut c_void) -> c_int {
+        let start = (*msl).__bindgen_anon_1.base_va as usize;
+        let end = start + (*msl).len;
+        let n = HEAP_RANGES.load(Ordering::Acquire);
+
+        if n < MAX_HEAP_RANGES && !in_heap_ranges(start as *const _) {
+            HEAP_STARTS[n].store(start, Ordering::Relaxed);
+            HEAP_ENDS[n].store(end, Ordering::Relaxed);
+            HEAP_RANGES.store(n + 1, Ordering::Release);
+        }
+
+        0
+    }
+
+    unsafe {
+        ffi::rte_memseg_list_walk(Some(record), ptr::null_mut());
+    }
+}
+
+#[inline]
+fn in_heap_ranges(ptr: *const c_void) -> bool {
+    let addr = ptr as usize;
+    let n = HEAP_RANGES.load(Ordering::Acquire);
+
+    (0..n).any(|i| HEAP_STARTS[i].load(Ordering::Relaxed) <= addr && addr < HEAP_ENDS[i].load(Ordering::Relaxed))
+}
+
+/// Test if the memory is allocated from the huge-page memory of the EAL.
+///
+/// After the EAL is cleaned up, the memory is recognized by the address ranges recorded when it was initialized.
+#[inline]
+pub fn is_rte_memory(ptr: *const c_void) -> bool {
+    if eal::initialized() {
+        unsafe { !ffi::rte_mem_virt2memseg_list(ptr).is_null() }
+    } else {
+        in_heap_ranges(ptr)
+    }
+}
+
+/// A NUMA-aware allocator over the huge-page heap.
+///
+/// It could be used as the global allocator, the memory allocated before the EAL is initialized
+/// is served by the system allocator, and freed by it whenever it is released.
+/// The memory of the huge-page heap is always freed to it, even after the EAL is cleaned up.
+///
+/// ```no_run
+/// # extern crate rte;
+/// use rte::malloc::RteAllocator;
+///
+/// #[global_allocator]
+/// static ALLOC: RteAllocator = RteAllocator::new();
+/// # fn main() {}
+/// ```
+///
+/// With the `allocator-api` feature, it also implements `Allocator`,
+/// e.g. `Vec::with_capacity_in(n, RteAllocator::on_socket(dev.socket_id()))`.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct RteAllocator {
+    socket_id: SocketId,
+}
+
+impl Default for RteAllocator {
+    fn default() -> Self {
+        RteAllocator::new()
+    }
+}
+
+impl RteAllocator {
+    /// Allocate the memory on the NUMA socket of the calling lcore.
+    pub const fn new() -> Self {
+        RteAllocator::on_socket(SOCKET_ID_ANY)
+    }
+
+    /// Allocate the memory on a NUMA socket.
+    pub const fn on_socket(socket_id: SocketId) -> Self {
+        RteAllocator { socket_id }
+    }
+
+    /// The NUMA socket of the memory allocated.
+    pub fn socket_id(&self) -> SocketId {
+        self.socket_id
+    }
+
+    #[inline]
+    unsafe fn rte_alloc(&self, layout: Layout, zeroed: bool) -> *mut u8 {
+        let align = layout.align() as u32;
+
+        if zeroed {
+            ffi::rte_zmalloc_socket(ptr::null(), layout.size(), align, self.socket_id) as *mut u8
+        } else {
+            ffi::rte_malloc_socket(ptr::null(), layout.size(), align, self.socket_id) as *mut u8
+        }
+    }
+}
+
+unsafe impl GlobalAlloc for RteAllocator {
+    #[inline]
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        if eal::initialized() {
+            self.rte_alloc(layout, false)
+        } else {
+            System.alloc(layout)
+        }
+    }
+
+    #[inline]
+    unsafe fn alloc_zeroed(&self, layout: Layout) -> *mut u8 {
+        if eal::initialized() {
+            self.rte_alloc(layout, true)
+        } else {
+            System.alloc_zeroed(layout)
+        }
+    }
+
+    #[inline]
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        if is_rte_memory(ptr as *const _) {
+            ffi::rte_free(ptr as *mut _)
+        } else {
+            System.dealloc(ptr, layout)
+        }
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        if is_rte_memory(ptr as *const _) {
+            // the new area resides on the same NUMA socket as the old one
+            ffi::rte_realloc(ptr as *mut _, new_size, layout.align() as u32) as *mut u8
+        } else if eal::initialized() {
+            // move the memory allocated before the EAL is initialized to the huge-page heap
+            let new_ptr = self.rte_alloc(Layout::from_size_align_unchecked(new_size, layout.align()), false);
+
+            if !new_ptr.is_null() {
+                ptr::copy_nonoverlapping(ptr, new_ptr, cmp::min(layout.size(), new_size));
+
+                System.dealloc(ptr, layout);
+            }
+
+            new_ptr
+        } else {
+            System.realloc(ptr, layout, new_size)
+        }
+    }
+}
+
+#[cfg(feature = "allocator-api")]
+unsafe impl Allocator for RteAllocator {
+    #[inline]
+    fn allocate(&self, layout: Layout) -> ::std::result::Result<NonNull<[u8]>, AllocError> {
+        self.allocate_with(layout, false)
+    }
+
+    #[inline]
+    fn allocate_zeroed(&self, layout: Layout) -> ::std::result::Result<NonNull<[u8]>, AllocError> {
+        self.allocate_with(layout, true)
+    }
+
+    #[inline]
+    unsafe fn deallocate(&self, ptr: NonNull<u8>, layout: Layout) {
+        if layout.size() != 0 {
+            ffi::rte_free(ptr.as_ptr() as *mut _)
+        }
+    }
+}
+
+#[cfg(feature = "allocator-api")]
+impl RteAllocator {
+    #[inline]
+    fn allocate_with(&self, layout: Layout, zeroed: bool) -> ::std::result::Result<NonNull<[u8]>, AllocError> {
+        // `rte_malloc` returns NULL for the empty allocations
+        let ptr = if layout.size() == 0 {
+            NonNull::new(layout.align() as *mut u8)
+        } else {
+            NonNull::new(unsafe { self.rte_alloc(layout, zeroed) })
+        };
+
+        ptr.map(|ptr| NonNull::slice_from_raw_parts(ptr, layout.size()))
+            .ok_or(AllocError)
+    }
+}
@@ -1,7 +1,17 @@
+use std::os::raw::c_void;
+
+use ffi;
+
 pub type SocketId = i32;
 
 pub const SOCKET_ID_ANY: SocketId = -1;
 
+/// Copy `n` bytes with the `rte_memcpy` variant of the running CPU, the locations must not overlap.
+#[inline]
+pub unsafe fn memcpy(dst: *mut c_void, src: *const c_void, n: usize) -> *mut c_void {
+    ffi::dispatch::memcpy(dst, src, n)
+}
+
 pub trait AsRef<'a, T: 'a> {
     fn as_ref(self) -> Option<&'a T>;
 }
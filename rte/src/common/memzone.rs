@@ -1,4 +1,44 @@
-use ffi::rte_memzone;
+use std::alloc::Layout;
+#[cfg(feature = "allocator-api")]
+use std::alloc::{AllocError, Allocator};
+use std::cell::Cell;
+use std::ffi::CStr;
+use std::os::raw::c_void;
+use std::ptr::{self, NonNull};
+use std::slice;
+
+use ffi::{self, rte_memzone};
+use libc;
+
+use eal;
+use errors::{Result, RteError};
+use memory::SocketId;
+use utils::AsCString;
+
+bitflags! {
+    pub struct MemoryZoneFlags: u32 {
+        /// Reserve from 2MB pages
+        const RTE_MEMZONE_2MB = ffi::RTE_MEMZONE_2MB;
+        /// Reserve from 1GB pages
+        const RTE_MEMZONE_1GB = ffi::RTE_MEMZONE_1GB;
+        /// Reserve from 16MB pages
+        const RTE_MEMZONE_16MB = ffi::RTE_MEMZONE_16MB;
+        /// Reserve from 16GB pages
+        const RTE_MEMZONE_16GB = ffi::RTE_MEMZONE_16GB;
+        /// Reserve from 256KB pages
+        const RTE_MEMZONE_256KB = ffi::RTE_MEMZONE_256KB;
+        /// Reserve from 256MB pages
+        const RTE_MEMZONE_256MB = ffi::RTE_MEMZONE_256MB;
+        /// Reserve from 512MB pages
+        const RTE_MEMZONE_512MB = ffi::RTE_MEMZONE_512MB;
+        /// Reserve from 4GB pages
+        const RTE_MEMZONE_4GB = ffi::RTE_MEMZONE_4GB;
+        /// Use the page size flags as a hint, reserve from another page size if not available
+        const RTE_MEMZONE_SIZE_HINT_ONLY = ffi::RTE_MEMZONE_SIZE_HINT_ONLY;
+        /// The memzone must be IOVA-contiguous
+        const RTE_MEMZONE_IOVA_CONTIG = ffi::RTE_MEMZONE_IOVA_CONTIG;
+    }
+}
 
 /// RTE Memzone
 ///
@@ -14,8 +54,243 @@ use ffi::rte_memzone;
 /// A reserved memory zone cannot be unreserved.
 /// The reservation shall be done at initialization time only.
 ///
+#[derive(Debug)]
 pub struct MemoryZone(*const rte_memzone);
 
 pub fn from_raw(zone: *const rte_memzone) -> MemoryZone {
     MemoryZone(zone)
 }
+
+/// Reserve a portion of physical memory aligned on `align` bytes, which must be a power of two.
+pub fn reserve<S: AsRef<str>>(
+    name: S,
+    len: usize,
+    socket_id: SocketId,
+    flags: MemoryZoneFlags,
+    align: u32,
+) -> Result<MemoryZone> {
+    let name = name.as_cstring();
+
+    let mz = unsafe { ffi::rte_memzone_reserve_aligned(name.as_ptr(), len, socket_id, flags.bits, align) };
+
+    rte_check!(mz, NonNull; ok => { MemoryZone(mz) })
+}
+
+/// Lookup for a memzone by its name.
+pub fn lookup<S: AsRef<str>>(name: S) -> Option<MemoryZone> {
+    let name = name.as_cstring();
+    let mz = unsafe { ffi::rte_memzone_lookup(name.as_ptr()) };
+
+    if mz.is_null() {
+        None
+    } else {
+        Some(MemoryZone(mz))
+    }
+}
+
+/// Lookup for a memzone reserved by the primary process, or reserve it if not found in the primary process.
+pub fn lookup_or_reserve<S: AsRef<str>>(
+    name: S,
+    len: usize,
+    socket_id: SocketId,
+    flags: MemoryZoneFlags,
+    align: u32,
+) -> Result<MemoryZone> {
+    eal::lookup_or_create(
+        || lookup(&name).ok_or_else(|| RteError(libc::ENOENT).into()),
+        || reserve(&name, len, socket_id, flags, align),
+    )
+}
+
+impl MemoryZone {
+    fn raw(&self) -> &rte_memzone {
+        unsafe { &*self.0 }
+    }
+
+    /// Name of the memory zone.
+    pub fn name(&self) -> &str {
+        unsafe { CStr::from_ptr(self.raw().name.as_ptr()) }
+            .to_str()
+            .unwrap_or_default()
+    }
+
+    /// Start virtual address.
+    pub fn addr(&self) -> *mut c_void {
+        unsafe { self.raw().__bindgen_anon_2.addr }
+    }
+
+    /// Start IO address.
+    pub fn iova(&self) -> ffi::rte_iova_t {
+        unsafe { self.raw().__bindgen_anon_1.iova }
+    }
+
+    /// Length of the memzone.
+    pub fn len(&self) -> usize {
+        self.raw().len
+    }
+
+    /// The page size of underlying memory
+    pub fn hugepage_sz(&self) -> u64 {
+        self.raw().hugepage_sz
+    }
+
+    /// NUMA socket ID.
+    pub fn socket_id(&self) -> SocketId {
+        self.raw().socket_id
+    }
+
+    /// Characteristics of this memzone.
+    pub fn flags(&self) -> u32 {
+        self.raw().flags
+    }
+
+    /// Free a memzone, which was reserved by this process.
+    ///
+    /// # Safety
+    ///
+    /// The memzone could be looked up by its name, the caller must ensure that
+    /// it is not used through any other handle, e.g. the one of an `Arena`.
+    pub unsafe fn free(self) -> Result<()> {
+        let ret = ffi::rte_memzone_free(self.0);
+
+        rte_check!(ret)
+    }
+}
+
+/// A bump allocator over a memzone, e.g. the per-lcore scratch memory of a burst.
+///
+/// The allocations are only released all together by `reset`, which is usually called after each burst,
+/// and the destructors of the values allocated are never run.
+///
+/// The arena is owned by one lcore at a time, and the memzone is freed when it is dropped.
+pub struct Arena {
+    zone: MemoryZone,
+    base: NonNull<u8>,
+    len: usize,
+    pos: Cell<usize>,
+}
+
+unsafe impl Send for Arena {}
+
+impl Drop for Arena {
+    fn drop(&mut self) {
+        let _ = unsafe { ffi::rte_memzone_free(self.zone.0) };
+    }
+}
+
+impl Arena {
+    /// Reserve an arena of `len` bytes on a NUMA socket.
+    pub fn reserve<S: AsRef<str>>(name: S, len: usize, socket_id: SocketId) -> Result<Arena> {
+        let zone = reserve(name, len, socket_id, MemoryZoneFlags::empty(), ffi::RTE_CACHE_LINE_SIZE)?;
+        let base = unsafe { NonNull::new_unchecked(zone.addr() as *mut u8) };
+        let len = zone.len();
+
+        Ok(Arena {
+            zone,
+            base,
+            len,
+            pos: Cell::new(0),
+        })
+    }
+
+    /// The memzone of arena, which is freed when the arena is dropped.
+    pub fn zone(&self) -> &MemoryZone {
+        &self.zone
+    }
+
+    /// The size of arena in bytes.
+    pub fn capacity(&self) -> usize {
+        self.len
+    }
+
+    /// The bytes allocated since the last reset.
+    pub fn used(&self) -> usize {
+        self.pos.get()
+    }
+
+    /// The bytes could be allocated, regardless of the alignment.
+    pub fn remaining(&self) -> usize {
+        self.len - self.pos.get()
+    }
+
+    /// Release all the allocations at once.
+    #[inline]
+    pub fn reset(&mut self) {
+        self.pos.set(0)
+    }
+
+    /// Allocate a block of memory, or `None` if the arena is exhausted.
+    #[inline]
+    pub fn alloc(&self, layout: Layout) -> Option<NonNull<u8>> {
+        let base = self.base.as_ptr() as usize;
+        let start = (base + self.pos.get() + layout.align() - 1) & !(layout.align() - 1);
+        let end = start.checked_add(layout.size())?;
+
+        if end > base + self.len {
+            None
+        } else {
+            self.pos.set(end - base);
+
+            NonNull::new(start as *mut u8)
+        }
+    }
+
+    /// Move a value into the arena.
+    #[inline]
+    #[allow(clippy::mut_from_ref)]
+    pub fn alloc_value<T>(&self, value: T) -> Option<&mut T> {
+        self.alloc(Layout::new::<T>()).map(|p| unsafe {
+            let p = p.as_ptr() as *mut T;
+
+            ptr::write(p, value);
+
+            &mut *p
+        })
+    }
+
+    /// Allocate a slice of `len` elements, which are initialized to `value`.
+    #[inline]
+    #[allow(clippy::mut_from_ref)]
+    pub fn alloc_slice<T: Copy>(&self, len: usize, value: T) -> Option<&mut [T]> {
+        let layout = Layout::array::<T>(len).ok()?;
+
+        self.alloc(layout).map(|p| unsafe {
+            let p = p.as_ptr() as *mut T;
+
+            for i in 0..len {
+                ptr::write(p.add(i), value);
+            }
+
+            slice::from_raw_parts_mut(p, len)
+        })
+    }
+
+    /// Copy a slice into the arena.
+    #[inline]
+    #[allow(clippy::mut_from_ref)]
+    pub fn alloc_slice_copy<T: Copy>(&self, src: &[T]) -> Option<&mut [T]> {
+        let layout = Layout::array::<T>(src.len()).ok()?;
+
+        self.alloc(layout).map(|p| unsafe {
+            let p = p.as_ptr() as *mut T;
+
+            ptr::copy_nonoverlapping(src.as_ptr(), p, src.len());
+
+            slice::from_raw_parts_mut(p, src.len())
+        })
+    }
+}
+
+/// The collections could be allocated in the arena, e.g. `Vec::with_capacity_in(n, &arena)`.
+#[cfg(feature = "allocator-api")]
+unsafe impl<'a> Allocator for &'a Arena {
+    #[inline]
+    fn allocate(&self, layout: Layout) -> ::std::result::Result<NonNull<[u8]>, AllocError> {
+        self.alloc(layout)
+            .map(|p| NonNull::slice_from_raw_parts(p, layout.size()))
+            .ok_or(AllocError)
+    }
+
+    #[inline]
+    unsafe fn deallocate(&self, _ptr: NonNull<u8>, _layout: Layout) {}
+}
@@ -1,5 +1,6 @@
 pub mod bitmap;
 mod config;
+pub mod cpuflags;
 pub mod eal;
 pub mod keepalive;
 pub mod launch;
@@ -19,6 +20,7 @@ pub mod byteorder;
 mod cycles;
 pub mod memory;
 pub mod memzone;
+pub mod prefetch;
 
 pub use self::config::{config, Config, MemoryConfig};
 pub use self::cycles::*;
@@ -0,0 +1,49 @@
+//! Prefetch operations.
+//!
+//! Prefetch a cache line into all cache levels, or with non-temporal hint,
+//! like `rte_prefetch0()`, `rte_prefetch1()`, `rte_prefetch2()` and `rte_prefetch_non_temporal()`.
+//!
+#[cfg(target_arch = "x86")]
+use std::arch::x86::{_mm_prefetch, _MM_HINT_NTA, _MM_HINT_T0, _MM_HINT_T1, _MM_HINT_T2};
+#[cfg(target_arch = "x86_64")]
+use std::arch::x86_64::{_mm_prefetch, _MM_HINT_NTA, _MM_HINT_T0, _MM_HINT_T1, _MM_HINT_T2};
+
+/// Prefetch a cache line into all cache levels.
+#[inline(always)]
+pub fn prefetch0<T>(p: *const T) {
+    #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+    unsafe {
+        _mm_prefetch::<_MM_HINT_T0>(p as *const i8)
+    }
+}
+
+/// Prefetch a cache line into all cache levels except the 0th cache level.
+#[inline(always)]
+pub fn prefetch1<T>(p: *const T) {
+    #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+    unsafe {
+        _mm_prefetch::<_MM_HINT_T1>(p as *const i8)
+    }
+}
+
+/// Prefetch a cache line into all cache levels except the 0th and 1th cache levels.
+#[inline(always)]
+pub fn prefetch2<T>(p: *const T) {
+    #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+    unsafe {
+        _mm_prefetch::<_MM_HINT_T2>(p as *const i8)
+    }
+}
+
+/// Prefetch a cache line into all cache levels (non-temporal/transient version)
+///
+/// The non-temporal prefetch is intended as a prefetch hint that processor will
+/// use the prefetched data only once or short period, unlike the `prefetch0()` function
+/// which imply that prefetched data to use repeatedly.
+#[inline(always)]
+pub fn prefetch_non_temporal<T>(p: *const T) {
+    #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+    unsafe {
+        _mm_prefetch::<_MM_HINT_NTA>(p as *const i8)
+    }
+}
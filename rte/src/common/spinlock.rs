@@ -34,6 +34,20 @@ impl<'a, T: LockImpl> Drop for LockGuard<'a, T> {
     }
 }
 
+impl<T: LockImpl> Lock<T>
+where
+    T::RawLock: Default,
+{
+    /// Create a spinlock in an unlocked state.
+    pub fn new() -> Self {
+        let mut lock = Lock::<T>(Default::default());
+
+        lock.init();
+
+        lock
+    }
+}
+
 impl<T: LockImpl> Deref for Lock<T> {
     type Target = T::RawLock;
 
@@ -0,0 +1,265 @@
+//!
+//! RTE Packet Distributor
+//!
+//! The distributor lcore receives the packets and hands them out to the worker lcores on demand,
+//! which balances the flows that RSS can't spread, e.g. a few elephant flows pinned to a queue.
+//!
+//! The packets with the same tag, see `MBuf::set_tag`, are never processed by two workers at the same time,
+//! so the order of a flow is kept. The tag shares the field of the RSS hash,
+//! which is used as is when the NIC fills it.
+//!
+//! Each `Worker` is moved to an lcore, e.g. as the argument of `launch::remote_launch`,
+//! and the `Distributor` stays on the lcore polling the ports.
+//!
+use std::os::raw::c_uint;
+use std::ptr::{self, NonNull};
+
+use ffi;
+
+use errors::{AsResult, Result, RteError};
+use mbuf::{MBufBatch, RawMBufPtr, RxBurst, TxBurst};
+use memory::SocketId;
+use utils::AsCString;
+
+/// The maximum length of distributor name.
+pub const DISTRIBUTOR_NAMESIZE: usize = ffi::RTE_DISTRIBUTOR_NAMESIZE as usize;
+
+/// The maximum number of packets a worker gets or returns at once.
+pub const DIST_BURST_SIZE: usize = 8;
+
+/// The packets of a worker.
+pub type WorkerBurst = MBufBatch<DIST_BURST_SIZE>;
+
+/// The algorithm to distribute packets.
+#[repr(u32)]
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum Algorithm {
+    /// Hand out a single packet at a time.
+    Single = ffi::RTE_DIST_ALG_SINGLE,
+    /// Hand out up to `DIST_BURST_SIZE` packets at a time, matching the flows with vector instructions.
+    Burst = ffi::RTE_DIST_ALG_BURST,
+}
+
+/// A packet distributor, which is used by a single lcore.
+pub struct Distributor(NonNull<ffi::rte_distributor>);
+
+unsafe impl Send for Distributor {}
+
+impl Distributor {
+    /// Create a distributor with `num_workers` workers.
+    ///
+    /// The distributor lives in the hugepage memory until the process exits.
+    pub fn create<S: AsRef<str>>(
+        name: S,
+        socket_id: SocketId,
+        num_workers: usize,
+        alg: Algorithm,
+    ) -> Result<(Distributor, Vec<Worker>)> {
+        let name = name.as_cstring();
+
+        let d = unsafe {
+            ffi::rte_distributor_create(name.as_ptr(), socket_id as c_uint, num_workers as c_uint, alg as c_uint)
+        }
+        .as_result()?;
+
+        let workers = (0..num_workers as u32).map(|id| Worker { d, id, alg }).collect();
+
+        Ok((Distributor(d), workers))
+    }
+
+    /// Hand out the pending packets to the workers.
+    ///
+    /// The packets are taken by the distributor, and backlogged until the workers request them.
+    /// Call it with no packets to hand out the backlog when there isn't any packet received.
+    #[inline]
+    pub fn process<B: TxBurst + ?Sized>(&mut self, pkts: &mut B) -> usize {
+        unsafe {
+            let n = {
+                let pending = pkts.pending();
+
+                ffi::rte_distributor_process(self.0.as_ptr(), pending.as_mut_ptr(), pending.len() as c_uint)
+            };
+
+            let n = n.max(0) as usize;
+
+            pkts.sent(n);
+
+            n
+        }
+    }
+
+    /// Take the packets returned by the workers to `out`, in the order they were received.
+    #[inline]
+    pub fn returned_pkts<B: RxBurst + ?Sized>(&mut self, out: &mut B) -> usize {
+        unsafe {
+            let n = {
+                let spare = out.spare();
+
+                ffi::rte_distributor_returned_pkts(self.0.as_ptr(), spare.as_mut_ptr(), spare.len() as c_uint)
+            };
+
+            let n = n.max(0) as usize;
+
+            out.filled(n);
+
+            n
+        }
+    }
+
+    /// Hand out all the in-flight and backlogged packets, and wait until the workers have processed them.
+    ///
+    /// The workers must be still requesting packets, it returns the number of packets flushed.
+    pub fn flush(&mut self) -> usize {
+        unsafe { ffi::rte_distributor_flush(self.0.as_ptr()) as usize }
+    }
+
+    /// Clear the returned packets, which are not freed.
+    pub fn clear_returns(&mut self) {
+        unsafe { ffi::rte_distributor_clear_returns(self.0.as_ptr()) }
+    }
+}
+
+/// A worker of distributor, which is used by a single lcore.
+pub struct Worker {
+    d: NonNull<ffi::rte_distributor>,
+    id: u32,
+    alg: Algorithm,
+}
+
+unsafe impl Send for Worker {}
+
+impl Worker {
+    /// The worker ID.
+    #[inline]
+    pub fn id(&self) -> u32 {
+        self.id
+    }
+
+    /// The packets returned at once, which is at most one in the single mode.
+    #[inline]
+    fn max_returns(&self) -> usize {
+        match self.alg {
+            Algorithm::Single => 1,
+            Algorithm::Burst => DIST_BURST_SIZE,
+        }
+    }
+
+    /// Return the processed packets in `done`, and wait for the new packets to `pkts`.
+    ///
+    /// The packets left in `pkts` are freed first, since the new packets fill the whole burst.
+    /// At most `DIST_BURST_SIZE` packets are returned, or a single one in the single mode,
+    /// it returns the number of new packets.
+    #[inline]
+    pub fn get_pkts<B: TxBurst + ?Sized>(&mut self, pkts: &mut WorkerBurst, done: &mut B) -> usize {
+        pkts.clear();
+
+        unsafe {
+            let (n, nb_done) = {
+                let mut empty = [ptr::null_mut(); 1];
+                let (oldpkt, nb_done) = returns(done.pending(), self.max_returns(), &mut empty);
+
+                (
+                    ffi::rte_distributor_get_pkt(
+                        self.d.as_ptr(),
+                        self.id,
+                        pkts.spare().as_mut_ptr(),
+                        oldpkt,
+                        nb_done as c_uint,
+                    ),
+                    nb_done,
+                )
+            };
+
+            if n < 0 {
+                return 0;
+            }
+
+            done.sent(nb_done);
+
+            let n = n as usize;
+
+            pkts.filled(n);
+
+            n
+        }
+    }
+
+    /// Return the processed packets in `done`, and request the new packets without waiting for them.
+    ///
+    /// The new packets should be polled with `poll_pkts` before requesting again.
+    #[inline]
+    pub fn request_pkts<B: TxBurst + ?Sized>(&mut self, done: &mut B) {
+        unsafe {
+            let nb_done = {
+                let mut empty = [ptr::null_mut(); 1];
+                let (oldpkt, nb_done) = returns(done.pending(), self.max_returns(), &mut empty);
+
+                ffi::rte_distributor_request_pkt(self.d.as_ptr(), self.id, oldpkt, nb_done as c_uint);
+
+                nb_done
+            };
+
+            done.sent(nb_done);
+        }
+    }
+
+    /// Poll the packets requested by `request_pkts` to `pkts`.
+    ///
+    /// The packets left in `pkts` are freed first, like `get_pkts`.
+    /// It returns `None` if the packets are not ready yet.
+    #[inline]
+    pub fn poll_pkts(&mut self, pkts: &mut WorkerBurst) -> Option<usize> {
+        pkts.clear();
+
+        unsafe {
+            let n = ffi::rte_distributor_poll_pkt(self.d.as_ptr(), self.id, pkts.spare().as_mut_ptr());
+
+            if n < 0 {
+                None
+            } else {
+                pkts.filled(n as usize);
+
+                Some(n as usize)
+            }
+        }
+    }
+
+    /// Return the processed packets in `done` without requesting new packets, e.g. when the worker quits.
+    pub fn return_pkts<B: TxBurst + ?Sized>(&mut self, done: &mut B) -> Result<()> {
+        unsafe {
+            let (ret, nb_done) = {
+                let mut empty = [ptr::null_mut(); 1];
+                let (oldpkt, nb_done) = returns(done.pending(), self.max_returns(), &mut empty);
+                // the single mode always returns one slot, which is the empty one if there is nothing to return
+                let num = match self.alg {
+                    Algorithm::Single => 1,
+                    Algorithm::Burst => nb_done,
+                };
+
+                (
+                    ffi::rte_distributor_return_pkt(self.d.as_ptr(), self.id, oldpkt, num as i32),
+                    nb_done,
+                )
+            };
+
+            if ret < 0 {
+                Err(RteError(ret).into())
+            } else {
+                done.sent(nb_done);
+
+                Ok(())
+            }
+        }
+    }
+}
+
+// The packets to return and the number of them, an empty slot is passed if there is nothing to return,
+// since the single mode always reads the first one.
+#[inline]
+fn returns(done: &mut [RawMBufPtr], max: usize, empty: &mut [RawMBufPtr; 1]) -> (*mut RawMBufPtr, usize) {
+    if done.is_empty() {
+        (empty.as_mut_ptr(), 0)
+    } else {
+        (done.as_mut_ptr(), done.len().min(max))
+    }
+}
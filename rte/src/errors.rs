@@ -125,6 +125,16 @@ pub enum ErrorKind {
     CmdLineParseError(i32),
     #[fail(display = "{}", _0)]
     OsError(i32),
+    #[fail(display = "not enough lcores for {} x {} on socket {}", _0, _1, _2)]
+    NotEnoughLcores(String, usize, i32),
+    #[fail(display = "flow error, {} (type {}, {})", _0, _1, _2)]
+    FlowError(String, u32, i32),
+    #[fail(display = "invalid or registered RCU reader thread, {}", _0)]
+    InvalidReader(usize),
+    #[fail(display = "invalid argument `{}`, {}", _0, _1)]
+    InvalidArg(&'static str, usize),
+    #[fail(display = "{} removed keys are not reclaimed", _0)]
+    RetiredKeys(usize),
 }
 
 pub fn rte_error() -> Error {
@@ -3,19 +3,27 @@ use std::mem;
 use std::ops::Range;
 use std::os::raw::c_void;
 use std::ptr;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::Mutex;
 
+use failure;
 use libc;
 
 use ffi;
 
+use common::get_tsc_hz;
 use dev;
-use errors::{AsResult, ErrorKind::OsError, Result};
+use errors::{AsResult, ErrorKind::OsError, Result, RteError};
 use ether;
+use flow;
+use launch;
+use lcore;
 use malloc;
 use mbuf;
 use memory::SocketId;
 use mempool;
-use utils::AsRaw;
+use metrics;
+use utils::{AsCString, AsRaw, IntoRaw};
 
 pub type PortId = u16;
 pub type QueueId = u16;
@@ -47,6 +55,28 @@ pub trait EthDevice {
     /// Reset the general I/O statistics of an Ethernet device.
     fn reset_stats(&self) -> &Self;
 
+    /// Retrieve the extended statistics of an Ethernet device, with their names.
+    fn xstats(&self) -> Result<Vec<EthXStat>>;
+
+    /// Reset the extended statistics of an Ethernet device.
+    fn reset_xstats(&self) -> &Self;
+
+    /// Retrieve the metrics of an Ethernet device, e.g. the bitrates of `metrics::BitrateStats`.
+    fn metrics(&self) -> Result<Vec<metrics::Metric>>;
+
+    /// Create a flow rule on an Ethernet device, see `flow::Rule`.
+    fn create_flow(&self, rule: &flow::Rule) -> Result<flow::Flow>;
+
+    /// Destroy all the flow rules of an Ethernet device.
+    ///
+    /// # Safety
+    ///
+    /// The `Flow`s of the device must not be used after it, see `flow::flush`.
+    unsafe fn flush_flows(&self) -> Result<&Self>;
+
+    /// Restrict the received packets to the ones matched by the flow rules.
+    fn isolate_flows(&self, enable: bool) -> Result<&Self>;
+
     /// Retrieve the Ethernet address of an Ethernet device.
     fn mac_addr(&self) -> ether::EtherAddr;
 
@@ -151,10 +181,48 @@ pub trait EthDevice {
     fn close(&self) -> &Self;
 
     /// Retrieve a burst of input packets from a receive queue of an Ethernet device.
-    fn rx_burst(&self, queue_id: QueueId, rx_pkts: &mut [Option<mbuf::MBuf>]) -> usize;
+    ///
+    /// The received packets are stored into the free slots of `rx_pkts`,
+    /// e.g. appended to the tail of a `mbuf::MBufBatch`.
+    fn rx_burst<B: mbuf::RxBurst + ?Sized>(&self, queue_id: QueueId, rx_pkts: &mut B) -> usize;
 
     /// Send a burst of output packets on a transmit queue of an Ethernet device.
-    fn tx_burst<T: AsRaw<Raw = mbuf::RawMBuf>>(&self, queue_id: QueueId, rx_pkts: &mut [T]) -> usize;
+    ///
+    /// The sent packets are removed from the head of a `mbuf::MBufBatch`,
+    /// the unsent packets are left in the batch, and will be freed in bulk when it is dropped.
+    fn tx_burst<B: mbuf::TxBurst + ?Sized>(&self, queue_id: QueueId, tx_pkts: &mut B) -> usize;
+
+    /// Process a burst of output packets on a transmit queue of an Ethernet device,
+    /// e.g. set the pseudo-header checksums for the TX checksum offload.
+    ///
+    /// Returns the number of packets ready to send with `tx_burst`,
+    /// if it is less than the pending packets, `rte_errno` is set for the first invalid one.
+    fn tx_prepare<B: mbuf::TxBurst + ?Sized>(&self, queue_id: QueueId, tx_pkts: &mut B) -> usize;
+
+    /// Buffer a single packet for future transmission on a port and queue.
+    ///
+    /// Returns the number of packets sent if the buffer was filled and flushed,
+    /// otherwise 0 when the packet was only buffered.
+    fn tx_buffer(&self, queue_id: QueueId, buffer: &mut RawTxBuffer, tx_pkt: mbuf::MBuf) -> usize;
+
+    /// Send any packets queued up for transmission on a port and HW queue.
+    fn tx_buffer_flush(&self, queue_id: QueueId, buffer: &mut RawTxBuffer) -> usize;
+
+    /// Enable the RX interrupt of a queue, it fires once the next packet arrives.
+    ///
+    /// The device must be configured with `EthConf::intr_conf` enabling `rxq`.
+    fn rx_intr_enable(&self, queue_id: QueueId) -> Result<&Self>;
+
+    /// Disable the RX interrupt of a queue, and get back to polling.
+    fn rx_intr_disable(&self, queue_id: QueueId) -> Result<&Self>;
+
+    /// Add the RX interrupt of a queue to the epoll instance of current thread.
+    ///
+    /// The `data` is returned in `rte_epoll_event.epdata.data` when the interrupt fires.
+    fn rx_intr_register(&self, queue_id: QueueId, data: *mut c_void) -> Result<&Self>;
+
+    /// Remove the RX interrupt of a queue from the epoll instance of current thread.
+    fn rx_intr_unregister(&self, queue_id: QueueId) -> Result<&Self>;
 
     /// Read VLAN Offload configuration from an Ethernet device
     fn vlan_offload(&self) -> Result<EthVlanOffloadMode>;
@@ -179,6 +247,140 @@ pub fn devices() -> Range<PortId> {
     0..count()
 }
 
+/// Get the port id of an Ethernet device from its name, e.g. `net_virtio_user0`.
+pub fn port_by_name(name: &str) -> Result<PortId> {
+    let name = name.as_cstring();
+    let mut port_id = 0;
+
+    rte_check!(unsafe { ffi::rte_eth_dev_get_port_by_name(name.as_ptr(), &mut port_id) }; ok => { port_id })
+}
+
+/// The configuration of ports set up by `setup_ports`.
+pub struct PortSetup<'a> {
+    /// The number of receive queues.
+    pub nb_rx_queue: QueueId,
+    /// The number of transmit queues.
+    pub nb_tx_queue: QueueId,
+    /// The configuration of ports.
+    pub conf: &'a EthConf,
+    /// The number of receive descriptors of each queue.
+    pub nb_rx_desc: u16,
+    /// The number of transmit descriptors of each queue.
+    pub nb_tx_desc: u16,
+    /// The configuration of receive queues, or the default one of driver.
+    pub rx_conf: Option<ffi::rte_eth_rxconf>,
+    /// The configuration of transmit queues, or the default one of driver.
+    pub tx_conf: Option<ffi::rte_eth_txconf>,
+    /// The mbuf pool of receive queues.
+    pub mb_pool: &'a mempool::MemoryPool,
+    /// Start the ports after their queues are set up.
+    pub start: bool,
+}
+
+impl<'a> PortSetup<'a> {
+    fn setup(&self, port_id: PortId) -> Result<()> {
+        let mut mb_pool = mempool::MemoryPool::from(self.mb_pool.as_raw());
+
+        port_id.configure(self.nb_rx_queue, self.nb_tx_queue, self.conf)?;
+
+        for queue_id in 0..self.nb_rx_queue {
+            port_id.rx_queue_setup(queue_id, self.nb_rx_desc, self.rx_conf, &mut mb_pool)?;
+        }
+
+        for queue_id in 0..self.nb_tx_queue {
+            port_id.tx_queue_setup(queue_id, self.nb_tx_desc, self.tx_conf)?;
+        }
+
+        if self.start {
+            port_id.start()?;
+        }
+
+        Ok(())
+    }
+}
+
+struct SetupJob<'a> {
+    ports: &'a [PortId],
+    setup: &'a PortSetup<'a>,
+    next: AtomicUsize,
+    err: Mutex<Option<failure::Error>>,
+}
+
+impl<'a> SetupJob<'a> {
+    fn run(&self) {
+        loop {
+            let idx = self.next.fetch_add(1, Ordering::Relaxed);
+
+            match self.ports.get(idx) {
+                Some(&port_id) => {
+                    if let Err(err) = self.setup.setup(port_id) {
+                        self.err.lock().unwrap().get_or_insert(err);
+                    }
+                }
+                None => break,
+            }
+        }
+    }
+}
+
+// the job is only shared with the lcores until `setup_ports` returns
+struct SetupJobPtr(*const SetupJob<'static>);
+
+fn setup_job_stub(job: Option<SetupJobPtr>) -> i32 {
+    if let Some(SetupJobPtr(job)) = job {
+        unsafe { &*job }.run();
+    }
+
+    0
+}
+
+/// Configure, set up the queues and start the ports in parallel on the idle slave lcores.
+///
+/// Most of the time is spent on the drivers and firmware, e.g. allocating the descriptor rings
+/// and waiting for the link to be reset, so the ports are set up concurrently instead of one by one.
+///
+/// The ports are set up serially if it is not executed on the MASTER lcore, or no slave lcore is idle.
+/// The first error is returned after all the ports are handled.
+pub fn setup_ports(ports: &[PortId], setup: &PortSetup) -> Result<()> {
+    let job = SetupJob {
+        ports,
+        setup,
+        next: AtomicUsize::new(0),
+        err: Mutex::new(None),
+    };
+
+    let mut workers = vec![];
+
+    if lcore::current().map_or(false, |lcore_id| lcore_id.is_master()) {
+        for lcore_id in lcore::enabled() {
+            if workers.len() + 1 >= ports.len() {
+                break;
+            }
+
+            if lcore_id.is_master() || lcore_id.state() != launch::State::Wait {
+                continue;
+            }
+
+            let ptr = SetupJobPtr(&job as *const SetupJob as *const SetupJob<'static>);
+
+            if launch::remote_launch(setup_job_stub, Some(ptr), lcore_id).is_ok() {
+                workers.push(lcore_id);
+            }
+        }
+    }
+
+    job.run();
+
+    for lcore_id in workers {
+        lcore_id.wait();
+    }
+
+    match job.err.into_inner().unwrap() {
+        Some(err) => Err(err),
+        None => Ok(()),
+    }
+}
+
 impl EthDevice for PortId {
     fn portid(&self) -> PortId {
         *self
@@ -215,6 +417,66 @@ impl EthDevice for PortId {
         self
     }
 
+    fn xstats(&self) -> Result<Vec<EthXStat>> {
+        let n = unsafe { ffi::rte_eth_xstats_get_names(*self, ptr::null_mut(), 0) };
+
+        if n < 0 {
+            return Err(RteError(n).into());
+        }
+
+        let mut names = vec![ffi::rte_eth_xstat_name::default(); n as usize];
+        let mut xstats = vec![ffi::rte_eth_xstat::default(); n as usize];
+
+        let n = unsafe { ffi::rte_eth_xstats_get_names(*self, names.as_mut_ptr(), n as u32) };
+
+        if n < 0 {
+            return Err(RteError(n).into());
+        }
+
+        let n = unsafe { ffi::rte_eth_xstats_get(*self, xstats.as_mut_ptr(), n as u32) };
+
+        if n < 0 {
+            return Err(RteError(n).into());
+        }
+
+        xstats.truncate(n as usize);
+
+        Ok(xstats
+            .iter()
+            .filter_map(|xstat| {
+                names.get(xstat.id as usize).map(|name| EthXStat {
+                    id: xstat.id,
+                    name: unsafe { CStr::from_ptr(name.name.as_ptr()) }
+                        .to_string_lossy()
+                        .into_owned(),
+                    value: xstat.value,
+                })
+            })
+            .collect())
+    }
+
+    fn reset_xstats(&self) -> &Self {
+        unsafe { ffi::rte_eth_xstats_reset(*self) };
+
+        self
+    }
+
+    fn metrics(&self) -> Result<Vec<metrics::Metric>> {
+        metrics::get(Some(*self))
+    }
+
+    fn create_flow(&self, rule: &flow::Rule) -> Result<flow::Flow> {
+        rule.create(*self)
+    }
+
+    unsafe fn flush_flows(&self) -> Result<&Self> {
+        flow::flush(*self).map(|_| self)
+    }
+
+    fn isolate_flows(&self, enable: bool) -> Result<&Self> {
+        flow::isolate(*self, enable).map(|_| self)
+    }
+
     fn mac_addr(&self) -> ether::EtherAddr {
         unsafe {
             let mut addr: ffi::ether_addr = mem::zeroed();
@@ -371,22 +633,83 @@ impl EthDevice for PortId {
         self
     }
 
-    fn rx_burst(&self, queue_id: QueueId, rx_pkts: &mut [Option<mbuf::MBuf>]) -> usize {
+    #[inline]
+    fn rx_burst<B: mbuf::RxBurst + ?Sized>(&self, queue_id: QueueId, rx_pkts: &mut B) -> usize {
         unsafe {
-            ffi::_rte_eth_rx_burst(*self, queue_id, rx_pkts.as_mut_ptr() as *mut _, rx_pkts.len() as u16) as usize
+            let nb_rx = {
+                let spare = rx_pkts.spare();
+
+                ffi::burst::rx_burst(*self, queue_id, spare.as_mut_ptr(), spare.len() as u16) as usize
+            };
+
+            rx_pkts.filled(nb_rx);
+
+            nb_rx
         }
     }
 
-    fn tx_burst<T: AsRaw<Raw = mbuf::RawMBuf>>(&self, queue_id: QueueId, rx_pkts: &mut [T]) -> usize {
+    #[inline]
+    fn tx_burst<B: mbuf::TxBurst + ?Sized>(&self, queue_id: QueueId, tx_pkts: &mut B) -> usize {
         unsafe {
-            if rx_pkts.is_empty() {
-                ffi::_rte_eth_tx_burst(*self, queue_id, ptr::null_mut(), 0) as usize
-            } else {
-                ffi::_rte_eth_tx_burst(*self, queue_id, rx_pkts.as_mut_ptr() as *mut _, rx_pkts.len() as u16) as usize
-            }
+            let nb_tx = {
+                let pending = tx_pkts.pending();
+
+                if pending.is_empty() {
+                    ffi::burst::tx_burst(*self, queue_id, ptr::null_mut(), 0) as usize
+                } else {
+                    ffi::burst::tx_burst(*self, queue_id, pending.as_mut_ptr(), pending.len() as u16) as usize
+                }
+            };
+
+            tx_pkts.sent(nb_tx);
+
+            nb_tx
         }
     }
 
+    #[inline]
+    fn tx_prepare<B: mbuf::TxBurst + ?Sized>(&self, queue_id: QueueId, tx_pkts: &mut B) -> usize {
+        let pending = tx_pkts.pending();
+
+        if pending.is_empty() {
+            0
+        } else {
+            unsafe { ffi::_rte_eth_tx_prepare(*self, queue_id, pending.as_mut_ptr(), pending.len() as u16) as usize }
+        }
+    }
+
+    #[inline]
+    fn tx_buffer(&self, queue_id: QueueId, buffer: &mut RawTxBuffer, tx_pkt: mbuf::MBuf) -> usize {
+        unsafe { ffi::burst::tx_buffer(*self, queue_id, buffer, tx_pkt.into_raw()) as usize }
+    }
+
+    #[inline]
+    fn tx_buffer_flush(&self, queue_id: QueueId, buffer: &mut RawTxBuffer) -> usize {
+        unsafe { ffi::burst::tx_buffer_flush(*self, queue_id, buffer) as usize }
+    }
+
+    fn rx_intr_enable(&self, queue_id: QueueId) -> Result<&Self> {
+        rte_check!(unsafe { ffi::rte_eth_dev_rx_intr_enable(*self, queue_id) }; ok => { self })
+    }
+
+    fn rx_intr_disable(&self, queue_id: QueueId) -> Result<&Self> {
+        rte_check!(unsafe { ffi::rte_eth_dev_rx_intr_disable(*self, queue_id) }; ok => { self })
+    }
+
+    fn rx_intr_register(&self, queue_id: QueueId, data: *mut c_void) -> Result<&Self> {
+        rte_check!(unsafe {
+            ffi::rte_eth_dev_rx_intr_ctl_q(*self, queue_id, ffi::RTE_EPOLL_PER_THREAD,
+                                           ffi::RTE_INTR_EVENT_ADD as i32, data)
+        }; ok => { self })
+    }
+
+    fn rx_intr_unregister(&self, queue_id: QueueId) -> Result<&Self> {
+        rte_check!(unsafe {
+            ffi::rte_eth_dev_rx_intr_ctl_q(*self, queue_id, ffi::RTE_EPOLL_PER_THREAD,
+                                           ffi::RTE_INTR_EVENT_DEL as i32, ptr::null_mut())
+        }; ok => { self })
+    }
+
     fn vlan_offload(&self) -> Result<EthVlanOffloadMode> {
         let mode = unsafe { ffi::rte_eth_dev_get_vlan_offload(*self) };
 
@@ -425,11 +748,83 @@ impl EthDeviceInfo for RawEthDeviceInfo {
     }
 }
 
-pub trait EthDeviceStats {}
+pub trait EthDeviceStats {
+    /// Total number of successfully received packets.
+    fn rx_packets(&self) -> u64;
+
+    /// Total number of successfully transmitted packets.
+    fn tx_packets(&self) -> u64;
+
+    /// Total number of successfully received bytes.
+    fn rx_bytes(&self) -> u64;
+
+    /// Total number of successfully transmitted bytes.
+    fn tx_bytes(&self) -> u64;
+
+    /// Total number of RX packets dropped by the HW, because there are no available buffers.
+    fn rx_missed(&self) -> u64;
+
+    /// Total number of erroneous received packets.
+    fn rx_errors(&self) -> u64;
+
+    /// Total number of failed transmitted packets.
+    fn tx_errors(&self) -> u64;
+
+    /// Total number of RX mbuf allocation failures.
+    fn rx_nombuf(&self) -> u64;
+}
 
 pub type RawEthDeviceStats = ffi::rte_eth_stats;
 
-impl EthDeviceStats for RawEthDeviceStats {}
+impl EthDeviceStats for RawEthDeviceStats {
+    #[inline]
+    fn rx_packets(&self) -> u64 {
+        self.ipackets
+    }
+
+    #[inline]
+    fn tx_packets(&self) -> u64 {
+        self.opackets
+    }
+
+    #[inline]
+    fn rx_bytes(&self) -> u64 {
+        self.ibytes
+    }
+
+    #[inline]
+    fn tx_bytes(&self) -> u64 {
+        self.obytes
+    }
+
+    #[inline]
+    fn rx_missed(&self) -> u64 {
+        self.imissed
+    }
+
+    #[inline]
+    fn rx_errors(&self) -> u64 {
+        self.ierrors
+    }
+
+    #[inline]
+    fn tx_errors(&self) -> u64 {
+        self.oerrors
+    }
+
+    #[inline]
+    fn rx_nombuf(&self) -> u64 {
+        self.rx_nombuf
+    }
+}
+
+/// An extended statistic of an Ethernet device.
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct EthXStat {
+    pub id: u64,
+    pub name: String,
+    pub value: u64,
+}
 
 bitflags! {
     /// Definitions used for VMDQ pool rx mode setting
@@ -661,8 +1056,17 @@ impl<'a> From<&'a EthConf> for RawEthConf {
             conf.txmode = *txmode
         }
 
+        if let Some(ref intr_conf) = c.intr_conf {
+            conf.intr_conf = *intr_conf
+        }
+
         if let Some(ref adv_conf) = c.rx_adv_conf {
             if let Some(ref rss_conf) = adv_conf.rss_conf {
+                // distribute the packets with RSS unless the RX mode is given
+                if c.rxmode.is_none() {
+                    conf.rxmode.mq_mode = ffi::rte_eth_rx_mq_mode::ETH_MQ_RX_RSS;
+                }
+
                 let (rss_key, rss_key_len) = rss_conf
                     .key
                     .map_or_else(|| (ptr::null(), 0), |key| (key.as_ptr(), key.len() as u8));
@@ -701,7 +1105,25 @@ pub trait TxBuffer {
     fn drop_err_packets(&mut self) -> Result<&mut Self>;
 
     /// Tracking unsent buffered packets.
-    fn count_err_packets(&mut self) -> Result<&mut Self>;
+    ///
+    /// The unsent packets will be freed, and the `counter` increased by the number of them.
+    ///
+    /// # Safety
+    ///
+    /// The buffer keeps the address of `counter`, which must not move or be dropped
+    /// until the buffer is freed or its error callback is replaced.
+    unsafe fn count_err_packets(&mut self, counter: &AtomicU64) -> Result<&mut Self>;
+
+    /// The number of packets buffered.
+    fn len(&self) -> usize;
+
+    /// Returns `true` if no packet is buffered.
+    fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// The maximum number of packets buffered, the buffer is flushed when it is full.
+    fn size(&self) -> usize;
 }
 
 /// Initialize default values for buffered transmitting
@@ -739,11 +1161,124 @@ impl TxBuffer for RawTxBuffer {
         }; ok => { self })
     }
 
-    fn count_err_packets(&mut self) -> Result<&mut Self> {
-        rte_check!(unsafe {
-            ffi::rte_eth_tx_buffer_set_err_callback(self,
-                                                    Some(ffi::rte_eth_tx_buffer_count_callback),
-                                                    ptr::null_mut())
-        }; ok => { self })
+    unsafe fn count_err_packets(&mut self, counter: &AtomicU64) -> Result<&mut Self> {
+        rte_check!(ffi::rte_eth_tx_buffer_set_err_callback(self,
+                                                           Some(ffi::rte_eth_tx_buffer_count_callback),
+                                                           counter as *const AtomicU64 as *mut c_void);
+                   ok => { self })
+    }
+
+    #[inline]
+    fn len(&self) -> usize {
+        self.length as usize
+    }
+
+    #[inline]
+    fn size(&self) -> usize {
+        self.size as usize
+    }
+}
+
+/// When to flush the packets buffered for transmission, besides when the buffer is full.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct TxFlushPolicy {
+    /// Flush as soon as a RX poll returns no packets, there is nothing more to batch with.
+    pub on_idle: bool,
+    /// The maximum TSC cycles a packet stays buffered, 0 to flush on every poll.
+    pub latency: u64,
+}
+
+impl Default for TxFlushPolicy {
+    fn default() -> Self {
+        TxFlushPolicy::with_latency_us(100)
+    }
+}
+
+impl TxFlushPolicy {
+    /// Flush on idle RX polls, or when the buffered packets wait for `us` microseconds.
+    pub fn with_latency_us(us: u64) -> Self {
+        TxFlushPolicy {
+            on_idle: true,
+            latency: (get_tsc_hz() + 999_999) / 1_000_000 * us,
+        }
+    }
+}
+
+/// Apply a `TxFlushPolicy` to a TX buffer.
+///
+/// Under light load the buffered packets are flushed on the first idle poll,
+/// or once the latency budget is spent, under heavy load the buffer fills up
+/// and is flushed on the burst boundary by `EthDevice::tx_buffer`.
+///
+/// The packets should be buffered with `TxFlush::tx_buffer`, so the latency restarts
+/// when the buffer is flushed because it's full.
+#[derive(Clone, Copy, Debug)]
+pub struct TxFlush {
+    policy: TxFlushPolicy,
+    // the TSC when the buffer is first seen not empty
+    pending_since: Option<u64>,
+}
+
+impl TxFlush {
+    pub fn new(policy: TxFlushPolicy) -> Self {
+        TxFlush {
+            policy,
+            pending_since: None,
+        }
+    }
+
+    /// The flush policy.
+    pub fn policy(&self) -> &TxFlushPolicy {
+        &self.policy
+    }
+
+    /// Buffer a packet with `EthDevice::tx_buffer`, returns the number of packets sent
+    /// if the buffer was full and flushed.
+    #[inline]
+    pub fn tx_buffer<D: EthDevice + ?Sized>(
+        &mut self,
+        dev: &D,
+        queue_id: QueueId,
+        buffer: &mut RawTxBuffer,
+        tx_pkt: mbuf::MBuf,
+    ) -> usize {
+        let sent = dev.tx_buffer(queue_id, buffer, tx_pkt);
+
+        // the buffer is drained, the packets buffered after it wait from the next poll
+        if buffer.is_empty() {
+            self.pending_since = None;
+        }
+
+        sent
+    }
+
+    /// Flush the buffer if the policy says so, returns the number of packets sent.
+    ///
+    /// It should be called after each RX poll, with `rx_idle` set if the poll returned no packets,
+    /// and `now` the current TSC.
+    #[inline]
+    pub fn poll<D: EthDevice + ?Sized>(
+        &mut self,
+        dev: &D,
+        queue_id: QueueId,
+        buffer: &mut RawTxBuffer,
+        rx_idle: bool,
+        now: u64,
+    ) -> usize {
+        if buffer.is_empty() {
+            self.pending_since = None;
+
+            return 0;
+        }
+
+        let since = *self.pending_since.get_or_insert(now);
+
+        if (self.policy.on_idle && rx_idle) || now.wrapping_sub(since) >= self.policy.latency {
+            self.pending_since = None;
+
+            dev.tx_buffer_flush(queue_id, buffer)
+        } else {
+            0
+        }
     }
 }
@@ -11,7 +11,8 @@ use rand::{thread_rng, Rng};
 use ffi;
 
 use errors::Result;
-use mbuf;
+use ip::{Ipv4View, Ipv6View};
+use mbuf::{self, Header, HeaderRef};
 use utils::AsRaw;
 
 pub use ffi::{
@@ -250,6 +251,143 @@ pub type VlanHdr = ffi::vlan_hdr;
 /// VXLAN protocol header.
 pub type VxlanHdr = ffi::vxlan_hdr;
 
+unsafe impl Header for EtherHdr {}
+unsafe impl Header for VlanHdr {}
+
+/// The maximum number of VLAN tags skipped to the L3 header, e.g. QinQ.
+const MAX_VLAN_TAGS: usize = 2;
+
+/// An Ethernet header parsed in place from the packet data.
+pub struct EthernetView<'a> {
+    m: &'a mbuf::MBuf,
+    hdr: HeaderRef<'a, EtherHdr>,
+}
+
+impl<'a> EthernetView<'a> {
+    /// Parse the Ethernet header at the start of the packet.
+    #[inline]
+    pub fn parse(m: &'a mbuf::MBuf) -> Option<Self> {
+        m.header::<EtherHdr>(0).map(|hdr| EthernetView { m, hdr })
+    }
+
+    /// The destination address.
+    #[inline]
+    pub fn dst(&self) -> EtherAddr {
+        EtherAddr::from(self.hdr.d_addr)
+    }
+
+    /// The source address.
+    #[inline]
+    pub fn src(&self) -> EtherAddr {
+        EtherAddr::from(self.hdr.s_addr)
+    }
+
+    /// The frame type in host byte order.
+    #[inline]
+    pub fn ether_type(&self) -> u16 {
+        u16::from_be(self.hdr.ether_type)
+    }
+
+    /// The offset of the payload in the packet.
+    #[inline]
+    pub fn payload_offset(&self) -> usize {
+        mem::size_of::<EtherHdr>()
+    }
+
+    /// The outer VLAN tag, if the frame is tagged.
+    #[inline]
+    pub fn vlan(&self) -> Option<VlanView<'a>> {
+        match self.ether_type() as u32 {
+            ETHER_TYPE_VLAN | ETHER_TYPE_QINQ => VlanView::parse(self.m, self.payload_offset()),
+            _ => None,
+        }
+    }
+
+    /// The L3 frame type in host byte order and its offset in the packet, after the VLAN tags.
+    #[inline]
+    pub fn l3(&self) -> Option<(u16, usize)> {
+        let mut ether_type = self.ether_type();
+        let mut off = self.payload_offset();
+
+        for _ in 0..MAX_VLAN_TAGS {
+            match ether_type as u32 {
+                ETHER_TYPE_VLAN | ETHER_TYPE_QINQ => {
+                    let vlan = VlanView::parse(self.m, off)?;
+
+                    ether_type = vlan.ether_type();
+                    off += mem::size_of::<VlanHdr>();
+                }
+                _ => break,
+            }
+        }
+
+        Some((ether_type, off))
+    }
+
+    /// The IPv4 header after the VLAN tags, if any.
+    #[inline]
+    pub fn ipv4(&self) -> Option<Ipv4View<'a>> {
+        match self.l3()? {
+            (ether_type, off) if ether_type as u32 == ETHER_TYPE_IPv4 => Ipv4View::parse(self.m, off),
+            _ => None,
+        }
+    }
+
+    /// The IPv6 header after the VLAN tags, if any.
+    #[inline]
+    pub fn ipv6(&self) -> Option<Ipv6View<'a>> {
+        match self.l3()? {
+            (ether_type, off) if ether_type as u32 == ETHER_TYPE_IPv6 => Ipv6View::parse(self.m, off),
+            _ => None,
+        }
+    }
+}
+
+impl<'a> Deref for EthernetView<'a> {
+    type Target = EtherHdr;
+
+    fn deref(&self) -> &Self::Target {
+        &self.hdr
+    }
+}
+
+/// A VLAN tag parsed in place from the packet data.
+pub struct VlanView<'a> {
+    hdr: HeaderRef<'a, VlanHdr>,
+}
+
+impl<'a> VlanView<'a> {
+    /// Parse the VLAN tag at an offset of the packet.
+    #[inline]
+    pub fn parse(m: &'a mbuf::MBuf, off: usize) -> Option<Self> {
+        m.header::<VlanHdr>(off).map(|hdr| VlanView { hdr })
+    }
+
+    /// The tag control information in host byte order.
+    #[inline]
+    pub fn tci(&self) -> u16 {
+        u16::from_be(self.hdr.vlan_tci)
+    }
+
+    /// The VLAN identifier.
+    #[inline]
+    pub fn vid(&self) -> u16 {
+        self.tci() & 0x0fff
+    }
+
+    /// The priority code point.
+    #[inline]
+    pub fn pcp(&self) -> u8 {
+        (self.tci() >> 13) as u8
+    }
+
+    /// The encapsulated frame type in host byte order.
+    #[inline]
+    pub fn ether_type(&self) -> u16 {
+        u16::from_be(self.hdr.eth_proto)
+    }
+}
+
 pub trait VlanExt {
     /// Extract VLAN tag information into mbuf
     fn vlan_strip(&mut self) -> Result<()>;
@@ -0,0 +1,38 @@
+//!
+//! The exception path, which exchanges the packets with the network stack of kernel.
+//!
+//! Both the KNI devices and the virtio_user ports are a backend of the exception path,
+//! see `kni::KniDevice` and `virtio_user::VirtioUser`.
+//!
+use errors::Result;
+use kni::KniDevice;
+use mbuf::{RxBurst, TxBurst};
+
+/// A backend of the exception path.
+pub trait ExceptionPath {
+    /// Retrieve a burst of packets sent by the kernel.
+    fn rx_burst<B: RxBurst + ?Sized>(&self, mbufs: &mut B) -> usize;
+
+    /// Send a burst of packets to the kernel.
+    fn tx_burst<B: TxBurst + ?Sized>(&self, mbufs: &mut B) -> usize;
+
+    /// Handle the requests of kernel, e.g. changing the MTU or the link state.
+    fn handle_requests(&self) -> Result<&Self>;
+}
+
+impl ExceptionPath for KniDevice {
+    #[inline]
+    fn rx_burst<B: RxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        KniDevice::rx_burst(self, mbufs)
+    }
+
+    #[inline]
+    fn tx_burst<B: TxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        KniDevice::tx_burst(self, mbufs)
+    }
+
+    #[inline]
+    fn handle_requests(&self) -> Result<&Self> {
+        KniDevice::handle_requests(self)
+    }
+}
@@ -0,0 +1,628 @@
+//!
+//! RTE Flow
+//!
+//! A flow rule matches the packets with a pattern of headers in the NIC,
+//! and applies the actions to them, e.g. steering to a queue or dropping,
+//! before any packet is seen by the CPU.
+//!
+//! ```no_run
+//! # use std::net::Ipv4Addr;
+//! # use rte::flow::{Action, Ipv4Spec, Item, Rule};
+//! # let port_id = 0;
+//! // steer BGP to the control plane queue
+//! let bgp = Rule::ingress()
+//!     .pattern(Item::eth())
+//!     .pattern(Item::ipv4())
+//!     .pattern(Item::tcp_dst(179))
+//!     .action(Action::Mark(179))
+//!     .action(Action::Queue(1))
+//!     .create(port_id)
+//!     .unwrap();
+//!
+//! // the fields of one header are merged into one item
+//! let peer = Rule::ingress()
+//!     .pattern(Item::eth())
+//!     .pattern(
+//!         Ipv4Spec::default()
+//!             .src(Ipv4Addr::new(192, 0, 2, 1))
+//!             .dst(Ipv4Addr::new(192, 0, 2, 2)),
+//!     )
+//!     .action(Action::Queue(1))
+//!     .create(port_id)
+//!     .unwrap();
+//! ```
+//!
+//! The packets matching a rule with `Action::Mark` carry the mark, see `MBuf::flow_mark`.
+//!
+use std::ffi::CStr;
+use std::net::{Ipv4Addr, Ipv6Addr};
+use std::os::raw::c_void;
+use std::ptr::{self, NonNull};
+
+use ffi;
+
+use errors::{ErrorKind, Result};
+use ethdev::{PortId, QueueId};
+use ether::EtherAddr;
+
+pub type EthItem = ffi::rte_flow_item_eth;
+pub type VlanItem = ffi::rte_flow_item_vlan;
+pub type Ipv4Item = ffi::rte_flow_item_ipv4;
+pub type Ipv6Item = ffi::rte_flow_item_ipv6;
+pub type UdpItem = ffi::rte_flow_item_udp;
+pub type TcpItem = ffi::rte_flow_item_tcp;
+
+/// The value and the mask of the fields to match, the fields are in network byte order.
+///
+/// The fields of one header are merged into one spec with its builder, e.g. `Ipv4Spec::default().src(..).dst(..)`,
+/// since each `Item` of a pattern matches another header.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+pub struct Spec<T> {
+    pub spec: T,
+    pub mask: T,
+}
+
+pub type EthSpec = Spec<EthItem>;
+pub type VlanSpec = Spec<VlanItem>;
+pub type Ipv4Spec = Spec<Ipv4Item>;
+pub type Ipv6Spec = Spec<Ipv6Item>;
+pub type UdpSpec = Spec<UdpItem>;
+pub type TcpSpec = Spec<TcpItem>;
+
+impl<T> Spec<T> {
+    /// Match the field set by `f` with all its bits, `f` gets `true` to set the mask.
+    fn exact<F: Fn(&mut T, bool)>(mut self, f: F) -> Self {
+        f(&mut self.spec, false);
+        f(&mut self.mask, true);
+
+        self
+    }
+}
+
+impl Spec<EthItem> {
+    /// Match the destination address.
+    pub fn dst(self, addr: &EtherAddr) -> Self {
+        self.exact(|eth, mask| eth.dst.addr_bytes = if mask { [0xff; 6] } else { **addr })
+    }
+
+    /// Match the source address.
+    pub fn src(self, addr: &EtherAddr) -> Self {
+        self.exact(|eth, mask| eth.src.addr_bytes = if mask { [0xff; 6] } else { **addr })
+    }
+
+    /// Match the EtherType.
+    pub fn ether_type(self, ether_type: u16) -> Self {
+        self.exact(|eth, mask| eth.type_ = if mask { 0xffff } else { ether_type.to_be() })
+    }
+}
+
+impl Spec<VlanItem> {
+    /// Match the VLAN ID.
+    pub fn vid(self, vid: u16) -> Self {
+        self.exact(|vlan, mask| {
+            vlan.tci = if mask {
+                0x0fff_u16.to_be()
+            } else {
+                (vid & 0x0fff).to_be()
+            }
+        })
+    }
+}
+
+impl Spec<Ipv4Item> {
+    /// Match the source address.
+    pub fn src(self, addr: Ipv4Addr) -> Self {
+        self.exact(|ip, mask| ip.hdr.src_addr = if mask { 0xffff_ffff } else { u32::from(addr).to_be() })
+    }
+
+    /// Match the destination address.
+    pub fn dst(self, addr: Ipv4Addr) -> Self {
+        self.exact(|ip, mask| ip.hdr.dst_addr = if mask { 0xffff_ffff } else { u32::from(addr).to_be() })
+    }
+
+    /// Match the next protocol, e.g. `IPPROTO_ICMP`.
+    pub fn proto(self, proto: u8) -> Self {
+        self.exact(|ip, mask| ip.hdr.next_proto_id = if mask { 0xff } else { proto })
+    }
+}
+
+impl Spec<Ipv6Item> {
+    /// Match the source address.
+    pub fn src(self, addr: Ipv6Addr) -> Self {
+        self.exact(|ip, mask| ip.hdr.src_addr = if mask { [0xff; 16] } else { addr.octets() })
+    }
+
+    /// Match the destination address.
+    pub fn dst(self, addr: Ipv6Addr) -> Self {
+        self.exact(|ip, mask| ip.hdr.dst_addr = if mask { [0xff; 16] } else { addr.octets() })
+    }
+
+    /// Match the next header, e.g. `IPPROTO_TCP`.
+    pub fn next_header(self, proto: u8) -> Self {
+        self.exact(|ip, mask| ip.hdr.proto = if mask { 0xff } else { proto })
+    }
+}
+
+impl Spec<UdpItem> {
+    /// Match the source port.
+    pub fn src_port(self, port: u16) -> Self {
+        self.exact(|udp, mask| udp.hdr.src_port = if mask { 0xffff } else { port.to_be() })
+    }
+
+    /// Match the destination port.
+    pub fn dst_port(self, port: u16) -> Self {
+        self.exact(|udp, mask| udp.hdr.dst_port = if mask { 0xffff } else { port.to_be() })
+    }
+}
+
+impl Spec<TcpItem> {
+    /// Match the source port.
+    pub fn src_port(self, port: u16) -> Self {
+        self.exact(|tcp, mask| tcp.hdr.src_port = if mask { 0xffff } else { port.to_be() })
+    }
+
+    /// Match the destination port.
+    pub fn dst_port(self, port: u16) -> Self {
+        self.exact(|tcp, mask| tcp.hdr.dst_port = if mask { 0xffff } else { port.to_be() })
+    }
+}
+
+/// A header of the pattern, any header of the protocol is matched without `Spec`.
+///
+/// The constructors match a single field, the builder of `Spec` matches more fields of the same header.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub enum Item {
+    Eth(Option<EthSpec>),
+    Vlan(Option<VlanSpec>),
+    Ipv4(Option<Ipv4Spec>),
+    Ipv6(Option<Ipv6Spec>),
+    Udp(Option<UdpSpec>),
+    Tcp(Option<TcpSpec>),
+}
+
+macro_rules! item_from_spec {
+    ($spec:ident, $item:ident) => {
+        impl From<$spec> for Item {
+            fn from(spec: $spec) -> Self {
+                Item::$item(Some(spec))
+            }
+        }
+    };
+}
+
+item_from_spec!(EthSpec, Eth);
+item_from_spec!(VlanSpec, Vlan);
+item_from_spec!(Ipv4Spec, Ipv4);
+item_from_spec!(Ipv6Spec, Ipv6);
+item_from_spec!(UdpSpec, Udp);
+item_from_spec!(TcpSpec, Tcp);
+
+impl Item {
+    /// Any Ethernet header.
+    pub fn eth() -> Self {
+        Item::Eth(None)
+    }
+
+    /// An Ethernet header to the destination address.
+    pub fn eth_dst(addr: &EtherAddr) -> Self {
+        EthSpec::default().dst(addr).into()
+    }
+
+    /// An Ethernet header of the EtherType.
+    pub fn eth_type(ether_type: u16) -> Self {
+        EthSpec::default().ether_type(ether_type).into()
+    }
+
+    /// Any VLAN tag.
+    pub fn vlan() -> Self {
+        Item::Vlan(None)
+    }
+
+    /// A VLAN tag of the VLAN ID.
+    pub fn vlan_id(vid: u16) -> Self {
+        VlanSpec::default().vid(vid).into()
+    }
+
+    /// Any IPv4 header.
+    pub fn ipv4() -> Self {
+        Item::Ipv4(None)
+    }
+
+    /// An IPv4 header from the source address.
+    pub fn ipv4_src(addr: Ipv4Addr) -> Self {
+        Ipv4Spec::default().src(addr).into()
+    }
+
+    /// An IPv4 header to the destination address.
+    pub fn ipv4_dst(addr: Ipv4Addr) -> Self {
+        Ipv4Spec::default().dst(addr).into()
+    }
+
+    /// An IPv4 header of the next protocol, e.g. `IPPROTO_ICMP`.
+    pub fn ipv4_proto(proto: u8) -> Self {
+        Ipv4Spec::default().proto(proto).into()
+    }
+
+    /// Any IPv6 header.
+    pub fn ipv6() -> Self {
+        Item::Ipv6(None)
+    }
+
+    /// An IPv6 header from the source address.
+    pub fn ipv6_src(addr: Ipv6Addr) -> Self {
+        Ipv6Spec::default().src(addr).into()
+    }
+
+    /// An IPv6 header to the destination address.
+    pub fn ipv6_dst(addr: Ipv6Addr) -> Self {
+        Ipv6Spec::default().dst(addr).into()
+    }
+
+    /// Any UDP header.
+    pub fn udp() -> Self {
+        Item::Udp(None)
+    }
+
+    /// An UDP header from the source port.
+    pub fn udp_src(port: u16) -> Self {
+        UdpSpec::default().src_port(port).into()
+    }
+
+    /// An UDP header to the destination port.
+    pub fn udp_dst(port: u16) -> Self {
+        UdpSpec::default().dst_port(port).into()
+    }
+
+    /// Any TCP header.
+    pub fn tcp() -> Self {
+        Item::Tcp(None)
+    }
+
+    /// A TCP header from the source port.
+    pub fn tcp_src(port: u16) -> Self {
+        TcpSpec::default().src_port(port).into()
+    }
+
+    /// A TCP header to the destination port.
+    pub fn tcp_dst(port: u16) -> Self {
+        TcpSpec::default().dst_port(port).into()
+    }
+
+    fn as_raw(&self) -> ffi::rte_flow_item {
+        fn raw<T>(type_: ffi::rte_flow_item_type::Type, spec: &Option<Spec<T>>) -> ffi::rte_flow_item {
+            let (spec, mask) = spec.as_ref().map_or((ptr::null(), ptr::null()), |spec| {
+                (
+                    &spec.spec as *const T as *const c_void,
+                    &spec.mask as *const T as *const c_void,
+                )
+            });
+
+            ffi::rte_flow_item {
+                type_,
+                spec,
+                last: ptr::null(),
+                mask,
+            }
+        }
+
+        match *self {
+            Item::Eth(ref spec) => raw(ffi::rte_flow_item_type::RTE_FLOW_ITEM_TYPE_ETH, spec),
+            Item::Vlan(ref spec) => raw(ffi::rte_flow_item_type::RTE_FLOW_ITEM_TYPE_VLAN, spec),
+            Item::Ipv4(ref spec) => raw(ffi::rte_flow_item_type::RTE_FLOW_ITEM_TYPE_IPV4, spec),
+            Item::Ipv6(ref spec) => raw(ffi::rte_flow_item_type::RTE_FLOW_ITEM_TYPE_IPV6, spec),
+            Item::Udp(ref spec) => raw(ffi::rte_flow_item_type::RTE_FLOW_ITEM_TYPE_UDP, spec),
+            Item::Tcp(ref spec) => raw(ffi::rte_flow_item_type::RTE_FLOW_ITEM_TYPE_TCP, spec),
+        }
+    }
+}
+
+/// An action applied to the matched packets.
+#[derive(Clone, Debug, PartialEq)]
+pub enum Action {
+    /// Steer the packets to a RX queue.
+    Queue(QueueId),
+    /// Spread the packets to the RX queues with the RSS hash of `types`, e.g. `ETH_RSS_IP`.
+    Rss {
+        queues: Vec<QueueId>,
+        types: u64,
+        key: Option<Vec<u8>>,
+    },
+    /// Drop the packets.
+    Drop,
+    /// Mark the packets with an ID, which is reported in the mbufs.
+    Mark(u32),
+    /// Count the packets and bytes, see `Flow::query_count`.
+    Count,
+}
+
+// The configuration of action, which must not move until the rule is created.
+enum ActionConf {
+    None,
+    Queue(ffi::rte_flow_action_queue),
+    Rss(ffi::rte_flow_action_rss),
+    Mark(ffi::rte_flow_action_mark),
+    Count(ffi::rte_flow_action_count),
+}
+
+impl Action {
+    fn conf(&self) -> ActionConf {
+        match *self {
+            Action::Queue(index) => ActionConf::Queue(ffi::rte_flow_action_queue { index }),
+            Action::Rss {
+                ref queues,
+                types,
+                ref key,
+            } => ActionConf::Rss(ffi::rte_flow_action_rss {
+                func: ffi::rte_eth_hash_function::RTE_ETH_HASH_FUNCTION_DEFAULT,
+                level: 0,
+                types,
+                key_len: key.as_ref().map_or(0, |key| key.len() as u32),
+                queue_num: queues.len() as u32,
+                key: key.as_ref().map_or(ptr::null(), |key| key.as_ptr()),
+                queue: queues.as_ptr(),
+            }),
+            Action::Drop => ActionConf::None,
+            Action::Mark(id) => ActionConf::Mark(ffi::rte_flow_action_mark { id }),
+            Action::Count => ActionConf::Count(Default::default()),
+        }
+    }
+
+    fn type_(&self) -> ffi::rte_flow_action_type::Type {
+        match *self {
+            Action::Queue(_) => ffi::rte_flow_action_type::RTE_FLOW_ACTION_TYPE_QUEUE,
+            Action::Rss { .. } => ffi::rte_flow_action_type::RTE_FLOW_ACTION_TYPE_RSS,
+            Action::Drop => ffi::rte_flow_action_type::RTE_FLOW_ACTION_TYPE_DROP,
+            Action::Mark(_) => ffi::rte_flow_action_type::RTE_FLOW_ACTION_TYPE_MARK,
+            Action::Count => ffi::rte_flow_action_type::RTE_FLOW_ACTION_TYPE_COUNT,
+        }
+    }
+}
+
+impl ActionConf {
+    fn as_ptr(&self) -> *const c_void {
+        match *self {
+            ActionConf::None => ptr::null(),
+            ActionConf::Queue(ref conf) => conf as *const _ as *const c_void,
+            ActionConf::Rss(ref conf) => conf as *const _ as *const c_void,
+            ActionConf::Mark(ref conf) => conf as *const _ as *const c_void,
+            ActionConf::Count(ref conf) => conf as *const _ as *const c_void,
+        }
+    }
+}
+
+/// A flow rule, which is made of the attributes, a pattern and a list of actions.
+#[derive(Clone, Debug)]
+pub struct Rule {
+    attr: ffi::rte_flow_attr,
+    pattern: Vec<Item>,
+    actions: Vec<Action>,
+}
+
+impl Rule {
+    /// A rule of the received packets.
+    pub fn ingress() -> Self {
+        let mut attr = ffi::rte_flow_attr::default();
+
+        attr.set_ingress(1);
+
+        Rule {
+            attr,
+            pattern: vec![],
+            actions: vec![],
+        }
+    }
+
+    /// A rule of the transmitted packets.
+    pub fn egress() -> Self {
+        let mut attr = ffi::rte_flow_attr::default();
+
+        attr.set_egress(1);
+
+        Rule {
+            attr,
+            pattern: vec![],
+            actions: vec![],
+        }
+    }
+
+    /// The group of rule, the rules of group 0 are matched first.
+    pub fn group(mut self, group: u32) -> Self {
+        self.attr.group = group;
+        self
+    }
+
+    /// The priority of rule in its group, lower values are matched first.
+    pub fn priority(mut self, priority: u32) -> Self {
+        self.attr.priority = priority;
+        self
+    }
+
+    /// Append a header to the pattern, from the outermost one.
+    ///
+    /// Each call appends another header, the fields of one header are merged with the builder of its `Spec`.
+    pub fn pattern<I: Into<Item>>(mut self, item: I) -> Self {
+        self.pattern.push(item.into());
+        self
+    }
+
+    /// The headers of the pattern, from the outermost one.
+    pub fn items(&self) -> &[Item] {
+        &self.pattern
+    }
+
+    /// Append an action.
+    pub fn action(mut self, action: Action) -> Self {
+        self.actions.push(action);
+        self
+    }
+
+    /// Check whether the rule could be created on a port, which must be configured.
+    pub fn validate(&self, port_id: PortId) -> Result<()> {
+        self.with_raw(|attr, pattern, actions, error| unsafe {
+            let ret = ffi::rte_flow_validate(port_id, attr, pattern, actions, error);
+
+            if ret == 0 {
+                Ok(())
+            } else {
+                Err(flow_error(ret, error))
+            }
+        })
+    }
+
+    /// Create the rule on a port, the rule is kept until it is destroyed or the port is flushed.
+    pub fn create(&self, port_id: PortId) -> Result<Flow> {
+        self.with_raw(|attr, pattern, actions, error| unsafe {
+            NonNull::new(ffi::rte_flow_create(port_id, attr, pattern, actions, error))
+                .map(|flow| Flow { port_id, flow })
+                .ok_or_else(|| flow_error(-ffi::rte_errno(), error))
+        })
+    }
+
+    // build the END terminated pattern and actions, which point to the specs and confs in place
+    fn with_raw<T, F>(&self, f: F) -> Result<T>
+    where
+        F: FnOnce(
+            *const ffi::rte_flow_attr,
+            *const ffi::rte_flow_item,
+            *const ffi::rte_flow_action,
+            &mut ffi::rte_flow_error,
+        ) -> Result<T>,
+    {
+        let mut pattern: Vec<ffi::rte_flow_item> = self.pattern.iter().map(Item::as_raw).collect();
+
+        pattern.push(ffi::rte_flow_item::default());
+
+        let confs: Vec<ActionConf> = self.actions.iter().map(Action::conf).collect();
+        let mut actions: Vec<ffi::rte_flow_action> = self
+            .actions
+            .iter()
+            .zip(confs.iter())
+            .map(|(action, conf)| ffi::rte_flow_action {
+                type_: action.type_(),
+                conf: conf.as_ptr(),
+            })
+            .collect();
+
+        actions.push(ffi::rte_flow_action::default());
+
+        let mut error = ffi::rte_flow_error::default();
+
+        f(&self.attr, pattern.as_ptr(), actions.as_ptr(), &mut error)
+    }
+}
+
+/// The counters of a flow rule.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct FlowCount {
+    /// The number of packets, if it is supported.
+    pub hits: Option<u64>,
+    /// The number of bytes, if it is supported.
+    pub bytes: Option<u64>,
+}
+
+/// A flow rule created on a port.
+///
+/// The rule isn't destroyed when it is dropped, it is kept by the port until `destroy` or `flush`.
+#[derive(Debug)]
+pub struct Flow {
+    port_id: PortId,
+    flow: NonNull<ffi::rte_flow>,
+}
+
+unsafe impl Send for Flow {}
+
+impl Flow {
+    /// The port of rule.
+    pub fn port_id(&self) -> PortId {
+        self.port_id
+    }
+
+    /// Destroy the rule.
+    pub fn destroy(self) -> Result<()> {
+        let mut error = ffi::rte_flow_error::default();
+        let ret = unsafe { ffi::rte_flow_destroy(self.port_id, self.flow.as_ptr(), &mut error) };
+
+        if ret == 0 {
+            Ok(())
+        } else {
+            Err(flow_error(ret, &error))
+        }
+    }
+
+    /// Query the counters of a rule with `Action::Count`, and reset them if `reset`.
+    pub fn query_count(&self, reset: bool) -> Result<FlowCount> {
+        let conf = ffi::rte_flow_action_count::default();
+        let action = ffi::rte_flow_action {
+            type_: ffi::rte_flow_action_type::RTE_FLOW_ACTION_TYPE_COUNT,
+            conf: &conf as *const _ as *const c_void,
+        };
+        let mut count = ffi::rte_flow_query_count::default();
+        let mut error = ffi::rte_flow_error::default();
+
+        count.set_reset(reset as u32);
+
+        let ret = unsafe {
+            ffi::rte_flow_query(
+                self.port_id,
+                self.flow.as_ptr(),
+                &action,
+                &mut count as *mut _ as *mut c_void,
+                &mut error,
+            )
+        };
+
+        if ret == 0 {
+            Ok(FlowCount {
+                hits: if count.hits_set() != 0 { Some(count.hits) } else { None },
+                bytes: if count.bytes_set() != 0 {
+                    Some(count.bytes)
+                } else {
+                    None
+                },
+            })
+        } else {
+            Err(flow_error(ret, &error))
+        }
+    }
+}
+
+/// Destroy all the flow rules of a port.
+///
+/// # Safety
+///
+/// The rules are freed by the driver, so the `Flow`s of the port must be dropped before,
+/// or never be used again.
+pub unsafe fn flush(port_id: PortId) -> Result<()> {
+    let mut error = ffi::rte_flow_error::default();
+    let ret = ffi::rte_flow_flush(port_id, &mut error);
+
+    if ret == 0 {
+        Ok(())
+    } else {
+        Err(flow_error(ret, &error))
+    }
+}
+
+/// Restrict the received packets of a port to the ones matched by the flow rules.
+///
+/// It should be called before the port is configured.
+pub fn isolate(port_id: PortId, enable: bool) -> Result<()> {
+    let mut error = ffi::rte_flow_error::default();
+    let ret = unsafe { ffi::rte_flow_isolate(port_id, enable as i32, &mut error) };
+
+    if ret == 0 {
+        Ok(())
+    } else {
+        Err(flow_error(ret, &error))
+    }
+}
+
+fn flow_error(ret: i32, error: &ffi::rte_flow_error) -> ::failure::Error {
+    let message = if error.message.is_null() {
+        String::from("unspecified")
+    } else {
+        unsafe { CStr::from_ptr(error.message) }.to_string_lossy().into_owned()
+    };
+
+    ErrorKind::FlowError(message, error.type_, ret).into()
+}
@@ -0,0 +1,432 @@
+//!
+//! Stage graph scheduler.
+//!
+//! A graph is a chain of packet processing stages, e.g. rx -> classify -> worker -> tx,
+//! which is mapped onto the slave lcores in one of two modes:
+//!
+//! - Run-to-completion, each lcore runs its own instance of the whole chain on every burst.
+//! - Pipeline, each stage runs on its own lcores, and the stages are connected by rings.
+//!
+//! The lcores are placed on the socket of each stage, e.g. the socket of the port it polls,
+//! and the rings and stage instances are allocated on the socket of the lcore consuming them.
+//!
+use std::fmt;
+use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+
+use errors::{ErrorKind, Result};
+use launch;
+use lcore;
+use mbuf::{MBuf, MBufBatch};
+use memory::{SocketId, SOCKET_ID_ANY};
+use ring::{Dequeuer, Enqueuer, MpscRing, RingFlags, Single};
+
+/// The maximum number of packets processed by a stage at once.
+pub const BURST_SIZE: usize = 32;
+
+/// The default size of rings between the pipeline stages.
+pub const DEFAULT_RING_SIZE: usize = 1024;
+
+// the unique ID of a launched graph, which is part of its ring names
+static NEXT_GRAPH_ID: AtomicUsize = AtomicUsize::new(0);
+
+/// A burst of packets passed between stages.
+pub type Batch = MBufBatch<BURST_SIZE>;
+
+/// A packet processing stage.
+pub trait Stage {
+    /// Process a burst of packets in place.
+    ///
+    /// The first stage gets an empty batch to fill, e.g. with `EthDevice::rx_burst`,
+    /// the packets left in the batch are passed to the next stage,
+    /// and freed in bulk after the last stage.
+    fn process(&mut self, pkts: &mut Batch);
+}
+
+impl<F: FnMut(&mut Batch)> Stage for F {
+    fn process(&mut self, pkts: &mut Batch) {
+        self(pkts)
+    }
+}
+
+/// The context of a stage instance.
+#[derive(Clone, Copy, Debug)]
+pub struct Context {
+    /// The lcore running the stage instance.
+    pub lcore_id: lcore::Id,
+    /// The socket of lcore.
+    pub socket_id: SocketId,
+    /// The index of stage instance, e.g. the queue to poll.
+    pub instance: usize,
+    /// The number of stage instances.
+    pub instances: usize,
+}
+
+/// The scheduling mode of a graph.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub enum Mode {
+    /// Each lcore runs all the stages back to back.
+    ///
+    /// The number of lcores and their socket are defined by the first stage.
+    RunToCompletion,
+    /// Each stage runs on its own lcores, and passes the packets to the next stage through rings.
+    Pipeline,
+}
+
+type StageFactory = dyn Fn(&Context) -> Box<dyn Stage> + Send + Sync;
+
+struct StageConf {
+    name: String,
+    instances: usize,
+    socket_id: Option<SocketId>,
+    factory: Box<StageFactory>,
+}
+
+/// A stage instance assigned to a lcore.
+#[derive(Clone, Debug)]
+pub struct Assignment {
+    /// The name of stage, or all the stages joined by `->` in the run-to-completion mode.
+    pub stage: String,
+    /// The index of stage in the graph, always 0 in the run-to-completion mode.
+    pub stage_idx: usize,
+    /// The index of stage instance.
+    pub instance: usize,
+    pub lcore_id: lcore::Id,
+    pub socket_id: SocketId,
+}
+
+impl fmt::Display for Assignment {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        write!(
+            f,
+            "lcore {} (socket {}): {} #{}",
+            self.lcore_id, self.socket_id, self.stage, self.instance
+        )
+    }
+}
+
+/// A graph of stages.
+pub struct Graph {
+    mode: Mode,
+    ring_size: usize,
+    stages: Vec<StageConf>,
+}
+
+impl Graph {
+    /// Create an empty graph.
+    pub fn new(mode: Mode) -> Self {
+        Graph {
+            mode,
+            ring_size: DEFAULT_RING_SIZE,
+            stages: Vec::new(),
+        }
+    }
+
+    /// The size of rings between the pipeline stages.
+    pub fn ring_size(mut self, ring_size: usize) -> Self {
+        self.ring_size = ring_size;
+        self
+    }
+
+    /// Append a stage to the graph.
+    ///
+    /// The `factory` is called on the lcore of each instance, so the stage is allocated on the local socket.
+    /// If `socket_id` is `None`, the stage is placed on the socket of previous stage.
+    pub fn stage<S, F>(mut self, name: &str, instances: usize, socket_id: Option<SocketId>, factory: F) -> Self
+    where
+        S: Stage + 'static,
+        F: Fn(&Context) -> S + Send + Sync + 'static,
+    {
+        self.stages.push(StageConf {
+            name: name.to_owned(),
+            instances,
+            socket_id,
+            factory: Box::new(move |ctx| Box::new(factory(ctx)) as Box<dyn Stage>),
+        });
+        self
+    }
+
+    /// Map the stage instances onto the slave lcores.
+    pub fn plan(&self) -> Result<Vec<Assignment>> {
+        let mut lcores = Vec::new();
+
+        lcore::foreach_slave(|lcore_id| lcores.push(lcore_id));
+
+        let mut assignments = Vec::new();
+        let mut last_socket_id = None;
+
+        let stages = match self.mode {
+            Mode::RunToCompletion => self.stages.first().map_or_else(Vec::new, |first| {
+                let name = self
+                    .stages
+                    .iter()
+                    .map(|stage| stage.name.as_str())
+                    .collect::<Vec<_>>()
+                    .join("->");
+
+                vec![(0, name, first.instances, first.socket_id)]
+            }),
+            Mode::Pipeline => self
+                .stages
+                .iter()
+                .enumerate()
+                .map(|(idx, stage)| (idx, stage.name.clone(), stage.instances, stage.socket_id))
+                .collect(),
+        };
+
+        for (stage_idx, name, instances, socket_id) in stages {
+            let socket_id = socket_id.or(last_socket_id);
+
+            for instance in 0..instances {
+                let pos = lcores
+                    .iter()
+                    .position(|lcore_id| socket_id.map_or(true, |socket_id| lcore_id.socket_id() == socket_id))
+                    .ok_or_else(|| {
+                        ErrorKind::NotEnoughLcores(name.clone(), instances, socket_id.unwrap_or(SOCKET_ID_ANY))
+                    })?;
+                let lcore_id = lcores.remove(pos);
+
+                assignments.push(Assignment {
+                    stage: name.clone(),
+                    stage_idx,
+                    instance,
+                    lcore_id,
+                    socket_id: lcore_id.socket_id(),
+                });
+            }
+
+            last_socket_id = socket_id.or_else(|| assignments.last().map(|assignment| assignment.socket_id));
+        }
+
+        Ok(assignments)
+    }
+
+    /// Launch the stage instances on their lcores.
+    ///
+    /// To be executed on the MASTER lcore only.
+    pub fn launch(self) -> Result<Running> {
+        let assignments = self.plan()?;
+        let graph_id = NEXT_GRAPH_ID.fetch_add(1, Ordering::Relaxed);
+        let stop = Arc::new(AtomicBool::new(false));
+        let mut rings = Vec::new();
+
+        if self.mode == Mode::Pipeline {
+            // the input rings of each stage, except the first one
+            for idx in 1..self.stages.len() {
+                let mut stage_rings = Vec::new();
+
+                for assignment in assignments.iter().filter(|assignment| assignment.stage_idx == idx) {
+                    let ring = MpscRing::create(
+                        format!("graph{}_{}_{}", graph_id, idx, assignment.instance),
+                        self.ring_size,
+                        assignment.socket_id,
+                        RingFlags::empty(),
+                    );
+                    let (tx, rx) = match ring {
+                        Ok(ring) => ring.split(),
+                        Err(err) => {
+                            rings.push(stage_rings);
+                            free_rings(rings);
+
+                            return Err(err);
+                        }
+                    };
+
+                    stage_rings.push(Link {
+                        tx,
+                        rx: Mutex::new(Some(rx)),
+                    });
+                }
+
+                rings.push(stage_rings);
+            }
+        }
+
+        let mode = self.mode;
+        let stages = Arc::new(self.stages);
+        let rings = Arc::new(rings);
+
+        for (launched, assignment) in assignments.iter().enumerate() {
+            let task = match mode {
+                Mode::RunToCompletion => Task::RunToCompletion,
+                Mode::Pipeline => Task::Pipeline(assignment.stage_idx),
+            };
+            let worker = Worker {
+                stop: stop.clone(),
+                stages: stages.clone(),
+                rings: rings.clone(),
+                task,
+                ctx: Context {
+                    lcore_id: assignment.lcore_id,
+                    socket_id: assignment.socket_id,
+                    instance: assignment.instance,
+                    instances: assignments
+                        .iter()
+                        .filter(|other| other.stage_idx == assignment.stage_idx)
+                        .count(),
+                },
+            };
+
+            if let Err(err) = launch::remote_launch(worker_main, Some(worker), assignment.lcore_id) {
+                // stop the instances already launched, and free the rings after them
+                let running = Running {
+                    stop,
+                    assignments: assignments[..launched].to_vec(),
+                    rings,
+                };
+
+                running.stop();
+                running.wait();
+
+                return Err(err);
+            }
+        }
+
+        Ok(Running {
+            stop,
+            assignments,
+            rings,
+        })
+    }
+}
+
+// A ring between the pipeline stages, the consumer is taken by the stage instance polling it.
+struct Link {
+    tx: Enqueuer<MBuf>,
+    rx: Mutex<Option<Dequeuer<MBuf, Single>>>,
+}
+
+/// A launched graph.
+pub struct Running {
+    stop: Arc<AtomicBool>,
+    assignments: Vec<Assignment>,
+    rings: Arc<Vec<Vec<Link>>>,
+}
+
+impl Running {
+    /// The stage instances and their lcores.
+    pub fn assignments(&self) -> &[Assignment] {
+        &self.assignments
+    }
+
+    /// Ask all the stage instances to stop.
+    pub fn stop(&self) {
+        self.stop.store(true, Ordering::Relaxed)
+    }
+
+    /// Wait until all the stage instances finish, free the rings and the packets left in them.
+    ///
+    /// To be executed on the MASTER lcore only.
+    pub fn wait(self) -> Vec<launch::JobState> {
+        let states = self
+            .assignments
+            .iter()
+            .map(|assignment| assignment.lcore_id.wait())
+            .collect();
+
+        if let Ok(rings) = Arc::try_unwrap(self.rings) {
+            free_rings(rings);
+        }
+
+        states
+    }
+}
+
+// Free the rings between the stages and the packets left in them.
+fn free_rings(rings: Vec<Vec<Link>>) {
+    for link in rings.into_iter().flat_map(|rings| rings.into_iter()) {
+        let ring = match link.rx.into_inner().unwrap() {
+            Some(rx) => MpscRing::join(link.tx, rx),
+            None => continue,
+        };
+        let mut pkts = Batch::new();
+
+        while ring.dequeue_batch(&mut pkts) > 0 {
+            pkts.clear();
+        }
+
+        ring.free();
+    }
+}
+
+enum Task {
+    RunToCompletion,
+    Pipeline(usize),
+}
+
+struct Worker {
+    stop: Arc<AtomicBool>,
+    stages: Arc<Vec<StageConf>>,
+    rings: Arc<Vec<Vec<Link>>>,
+    task: Task,
+    ctx: Context,
+}
+
+fn worker_main(worker: Option<Worker>) -> i32 {
+    let worker = worker.unwrap();
+    let mut pkts = Batch::new();
+
+    match worker.task {
+        Task::RunToCompletion => {
+            let mut stages = worker
+                .stages
+                .iter()
+                .map(|stage| (stage.factory)(&worker.ctx))
+                .collect::<Vec<_>>();
+
+            while !worker.stop.load(Ordering::Relaxed) {
+                for stage in stages.iter_mut() {
+                    stage.process(&mut pkts);
+
+                    if pkts.is_empty() {
+                        break;
+                    }
+                }
+
+                pkts.clear();
+            }
+        }
+        Task::Pipeline(idx) => {
+            let mut stage = (worker.stages[idx].factory)(&worker.ctx);
+            let input_link = if idx > 0 {
+                Some(&worker.rings[idx - 1][worker.ctx.instance])
+            } else {
+                None
+            };
+            let input = input_link.and_then(|link| link.rx.lock().unwrap().take());
+            let output = worker.rings.get(idx).map(|rings| rings.as_slice()).unwrap_or(&[]);
+            let mut next = worker.ctx.instance;
+
+            while !worker.stop.load(Ordering::Relaxed) {
+                if let Some(ref ring) = input {
+                    if ring.dequeue_batch(&mut pkts) == 0 {
+                        continue;
+                    }
+                }
+
+                stage.process(&mut pkts);
+
+                // spread the bursts to the next stage instances in round robin,
+                // and drop the packets if all the rings are full.
+                for _ in 0..output.len() {
+                    if pkts.is_empty() {
+                        break;
+                    }
+
+                    next = (next + 1) % output.len();
+
+                    output[next].tx.enqueue_batch(&mut pkts);
+                }
+
+                pkts.clear();
+            }
+
+            // give back the consumer to free the ring
+            if let Some(link) = input_link {
+                *link.rx.lock().unwrap() = input;
+            }
+        }
+    }
+
+    0
+}
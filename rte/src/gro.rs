@@ -0,0 +1,174 @@
+//!
+//! RTE Generic Receive Offload
+//!
+//! GRO merges the TCP segments of a flow into a large packet chained of the segments,
+//! it requires the packet type and the header lengths of mbufs, see `MBuf::parse_packet_type`.
+//!
+//! The lightweight mode merges the packets of a single burst with `reassemble_burst`,
+//! and the heavyweight mode keeps the packets across the bursts in a `GroContext`,
+//! until they are flushed by `GroContext::timeout_flush`.
+//!
+//! The checksums are neither checked nor updated for the merged packets.
+//!
+use std::os::raw::c_void;
+use std::ptr::NonNull;
+
+use ffi;
+
+use errors::{AsResult, Result};
+use lcore;
+use mbuf::{MBufBatch, RxBurst, TxBurst};
+use memory::SocketId;
+
+/// The maximum number of packets merged by `reassemble_burst`.
+pub const GRO_MAX_BURST_ITEM_NUM: usize = ffi::RTE_GRO_MAX_BURST_ITEM_NUM as usize;
+
+bitflags! {
+    /// The types of packets to merge.
+    pub struct GroTypes: u64 {
+        /// TCP/IPv4 packets.
+        const TCP_IPV4 = ffi::RTE_GRO_TCP_IPV4 as u64;
+        /// TCP/IPv4 packets encapsulated in VXLAN/IPv4.
+        const IPV4_VXLAN_TCP_IPV4 = ffi::RTE_GRO_IPV4_VXLAN_TCP_IPV4 as u64;
+    }
+}
+
+/// The parameters of GRO.
+#[derive(Clone, Copy, Debug)]
+pub struct GroParam {
+    /// The types of packets to merge.
+    pub types: GroTypes,
+    /// The maximum number of flows.
+    pub max_flow_num: u16,
+    /// The maximum number of packets per flow.
+    pub max_item_per_flow: u16,
+    /// The socket to allocate the reassembly tables of `GroContext`.
+    pub socket_id: SocketId,
+}
+
+impl Default for GroParam {
+    fn default() -> Self {
+        GroParam {
+            types: GroTypes::TCP_IPV4,
+            max_flow_num: 4,
+            max_item_per_flow: 32,
+            socket_id: lcore::socket_id() as SocketId,
+        }
+    }
+}
+
+impl GroParam {
+    fn to_raw(&self) -> ffi::rte_gro_param {
+        ffi::rte_gro_param {
+            gro_types: self.types.bits,
+            max_flow_num: self.max_flow_num,
+            max_item_per_flow: self.max_item_per_flow,
+            socket_id: self.socket_id as u16,
+        }
+    }
+}
+
+/// Merge the packets of a burst in place, the packets of a flow are chained to its first packet.
+///
+/// It returns the number of packets left in the batch,
+/// at most `max_flow_num * max_item_per_flow` packets are processed.
+#[inline]
+pub fn reassemble_burst<const N: usize>(pkts: &mut MBufBatch<N>, param: &GroParam) -> usize {
+    let param = param.to_raw();
+    let nb_pkts = {
+        let pending = pkts.pending();
+
+        if pending.is_empty() {
+            return 0;
+        }
+
+        unsafe { ffi::rte_gro_reassemble_burst(pending.as_mut_ptr(), pending.len() as u16, &param) as usize }
+    };
+
+    unsafe { pkts.set_len(nb_pkts) };
+
+    nb_pkts
+}
+
+/// A GRO context, which merges the packets across the bursts in its reassembly tables.
+pub struct GroContext {
+    ctx: NonNull<c_void>,
+    types: GroTypes,
+}
+
+unsafe impl Send for GroContext {}
+
+impl Drop for GroContext {
+    fn drop(&mut self) {
+        // the packets in the reassembly tables are not freed by `rte_gro_ctx_destroy`
+        let mut pkts = MBufBatch::<32>::new();
+
+        while self.timeout_flush(0, &mut pkts) > 0 {
+            pkts.clear();
+        }
+
+        unsafe { ffi::rte_gro_ctx_destroy(self.ctx.as_ptr()) }
+    }
+}
+
+impl GroContext {
+    /// Create a GRO context with its reassembly tables.
+    pub fn create(param: &GroParam) -> Result<Self> {
+        unsafe { ffi::rte_gro_ctx_create(&param.to_raw()) }
+            .as_result()
+            .map(|ctx| GroContext {
+                ctx,
+                types: param.types,
+            })
+    }
+
+    /// Merge the packets of a burst into the reassembly tables.
+    ///
+    /// The packets which could not be merged, e.g. not TCP or the tables are full, are left in the batch,
+    /// it returns the number of them.
+    #[inline]
+    pub fn reassemble<const N: usize>(&mut self, pkts: &mut MBufBatch<N>) -> usize {
+        let nb_pkts = {
+            let pending = pkts.pending();
+
+            if pending.is_empty() {
+                return 0;
+            }
+
+            unsafe { ffi::rte_gro_reassemble(pending.as_mut_ptr(), pending.len() as u16, self.ctx.as_ptr()) as usize }
+        };
+
+        unsafe { pkts.set_len(nb_pkts) };
+
+        nb_pkts
+    }
+
+    /// Flush the packets staying in the reassembly tables longer than `timeout_cycles` TSC cycles to `out`,
+    /// it returns the number of packets flushed.
+    #[inline]
+    pub fn timeout_flush<B: RxBurst + ?Sized>(&mut self, timeout_cycles: u64, out: &mut B) -> usize {
+        unsafe {
+            let nb_out = {
+                let spare = out.spare();
+
+                ffi::rte_gro_timeout_flush(
+                    self.ctx.as_ptr(),
+                    timeout_cycles,
+                    self.types.bits,
+                    spare.as_mut_ptr(),
+                    spare.len() as u16,
+                ) as usize
+            };
+
+            out.filled(nb_out);
+
+            nb_out
+        }
+    }
+
+    /// The number of packets in the reassembly tables.
+    #[inline]
+    pub fn pkt_count(&self) -> usize {
+        unsafe { ffi::rte_gro_get_pkt_count(self.ctx.as_ptr()) as usize }
+    }
+}
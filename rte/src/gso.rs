@@ -0,0 +1,92 @@
+//!
+//! RTE Generic Segmentation Offload
+//!
+//! GSO segments a large TCP or UDP packet in software when the NIC doesn't support TSO.
+//! Each segment is a direct mbuf with a copy of the headers, chained to an indirect mbuf of the payload,
+//! so the payload of the input packet is never copied.
+//!
+//! The input packet must be flagged with `PKT_TX_TCP_SEG` or `PKT_TX_UDP_SEG` and the header lengths.
+//! The checksums of segments are not updated, which are usually left to the TX checksum offload.
+//!
+use ffi;
+
+use errors::{Result, RteError};
+use mbuf::{MBuf, RxBurst};
+use mempool::MemoryPool;
+use utils::{AsRaw, IntoRaw};
+
+/// The minimum size of a segment.
+pub const GSO_SEG_SIZE_MIN: usize = ffi::RTE_GSO_SEG_SIZE_MIN as usize;
+
+bitflags! {
+    /// The types of packets to segment.
+    pub struct GsoTypes: u64 {
+        const TCP_TSO = ffi::DEV_TX_OFFLOAD_TCP_TSO as u64;
+        const UDP_TSO = ffi::DEV_TX_OFFLOAD_UDP_TSO as u64;
+        const VXLAN_TNL_TSO = ffi::DEV_TX_OFFLOAD_VXLAN_TNL_TSO as u64;
+        const GRE_TNL_TSO = ffi::DEV_TX_OFFLOAD_GRE_TNL_TSO as u64;
+    }
+}
+
+/// A GSO context.
+pub struct GsoContext(ffi::rte_gso_ctx);
+
+unsafe impl Send for GsoContext {}
+
+impl GsoContext {
+    /// Create a GSO context, which segments packets to at most `gso_size` bytes including the headers.
+    ///
+    /// The headers of segments are allocated from `direct_pool`,
+    /// and the indirect mbufs of payload from `indirect_pool`, which could have no data room.
+    pub fn new(direct_pool: &MemoryPool, indirect_pool: &MemoryPool, types: GsoTypes, gso_size: u16) -> Self {
+        GsoContext(ffi::rte_gso_ctx {
+            direct_pool: direct_pool.as_raw(),
+            indirect_pool: indirect_pool.as_raw(),
+            gso_types: types.bits,
+            gso_size,
+            flag: 0,
+        })
+    }
+
+    /// Keep the IPv4 ID of segments the same as the input packet, instead of incrementing it.
+    pub fn with_fixed_ipid(mut self) -> Self {
+        self.0.flag |= ffi::RTE_GSO_FLAG_IPID_FIXED as u8;
+        self
+    }
+
+    /// The maximum size of a segment, including the headers.
+    #[inline]
+    pub fn gso_size(&self) -> usize {
+        usize::from(self.0.gso_size)
+    }
+
+    /// Segment a packet, and append the segments to `out`.
+    ///
+    /// The packet is appended as is if it doesn't need segmenting,
+    /// otherwise it is freed with its last segment.
+    /// If there are not enough spare slots or mbufs, the packet is dropped.
+    ///
+    /// It returns the number of packets appended to `out`.
+    #[inline]
+    pub fn segment<B: RxBurst + ?Sized>(&self, m: MBuf, out: &mut B) -> Result<usize> {
+        let m = m.into_raw();
+
+        unsafe {
+            let ret = {
+                let spare = out.spare();
+
+                ffi::rte_gso_segment(m, &self.0, spare.as_mut_ptr(), spare.len() as u16)
+            };
+
+            if ret < 0 {
+                drop(MBuf::from(m));
+
+                Err(RteError(ret).into())
+            } else {
+                out.filled(ret as usize);
+
+                Ok(ret as usize)
+            }
+        }
+    }
+}
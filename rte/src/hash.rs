@@ -0,0 +1,493 @@
+//!
+//! RTE Hash
+//!
+//! A typed flow table over `rte_hash`, the keys are stored in the hash table,
+//! and the values in a slot array owned by the table, whose index is kept as the key data.
+//!
+//! The lookups of a whole burst are done at once with `lookup_bulk`,
+//! which pipelines the bucket accesses of up to 64 keys,
+//! and the signatures may be computed once and reused with the `*_with_hash` variants.
+//!
+//! A table created with `HashFlags::RW_CONCURRENCY_LF` may be read by many lcores without lock,
+//! while a single writer updates it with `insert_shared` and `remove_shared`.
+//!
+use std::cell::UnsafeCell;
+use std::cmp;
+use std::marker::PhantomData;
+use std::mem::{self, MaybeUninit};
+use std::os::raw::c_void;
+use std::ptr::{self, NonNull};
+
+use ffi;
+use libc;
+
+use errors::{AsResult, ErrorKind, Result, RteError};
+use memory::SocketId;
+use utils::AsCString;
+
+/// The maximum number of keys looked up at once by `rte_hash_lookup_bulk_data`.
+pub const LOOKUP_BULK_MAX: usize = ffi::RTE_HASH_LOOKUP_BULK_MAX as usize;
+
+/// The signature of a key.
+pub type Signature = ffi::hash_sig_t;
+
+bitflags! {
+    pub struct HashFlags: u8 {
+        /// Use the hardware transactional memory for the concurrent writers, if supported.
+        const TRANS_MEM_SUPPORT     = ffi::RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT as u8;
+        /// Many writers may add the keys concurrently.
+        const MULTI_WRITER_ADD      = ffi::RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD as u8;
+        /// The readers and writers may access the table concurrently, with a reader-writer lock.
+        const RW_CONCURRENCY        = ffi::RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY as u8;
+        /// Use the extendable buckets when a bucket is full, so the table never fails
+        /// to insert a key before it holds `entries` keys.
+        const EXT_TABLE             = ffi::RTE_HASH_EXTRA_FLAGS_EXT_TABLE as u8;
+        /// The position of a deleted key is not freed until `rte_hash_free_key_with_position`.
+        const NO_FREE_ON_DEL        = ffi::RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL as u8;
+        /// The readers never block, and the position of a deleted key
+        /// is not freed until `rte_hash_free_key_with_position`.
+        const RW_CONCURRENCY_LF     = ffi::RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF as u8;
+    }
+}
+
+/// A key of flow table.
+///
+/// The keys are hashed and compared byte by byte,
+/// so the type must not have any padding or pointer, e.g. a `#[repr(C)]` struct with explicit pad fields.
+pub unsafe trait HashKey: Copy {}
+
+macro_rules! impl_hash_key {
+    ($($t:ty)*) => ($(
+        unsafe impl HashKey for $t {}
+    )*)
+}
+
+impl_hash_key! { u8 u16 u32 u64 u128 i8 i16 i32 i64 i128 }
+
+unsafe impl<T: HashKey, const N: usize> HashKey for [T; N] {}
+
+/// The IPv4 5-tuple of a flow.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq, Hash)]
+pub struct Ipv4FiveTuple {
+    /// The source address, in network byte order.
+    pub src_addr: u32,
+    /// The destination address, in network byte order.
+    pub dst_addr: u32,
+    /// The source port, in network byte order.
+    pub src_port: u16,
+    /// The destination port, in network byte order.
+    pub dst_port: u16,
+    pub proto: u8,
+    pad: [u8; 3],
+}
+
+unsafe impl HashKey for Ipv4FiveTuple {}
+
+impl Ipv4FiveTuple {
+    pub fn new(src_addr: u32, dst_addr: u32, src_port: u16, dst_port: u16, proto: u8) -> Self {
+        Ipv4FiveTuple {
+            src_addr,
+            dst_addr,
+            src_port,
+            dst_port,
+            proto,
+            pad: [0; 3],
+        }
+    }
+}
+
+/// Calculate the CRC32 hash of a key, the default hash function of `FlowTable`.
+#[inline]
+pub fn hash_crc<K: HashKey>(key: &K, init_val: u32) -> Signature {
+    unsafe { ffi::_rte_hash_crc(key as *const K as *const c_void, mem::size_of::<K>() as u32, init_val) }
+}
+
+/// Calculate the Jenkins hash of a key.
+#[inline]
+pub fn jhash<K: HashKey>(key: &K, init_val: u32) -> Signature {
+    unsafe { ffi::_rte_jhash(key as *const K as *const c_void, mem::size_of::<K>() as u32, init_val) }
+}
+
+type Slot<V> = UnsafeCell<MaybeUninit<V>>;
+
+/// A key removed from a shared table, whose value may still be referenced by the readers.
+///
+/// It must be passed to `FlowTable::reclaim` once all the readers have quiesced.
+#[must_use]
+#[derive(Debug)]
+pub struct Retired {
+    pos: i32,
+    slot: usize,
+}
+
+/// A flow table from `K` to `V`.
+pub struct FlowTable<K, V> {
+    raw: NonNull<ffi::rte_hash>,
+    flags: HashFlags,
+    slots: Box<[Slot<V>]>,
+    free: UnsafeCell<Vec<u32>>,
+    // the number of `Retired` keys not reclaimed yet
+    retired: UnsafeCell<usize>,
+    phantom: PhantomData<K>,
+}
+
+unsafe impl<K: HashKey + Send, V: Send> Send for FlowTable<K, V> {}
+unsafe impl<K: HashKey + Sync, V: Send + Sync> Sync for FlowTable<K, V> {}
+
+impl<K, V> Drop for FlowTable<K, V> {
+    fn drop(&mut self) {
+        self.drop_values();
+
+        unsafe { ffi::rte_hash_free(self.raw.as_ptr()) }
+    }
+}
+
+impl<K: HashKey, V> FlowTable<K, V> {
+    /// Create a flow table holding up to `entries` keys, hashed with CRC32.
+    pub fn create<S: AsRef<str>>(name: S, entries: usize, socket_id: SocketId, flags: HashFlags) -> Result<Self> {
+        let name = name.as_cstring();
+        let params = ffi::rte_hash_parameters {
+            name: name.as_ptr(),
+            entries: entries as u32,
+            key_len: mem::size_of::<K>() as u32,
+            hash_func: Some(ffi::_rte_hash_crc),
+            hash_func_init_val: 0,
+            socket_id,
+            extra_flag: flags.bits,
+            ..Default::default()
+        };
+
+        let raw = unsafe { ffi::rte_hash_create(&params) }.as_result()?;
+
+        Ok(FlowTable {
+            raw,
+            flags,
+            slots: (0..entries).map(|_| UnsafeCell::new(MaybeUninit::uninit())).collect(),
+            free: UnsafeCell::new((0..entries as u32).rev().collect()),
+            retired: UnsafeCell::new(0),
+            phantom: PhantomData,
+        })
+    }
+}
+
+impl<K, V> FlowTable<K, V> {
+    /// The flags of table.
+    pub fn flags(&self) -> HashFlags {
+        self.flags
+    }
+
+    /// The maximum number of keys.
+    pub fn capacity(&self) -> usize {
+        self.slots.len()
+    }
+
+    /// The number of keys in the table.
+    pub fn len(&self) -> usize {
+        cmp::max(unsafe { ffi::rte_hash_count(self.raw.as_ptr()) }, 0) as usize
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    #[inline(always)]
+    fn raw(&self) -> *const ffi::rte_hash {
+        self.raw.as_ptr()
+    }
+
+    #[inline(always)]
+    unsafe fn value(&self, data: *mut c_void) -> &V {
+        &*(*self.slots.get_unchecked(data as usize).get()).as_ptr()
+    }
+
+    #[inline(always)]
+    unsafe fn take(&self, slot: usize) -> V {
+        let value = (*self.slots[slot].get()).as_ptr().read();
+
+        (*self.free.get()).push(slot as u32);
+
+        value
+    }
+
+    fn drop_values(&mut self) {
+        let mut key = ptr::null();
+        let mut data = ptr::null_mut();
+        let mut next = 0;
+
+        while unsafe { ffi::rte_hash_iterate(self.raw(), &mut key, &mut data, &mut next) } >= 0 {
+            unsafe { ptr::drop_in_place((*self.slots[data as usize].get()).as_mut_ptr()) }
+        }
+    }
+
+    /// Remove all the keys and drop their values.
+    ///
+    /// It fails if some keys removed by `remove_shared` are not reclaimed yet,
+    /// since their slots would be reused while the `Retired` still refer to them.
+    pub fn clear(&mut self) -> Result<()> {
+        let retired = *self.retired.get_mut();
+
+        if retired > 0 {
+            return Err(ErrorKind::RetiredKeys(retired).into());
+        }
+
+        self.drop_values();
+
+        unsafe { ffi::rte_hash_reset(self.raw.as_ptr()) }
+
+        *self.free.get_mut() = (0..self.slots.len() as u32).rev().collect();
+
+        Ok(())
+    }
+}
+
+impl<K: HashKey, V> FlowTable<K, V> {
+    #[inline(always)]
+    fn key_ptr(key: &K) -> *const c_void {
+        key as *const K as *const c_void
+    }
+
+    /// Calculate the signature of a key.
+    #[inline]
+    pub fn hash(&self, key: &K) -> Signature {
+        unsafe { ffi::rte_hash_hash(self.raw(), Self::key_ptr(key)) }
+    }
+
+    /// Calculate the signatures of keys, e.g. to look them up in many tables.
+    pub fn hash_bulk(&self, keys: &[K], sigs: &mut [Signature]) {
+        for (key, sig) in keys.iter().zip(sigs.iter_mut()) {
+            *sig = self.hash(key);
+        }
+    }
+
+    /// Find the value of a key.
+    #[inline]
+    pub fn lookup(&self, key: &K) -> Option<&V> {
+        let mut data = ptr::null_mut();
+
+        if unsafe { ffi::rte_hash_lookup_data(self.raw(), Self::key_ptr(key), &mut data) } >= 0 {
+            Some(unsafe { self.value(data) })
+        } else {
+            None
+        }
+    }
+
+    /// Find the value of a key with its precomputed signature.
+    #[inline]
+    pub fn lookup_with_hash(&self, key: &K, sig: Signature) -> Option<&V> {
+        let mut data = ptr::null_mut();
+
+        if unsafe { ffi::rte_hash_lookup_with_hash_data(self.raw(), Self::key_ptr(key), sig, &mut data) } >= 0 {
+            Some(unsafe { self.value(data) })
+        } else {
+            None
+        }
+    }
+
+    /// Find the values of a burst of keys, and return the number of keys found.
+    ///
+    /// The keys are looked up by chunks of `LOOKUP_BULK_MAX`.
+    pub fn lookup_bulk<'a>(&'a self, keys: &[K], values: &mut [Option<&'a V>]) -> usize {
+        let mut hits = 0;
+
+        for (keys, values) in keys.chunks(LOOKUP_BULK_MAX).zip(values.chunks_mut(LOOKUP_BULK_MAX)) {
+            let n = cmp::min(keys.len(), values.len());
+            let mut key_ptrs = [ptr::null(); LOOKUP_BULK_MAX];
+            let mut data = [ptr::null_mut(); LOOKUP_BULK_MAX];
+            let mut hit_mask = 0u64;
+
+            for (p, key) in key_ptrs.iter_mut().zip(&keys[..n]) {
+                *p = Self::key_ptr(key);
+            }
+
+            if unsafe {
+                ffi::rte_hash_lookup_bulk_data(
+                    self.raw(),
+                    key_ptrs.as_mut_ptr(),
+                    n as u32,
+                    &mut hit_mask,
+                    data.as_mut_ptr(),
+                )
+            } < 0
+            {
+                hit_mask = 0;
+            }
+
+            for (i, value) in values[..n].iter_mut().enumerate() {
+                *value = if (hit_mask & (1 << i)) != 0 {
+                    Some(unsafe { self.value(data[i]) })
+                } else {
+                    None
+                };
+            }
+
+            hits += hit_mask.count_ones() as usize;
+        }
+
+        hits
+    }
+
+    /// Find the values of a burst of keys with their precomputed signatures,
+    /// and return the number of keys found.
+    ///
+    /// It skips hashing, but looks up the keys one by one,
+    /// since there is no bulk lookup with signatures in this DPDK release.
+    pub fn lookup_bulk_with_hash<'a>(&'a self, keys: &[K], sigs: &[Signature], values: &mut [Option<&'a V>]) -> usize {
+        let mut hits = 0;
+
+        for ((key, &sig), value) in keys.iter().zip(sigs).zip(values.iter_mut()) {
+            *value = self.lookup_with_hash(key, sig);
+
+            if value.is_some() {
+                hits += 1;
+            }
+        }
+
+        hits
+    }
+
+    /// Insert a key-value pair, and return the previous value of key.
+    pub fn insert(&mut self, key: K, value: V) -> Result<Option<V>> {
+        let sig = self.hash(&key);
+
+        self.insert_with_hash(key, sig, value)
+    }
+
+    /// Insert a key-value pair with the precomputed signature of key, and return the previous value of key.
+    pub fn insert_with_hash(&mut self, key: K, sig: Signature, value: V) -> Result<Option<V>> {
+        let mut data = ptr::null_mut();
+
+        if unsafe { ffi::rte_hash_lookup_with_hash_data(self.raw(), Self::key_ptr(&key), sig, &mut data) } >= 0 {
+            return Ok(Some(mem::replace(
+                unsafe { &mut *(*self.slots[data as usize].get()).as_mut_ptr() },
+                value,
+            )));
+        }
+
+        unsafe { self.add(&key, sig, value) }.map(|_| None)
+    }
+
+    /// Insert a key-value pair to a table shared with the concurrent readers.
+    ///
+    /// The value is written before the key is published, so the readers never see it partially.
+    /// If the key exists, the table is left unchanged and the value is given back.
+    ///
+    /// # Safety
+    ///
+    /// The table must be created with `RW_CONCURRENCY` or `RW_CONCURRENCY_LF`,
+    /// and only one lcore may insert or remove the keys at a time.
+    pub unsafe fn insert_shared(&self, key: K, value: V) -> Result<Option<V>> {
+        let sig = self.hash(&key);
+
+        if ffi::rte_hash_lookup_with_hash(self.raw(), Self::key_ptr(&key), sig) >= 0 {
+            return Ok(Some(value));
+        }
+
+        self.add(&key, sig, value).map(|_| None)
+    }
+
+    unsafe fn add(&self, key: &K, sig: Signature, value: V) -> Result<()> {
+        let free = &mut *self.free.get();
+        let slot = free.pop().ok_or(RteError(-libc::ENOSPC))?;
+
+        (*self.slots[slot as usize].get()).as_mut_ptr().write(value);
+
+        let ret = ffi::rte_hash_add_key_with_hash_data(self.raw(), Self::key_ptr(key), sig, slot as usize as *mut _);
+
+        if ret < 0 {
+            self.take(slot as usize);
+
+            Err(RteError(ret).into())
+        } else {
+            Ok(())
+        }
+    }
+
+    /// Remove a key, and return its value.
+    pub fn remove(&mut self, key: &K) -> Option<V> {
+        unsafe { self.remove_shared(key) }.map(|retired| unsafe { self.reclaim(retired) })
+    }
+
+    /// Remove a key from a table shared with the concurrent readers.
+    ///
+    /// The value is kept until the returned `Retired` is reclaimed.
+    ///
+    /// # Safety
+    ///
+    /// Only one lcore may insert or remove the keys at a time.
+    pub unsafe fn remove_shared(&self, key: &K) -> Option<Retired> {
+        let mut data = ptr::null_mut();
+
+        if ffi::rte_hash_lookup_data(self.raw(), Self::key_ptr(key), &mut data) < 0 {
+            return None;
+        }
+
+        let pos = ffi::rte_hash_del_key(self.raw(), Self::key_ptr(key));
+
+        if pos < 0 {
+            None
+        } else {
+            *self.retired.get() += 1;
+
+            Some(Retired {
+                pos,
+                slot: data as usize,
+            })
+        }
+    }
+
+    /// Free the position of a removed key, and return its value.
+    ///
+    /// # Safety
+    ///
+    /// No reader may still reference the value, and only one lcore may insert or remove the keys at a time.
+    pub unsafe fn reclaim(&self, retired: Retired) -> V {
+        if self
+            .flags
+            .intersects(HashFlags::NO_FREE_ON_DEL | HashFlags::RW_CONCURRENCY_LF)
+        {
+            ffi::rte_hash_free_key_with_position(self.raw(), retired.pos);
+        }
+
+        *self.retired.get() -= 1;
+
+        self.take(retired.slot)
+    }
+
+    /// Iterate the key-value pairs.
+    ///
+    /// The table must not be updated concurrently.
+    pub fn iter(&self) -> Iter<'_, K, V> {
+        Iter { table: self, next: 0 }
+    }
+}
+
+impl<'a, K: HashKey, V> IntoIterator for &'a FlowTable<K, V> {
+    type Item = (&'a K, &'a V);
+    type IntoIter = Iter<'a, K, V>;
+
+    fn into_iter(self) -> Self::IntoIter {
+        self.iter()
+    }
+}
+
+/// An iterator over the key-value pairs of a `FlowTable`.
+pub struct Iter<'a, K: 'a, V: 'a> {
+    table: &'a FlowTable<K, V>,
+    next: u32,
+}
+
+impl<'a, K: HashKey, V> Iterator for Iter<'a, K, V> {
+    type Item = (&'a K, &'a V);
+
+    fn next(&mut self) -> Option<Self::Item> {
+        let mut key = ptr::null();
+        let mut data = ptr::null_mut();
+
+        if unsafe { ffi::rte_hash_iterate(self.table.raw(), &mut key, &mut data, &mut self.next) } < 0 {
+            None
+        } else {
+            Some(unsafe { (&*(key as *const K), self.table.value(data)) })
+        }
+    }
+}
@@ -0,0 +1,158 @@
+//!
+//! Idle heuristics for the poll loops.
+//!
+//! A poll loop reports the number of packets it received on each round,
+//! after some consecutive empty rounds it starts to pause between the polls,
+//! with an exponential backoff, and when the RX queues stay empty for longer,
+//! it arms their RX interrupts and sleeps on the epoll instance of the thread.
+//!
+//! The first packet wakes the lcore up, and the backoff is reset,
+//! so it gets back to full speed polling immediately.
+//!
+use std::cmp;
+use std::hint;
+use std::mem;
+
+use ffi;
+
+use errors::Result;
+use ethdev::{EthDevice, PortId, QueueId};
+
+/// The idle heuristics of a poll loop.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct IdlePolicy {
+    /// The number of consecutive empty polls before pausing between polls.
+    pub pause_after: u32,
+    /// The maximum number of `pause` instructions between two polls,
+    /// the pause is doubled on each empty poll up to it.
+    pub max_pause: u32,
+    /// The number of consecutive empty polls before sleeping on the RX interrupts, 0 to never sleep.
+    pub sleep_after: u32,
+    /// The maximum time to sleep in milliseconds, -1 to wait for the interrupts forever.
+    pub sleep_timeout_ms: i32,
+}
+
+impl Default for IdlePolicy {
+    fn default() -> Self {
+        IdlePolicy {
+            pause_after: 10,
+            max_pause: 256,
+            sleep_after: 300,
+            sleep_timeout_ms: 10,
+        }
+    }
+}
+
+// The maximum number of events returned on wake up
+const MAX_EVENTS: usize = 16;
+
+/// Back off a poll loop when it is idle.
+pub struct IdleBackoff {
+    policy: IdlePolicy,
+    empty_polls: u32,
+    pause: u32,
+    rx_queues: Vec<(PortId, QueueId)>,
+    sleeps: u64,
+}
+
+impl Drop for IdleBackoff {
+    fn drop(&mut self) {
+        for &(port_id, queue_id) in &self.rx_queues {
+            let _ = port_id.rx_intr_unregister(queue_id);
+        }
+    }
+}
+
+impl IdleBackoff {
+    pub fn new(policy: IdlePolicy) -> Self {
+        IdleBackoff {
+            policy,
+            empty_polls: 0,
+            pause: 1,
+            rx_queues: Vec::new(),
+            sleeps: 0,
+        }
+    }
+
+    /// The idle policy.
+    pub fn policy(&self) -> &IdlePolicy {
+        &self.policy
+    }
+
+    /// The number of times the lcore slept on the RX interrupts.
+    pub fn sleeps(&self) -> u64 {
+        self.sleeps
+    }
+
+    /// Add a RX queue polled by the loop, to be woken up by its RX interrupt.
+    ///
+    /// It registers the interrupt to the epoll instance of current thread,
+    /// so it must be called on the polling lcore.
+    /// Without any RX queue, the loop only pauses and never sleeps.
+    pub fn add_rx_queue(&mut self, port_id: PortId, queue_id: QueueId) -> Result<&mut Self> {
+        let data = ((u32::from(port_id) << 16) | u32::from(queue_id)) as usize;
+
+        port_id.rx_intr_register(queue_id, data as *mut _)?;
+
+        self.rx_queues.push((port_id, queue_id));
+
+        Ok(self)
+    }
+
+    /// Report the number of packets received in a round of polls, and back off if idle.
+    ///
+    /// The buffered TX packets should be flushed on the empty polls before calling it,
+    /// e.g. with `TxFlushPolicy::on_idle`, or they may wait until the lcore wakes up.
+    #[inline]
+    pub fn poll(&mut self, nb_rx: usize) {
+        if nb_rx > 0 {
+            self.empty_polls = 0;
+            self.pause = 1;
+
+            return;
+        }
+
+        self.empty_polls = self.empty_polls.saturating_add(1);
+
+        if self.policy.sleep_after > 0 && self.empty_polls >= self.policy.sleep_after && !self.rx_queues.is_empty() {
+            self.sleep();
+
+            self.empty_polls = 0;
+            self.pause = 1;
+        } else if self.empty_polls >= self.policy.pause_after {
+            for _ in 0..self.pause {
+                hint::spin_loop();
+            }
+
+            self.pause = cmp::min(self.pause * 2, cmp::max(self.policy.max_pause, 1));
+        }
+    }
+
+    // Arm the RX interrupts, and sleep until one of them fires or timeout.
+    fn sleep(&mut self) {
+        for &(port_id, queue_id) in &self.rx_queues {
+            let _ = port_id.rx_intr_enable(queue_id);
+        }
+
+        let mut events: [ffi::rte_epoll_event; MAX_EVENTS] = unsafe { mem::zeroed() };
+
+        let n = unsafe {
+            ffi::rte_epoll_wait(
+                ffi::RTE_EPOLL_PER_THREAD,
+                events.as_mut_ptr(),
+                MAX_EVENTS as i32,
+                self.policy.sleep_timeout_ms,
+            )
+        };
+
+        if n < 0 {
+            debug!("fail to wait RX interrupts, {}", n);
+        }
+
+        for &(port_id, queue_id) in &self.rx_queues {
+            let _ = port_id.rx_intr_disable(queue_id);
+        }
+
+        self.sleeps += 1;
+    }
+}
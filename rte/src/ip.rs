@@ -1,7 +1,243 @@
+use std::mem;
+use std::net::{Ipv4Addr, Ipv6Addr};
+use std::ops::Deref;
+
+use libc;
+
 use ffi;
 
+use mbuf::{Header, HeaderRef, MBuf};
+use tcp::TcpView;
+use udp::UdpView;
+
 /// IPv4 Header
 pub type Ipv4Hdr = ffi::ipv4_hdr;
 
 /// IPv6 Header
 pub type Ipv6Hdr = ffi::ipv6_hdr;
+
+unsafe impl Header for Ipv4Hdr {}
+unsafe impl Header for Ipv6Hdr {}
+
+/// The more fragments flag of IPv4 header.
+pub const IPV4_HDR_MF_FLAG: u16 = 0x2000;
+
+/// The fragment offset mask of IPv4 header, in units of 8 bytes.
+pub const IPV4_HDR_OFFSET_MASK: u16 = 0x1fff;
+
+/// Decrement the TTL of an IPv4 header, and update its checksum incrementally (RFC 1624).
+///
+/// Return `false` without touching the header if the TTL has expired.
+#[inline]
+pub fn ipv4_dec_ttl(hdr: &mut Ipv4Hdr) -> bool {
+    if hdr.time_to_live <= 1 {
+        return false;
+    }
+
+    hdr.time_to_live -= 1;
+
+    // the TTL is the high byte of a 16 bits word, so the checksum gets 0x0100 with the end-around carry
+    let sum = u32::from(u16::from_be(hdr.hdr_checksum)) + 0x0100;
+
+    hdr.hdr_checksum = ((sum + (sum >> 16)) as u16).to_be();
+
+    true
+}
+
+/// An IPv4 header parsed in place from the packet data.
+pub struct Ipv4View<'a> {
+    m: &'a MBuf,
+    off: usize,
+    hdr: HeaderRef<'a, Ipv4Hdr>,
+}
+
+impl<'a> Ipv4View<'a> {
+    /// Parse the IPv4 header at an offset of the packet.
+    ///
+    /// It returns `None` if the version, the header length or the total length is malformed,
+    /// or if the header with its options or the total length runs past the end of packet.
+    #[inline]
+    pub fn parse(m: &'a MBuf, off: usize) -> Option<Self> {
+        let hdr = m.header::<Ipv4Hdr>(off)?;
+        let ihl = usize::from(hdr.version_ihl & 0x0f) * 4;
+        let total_len = usize::from(u16::from_be(hdr.total_length));
+
+        // the header is in the packet, so `off` can't overflow with a 16 bits length
+        if (hdr.version_ihl >> 4) == 4
+            && ihl >= mem::size_of::<Ipv4Hdr>()
+            && total_len >= ihl
+            && off + total_len <= m.pkt_len()
+        {
+            Some(Ipv4View { m, off, hdr })
+        } else {
+            None
+        }
+    }
+
+    /// The source address.
+    #[inline]
+    pub fn src(&self) -> Ipv4Addr {
+        Ipv4Addr::from(u32::from_be(self.hdr.src_addr))
+    }
+
+    /// The destination address.
+    #[inline]
+    pub fn dst(&self) -> Ipv4Addr {
+        Ipv4Addr::from(u32::from_be(self.hdr.dst_addr))
+    }
+
+    /// The time to live.
+    #[inline]
+    pub fn ttl(&self) -> u8 {
+        self.hdr.time_to_live
+    }
+
+    /// The protocol of payload, e.g. `IPPROTO_TCP`.
+    #[inline]
+    pub fn proto(&self) -> u8 {
+        self.hdr.next_proto_id
+    }
+
+    /// The length of header with the options.
+    #[inline]
+    pub fn header_len(&self) -> usize {
+        usize::from(self.hdr.version_ihl & 0x0f) * 4
+    }
+
+    /// The length of packet, includes the header.
+    #[inline]
+    pub fn total_len(&self) -> usize {
+        usize::from(u16::from_be(self.hdr.total_length))
+    }
+
+    /// The packet is a fragment, the first one or not.
+    #[inline]
+    pub fn is_fragment(&self) -> bool {
+        (u16::from_be(self.hdr.fragment_offset) & (IPV4_HDR_MF_FLAG | IPV4_HDR_OFFSET_MASK)) != 0
+    }
+
+    /// The offset of the payload in the packet.
+    #[inline]
+    pub fn payload_offset(&self) -> usize {
+        self.off + self.header_len()
+    }
+
+    /// The TCP header, unless the packet is a non-first fragment.
+    #[inline]
+    pub fn tcp(&self) -> Option<TcpView<'a>> {
+        if self.proto() == libc::IPPROTO_TCP as u8 && self.is_first_fragment() {
+            TcpView::parse(self.m, self.payload_offset())
+        } else {
+            None
+        }
+    }
+
+    /// The UDP header, unless the packet is a non-first fragment.
+    #[inline]
+    pub fn udp(&self) -> Option<UdpView<'a>> {
+        if self.proto() == libc::IPPROTO_UDP as u8 && self.is_first_fragment() {
+            UdpView::parse(self.m, self.payload_offset())
+        } else {
+            None
+        }
+    }
+
+    fn is_first_fragment(&self) -> bool {
+        (u16::from_be(self.hdr.fragment_offset) & IPV4_HDR_OFFSET_MASK) == 0
+    }
+}
+
+impl<'a> Deref for Ipv4View<'a> {
+    type Target = Ipv4Hdr;
+
+    fn deref(&self) -> &Self::Target {
+        &self.hdr
+    }
+}
+
+/// An IPv6 header parsed in place from the packet data.
+///
+/// The extension headers are not walked, `tcp` and `udp` only match the next header.
+pub struct Ipv6View<'a> {
+    m: &'a MBuf,
+    off: usize,
+    hdr: HeaderRef<'a, Ipv6Hdr>,
+}
+
+impl<'a> Ipv6View<'a> {
+    /// Parse the IPv6 header at an offset of the packet.
+    #[inline]
+    pub fn parse(m: &'a MBuf, off: usize) -> Option<Self> {
+        let hdr = m.header::<Ipv6Hdr>(off)?;
+
+        if (u32::from_be(hdr.vtc_flow) >> 28) == 6 {
+            Some(Ipv6View { m, off, hdr })
+        } else {
+            None
+        }
+    }
+
+    /// The source address.
+    #[inline]
+    pub fn src(&self) -> Ipv6Addr {
+        Ipv6Addr::from(self.hdr.src_addr)
+    }
+
+    /// The destination address.
+    #[inline]
+    pub fn dst(&self) -> Ipv6Addr {
+        Ipv6Addr::from(self.hdr.dst_addr)
+    }
+
+    /// The next header, e.g. `IPPROTO_TCP`.
+    #[inline]
+    pub fn next_header(&self) -> u8 {
+        self.hdr.proto
+    }
+
+    /// The hop limit.
+    #[inline]
+    pub fn hop_limit(&self) -> u8 {
+        self.hdr.hop_limits
+    }
+
+    /// The length of payload, excludes the header.
+    #[inline]
+    pub fn payload_len(&self) -> usize {
+        usize::from(u16::from_be(self.hdr.payload_len))
+    }
+
+    /// The offset of the payload in the packet.
+    #[inline]
+    pub fn payload_offset(&self) -> usize {
+        self.off + mem::size_of::<Ipv6Hdr>()
+    }
+
+    /// The TCP header, if it is the next header.
+    #[inline]
+    pub fn tcp(&self) -> Option<TcpView<'a>> {
+        if self.next_header() == libc::IPPROTO_TCP as u8 {
+            TcpView::parse(self.m, self.payload_offset())
+        } else {
+            None
+        }
+    }
+
+    /// The UDP header, if it is the next header.
+    #[inline]
+    pub fn udp(&self) -> Option<UdpView<'a>> {
+        if self.next_header() == libc::IPPROTO_UDP as u8 {
+            UdpView::parse(self.m, self.payload_offset())
+        } else {
+            None
+        }
+    }
+}
+
+impl<'a> Deref for Ipv6View<'a> {
+    type Target = Ipv6Hdr;
+
+    fn deref(&self) -> &Self::Target {
+        &self.hdr
+    }
+}
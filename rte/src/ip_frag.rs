@@ -0,0 +1,294 @@
+//!
+//! RTE IP Fragmentation and Reassembly
+//!
+//! The reassembly keeps the fragments in a `FragTable` until all the fragments of a packet arrive,
+//! then chains them to the first fragment, as `MBuf::chain` does.
+//! The table is not thread safe, each lcore should own its table and `DeathRow`.
+//!
+//! The fragments which are dropped or expired are pushed to the `DeathRow`,
+//! and they should be freed in bulk after each burst with `DeathRow::free`.
+//!
+//! The reassembly requires the L2 and L3 header lengths of mbufs, see `MBuf::parse_packet_type`.
+//!
+use std::mem;
+use std::os::unix::io::AsRawFd;
+use std::ptr::NonNull;
+
+use cfile;
+use ffi;
+use libc;
+
+use errors::{AsResult, Result, RteError};
+use ip::{Ipv4Hdr, Ipv6Hdr, IPV4_HDR_MF_FLAG, IPV4_HDR_OFFSET_MASK};
+use mbuf::{Header, MBuf, MBufBatch, RxBurst};
+use memory::SocketId;
+use mempool::MemoryPool;
+use utils::{AsRaw, IntoRaw};
+
+/// The maximum number of fragments per packet.
+pub const IP_MAX_FRAG_NUM: usize = ffi::IP_MAX_FRAG_NUM as usize;
+
+/// The number of packets could be reassembled before the death row must be freed.
+pub const IP_FRAG_DEATH_ROW_LEN: usize = ffi::IP_FRAG_DEATH_ROW_LEN as usize;
+
+/// IPv6 fragment extension header
+pub type Ipv6FragHdr = ffi::ipv6_extension_fragment;
+
+unsafe impl Header for Ipv6FragHdr {}
+
+/// The mbufs to be freed by the reassembly.
+pub struct DeathRow(ffi::rte_ip_frag_death_row);
+
+impl Default for DeathRow {
+    fn default() -> Self {
+        DeathRow::new()
+    }
+}
+
+impl Drop for DeathRow {
+    fn drop(&mut self) {
+        self.free(0)
+    }
+}
+
+impl DeathRow {
+    /// Create an empty death row.
+    pub fn new() -> Self {
+        DeathRow(Default::default())
+    }
+
+    /// The number of mbufs on the death row.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.0.cnt as usize
+    }
+
+    /// The death row is empty.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.0.cnt == 0
+    }
+
+    /// Free the mbufs on the death row, prefetching `prefetch` mbufs ahead of the freed one.
+    #[inline]
+    pub fn free(&mut self, prefetch: usize) {
+        if self.0.cnt > 0 {
+            unsafe { ffi::rte_ip_frag_free_death_row(&mut self.0, prefetch as u32) }
+        }
+    }
+
+    // there is room for the fragments of another packet
+    #[inline]
+    fn has_room(&self) -> bool {
+        self.len() + IP_MAX_FRAG_NUM < self.0.row.len()
+    }
+}
+
+/// A fragmentation table to reassemble the IPv4 and IPv6 packets.
+pub struct FragTable(NonNull<ffi::rte_ip_frag_tbl>);
+
+unsafe impl Send for FragTable {}
+
+impl Drop for FragTable {
+    fn drop(&mut self) {
+        unsafe { ffi::rte_ip_frag_table_destroy(self.0.as_ptr()) }
+    }
+}
+
+impl FragTable {
+    /// Create a table with `bucket_num` buckets of `bucket_entries` entries,
+    /// which keeps at most `max_entries` packets being reassembled.
+    ///
+    /// The packets which are not completed in `max_cycles` TSC cycles are dropped.
+    pub fn create(
+        bucket_num: u32,
+        bucket_entries: u32,
+        max_entries: u32,
+        max_cycles: u64,
+        socket_id: SocketId,
+    ) -> Result<Self> {
+        unsafe { ffi::rte_ip_frag_table_create(bucket_num, bucket_entries, max_entries, max_cycles, socket_id) }
+            .as_result()
+            .map(FragTable)
+    }
+
+    /// Reassemble an IPv4 packet, `tms` is the current timestamp in TSC cycles.
+    ///
+    /// It returns the packet if it is not a fragment or the last missed fragment,
+    /// otherwise the fragment is kept in the table.
+    #[inline]
+    pub fn reassemble_ipv4(&mut self, dr: &mut DeathRow, mut m: MBuf, tms: u64) -> Option<MBuf> {
+        let hdr = match m.header_mut::<Ipv4Hdr>(m.l2_len()) {
+            Some(hdr) if ipv4_is_fragmented(hdr) => hdr as *mut _,
+            _ => return Some(m),
+        };
+
+        let m = unsafe { ffi::rte_ipv4_frag_reassemble_packet(self.0.as_ptr(), &mut dr.0, m.into_raw(), tms, hdr) };
+
+        NonNull::new(m).map(|m| MBuf::from(m.as_ptr()))
+    }
+
+    /// Reassemble an IPv6 packet, `tms` is the current timestamp in TSC cycles.
+    ///
+    /// The fragment header must follow the IPv6 header immediately,
+    /// and the L3 header length must include it.
+    #[inline]
+    pub fn reassemble_ipv6(&mut self, dr: &mut DeathRow, mut m: MBuf, tms: u64) -> Option<MBuf> {
+        let l2_len = m.l2_len();
+        let hdr = match m.header_mut::<Ipv6Hdr>(l2_len) {
+            Some(hdr) if hdr.proto == libc::IPPROTO_FRAGMENT as u8 => hdr as *mut _,
+            _ => return Some(m),
+        };
+        let frag_hdr = match m.header_mut::<Ipv6FragHdr>(l2_len + mem::size_of::<Ipv6Hdr>()) {
+            Some(frag_hdr) => frag_hdr as *mut _,
+            None => return Some(m),
+        };
+
+        let m = unsafe {
+            ffi::rte_ipv6_frag_reassemble_packet(self.0.as_ptr(), &mut dr.0, m.into_raw(), tms, hdr, frag_hdr)
+        };
+
+        NonNull::new(m).map(|m| MBuf::from(m.as_ptr()))
+    }
+
+    /// Reassemble the fragments of a burst in place, with the packet types of mbufs.
+    ///
+    /// The packets which are not fragments and the reassembled packets are kept in order,
+    /// it returns the number of packets left in the batch.
+    /// The death row is freed when it could overflow, and should be freed after the burst.
+    #[inline]
+    pub fn reassemble_burst<const N: usize>(&mut self, dr: &mut DeathRow, pkts: &mut MBufBatch<N>, tms: u64) -> usize {
+        let nb_pkts = pkts.len();
+        let mut len = 0;
+
+        unsafe {
+            // take back the ownership of the packets, and compact the left ones to the head
+            pkts.set_len(0);
+
+            for i in 0..nb_pkts {
+                let m = MBuf::from(pkts.spare()[i]);
+                let ptype = m.packet_type();
+
+                let m = if !ptype.is_fragment() {
+                    Some(m)
+                } else {
+                    if !dr.has_room() {
+                        dr.free(0);
+                    }
+
+                    if ptype.is_ipv4() {
+                        self.reassemble_ipv4(dr, m, tms)
+                    } else if ptype.is_ipv6() {
+                        self.reassemble_ipv6(dr, m, tms)
+                    } else {
+                        Some(m)
+                    }
+                };
+
+                if let Some(m) = m {
+                    pkts.spare()[len] = m.into_raw();
+                    len += 1;
+                }
+            }
+
+            pkts.set_len(len);
+        }
+
+        len
+    }
+
+    /// Drop the packets which are not completed in time, `tms` is the current timestamp in TSC cycles.
+    #[inline]
+    pub fn del_expired(&mut self, dr: &mut DeathRow, tms: u64) {
+        unsafe { ffi::rte_frag_table_del_expired_entries(self.0.as_ptr(), &mut dr.0, tms) }
+    }
+
+    /// Dump the statistics of table to a file.
+    pub fn dump<S: AsRawFd>(&self, s: &S) -> Result<()> {
+        let mut f = cfile::fdopen(s, "w")?;
+
+        unsafe { ffi::rte_ip_frag_table_statistics_dump(&mut **f as *mut _ as *mut _, self.0.as_ptr()) };
+
+        Ok(())
+    }
+}
+
+/// The IPv4 packet is a fragment, the first one or not.
+#[inline]
+pub fn ipv4_is_fragmented(hdr: &Ipv4Hdr) -> bool {
+    (u16::from_be(hdr.fragment_offset) & (IPV4_HDR_MF_FLAG | IPV4_HDR_OFFSET_MASK)) != 0
+}
+
+/// Fragment an IPv4 packet to at most `mtu` bytes, and append the fragments to `out`.
+///
+/// The packet must start with the IPv4 header, which is copied to a direct mbuf from `direct_pool`,
+/// and chained to an indirect mbuf of the payload from `indirect_pool`, see `MBuf::chain`.
+/// The caller still owns the packet, and should prepend the L2 header to the fragments.
+///
+/// It returns the number of fragments appended to `out`.
+#[inline]
+pub fn fragment_ipv4<B: RxBurst + ?Sized>(
+    m: &MBuf,
+    out: &mut B,
+    mtu: u16,
+    direct_pool: &MemoryPool,
+    indirect_pool: &MemoryPool,
+) -> Result<usize> {
+    fragment(ffi::rte_ipv4_fragment_packet, m, out, mtu, direct_pool, indirect_pool)
+}
+
+/// Fragment an IPv6 packet to at most `mtu` bytes, and append the fragments to `out`.
+///
+/// The packet must start with the IPv6 header without extension headers, see `fragment_ipv4`.
+#[inline]
+pub fn fragment_ipv6<B: RxBurst + ?Sized>(
+    m: &MBuf,
+    out: &mut B,
+    mtu: u16,
+    direct_pool: &MemoryPool,
+    indirect_pool: &MemoryPool,
+) -> Result<usize> {
+    fragment(ffi::rte_ipv6_fragment_packet, m, out, mtu, direct_pool, indirect_pool)
+}
+
+type FragmentFn = unsafe extern "C" fn(
+    *mut ffi::rte_mbuf,
+    *mut *mut ffi::rte_mbuf,
+    u16,
+    u16,
+    *mut ffi::rte_mempool,
+    *mut ffi::rte_mempool,
+) -> i32;
+
+#[inline(always)]
+fn fragment<B: RxBurst + ?Sized>(
+    f: FragmentFn,
+    m: &MBuf,
+    out: &mut B,
+    mtu: u16,
+    direct_pool: &MemoryPool,
+    indirect_pool: &MemoryPool,
+) -> Result<usize> {
+    unsafe {
+        let ret = {
+            let spare = out.spare();
+
+            f(
+                m.as_raw(),
+                spare.as_mut_ptr(),
+                spare.len() as u16,
+                mtu,
+                direct_pool.as_raw(),
+                indirect_pool.as_raw(),
+            )
+        };
+
+        if ret < 0 {
+            Err(RteError(ret).into())
+        } else {
+            out.filled(ret as usize);
+
+            Ok(ret as usize)
+        }
+    }
+}
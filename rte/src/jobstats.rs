@@ -0,0 +1,191 @@
+//!
+//! RTE Job Statistics
+//!
+//! A `JobContext` accounts the cycles of a polling loop on an lcore,
+//! the cycles of the jobs finished are the execution time,
+//! and the others, including the jobs aborted, e.g. the polls without any packet,
+//! are the management time.
+//!
+//! The context and the jobs are updated through shared references by the lcore running the loop,
+//! so neither of them is `Sync`.
+//!
+use std::cell::UnsafeCell;
+use std::cmp;
+use std::ffi::CStr;
+
+use ffi;
+
+use errors::Result;
+use utils::AsCString;
+
+/// The maximum length of job name.
+pub const JOBSTATS_NAMESIZE: usize = ffi::RTE_JOBSTATS_NAMESIZE as usize;
+
+/// The load of a polling loop in TSC cycles.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct Load {
+    /// The cycles of the jobs finished.
+    pub busy_cycles: u64,
+    /// The cycles of the jobs aborted and between the jobs.
+    pub idle_cycles: u64,
+    /// The loops with at least one job finished.
+    pub loops: u64,
+    /// The jobs finished.
+    pub jobs: u64,
+}
+
+impl Load {
+    /// The ratio of busy cycles, from 0.0 to 1.0.
+    pub fn busy_ratio(&self) -> f64 {
+        let total = self.busy_cycles + self.idle_cycles;
+
+        if total == 0 {
+            0.0
+        } else {
+            self.busy_cycles as f64 / total as f64
+        }
+    }
+}
+
+/// The statistics context of a polling loop, which must not move once a job is started.
+pub struct JobContext(UnsafeCell<ffi::rte_jobstats_context>);
+
+impl Default for JobContext {
+    fn default() -> Self {
+        JobContext::new()
+    }
+}
+
+impl JobContext {
+    pub fn new() -> Self {
+        let ctx = JobContext(UnsafeCell::new(Default::default()));
+
+        unsafe { ffi::rte_jobstats_context_init(ctx.0.get()) };
+
+        ctx
+    }
+
+    /// Mark the start of a loop turn.
+    #[inline]
+    pub fn start(&self) {
+        unsafe { ffi::rte_jobstats_context_start(self.0.get()) }
+    }
+
+    /// Mark the end of a loop turn.
+    #[inline]
+    pub fn finish(&self) {
+        unsafe { ffi::rte_jobstats_context_finish(self.0.get()) }
+    }
+
+    /// Reset the statistics.
+    pub fn reset(&self) {
+        unsafe { ffi::rte_jobstats_context_reset(self.0.get()) }
+    }
+
+    /// The load since the last reset.
+    pub fn load(&self) -> Load {
+        let ctx = unsafe { &*self.0.get() };
+
+        Load {
+            busy_cycles: ctx.exec_time,
+            idle_cycles: ctx.management_time,
+            loops: ctx.loop_cnt,
+            jobs: ctx.job_exec_cnt,
+        }
+    }
+}
+
+/// A job, whose period is adjusted by how far its value is from the target.
+pub struct Job(UnsafeCell<ffi::rte_jobstats>);
+
+impl Job {
+    /// Create a job with the period between `min_period` and `max_period` TSC cycles.
+    pub fn new<S: AsRef<str>>(
+        name: S,
+        min_period: u64,
+        max_period: u64,
+        initial_period: u64,
+        target: i64,
+    ) -> Result<Self> {
+        let job = Job(UnsafeCell::new(Default::default()));
+        let name = name.as_cstring();
+
+        let ret = unsafe {
+            ffi::rte_jobstats_init(
+                job.0.get(),
+                name.as_ptr(),
+                min_period,
+                max_period,
+                cmp::max(initial_period, min_period),
+                target,
+            )
+        };
+
+        rte_check!(ret; ok => { job })
+    }
+
+    /// The name of job.
+    pub fn name(&self) -> &str {
+        unsafe { CStr::from_ptr((*self.0.get()).name.as_ptr()) }
+            .to_str()
+            .unwrap_or_default()
+    }
+
+    /// Mark the start of job in a context, which is started.
+    ///
+    /// # Safety
+    ///
+    /// The job keeps the address of context until it is finished or aborted,
+    /// so neither the context nor the job may move or be dropped before.
+    #[inline]
+    pub unsafe fn start(&self, ctx: &JobContext) -> bool {
+        ffi::rte_jobstats_start(ctx.0.get(), self.0.get()) == 0
+    }
+
+    /// Abort the job, the cycles since it was started are counted as the idle cycles.
+    #[inline]
+    pub fn abort(&self) -> bool {
+        unsafe { ffi::rte_jobstats_abort(self.0.get()) == 0 }
+    }
+
+    /// Finish the job with its value, e.g. the number of packets processed.
+    ///
+    /// It returns `true` if the period of job is updated.
+    #[inline]
+    pub fn finish(&self, value: i64) -> bool {
+        unsafe { ffi::rte_jobstats_finish(self.0.get(), value) == 1 }
+    }
+
+    /// The period of job in TSC cycles.
+    #[inline]
+    pub fn period(&self) -> u64 {
+        unsafe { (*self.0.get()).period }
+    }
+
+    /// Set the period of job, it is saturated between the minimum and maximum periods if `saturate`.
+    pub fn set_period(&self, period: u64, saturate: bool) {
+        unsafe { ffi::rte_jobstats_set_period(self.0.get(), period, saturate as u8) }
+    }
+
+    /// Set the target value of job.
+    pub fn set_target(&self, target: i64) {
+        unsafe { ffi::rte_jobstats_set_target(self.0.get(), target) }
+    }
+
+    /// The total, minimum and maximum execution cycles of job.
+    pub fn exec_time(&self) -> (u64, u64, u64) {
+        let job = unsafe { &*self.0.get() };
+
+        (job.exec_time, job.min_exec_time, job.max_exec_time)
+    }
+
+    /// The number of executions of job.
+    pub fn exec_count(&self) -> u64 {
+        unsafe { (*self.0.get()).exec_cnt }
+    }
+
+    /// Reset the statistics.
+    pub fn reset(&self) {
+        unsafe { ffi::rte_jobstats_reset(self.0.get()) }
+    }
+}
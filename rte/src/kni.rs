@@ -143,7 +143,11 @@ impl KniDevice {
 
     /// Consume the KniDevice, returning the raw pointer from an underlying object.
     pub fn into_raw(self) -> RawKniDevicePtr {
-        self.0
+        let p = self.0;
+
+        mem::forget(self);
+
+        p
     }
 
     pub fn release(&mut self) -> Result<()> {
@@ -186,8 +190,18 @@ impl KniDevice {
     /// and the maximum number is indicated by num.
     /// It handles the freeing of the mbufs in the free queue of KNI interface.
     ///
-    pub fn rx_burst(&self, mbufs: &mut [mbuf::RawMBufPtr]) -> usize {
-        unsafe { ffi::rte_kni_rx_burst(self.0, mbufs.as_mut_ptr(), mbufs.len() as u32) as usize }
+    pub fn rx_burst<B: mbuf::RxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        unsafe {
+            let nb_rx = {
+                let spare = mbufs.spare();
+
+                ffi::rte_kni_rx_burst(self.0, spare.as_mut_ptr(), spare.len() as u32) as usize
+            };
+
+            mbufs.filled(nb_rx);
+
+            nb_rx
+        }
     }
 
     /// Send a burst of packets to a KNI interface.
@@ -197,8 +211,18 @@ impl KniDevice {
     /// and the maximum number is indicated by num.
     /// It handles allocating the mbufs for KNI interface alloc queue.
     ///
-    pub fn tx_burst(&self, mbufs: &mut [mbuf::RawMBufPtr]) -> usize {
-        unsafe { ffi::rte_kni_rx_burst(self.0, mbufs.as_mut_ptr(), mbufs.len() as u32) as usize }
+    pub fn tx_burst<B: mbuf::TxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        unsafe {
+            let nb_tx = {
+                let pending = mbufs.pending();
+
+                ffi::rte_kni_tx_burst(self.0, pending.as_mut_ptr(), pending.len() as u32) as usize
+            };
+
+            mbufs.sent(nb_tx);
+
+            nb_tx
+        }
     }
 
     /// Register KNI request handling for a specified port,
@@ -1,3 +1,4 @@
+#![cfg_attr(feature = "allocator-api", feature(allocator_api))]
 #![allow(
     deprecated,
     unused,
@@ -41,15 +42,38 @@ pub mod utils;
 pub mod mbuf;
 pub mod mempool;
 pub mod ring;
+pub mod hash;
+pub mod lpm;
+pub mod gro;
+pub mod gso;
+pub mod distributor;
+pub mod timer;
+pub mod rcu;
+pub mod stats;
+pub mod metrics;
+pub mod jobstats;
+pub mod profile;
+pub mod bpf;
+pub mod capture;
+pub mod zerocopy;
+
+pub mod graph;
 
 pub mod bond;
 pub mod ethdev;
+pub mod flow;
+pub mod idle;
 pub mod kni;
+pub mod exception;
+pub mod virtio_user;
 pub mod pci;
 
 pub mod arp;
 pub mod ether;
 pub mod ip;
+pub mod tcp;
+pub mod udp;
+pub mod ip_frag;
 
 #[macro_use]
 pub mod cmdline;
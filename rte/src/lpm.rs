@@ -0,0 +1,209 @@
+//!
+//! RTE Longest Prefix Match
+//!
+//! The IPv4 table is a DIR-24-8 structure, most lookups are resolved with a single access to `tbl24`,
+//! and `lookup_x4` resolves four addresses at once with the vector instructions.
+//!
+//! The IPv4 addresses of lookups are in host byte order, e.g. `u32::from_be(hdr.dst_addr)`.
+//!
+use std::net::{Ipv4Addr, Ipv6Addr};
+use std::ptr::NonNull;
+
+use ffi;
+
+use errors::{AsResult, Result};
+use memory::SocketId;
+use utils::AsCString;
+
+/// The maximum depth of IPv4 rules.
+pub const LPM_MAX_DEPTH: u8 = ffi::RTE_LPM_MAX_DEPTH as u8;
+
+/// The maximum depth of IPv6 rules.
+pub const LPM6_MAX_DEPTH: u8 = ffi::RTE_LPM6_MAX_DEPTH as u8;
+
+/// The next hop is an index, e.g. of the port or the neighbor table, up to 24 bits.
+pub type NextHop = u32;
+
+/// An IPv4 LPM table.
+pub struct Lpm4(NonNull<ffi::rte_lpm>);
+
+unsafe impl Send for Lpm4 {}
+unsafe impl Sync for Lpm4 {}
+
+impl Drop for Lpm4 {
+    fn drop(&mut self) {
+        unsafe { ffi::rte_lpm_free(self.0.as_ptr()) }
+    }
+}
+
+impl Lpm4 {
+    /// Create an LPM table with up to `max_rules` rules, and `number_tbl8s` groups for the rules longer than /24.
+    pub fn create<S: AsRef<str>>(name: S, socket_id: SocketId, max_rules: u32, number_tbl8s: u32) -> Result<Self> {
+        let name = name.as_cstring();
+        let config = ffi::rte_lpm_config {
+            max_rules,
+            number_tbl8s,
+            flags: 0,
+        };
+
+        unsafe { ffi::rte_lpm_create(name.as_ptr(), socket_id, &config) }
+            .as_result()
+            .map(Lpm4)
+    }
+
+    /// Add a rule, or update the next hop of an existing rule.
+    pub fn add(&mut self, ip: Ipv4Addr, depth: u8, next_hop: NextHop) -> Result<()> {
+        rte_check!(unsafe { ffi::rte_lpm_add(self.0.as_ptr(), u32::from(ip), depth, next_hop) })
+    }
+
+    /// The next hop of a rule, if it is present.
+    pub fn is_rule_present(&self, ip: Ipv4Addr, depth: u8) -> Option<NextHop> {
+        let mut next_hop = 0;
+
+        if unsafe { ffi::rte_lpm_is_rule_present(self.0.as_ptr(), u32::from(ip), depth, &mut next_hop) } > 0 {
+            Some(next_hop)
+        } else {
+            None
+        }
+    }
+
+    /// Delete a rule.
+    pub fn delete(&mut self, ip: Ipv4Addr, depth: u8) -> Result<()> {
+        rte_check!(unsafe { ffi::rte_lpm_delete(self.0.as_ptr(), u32::from(ip), depth) })
+    }
+
+    /// Delete all the rules.
+    pub fn delete_all(&mut self) {
+        unsafe { ffi::rte_lpm_delete_all(self.0.as_ptr()) }
+    }
+
+    /// Find the next hop of an address in host byte order.
+    #[inline]
+    pub fn lookup(&self, ip: u32) -> Option<NextHop> {
+        let mut next_hop = 0;
+
+        if unsafe { ffi::_rte_lpm_lookup(self.0.as_ptr(), ip, &mut next_hop) } == 0 {
+            Some(next_hop)
+        } else {
+            None
+        }
+    }
+
+    /// Find the next hops of addresses in host byte order.
+    ///
+    /// It returns the raw results, where a hit is flagged with `RTE_LPM_LOOKUP_SUCCESS`,
+    /// see `lookup_result` to decode them.
+    #[inline]
+    pub fn lookup_bulk(&self, ips: &[u32], next_hops: &mut [u32]) {
+        let n = ips.len().min(next_hops.len());
+
+        unsafe { ffi::_rte_lpm_lookup_bulk(self.0.as_ptr(), ips.as_ptr(), next_hops.as_mut_ptr(), n as u32) };
+    }
+
+    /// Find the next hops of four addresses in host byte order at once,
+    /// the missed addresses get the `default` next hop.
+    #[inline(always)]
+    pub fn lookup_x4(&self, ips: &[u32; 4], default: NextHop) -> [NextHop; 4] {
+        let mut hops = [0; 4];
+
+        unsafe { ffi::dispatch::lpm_lookupx4(self.0.as_ptr(), ips.as_ptr(), hops.as_mut_ptr(), default) };
+
+        hops
+    }
+}
+
+/// Decode a raw result of `Lpm4::lookup_bulk`.
+#[inline(always)]
+pub fn lookup_result(next_hop: u32) -> Option<NextHop> {
+    if (next_hop & ffi::RTE_LPM_LOOKUP_SUCCESS) != 0 {
+        Some(next_hop & (ffi::RTE_LPM_LOOKUP_SUCCESS - 1))
+    } else {
+        None
+    }
+}
+
+/// An IPv6 LPM table.
+pub struct Lpm6(NonNull<ffi::rte_lpm6>);
+
+unsafe impl Send for Lpm6 {}
+unsafe impl Sync for Lpm6 {}
+
+impl Drop for Lpm6 {
+    fn drop(&mut self) {
+        unsafe { ffi::rte_lpm6_free(self.0.as_ptr()) }
+    }
+}
+
+impl Lpm6 {
+    /// Create an LPM table with up to `max_rules` rules, and `number_tbl8s` groups of `tbl8` entries.
+    pub fn create<S: AsRef<str>>(name: S, socket_id: SocketId, max_rules: u32, number_tbl8s: u32) -> Result<Self> {
+        let name = name.as_cstring();
+        let config = ffi::rte_lpm6_config {
+            max_rules,
+            number_tbl8s,
+            flags: 0,
+        };
+
+        unsafe { ffi::rte_lpm6_create(name.as_ptr(), socket_id, &config) }
+            .as_result()
+            .map(Lpm6)
+    }
+
+    /// Add a rule, or update the next hop of an existing rule.
+    pub fn add(&mut self, ip: &Ipv6Addr, depth: u8, next_hop: NextHop) -> Result<()> {
+        let mut ip = ip.octets();
+
+        rte_check!(unsafe { ffi::rte_lpm6_add(self.0.as_ptr(), ip.as_mut_ptr(), depth, next_hop) })
+    }
+
+    /// The next hop of a rule, if it is present.
+    pub fn is_rule_present(&self, ip: &Ipv6Addr, depth: u8) -> Option<NextHop> {
+        let mut ip = ip.octets();
+        let mut next_hop = 0;
+
+        if unsafe { ffi::rte_lpm6_is_rule_present(self.0.as_ptr(), ip.as_mut_ptr(), depth, &mut next_hop) } > 0 {
+            Some(next_hop)
+        } else {
+            None
+        }
+    }
+
+    /// Delete a rule.
+    pub fn delete(&mut self, ip: &Ipv6Addr, depth: u8) -> Result<()> {
+        let mut ip = ip.octets();
+
+        rte_check!(unsafe { ffi::rte_lpm6_delete(self.0.as_ptr(), ip.as_mut_ptr(), depth) })
+    }
+
+    /// Delete all the rules.
+    pub fn delete_all(&mut self) {
+        unsafe { ffi::rte_lpm6_delete_all(self.0.as_ptr()) }
+    }
+
+    /// Find the next hop of an address.
+    #[inline]
+    pub fn lookup(&self, ip: &[u8; 16]) -> Option<NextHop> {
+        let mut next_hop = 0;
+
+        if unsafe { ffi::rte_lpm6_lookup(self.0.as_ptr(), ip.as_ptr() as *mut _, &mut next_hop) } == 0 {
+            Some(next_hop)
+        } else {
+            None
+        }
+    }
+
+    /// Find the next hops of addresses, the missed addresses get -1.
+    #[inline]
+    pub fn lookup_bulk(&self, ips: &[[u8; 16]], next_hops: &mut [i32]) {
+        let n = ips.len().min(next_hops.len());
+
+        unsafe {
+            ffi::rte_lpm6_lookup_bulk_func(
+                self.0.as_ptr(),
+                ips.as_ptr() as *mut _,
+                next_hops.as_mut_ptr(),
+                n as u32,
+            )
+        };
+    }
+}
@@ -50,3 +50,54 @@ macro_rules! offset_of {
         unsafe { offset_of_unsafe!($container, $field) }
     };
 }
+
+/// Profile a scope as a named span on the current lcore, with the number of packets processed.
+///
+/// It returns a `profile::Scope`, which records the cycles per packet when it is dropped,
+/// or a `profile::Disabled` unless the `profile` feature is enabled.
+#[cfg(feature = "profile")]
+#[macro_export]
+macro_rules! profile {
+    ($name:expr) => {{
+        static SPAN: $crate::profile::Span = $crate::profile::Span::new($name);
+
+        SPAN.enter()
+    }};
+    ($name:expr, $packets:expr) => {{
+        static SPAN: $crate::profile::Span = $crate::profile::Span::new($name);
+
+        SPAN.enter().packets($packets as u64)
+    }};
+}
+
+#[cfg(not(feature = "profile"))]
+#[macro_export]
+macro_rules! profile {
+    ($name:expr) => {
+        $crate::profile::Disabled
+    };
+    ($name:expr, $packets:expr) => {{
+        let _ = &$packets;
+
+        $crate::profile::Disabled
+    }};
+}
+
+/// Start a turn of the polling loop on the current lcore, which is finished by `done(packets)`.
+///
+/// The turns without any packet are accounted as the idle cycles of the lcore.
+#[cfg(feature = "profile")]
+#[macro_export]
+macro_rules! profile_loop {
+    () => {
+        $crate::profile::LoopTurn::begin()
+    };
+}
+
+#[cfg(not(feature = "profile"))]
+#[macro_export]
+macro_rules! profile_loop {
+    () => {
+        $crate::profile::Disabled
+    };
+}
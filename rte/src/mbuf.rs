@@ -22,7 +22,10 @@
 //! http://www.kohala.com/start/tcpipiv2.html
 //!
 use std::ffi::CStr;
-use std::os::raw::c_void;
+use std::fmt;
+use std::mem::{self, MaybeUninit};
+use std::ops::Deref;
+use std::os::raw::{c_char, c_void};
 use std::os::unix::io::AsRawFd;
 use std::ptr::{self, NonNull};
 use std::slice;
@@ -31,6 +34,7 @@ use cfile;
 
 use ffi;
 
+use eal;
 use errors::{AsResult, Result};
 use mempool;
 use utils::{AsCString, AsRaw, CallbackContext, IntoRaw};
@@ -294,6 +298,179 @@ bitflags! {
     }
 }
 
+/// The packet type, the L2/L3/L4 and tunnel information parsed by the NIC or the software.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq, Hash)]
+pub struct PacketType(pub u32);
+
+impl fmt::Display for PacketType {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        let mut buf = [0 as c_char; 256];
+
+        if unsafe { ffi::rte_get_ptype_name(self.0, buf.as_mut_ptr(), buf.len()) } < 0 {
+            write!(f, "{:#x}", self.0)
+        } else {
+            write!(f, "{}", unsafe { CStr::from_ptr(buf.as_ptr()) }.to_string_lossy())
+        }
+    }
+}
+
+impl PacketType {
+    /// The packet type is unknown.
+    pub const UNKNOWN: PacketType = PacketType(ffi::RTE_PTYPE_UNKNOWN);
+
+    /// The L2 type, e.g. `RTE_PTYPE_L2_ETHER_VLAN`.
+    #[inline]
+    pub fn l2(self) -> u32 {
+        self.0 & ffi::RTE_PTYPE_L2_MASK
+    }
+
+    /// The L3 type, e.g. `RTE_PTYPE_L3_IPV4_EXT`.
+    #[inline]
+    pub fn l3(self) -> u32 {
+        self.0 & ffi::RTE_PTYPE_L3_MASK
+    }
+
+    /// The L4 type, e.g. `RTE_PTYPE_L4_TCP`.
+    #[inline]
+    pub fn l4(self) -> u32 {
+        self.0 & ffi::RTE_PTYPE_L4_MASK
+    }
+
+    /// The tunnel type, e.g. `RTE_PTYPE_TUNNEL_VXLAN`.
+    #[inline]
+    pub fn tunnel(self) -> u32 {
+        self.0 & ffi::RTE_PTYPE_TUNNEL_MASK
+    }
+
+    /// The L3 type of the inner packet of a tunnel.
+    #[inline]
+    pub fn inner_l3(self) -> u32 {
+        self.0 & ffi::RTE_PTYPE_INNER_L3_MASK
+    }
+
+    /// The L4 type of the inner packet of a tunnel.
+    #[inline]
+    pub fn inner_l4(self) -> u32 {
+        self.0 & ffi::RTE_PTYPE_INNER_L4_MASK
+    }
+
+    /// An IPv4 packet, with or without options.
+    #[inline]
+    pub fn is_ipv4(self) -> bool {
+        (self.0 & ffi::RTE_PTYPE_L3_IPV4) != 0
+    }
+
+    /// An IPv6 packet, with or without extension headers.
+    #[inline]
+    pub fn is_ipv6(self) -> bool {
+        (self.0 & ffi::RTE_PTYPE_L3_IPV6) != 0
+    }
+
+    #[inline]
+    pub fn is_tcp(self) -> bool {
+        self.l4() == ffi::RTE_PTYPE_L4_TCP
+    }
+
+    #[inline]
+    pub fn is_udp(self) -> bool {
+        self.l4() == ffi::RTE_PTYPE_L4_UDP
+    }
+
+    #[inline]
+    pub fn is_fragment(self) -> bool {
+        self.l4() == ffi::RTE_PTYPE_L4_FRAG
+    }
+
+    #[inline]
+    pub fn is_tunnel(self) -> bool {
+        self.tunnel() != 0
+    }
+
+    /// The length of L2 header, if it is known from the L2 type.
+    #[inline]
+    pub fn l2_len(self) -> Option<usize> {
+        match self.l2() {
+            ffi::RTE_PTYPE_L2_ETHER => Some(ETHER_HDR_LEN),
+            ffi::RTE_PTYPE_L2_ETHER_VLAN => Some(ETHER_HDR_LEN + VLAN_HDR_LEN),
+            ffi::RTE_PTYPE_L2_ETHER_QINQ => Some(ETHER_HDR_LEN + 2 * VLAN_HDR_LEN),
+            _ => None,
+        }
+    }
+}
+
+// The length of Ethernet and VLAN headers.
+const ETHER_HDR_LEN: usize = 14;
+const VLAN_HDR_LEN: usize = 4;
+
+/// A protocol header parsed in place from the packet data.
+///
+/// The type must be `#[repr(C, packed)]` plain data, e.g. the `ffi` protocol headers,
+/// so it can be borrowed at any offset of the packet data.
+pub unsafe trait Header: Copy {}
+
+/// A header borrowed from the packet data, or copied if it straddles the segments.
+#[derive(Debug)]
+pub enum HeaderRef<'a, T: 'a> {
+    Borrowed(&'a T),
+    Copied(T),
+}
+
+impl<'a, T> Deref for HeaderRef<'a, T> {
+    type Target = T;
+
+    #[inline(always)]
+    fn deref(&self) -> &T {
+        match *self {
+            HeaderRef::Borrowed(hdr) => hdr,
+            HeaderRef::Copied(ref hdr) => hdr,
+        }
+    }
+}
+
+/// The verdict of a checksum verified by the NIC on RX.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum CksumStatus {
+    /// No information about the checksum.
+    Unknown,
+    /// The checksum is wrong.
+    Bad,
+    /// The checksum is valid.
+    Good,
+    /// The checksum is not correct in the packet data, but the integrity is verified.
+    None,
+}
+
+impl CksumStatus {
+    fn from_flags(flags: u64, bad: u64, good: u64, mask: u64) -> Self {
+        match flags & mask {
+            f if f == mask => CksumStatus::None,
+            f if f == bad => CksumStatus::Bad,
+            f if f == good => CksumStatus::Good,
+            _ => CksumStatus::Unknown,
+        }
+    }
+}
+
+/// The L4 checksum computed by the NIC on TX.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum L4Cksum {
+    None,
+    Tcp,
+    Udp,
+    Sctp,
+}
+
+impl L4Cksum {
+    fn flags(self) -> OffloadFlags {
+        match self {
+            L4Cksum::None => OffloadFlags::PKT_TX_L4_NO_CKSUM,
+            L4Cksum::Tcp => OffloadFlags::PKT_TX_TCP_CKSUM,
+            L4Cksum::Udp => OffloadFlags::PKT_TX_UDP_CKSUM,
+            L4Cksum::Sctp => OffloadFlags::PKT_TX_SCTP_CKSUM,
+        }
+    }
+}
+
 pub type RawMBuf = ffi::rte_mbuf;
 pub type RawMBufPtr = *mut ffi::rte_mbuf;
 
@@ -311,9 +488,7 @@ impl Clone for MBuf {
 
 impl Drop for MBuf {
     fn drop(&mut self) {
-        if self.refcnt_update(-1) == 0 {
-            self.free()
-        }
+        self.free()
     }
 }
 
@@ -354,6 +529,208 @@ impl MBuf {
         OffloadFlags::from_bits_truncate(self.ol_flags)
     }
 
+    /// Set the offload features.
+    #[inline]
+    pub fn set_offload(&mut self, flags: OffloadFlags) {
+        self.ol_flags = flags.bits
+    }
+
+    /// The packet type parsed on RX.
+    #[inline]
+    pub fn packet_type(&self) -> PacketType {
+        PacketType(unsafe { self.__bindgen_anon_3.packet_type })
+    }
+
+    #[inline]
+    pub fn set_packet_type(&mut self, ptype: PacketType) {
+        self.__bindgen_anon_3.packet_type = ptype.0
+    }
+
+    /// Parse the L2, L3 and L4 headers in software, when the NIC doesn't recognize the packet type,
+    /// and set both the packet type and the header lengths, e.g. for GRO or GSO.
+    #[inline]
+    pub fn parse_packet_type(&mut self) -> PacketType {
+        let mut hdr_lens = ffi::rte_net_hdr_lens::default();
+        let ptype = unsafe {
+            ffi::rte_net_get_ptype(
+                self.as_raw(),
+                &mut hdr_lens,
+                ffi::RTE_PTYPE_L2_MASK | ffi::RTE_PTYPE_L3_MASK | ffi::RTE_PTYPE_L4_MASK,
+            )
+        };
+
+        self.set_packet_type(PacketType(ptype));
+        self.set_header_lens(
+            usize::from(hdr_lens.l2_len),
+            usize::from(hdr_lens.l3_len),
+            usize::from(hdr_lens.l4_len),
+        );
+
+        PacketType(ptype)
+    }
+
+    /// The RSS hash of NIC, valid if `PKT_RX_RSS_HASH` is set.
+    #[inline]
+    pub fn rss_hash(&self) -> u32 {
+        unsafe { self.__bindgen_anon_4.hash.rss }
+    }
+
+    /// The user defined tag, e.g. the flow tag of the distributor.
+    #[inline]
+    pub fn tag(&self) -> u32 {
+        unsafe { self.__bindgen_anon_4.hash.usr }
+    }
+
+    #[inline]
+    pub fn set_tag(&mut self, tag: u32) {
+        self.__bindgen_anon_4.hash.usr = tag
+    }
+
+    /// The mark of the flow rule matched by the NIC, see `flow::Action::Mark`.
+    #[inline]
+    pub fn flow_mark(&self) -> Option<u32> {
+        if (self.ol_flags & ffi::PKT_RX_FDIR_ID as u64) != 0 {
+            Some(unsafe { self.__bindgen_anon_4.hash.fdir.hi })
+        } else {
+            None
+        }
+    }
+
+    /// The IP header checksum verdict of the NIC.
+    #[inline]
+    pub fn rx_ip_cksum(&self) -> CksumStatus {
+        CksumStatus::from_flags(
+            self.ol_flags,
+            ffi::PKT_RX_IP_CKSUM_BAD as u64,
+            ffi::PKT_RX_IP_CKSUM_GOOD as u64,
+            ffi::PKT_RX_IP_CKSUM_MASK as u64,
+        )
+    }
+
+    /// The L4 checksum verdict of the NIC.
+    #[inline]
+    pub fn rx_l4_cksum(&self) -> CksumStatus {
+        CksumStatus::from_flags(
+            self.ol_flags,
+            ffi::PKT_RX_L4_CKSUM_BAD as u64,
+            ffi::PKT_RX_L4_CKSUM_GOOD as u64,
+            ffi::PKT_RX_L4_CKSUM_MASK as u64,
+        )
+    }
+
+    /// The L2 header length for TX offload.
+    #[inline]
+    pub fn l2_len(&self) -> usize {
+        unsafe { self.__bindgen_anon_6.__bindgen_anon_1.l2_len() as usize }
+    }
+
+    #[inline]
+    pub fn set_l2_len(&mut self, len: usize) {
+        unsafe { self.__bindgen_anon_6.__bindgen_anon_1.set_l2_len(len as u64) }
+    }
+
+    /// The L3 header length for TX offload.
+    #[inline]
+    pub fn l3_len(&self) -> usize {
+        unsafe { self.__bindgen_anon_6.__bindgen_anon_1.l3_len() as usize }
+    }
+
+    #[inline]
+    pub fn set_l3_len(&mut self, len: usize) {
+        unsafe { self.__bindgen_anon_6.__bindgen_anon_1.set_l3_len(len as u64) }
+    }
+
+    /// The L4 header length for TX offload.
+    #[inline]
+    pub fn l4_len(&self) -> usize {
+        unsafe { self.__bindgen_anon_6.__bindgen_anon_1.l4_len() as usize }
+    }
+
+    #[inline]
+    pub fn set_l4_len(&mut self, len: usize) {
+        unsafe { self.__bindgen_anon_6.__bindgen_anon_1.set_l4_len(len as u64) }
+    }
+
+    /// The TCP TSO segment size.
+    #[inline]
+    pub fn tso_segsz(&self) -> usize {
+        unsafe { self.__bindgen_anon_6.__bindgen_anon_1.tso_segsz() as usize }
+    }
+
+    #[inline]
+    pub fn set_tso_segsz(&mut self, size: usize) {
+        unsafe { self.__bindgen_anon_6.__bindgen_anon_1.set_tso_segsz(size as u64) }
+    }
+
+    /// Set the L2, L3 and L4 header lengths for TX offload with a single store,
+    /// the outer header lengths and TSO segment size are cleared.
+    #[inline]
+    pub fn set_header_lens(&mut self, l2_len: usize, l3_len: usize, l4_len: usize) {
+        // l2_len:7, l3_len:9, l4_len:8, tso_segsz:16, outer_l3_len:9, outer_l2_len:7
+        self.__bindgen_anon_6.tx_offload =
+            (l2_len as u64 & 0x7f) | (l3_len as u64 & 0x1ff) << 7 | (l4_len as u64 & 0xff) << 16;
+    }
+
+    /// Request the NIC to compute the IPv4 header checksum, if `ipv4`, and the L4 checksum on TX.
+    ///
+    /// The L4 checksum field must hold the pseudo-header checksum as expected by the NIC,
+    /// which is done by `EthDevice::tx_prepare` before `tx_burst`.
+    #[inline]
+    pub fn set_tx_cksum(&mut self, l2_len: usize, l3_len: usize, ipv4: bool, l4: L4Cksum) {
+        let flags = if ipv4 {
+            OffloadFlags::PKT_TX_IPV4 | OffloadFlags::PKT_TX_IP_CKSUM
+        } else {
+            OffloadFlags::PKT_TX_IPV6
+        };
+
+        self.set_l2_len(l2_len);
+        self.set_l3_len(l3_len);
+        // replace the L3 type and the checksum requests of a previous call, e.g. on a reused mbuf
+        let cleared = OffloadFlags::PKT_TX_L4_MASK
+            | OffloadFlags::PKT_TX_IP_CKSUM
+            | OffloadFlags::PKT_TX_IPV4
+            | OffloadFlags::PKT_TX_IPV6;
+
+        self.ol_flags = (self.ol_flags & !cleared.bits) | (flags | l4.flags()).bits;
+    }
+
+    /// Request the TX checksum offload of a forwarded TCP or UDP packet,
+    /// with the header lengths from the packet type parsed on RX instead of the packet data.
+    ///
+    /// Only the IHL of IPv4 header with options is read from the packet, it returns `false`
+    /// if the packet type is not known enough, e.g. IPv6 with extension headers or a tunnel.
+    pub fn set_tx_cksum_from_ptype(&mut self) -> bool {
+        let ptype = self.packet_type();
+
+        let l4 = if ptype.is_tcp() {
+            L4Cksum::Tcp
+        } else if ptype.is_udp() {
+            L4Cksum::Udp
+        } else {
+            return false;
+        };
+
+        let l2_len = match ptype.l2_len() {
+            Some(len) if !ptype.is_tunnel() && len < self.data_len() => len,
+            _ => return false,
+        };
+
+        let (l3_len, ipv4) = match ptype.l3() {
+            ffi::RTE_PTYPE_L3_IPV4 => (20, true),
+            ffi::RTE_PTYPE_L3_IPV6 => (40, false),
+            _ if ptype.is_ipv4() => {
+                let version_ihl = unsafe { *self.mtod_offset::<u8>(l2_len).as_ptr() };
+
+                (usize::from(version_ihl & 0x0f) * 4, true)
+            }
+            _ => return false,
+        };
+
+        self.set_tx_cksum(l2_len, l3_len, ipv4, l4);
+
+        true
+    }
+
     /// The mbuf is cloned by mbuf indirection.
     #[inline]
     pub fn has_cloned(&self) -> bool {
@@ -498,6 +875,46 @@ impl MBuf {
         self.iova_offset(0)
     }
 
+    /// Borrow a header at an offset of the packet data.
+    ///
+    /// The header is only copied with `rte_pktmbuf_read` if it straddles the segments,
+    /// it returns `None` if the packet is too short.
+    #[inline]
+    pub fn header<T: Header>(&self, off: usize) -> Option<HeaderRef<'_, T>> {
+        let len = mem::size_of::<T>();
+        let end = off.checked_add(len)?;
+
+        if end <= self.data_len() {
+            Some(HeaderRef::Borrowed(unsafe { self.mtod_offset::<T>(off).as_ref() }))
+        } else if end <= self.pkt_len() {
+            let mut hdr = MaybeUninit::<T>::uninit();
+
+            let p =
+                unsafe { ffi::_rte_pktmbuf_read(self.as_raw(), off as u32, len as u32, hdr.as_mut_ptr() as *mut _) };
+
+            if p.is_null() {
+                None
+            } else if p as *const T == hdr.as_ptr() {
+                Some(HeaderRef::Copied(unsafe { hdr.assume_init() }))
+            } else {
+                Some(HeaderRef::Borrowed(unsafe { &*(p as *const T) }))
+            }
+        } else {
+            None
+        }
+    }
+
+    /// Borrow a mutable header at an offset of the packet data,
+    /// it returns `None` if the header is not in the first segment.
+    #[inline]
+    pub fn header_mut<T: Header>(&mut self, off: usize) -> Option<&mut T> {
+        if off.checked_add(mem::size_of::<T>())? <= self.data_len() {
+            Some(unsafe { self.mtod_offset::<T>(off).as_mut() })
+        } else {
+            None
+        }
+    }
+
     /// Returns the length of the packet.
     #[inline]
     pub fn pkt_len(&self) -> usize {
@@ -752,6 +1169,21 @@ pub fn pool_create<S: AsRef<str>>(
         .map(mempool::MemoryPool::from)
 }
 
+/// Search a mbuf pool created by the primary process, or create it if not found in the primary process.
+pub fn pool_lookup_or_create<S: AsRef<str>>(
+    name: S,
+    n: u32,
+    cache_size: u32,
+    priv_size: u16,
+    data_room_size: u16,
+    socket_id: i32,
+) -> Result<mempool::MemoryPool> {
+    eal::lookup_or_create(
+        || mempool::MemoryPool::lookup(&name),
+        || pool_create(&name, n, cache_size, priv_size, data_room_size, socket_id),
+    )
+}
+
 /// Create a mbuf pool with a given mempool ops name
 ///
 /// This function creates and initializes a packet mbuf pool.
@@ -783,3 +1215,370 @@ pub fn pool_create_by_ops<S: AsRef<str>>(
     .map(|p| p.as_ptr())
     .map(mempool::MemoryPool::from)
 }
+
+/// The maximum number of segments returned to a mempool at once by `free_bulk()`.
+const FREE_BULK_PENDING_SZ: usize = 64;
+
+/// Put the freed segments back to their mempool in bulk.
+struct BulkFree {
+    pending: [*mut c_void; FREE_BULK_PENDING_SZ],
+    nb_pending: usize,
+}
+
+impl Drop for BulkFree {
+    fn drop(&mut self) {
+        unsafe { self.flush() }
+    }
+}
+
+impl BulkFree {
+    #[inline]
+    fn new() -> Self {
+        BulkFree {
+            pending: [ptr::null_mut(); FREE_BULK_PENDING_SZ],
+            nb_pending: 0,
+        }
+    }
+
+    /// Free a packet mbuf and all its segments.
+    ///
+    /// Consecutive segments of the same mempool are batched together,
+    /// the pending segments are flushed when the mempool changes or the batch is full.
+    #[inline]
+    unsafe fn free(&mut self, mut m: RawMBufPtr) {
+        while !m.is_null() {
+            let next = (*m).next;
+            let seg = ffi::_rte_pktmbuf_prefree_seg(m);
+
+            if !seg.is_null() {
+                if self.nb_pending == FREE_BULK_PENDING_SZ
+                    || (self.nb_pending > 0 && (*seg).pool != (*(self.pending[0] as RawMBufPtr)).pool)
+                {
+                    self.flush();
+                }
+
+                self.pending[self.nb_pending] = seg as *mut c_void;
+                self.nb_pending += 1;
+            }
+
+            m = next;
+        }
+    }
+
+    #[inline]
+    unsafe fn flush(&mut self) {
+        if self.nb_pending > 0 {
+            let pool = (*(self.pending[0] as RawMBufPtr)).pool;
+
+            ffi::_rte_mempool_put_bulk(pool, self.pending.as_ptr(), self.nb_pending as u32);
+
+            self.nb_pending = 0;
+        }
+    }
+}
+
+/// Free a bulk of packet mbufs back into their original mempools.
+///
+/// Free the mbufs, and all their segments in case of chained buffers.
+/// Each segment is added back into its original mempool,
+/// with one `rte_mempool_put_bulk()` per run of segments from the same mempool.
+pub fn free_bulk<I: IntoIterator<Item = MBuf>>(mbufs: I) {
+    let mut bulk = BulkFree::new();
+
+    for m in mbufs {
+        unsafe { bulk.free(m.into_raw()) }
+    }
+}
+
+/// Free a bulk of raw packet mbufs back into their original mempools.
+///
+/// The NULL pointers in the array will be ignored.
+pub unsafe fn raw_free_bulk(mbufs: &[RawMBufPtr]) {
+    let mut bulk = BulkFree::new();
+
+    for &m in mbufs {
+        bulk.free(m)
+    }
+}
+
+/// A buffer which could be filled by a receive burst.
+pub trait RxBurst {
+    /// The free slots at the tail of buffer.
+    fn spare(&mut self) -> &mut [RawMBufPtr];
+
+    /// Take the ownership of the first `nb_rx` received mbufs in the free slots.
+    unsafe fn filled(&mut self, nb_rx: usize);
+}
+
+/// A buffer of packets which could be sent by a transmit burst.
+pub trait TxBurst {
+    /// The pending packets to transmit.
+    fn pending(&mut self) -> &mut [RawMBufPtr];
+
+    /// Release the ownership of the first `nb_tx` mbufs, which have been sent.
+    unsafe fn sent(&mut self, nb_tx: usize);
+}
+
+impl RxBurst for [RawMBufPtr] {
+    fn spare(&mut self) -> &mut [RawMBufPtr] {
+        self
+    }
+
+    unsafe fn filled(&mut self, _nb_rx: usize) {}
+}
+
+impl TxBurst for [RawMBufPtr] {
+    fn pending(&mut self) -> &mut [RawMBufPtr] {
+        self
+    }
+
+    unsafe fn sent(&mut self, _nb_tx: usize) {}
+}
+
+impl RxBurst for [Option<MBuf>] {
+    fn spare(&mut self) -> &mut [RawMBufPtr] {
+        unsafe { slice::from_raw_parts_mut(self.as_mut_ptr() as *mut _, self.len()) }
+    }
+
+    unsafe fn filled(&mut self, _nb_rx: usize) {}
+}
+
+impl<const N: usize> RxBurst for [Option<MBuf>; N] {
+    fn spare(&mut self) -> &mut [RawMBufPtr] {
+        self[..].spare()
+    }
+
+    unsafe fn filled(&mut self, _nb_rx: usize) {}
+}
+
+// the sent raw mbufs are owned by the NIC, and the unsent ones are left to the caller.
+// There is no impl for the slices of `MBuf`, which would still drop the sent ones, use `MBufBatch` instead.
+impl<const N: usize> TxBurst for [RawMBufPtr; N] {
+    fn pending(&mut self) -> &mut [RawMBufPtr] {
+        self
+    }
+
+    unsafe fn sent(&mut self, _nb_tx: usize) {}
+}
+
+/// A fixed-capacity, stack allocated batch of packet mbufs.
+///
+/// The batch owns its mbufs, the received packets are appended to the tail,
+/// the sent packets are removed from the head, and the remaining packets
+/// will be freed in bulk when the batch is dropped.
+pub struct MBufBatch<const N: usize> {
+    len: usize,
+    mbufs: [RawMBufPtr; N],
+}
+
+impl<const N: usize> Default for MBufBatch<N> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<const N: usize> Drop for MBufBatch<N> {
+    fn drop(&mut self) {
+        self.clear()
+    }
+}
+
+impl<const N: usize> ::std::ops::Deref for MBufBatch<N> {
+    type Target = [MBuf];
+
+    fn deref(&self) -> &Self::Target {
+        unsafe { slice::from_raw_parts(self.mbufs.as_ptr() as *const MBuf, self.len) }
+    }
+}
+
+impl<const N: usize> ::std::ops::DerefMut for MBufBatch<N> {
+    fn deref_mut(&mut self) -> &mut Self::Target {
+        unsafe { slice::from_raw_parts_mut(self.mbufs.as_mut_ptr() as *mut MBuf, self.len) }
+    }
+}
+
+impl<const N: usize> MBufBatch<N> {
+    /// The maximum number of mbufs in the batch.
+    pub const CAPACITY: usize = N;
+
+    /// Create an empty batch.
+    #[inline]
+    pub fn new() -> Self {
+        MBufBatch {
+            len: 0,
+            mbufs: [ptr::null_mut(); N],
+        }
+    }
+
+    /// The maximum number of mbufs in the batch.
+    #[inline]
+    pub fn capacity(&self) -> usize {
+        N
+    }
+
+    /// The batch is full.
+    #[inline]
+    pub fn is_full(&self) -> bool {
+        self.len == N
+    }
+
+    /// Append a mbuf to the tail of batch, or return it back if the batch is full.
+    #[inline]
+    pub fn push(&mut self, m: MBuf) -> ::std::result::Result<(), MBuf> {
+        if self.is_full() {
+            Err(m)
+        } else {
+            self.mbufs[self.len] = m.into_raw();
+            self.len += 1;
+
+            Ok(())
+        }
+    }
+
+    /// Remove the last mbuf from the batch.
+    #[inline]
+    pub fn pop(&mut self) -> Option<MBuf> {
+        if self.len == 0 {
+            None
+        } else {
+            self.len -= 1;
+
+            Some(MBuf::from(self.mbufs[self.len]))
+        }
+    }
+
+    /// Shorten the batch, free the mbufs after `len` in bulk.
+    #[inline]
+    pub fn truncate(&mut self, len: usize) {
+        if len < self.len {
+            unsafe { raw_free_bulk(&self.mbufs[len..self.len]) }
+
+            self.len = len;
+        }
+    }
+
+    /// Free all the mbufs in bulk.
+    #[inline]
+    pub fn clear(&mut self) {
+        self.truncate(0)
+    }
+
+    /// Remove all the mbufs from the batch, and take their ownership.
+    ///
+    /// The batch is emptied up front, so the mbufs are leaked rather than freed twice if the `Drain` is leaked.
+    #[inline]
+    pub fn drain(&mut self) -> Drain<'_, N> {
+        let len = self.len;
+
+        self.len = 0;
+
+        Drain {
+            batch: self,
+            pos: 0,
+            len,
+        }
+    }
+
+    /// Retain only the mbufs specified by the predicate, free the others in bulk.
+    pub fn retain<F: FnMut(&MBuf) -> bool>(&mut self, mut f: F) {
+        let mut bulk = BulkFree::new();
+        let mut len = 0;
+
+        for i in 0..self.len {
+            let p = self.mbufs[i];
+
+            if f(unsafe { &*(&self.mbufs[i] as *const RawMBufPtr as *const MBuf) }) {
+                self.mbufs[len] = p;
+                len += 1;
+            } else {
+                unsafe { bulk.free(p) }
+            }
+        }
+
+        self.len = len;
+    }
+
+    /// The raw pointers of mbufs in the batch.
+    #[inline]
+    pub fn as_raw_slice(&self) -> &[RawMBufPtr] {
+        &self.mbufs[..self.len]
+    }
+
+    /// Force the length of batch, and take the ownership of mbufs before `len`.
+    #[inline]
+    pub unsafe fn set_len(&mut self, len: usize) {
+        debug_assert!(len <= N);
+
+        self.len = len;
+    }
+}
+
+impl<const N: usize> RxBurst for MBufBatch<N> {
+    #[inline]
+    fn spare(&mut self) -> &mut [RawMBufPtr] {
+        &mut self.mbufs[self.len..]
+    }
+
+    #[inline]
+    unsafe fn filled(&mut self, nb_rx: usize) {
+        self.set_len(self.len + nb_rx)
+    }
+}
+
+impl<const N: usize> TxBurst for MBufBatch<N> {
+    #[inline]
+    fn pending(&mut self) -> &mut [RawMBufPtr] {
+        &mut self.mbufs[..self.len]
+    }
+
+    #[inline]
+    unsafe fn sent(&mut self, nb_tx: usize) {
+        debug_assert!(nb_tx <= self.len);
+
+        if nb_tx > 0 {
+            self.mbufs.copy_within(nb_tx..self.len, 0);
+            self.len -= nb_tx;
+        }
+    }
+}
+
+/// A draining iterator for `MBufBatch`.
+///
+/// The mbufs which are not yielded will be freed in bulk when it is dropped.
+pub struct Drain<'a, const N: usize> {
+    batch: &'a mut MBufBatch<N>,
+    pos: usize,
+    len: usize,
+}
+
+impl<'a, const N: usize> Iterator for Drain<'a, N> {
+    type Item = MBuf;
+
+    #[inline]
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.pos < self.len {
+            let m = self.batch.mbufs[self.pos];
+
+            self.pos += 1;
+
+            Some(MBuf::from(m))
+        } else {
+            None
+        }
+    }
+
+    #[inline]
+    fn size_hint(&self) -> (usize, Option<usize>) {
+        let n = self.len - self.pos;
+
+        (n, Some(n))
+    }
+}
+
+impl<'a, const N: usize> ExactSizeIterator for Drain<'a, N> {}
+
+impl<'a, const N: usize> Drop for Drain<'a, N> {
+    fn drop(&mut self) {
+        unsafe { raw_free_bulk(&self.batch.mbufs[self.pos..self.len]) }
+    }
+}
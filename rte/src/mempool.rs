@@ -24,7 +24,8 @@
 //! created with rte_mempool_cache_create().
 //!
 use std::ffi::CStr;
-use std::mem;
+use std::marker::PhantomData;
+use std::mem::{self, MaybeUninit};
 use std::os::raw::{c_uint, c_void};
 use std::os::unix::io::AsRawFd;
 use std::ptr::{self, NonNull};
@@ -499,3 +500,134 @@ impl MemoryPool {
             .map(|_| ())
     }
 }
+
+/// A mempool bound to the default cache of an lcore.
+///
+/// The cache is looked up once when the handle is created, instead of on every call,
+/// and the fixed size batches are copied from or to it inline, only falling back to
+/// the out-of-line mempool functions when the cache must be refilled or flushed.
+///
+/// Like the per-lcore cache itself, the handle must stay on the lcore it was created on.
+pub struct LocalCache {
+    pool: NonNull<RawMemoryPool>,
+    // null if the mempool has no cache
+    cache: RawCachePtr,
+    // not `Send` or `Sync`
+    phantom: PhantomData<*mut ()>,
+}
+
+impl MemoryPool {
+    /// Bind the mempool to the default cache of current lcore.
+    ///
+    /// Outside of the EAL threads or without a cache, the objects go straight to the common pool.
+    pub fn local_cache(&self) -> LocalCache {
+        LocalCache {
+            pool: self.0,
+            cache: self.default_cache().map_or(ptr::null_mut(), |cache| cache.into_raw()),
+            phantom: PhantomData,
+        }
+    }
+}
+
+impl LocalCache {
+    /// The mempool of the cache.
+    pub fn pool(&self) -> MemoryPool {
+        MemoryPool(self.pool)
+    }
+
+    /// Returns `true` if the objects are cached.
+    pub fn is_cached(&self) -> bool {
+        !self.cache.is_null()
+    }
+
+    /// Flush the cache to the common pool.
+    pub fn flush(&self) {
+        if !self.cache.is_null() {
+            unsafe { ffi::_rte_mempool_cache_flush(self.cache, self.pool.as_ptr()) }
+        }
+    }
+
+    /// Get `N` objects from the mempool.
+    ///
+    /// The objects are taken from the top of the cache, like `rte_mempool_generic_get()`,
+    /// the cache is refilled from the common pool if it holds less than `N` objects.
+    #[inline(always)]
+    pub fn get_array<T: Pooled<R>, R, const N: usize>(&mut self) -> Result<[T; N]> {
+        let mut objs = MaybeUninit::<[*mut c_void; N]>::uninit();
+        let table = objs.as_mut_ptr() as *mut *mut c_void;
+
+        unsafe {
+            match self.cache.as_mut() {
+                Some(cache) if N < cache.size as usize && N <= cache.len as usize => {
+                    let len = cache.len as usize;
+
+                    for i in 0..N {
+                        *table.add(i) = cache.objs[len - 1 - i];
+                    }
+
+                    cache.len -= N as u32;
+                }
+                _ => {
+                    ffi::_rte_mempool_generic_get(self.pool.as_ptr(), table, N as u32, self.cache).as_result()?;
+                }
+            }
+
+            // the pooled objects are transparent wrappers of their pointers
+            Ok(mem::transmute_copy(&objs.assume_init()))
+        }
+    }
+
+    /// Put `N` objects back in the mempool.
+    ///
+    /// The objects are pushed to the top of the cache, like `rte_mempool_generic_put()`,
+    /// the cache is flushed to the common pool if it would reach its flush threshold.
+    #[inline(always)]
+    pub fn put_array<T: Pooled<R>, R, const N: usize>(&mut self, objs: [T; N]) {
+        let objs = mem::ManuallyDrop::new(objs);
+        let table = objs.as_ptr() as *const *mut c_void;
+
+        unsafe {
+            match self.cache.as_mut() {
+                Some(cache)
+                    if N <= ffi::RTE_MEMPOOL_CACHE_MAX_SIZE as usize
+                        && cache.len as usize + N < cache.flushthresh as usize =>
+                {
+                    let len = cache.len as usize;
+
+                    for i in 0..N {
+                        cache.objs[len + i] = *table.add(i);
+                    }
+
+                    cache.len += N as u32;
+                }
+                _ => ffi::_rte_mempool_generic_put(self.pool.as_ptr(), table, N as u32, self.cache),
+            }
+        }
+    }
+
+    /// Get several objects from the mempool, through the cache.
+    pub fn get_bulk<T: Pooled<R>, R>(&mut self, objs: &mut [T]) -> Result<()> {
+        unsafe {
+            ffi::_rte_mempool_generic_get(
+                self.pool.as_ptr(),
+                objs.as_mut_ptr() as *mut _,
+                objs.len() as u32,
+                self.cache,
+            )
+        }
+        .as_result()
+        .map(|_| ())
+    }
+
+    /// Put several objects back in the mempool, through the cache.
+    pub fn put_bulk<T: Pooled<R>, R>(&mut self, objs: &[T]) {
+        unsafe {
+            ffi::_rte_mempool_generic_put(
+                self.pool.as_ptr(),
+                objs.as_ptr() as *const _,
+                objs.len() as u32,
+                self.cache,
+            )
+        }
+    }
+}
@@ -0,0 +1,258 @@
+//!
+//! RTE Metrics
+//!
+//! The metrics library keeps the named values of ports and the global ones,
+//! which are filled by the latency statistics and the bitrate statistics libraries,
+//! and could be read by the secondary processes, e.g. `dpdk-procinfo`.
+//!
+//! The `LatencyTracker` measures the RX to TX latency of a port by itself,
+//! and reports the quantiles, e.g. p50 and p99, which the latency statistics library doesn't.
+//!
+use std::ffi::CStr;
+use std::os::raw::{c_int, c_void};
+use std::ptr::{self, NonNull};
+use std::slice;
+
+use ffi;
+
+use common::{get_tsc_hz, rdtsc};
+use errors::{rte_error, AsResult, Result, RteError};
+use ethdev::{PortId, QueueId};
+use malloc;
+use memory::SocketId;
+use stats::{CacheAligned, Histogram, HistogramSnapshot};
+
+/// The maximum length of metric name.
+pub const METRICS_MAX_NAME_LEN: usize = ffi::RTE_METRICS_MAX_NAME_LEN as usize;
+
+/// A named metric value.
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct Metric {
+    pub name: String,
+    pub value: u64,
+}
+
+/// Initialize the metrics library, it must be called from the primary process before the metrics are used.
+pub fn init(socket_id: SocketId) {
+    unsafe { ffi::rte_metrics_init(socket_id) }
+}
+
+/// The metrics of a port, or the global metrics if `port_id` is `None`.
+pub fn get(port_id: Option<PortId>) -> Result<Vec<Metric>> {
+    let port_id = port_id.map_or(ffi::RTE_METRICS_GLOBAL, c_int::from);
+
+    let names = collect(|names, capacity| unsafe { ffi::rte_metrics_get_names(names, capacity) })?;
+    let values = collect(|values, capacity| unsafe { ffi::rte_metrics_get_values(port_id, values, capacity) })?;
+
+    Ok(to_metrics(&names, &values))
+}
+
+// get the items with the capacity returned by a call without buffer
+fn collect<T: Default + Clone, F: Fn(*mut T, u16) -> c_int>(f: F) -> Result<Vec<T>> {
+    let n = f(ptr::null_mut(), 0);
+
+    if n < 0 {
+        return Err(RteError(n).into());
+    }
+
+    let mut items = vec![T::default(); n as usize];
+    let n = f(items.as_mut_ptr(), items.len() as u16);
+
+    if n < 0 {
+        Err(RteError(n).into())
+    } else {
+        items.truncate(n as usize);
+
+        Ok(items)
+    }
+}
+
+fn to_metrics(names: &[ffi::rte_metric_name], values: &[ffi::rte_metric_value]) -> Vec<Metric> {
+    values
+        .iter()
+        .filter_map(|v| {
+            names.get(usize::from(v.key)).map(|name| Metric {
+                name: unsafe { CStr::from_ptr(name.name.as_ptr()) }
+                    .to_string_lossy()
+                    .into_owned(),
+                value: v.value,
+            })
+        })
+        .collect()
+}
+
+/// Register the RX and TX callbacks of all the ports and queues to measure the latencies,
+/// a packet is sampled every `samp_intvl` nanoseconds.
+///
+/// The minimum, average and maximum latencies and the jitter are global in nanoseconds,
+/// they are calculated by `latency_update` and reported as the global metrics.
+pub fn latency_init(samp_intvl: u64) -> Result<()> {
+    rte_check!(unsafe { ffi::rte_latencystats_init(samp_intvl, None) })
+}
+
+/// Calculate the latencies and the jitter, and update the global metrics.
+pub fn latency_update() -> Result<()> {
+    rte_check!(unsafe { ffi::rte_latencystats_update() })
+}
+
+/// Remove the RX and TX callbacks of the latency statistics.
+pub fn latency_uninit() -> Result<()> {
+    rte_check!(unsafe { ffi::rte_latencystats_uninit() })
+}
+
+/// The latency statistics in nanoseconds.
+pub fn latency_stats() -> Result<Vec<Metric>> {
+    let names = collect(|names, size| unsafe { ffi::rte_latencystats_get_names(names, size) })?;
+    let values = collect(|values, size| unsafe { ffi::rte_latencystats_get(values, size) })?;
+
+    Ok(to_metrics(&names, &values))
+}
+
+/// The bitrate statistics, which calculates the mean, EWMA and peak bitrates of ports.
+///
+/// The bitrates are reported as the metrics of ports.
+pub struct BitrateStats(NonNull<ffi::rte_stats_bitrates>);
+
+unsafe impl Send for BitrateStats {}
+
+impl Drop for BitrateStats {
+    fn drop(&mut self) {
+        malloc::free(self.0.as_ptr() as *mut c_void)
+    }
+}
+
+impl BitrateStats {
+    /// Create the bitrate statistics, and register its metrics.
+    pub fn create() -> Result<Self> {
+        let stats = unsafe { ffi::rte_stats_bitrate_create() }
+            .as_result()
+            .map(BitrateStats)?;
+
+        rte_check!(unsafe { ffi::rte_stats_bitrate_reg(stats.0.as_ptr()) }; ok => { stats })
+    }
+
+    /// Calculate the bitrates of a port in the current window.
+    ///
+    /// It should be called periodically, which is the width of windows, e.g. once a second.
+    pub fn calc(&mut self, port_id: PortId) -> Result<()> {
+        rte_check!(unsafe { ffi::rte_stats_bitrate_calc(self.0.as_ptr(), port_id) })
+    }
+}
+
+/// The RX to TX latency of a port in TSC cycles.
+///
+/// The TSC is read once per received burst and stored in the `mbuf.timestamp` of every packet,
+/// a packet of each transmitted burst is sampled to the histogram of its TX queue.
+/// The histograms are only written by the lcore transmitting on the queue.
+///
+/// The timestamps of the received packets are overwritten, so the tracker can't be used with
+/// `latency_init`, which stamps the same field, or the RX timestamp offload of the NIC.
+///
+/// The packets transmitted to the port should be received from the ports tracked,
+/// otherwise the stale timestamps of mbufs are sampled.
+pub struct LatencyTracker {
+    port_id: PortId,
+    queues: Vec<CacheAligned<Histogram>>,
+}
+
+unsafe extern "C" fn stamp_rx_burst(
+    _port_id: u16,
+    _queue: u16,
+    pkts: *mut *mut ffi::rte_mbuf,
+    nb_pkts: u16,
+    _max_pkts: u16,
+    _user_param: *mut c_void,
+) -> u16 {
+    if nb_pkts > 0 {
+        let now = rdtsc();
+
+        // any packet of the burst may be sampled on TX, so all of them are stamped
+        for &m in slice::from_raw_parts(pkts, usize::from(nb_pkts)) {
+            (*m).timestamp = now;
+        }
+    }
+
+    nb_pkts
+}
+
+unsafe extern "C" fn sample_tx_burst(
+    _port_id: u16,
+    _queue: u16,
+    pkts: *mut *mut ffi::rte_mbuf,
+    nb_pkts: u16,
+    user_param: *mut c_void,
+) -> u16 {
+    if nb_pkts > 0 {
+        let now = rdtsc();
+        // the low bits of TSC pick the sample, the oldest packet isn't always the first one
+        let m = *pkts.add(now as usize % usize::from(nb_pkts));
+        let stamp = (*m).timestamp;
+
+        if stamp != 0 && stamp <= now {
+            (*(user_param as *const Histogram)).record(now - stamp);
+        }
+    }
+
+    nb_pkts
+}
+
+impl LatencyTracker {
+    /// Track the latency of a port, which is configured with the RX and TX queues.
+    ///
+    /// The callbacks would be called until the process exits, so the tracker lives as long as it does.
+    pub fn install(port_id: PortId, nb_rx_queue: QueueId, nb_tx_queue: QueueId) -> Result<&'static Self> {
+        let tracker: &'static LatencyTracker = Box::leak(Box::new(LatencyTracker {
+            port_id,
+            queues: (0..nb_tx_queue).map(|_| Default::default()).collect(),
+        }));
+
+        for queue_id in 0..nb_rx_queue {
+            let cb = unsafe { ffi::rte_eth_add_rx_callback(port_id, queue_id, Some(stamp_rx_burst), ptr::null_mut()) };
+
+            if cb.is_null() {
+                return Err(rte_error());
+            }
+        }
+
+        for (queue_id, hist) in tracker.queues.iter().enumerate() {
+            let param = &**hist as *const Histogram as *mut c_void;
+            let cb =
+                unsafe { ffi::rte_eth_add_tx_callback(port_id, queue_id as QueueId, Some(sample_tx_burst), param) };
+
+            if cb.is_null() {
+                return Err(rte_error());
+            }
+        }
+
+        Ok(tracker)
+    }
+
+    /// The port tracked.
+    pub fn port_id(&self) -> PortId {
+        self.port_id
+    }
+
+    /// Take a snapshot of the latencies in TSC cycles of all the TX queues.
+    pub fn snapshot(&self) -> HistogramSnapshot {
+        self.queues.iter().fold(HistogramSnapshot::default(), |mut sum, hist| {
+            sum.merge(&hist.snapshot());
+            sum
+        })
+    }
+
+    /// The latency at the quantile `q` in nanoseconds, e.g. 0.5 for p50 and 0.99 for p99.
+    pub fn quantile_ns(&self, q: f64) -> Option<u64> {
+        let hz = get_tsc_hz();
+
+        self.snapshot()
+            .quantile(q)
+            .map(|cycles| (u128::from(cycles) * 1_000_000_000 / u128::from(hz)) as u64)
+    }
+
+    /// Reset the latencies, the samples racing with the reset may be lost.
+    pub fn reset(&self) {
+        for hist in &self.queues {
+            hist.reset()
+        }
+    }
+}
@@ -0,0 +1,330 @@
+//!
+//! The hot path profiler
+//!
+//! A span measures the cycles of a scope with `rdtsc_precise`,
+//! and records the cycles per packet to a histogram of the current lcore.
+//! A loop scope accounts the busy and idle cycles of a polling loop with `jobstats`.
+//!
+//! ```no_run
+//! # #[macro_use] extern crate rte;
+//! # fn main() {
+//! # let nb_rx = 32;
+//! loop {
+//!     let turn = profile_loop!();
+//!
+//!     {
+//!         let _span = profile!("classify", nb_rx);
+//!
+//!         // classify the packets
+//!     }
+//!
+//!     turn.done(nb_rx);
+//! #   break;
+//! }
+//! # }
+//! ```
+//!
+//! The macros are expanded to nothing but `profile::Disabled` unless the `profile` feature is enabled,
+//! which costs nothing on the hot path.
+//!
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+
+use common::rdtsc_precise;
+use jobstats::{Job, JobContext, Load};
+use lcore;
+use stats::{CacheAligned, Counter, Histogram};
+
+/// The maximum number of spans.
+pub const MAX_SPANS: usize = 32;
+
+const UNREGISTERED: usize = usize::max_value();
+
+lazy_static! {
+    static ref SPAN_NAMES: Mutex<Vec<&'static str>> = Mutex::new(Vec::new());
+    static ref LCORES: Mutex<Vec<Arc<LcoreProfile>>> = Mutex::new(Vec::new());
+}
+
+thread_local! {
+    static LOCAL: Arc<LcoreProfile> = LcoreProfile::register();
+}
+
+/// A named span, which is usually declared by `profile!`.
+pub struct Span {
+    name: &'static str,
+    id: AtomicUsize,
+}
+
+impl Span {
+    pub const fn new(name: &'static str) -> Self {
+        Span {
+            name,
+            id: AtomicUsize::new(UNREGISTERED),
+        }
+    }
+
+    /// The name of span.
+    pub fn name(&self) -> &'static str {
+        self.name
+    }
+
+    #[inline]
+    fn id(&self) -> usize {
+        let id = self.id.load(Ordering::Relaxed);
+
+        if id != UNREGISTERED {
+            id
+        } else {
+            self.register()
+        }
+    }
+
+    #[cold]
+    fn register(&self) -> usize {
+        let mut names = SPAN_NAMES.lock().unwrap();
+        let id = self.id.load(Ordering::Relaxed);
+
+        if id != UNREGISTERED {
+            return id;
+        }
+
+        // the spans over the limit are not recorded
+        let id = names.len();
+
+        if id < MAX_SPANS {
+            names.push(self.name);
+        }
+
+        self.id.store(id, Ordering::Relaxed);
+
+        id
+    }
+
+    /// Enter the span, the cycles are recorded when the scope is dropped.
+    #[inline]
+    pub fn enter(&'static self) -> Scope {
+        Scope {
+            span: self,
+            packets: 1,
+            start: rdtsc_precise(),
+        }
+    }
+}
+
+/// The scope of a span.
+pub struct Scope {
+    span: &'static Span,
+    packets: u64,
+    start: u64,
+}
+
+impl Scope {
+    /// Set the number of packets processed in the scope.
+    #[inline]
+    pub fn packets(mut self, n: u64) -> Self {
+        self.packets = n;
+        self
+    }
+
+    /// Set the number of packets processed in the scope, when it is known at the end.
+    #[inline]
+    pub fn set_packets(&mut self, n: u64) {
+        self.packets = n;
+    }
+}
+
+impl Drop for Scope {
+    #[inline]
+    fn drop(&mut self) {
+        let cycles = rdtsc_precise().wrapping_sub(self.start);
+        let id = self.span.id();
+
+        if id < MAX_SPANS {
+            let packets = self.packets;
+
+            LOCAL.with(|p| p.spans[id].record(cycles, packets));
+        }
+    }
+}
+
+/// A turn of the polling loop, see `profile_loop!`.
+pub struct LoopTurn(());
+
+impl LoopTurn {
+    #[inline]
+    pub fn begin() -> Self {
+        LOCAL.with(|p| {
+            p.ctx.start();
+
+            // the context and the job are pinned in the profile of lcore, which lives until the thread exits
+            unsafe {
+                p.poll.start(&p.ctx);
+            }
+        });
+
+        LoopTurn(())
+    }
+
+    /// Finish the turn, which is busy if any packet is processed.
+    #[inline]
+    pub fn done(self, packets: u64) {
+        LOCAL.with(|p| {
+            if packets > 0 {
+                p.poll.finish(packets as i64);
+            } else {
+                p.poll.abort();
+            }
+
+            p.ctx.finish();
+        });
+    }
+}
+
+/// The placeholder of spans and loop turns when the `profile` feature is disabled.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct Disabled;
+
+impl Disabled {
+    #[inline(always)]
+    pub fn packets(self, _n: u64) -> Self {
+        self
+    }
+
+    #[inline(always)]
+    pub fn set_packets(&mut self, _n: u64) {}
+
+    #[inline(always)]
+    pub fn done(self, _packets: u64) {}
+}
+
+#[derive(Default)]
+struct SpanStats {
+    calls: Counter,
+    packets: Counter,
+    cycles: Counter,
+    // the cycles per packet
+    histogram: Histogram,
+}
+
+impl SpanStats {
+    #[inline]
+    fn record(&self, cycles: u64, packets: u64) {
+        self.calls.incr();
+        self.packets.add(packets);
+        self.cycles.add(cycles);
+        self.histogram.record(cycles / packets.max(1));
+    }
+
+    fn reset(&self) {
+        self.calls.reset();
+        self.packets.reset();
+        self.cycles.reset();
+        self.histogram.reset();
+    }
+}
+
+// The profile of an lcore, which is only written by the lcore.
+struct LcoreProfile {
+    lcore_id: Option<lcore::Id>,
+    ctx: JobContext,
+    poll: Job,
+    spans: Vec<CacheAligned<SpanStats>>,
+}
+
+unsafe impl Send for LcoreProfile {}
+
+unsafe impl Sync for LcoreProfile {}
+
+impl LcoreProfile {
+    #[cold]
+    fn register() -> Arc<LcoreProfile> {
+        let p = Arc::new(LcoreProfile {
+            lcore_id: lcore::current(),
+            ctx: JobContext::new(),
+            poll: Job::new("poll", 0, u64::max_value(), 0, 1).expect("fail to init poll job"),
+            spans: (0..MAX_SPANS).map(|_| Default::default()).collect(),
+        });
+
+        LCORES.lock().unwrap().push(p.clone());
+
+        p
+    }
+}
+
+/// The report of a span on an lcore.
+#[derive(Clone, Debug, Default, PartialEq)]
+pub struct SpanReport {
+    pub name: &'static str,
+    pub calls: u64,
+    pub packets: u64,
+    pub cycles: u64,
+    /// The median cycles per packet.
+    pub p50: Option<u64>,
+    /// The 99th percentile cycles per packet.
+    pub p99: Option<u64>,
+}
+
+impl SpanReport {
+    /// The average cycles per packet.
+    pub fn cycles_per_packet(&self) -> f64 {
+        if self.packets == 0 {
+            0.0
+        } else {
+            self.cycles as f64 / self.packets as f64
+        }
+    }
+}
+
+/// The report of an lcore.
+#[derive(Clone, Debug, Default, PartialEq)]
+pub struct LcoreReport {
+    /// The lcore, or `None` for the non-EAL threads.
+    pub lcore_id: Option<lcore::Id>,
+    /// The busy and idle cycles of the polling loop.
+    pub load: Load,
+    pub spans: Vec<SpanReport>,
+}
+
+/// Report the spans and loads of all the lcores profiled.
+pub fn report() -> Vec<LcoreReport> {
+    let names = SPAN_NAMES.lock().unwrap().clone();
+
+    LCORES
+        .lock()
+        .unwrap()
+        .iter()
+        .map(|p| LcoreReport {
+            lcore_id: p.lcore_id,
+            load: p.ctx.load(),
+            spans: names
+                .iter()
+                .zip(p.spans.iter())
+                .filter(|&(_, stats)| stats.calls.get() > 0)
+                .map(|(&name, stats)| {
+                    let snapshot = stats.histogram.snapshot();
+
+                    SpanReport {
+                        name,
+                        calls: stats.calls.get(),
+                        packets: stats.packets.get(),
+                        cycles: stats.cycles.get(),
+                        p50: snapshot.quantile(0.5),
+                        p99: snapshot.quantile(0.99),
+                    }
+                })
+                .collect(),
+        })
+        .collect()
+}
+
+/// Reset the profile of current lcore, it must be called by the lcore itself.
+pub fn reset() {
+    LOCAL.with(|p| {
+        p.ctx.reset();
+        p.poll.reset();
+
+        for stats in &p.spans {
+            stats.reset()
+        }
+    })
+}
@@ -0,0 +1,316 @@
+//!
+//! Read-Copy-Update
+//!
+//! The quiescent state based reclamation (QSBR), which follows `rte_rcu_qsbr` of the later DPDK.
+//!
+//! The worker lcores read the shared data without any lock or atomic read-modify-write,
+//! and report a quiescent state once per poll iteration, when they don't hold any reference to the data.
+//! The control plane swaps in a new version of data, and reclaims the old one
+//! after all the online readers have reported a quiescent state.
+//!
+//! ```no_run
+//! # extern crate rte;
+//! # use rte::rcu::{Qsbr, Rcu};
+//! # fn main() {
+//! let qsbr = Qsbr::new(4);
+//! let dst_ports = Rcu::new(&qsbr, vec![1u16, 0]);
+//!
+//! // on the worker lcore
+//! let mut reader = qsbr.register(1).unwrap();
+//!
+//! loop {
+//!     {
+//!         let dst_port = dst_ports.read(&reader)[0];
+//!
+//!         // forward the burst to `dst_port`
+//!     }
+//!
+//!     reader.quiescent();
+//! #   break;
+//! }
+//!
+//! // on the control plane, wait for the readers and drop the old table
+//! # drop(reader);
+//! dst_ports.replace(vec![0, 1]);
+//! # }
+//! ```
+//!
+use std::hint;
+use std::marker::PhantomData;
+use std::ptr;
+use std::sync::atomic::{fence, AtomicBool, AtomicPtr, AtomicU64, Ordering};
+use std::sync::Mutex;
+
+use errors::{ErrorKind, Result};
+use stats::CacheAligned;
+
+// the counter of an offline thread
+const OFFLINE: u64 = 0;
+
+#[derive(Default)]
+struct ThreadState {
+    // the token of the last quiescent state, or `OFFLINE`
+    cnt: AtomicU64,
+    registered: AtomicBool,
+}
+
+/// A QSBR variable, which tracks the quiescent states of up to `max_threads` reader threads.
+pub struct Qsbr {
+    token: CacheAligned<AtomicU64>,
+    threads: Vec<CacheAligned<ThreadState>>,
+}
+
+impl Qsbr {
+    /// Create a QSBR variable for the reader threads with ID from 0 to `max_threads - 1`, e.g. the lcore ID.
+    pub fn new(max_threads: usize) -> Self {
+        Qsbr {
+            token: CacheAligned(AtomicU64::new(OFFLINE + 1)),
+            threads: (0..max_threads).map(|_| Default::default()).collect(),
+        }
+    }
+
+    /// The maximum number of reader threads.
+    pub fn max_threads(&self) -> usize {
+        self.threads.len()
+    }
+
+    /// Register a reader thread, which is online.
+    pub fn register(&self, thread_id: usize) -> Result<Reader<'_>> {
+        match self.threads.get(thread_id) {
+            Some(thread) if !thread.registered.swap(true, Ordering::AcqRel) => {}
+            _ => return Err(ErrorKind::InvalidReader(thread_id).into()),
+        }
+
+        let mut reader = Reader {
+            qsbr: self,
+            thread_id,
+            phantom: PhantomData,
+        };
+
+        reader.online();
+
+        Ok(reader)
+    }
+
+    /// Start a grace period, and return its token for `check`.
+    #[inline]
+    pub fn start(&self) -> u64 {
+        self.token.fetch_add(1, Ordering::Release) + 1
+    }
+
+    /// Check if all the online readers have reported a quiescent state after `start` returned `token`.
+    ///
+    /// It spins until they have if `wait`.
+    pub fn check(&self, token: u64, wait: bool) -> bool {
+        for thread in &self.threads {
+            if !thread.registered.load(Ordering::Acquire) {
+                continue;
+            }
+
+            loop {
+                let cnt = thread.cnt.load(Ordering::Acquire);
+
+                if cnt == OFFLINE || cnt >= token {
+                    break;
+                }
+
+                if !wait {
+                    return false;
+                }
+
+                hint::spin_loop();
+            }
+        }
+
+        true
+    }
+
+    /// Wait for all the online readers to report a quiescent state.
+    ///
+    /// A reader must not call it when it is online, or it will wait for itself forever.
+    pub fn synchronize(&self) {
+        let token = self.start();
+
+        self.check(token, true);
+    }
+}
+
+/// A registered reader thread of a QSBR variable, which is unregistered when dropped.
+///
+/// The data read through the reader could not be held across the quiescent states.
+pub struct Reader<'a> {
+    qsbr: &'a Qsbr,
+    thread_id: usize,
+    // a reader stays on its thread
+    phantom: PhantomData<*mut ()>,
+}
+
+impl<'a> Drop for Reader<'a> {
+    fn drop(&mut self) {
+        self.offline();
+        self.state().registered.store(false, Ordering::Release);
+    }
+}
+
+impl<'a> Reader<'a> {
+    #[inline]
+    fn state(&self) -> &ThreadState {
+        &self.qsbr.threads[self.thread_id]
+    }
+
+    /// The ID of reader thread.
+    pub fn thread_id(&self) -> usize {
+        self.thread_id
+    }
+
+    /// Report a quiescent state, e.g. once per poll iteration.
+    #[inline]
+    pub fn quiescent(&mut self) {
+        let token = self.qsbr.token.load(Ordering::Acquire);
+        let state = self.state();
+
+        if state.cnt.load(Ordering::Relaxed) != token {
+            state.cnt.store(token, Ordering::Release);
+        }
+    }
+
+    /// Go online and read the shared data, which is the state after `register`.
+    #[inline]
+    pub fn online(&mut self) {
+        let token = self.qsbr.token.load(Ordering::Relaxed);
+
+        self.state().cnt.store(token, Ordering::Relaxed);
+
+        // the following reads must not happen before the writers see the reader is online
+        fence(Ordering::SeqCst);
+    }
+
+    /// Go offline before blocking for a long time, e.g. sleep on the RX interrupts,
+    /// so that the writers don't wait for it.
+    #[inline]
+    pub fn offline(&mut self) {
+        self.state().cnt.store(OFFLINE, Ordering::Release);
+    }
+
+    /// Test if the reader is online.
+    pub fn is_online(&self) -> bool {
+        self.state().cnt.load(Ordering::Relaxed) != OFFLINE
+    }
+}
+
+/// A shared value, which is read without any lock and updated by swapping in a new version.
+pub struct Rcu<'q, T> {
+    qsbr: &'q Qsbr,
+    ptr: AtomicPtr<T>,
+    // serialize the writers
+    writer: Mutex<()>,
+    phantom: PhantomData<*mut T>,
+}
+
+unsafe impl<'q, T: Send> Send for Rcu<'q, T> {}
+
+unsafe impl<'q, T: Send + Sync> Sync for Rcu<'q, T> {}
+
+impl<'q, T> Drop for Rcu<'q, T> {
+    fn drop(&mut self) {
+        unsafe { drop(Box::from_raw(*self.ptr.get_mut())) }
+    }
+}
+
+impl<'q, T> Rcu<'q, T> {
+    /// Create a shared value, which is read by the readers of `qsbr`.
+    pub fn new(qsbr: &'q Qsbr, value: T) -> Self {
+        Rcu {
+            qsbr,
+            ptr: AtomicPtr::new(Box::into_raw(Box::new(value))),
+            writer: Mutex::new(()),
+            phantom: PhantomData,
+        }
+    }
+
+    /// Read the current version, which is valid until the reader reports a quiescent state.
+    ///
+    /// It panics if the reader is offline or belongs to another QSBR variable,
+    /// since the writers would not wait for it.
+    #[inline]
+    pub fn read<'r>(&'r self, reader: &'r Reader<'q>) -> &'r T {
+        assert!(
+            ptr::eq(reader.qsbr, self.qsbr) && reader.is_online(),
+            "read by an offline or foreign reader"
+        );
+
+        unsafe { &*self.ptr.load(Ordering::Acquire) }
+    }
+
+    /// Swap in a new version, and wait for the readers to release the old one.
+    ///
+    /// The caller must not be an online reader, like `Qsbr::synchronize`.
+    pub fn replace(&self, value: T) -> T {
+        self.swap(value).reclaim()
+    }
+
+    /// Update the value with a new version copied from the current one.
+    pub fn update<F: FnOnce(&T) -> T>(&self, f: F) {
+        let retired = {
+            let _guard = self.writer.lock().unwrap();
+
+            let value = f(unsafe { &*self.ptr.load(Ordering::Acquire) });
+
+            self.retire(value)
+        };
+
+        drop(retired.reclaim())
+    }
+
+    /// Swap in a new version, and retire the old one without waiting for the readers.
+    pub fn swap(&self, value: T) -> Retired<'q, T> {
+        let _guard = self.writer.lock().unwrap();
+
+        self.retire(value)
+    }
+
+    fn retire(&self, value: T) -> Retired<'q, T> {
+        let old = self.ptr.swap(Box::into_raw(Box::new(value)), Ordering::AcqRel);
+
+        Retired {
+            qsbr: self.qsbr,
+            ptr: old,
+            token: self.qsbr.start(),
+        }
+    }
+}
+
+/// An old version, which may be still read by the readers.
+///
+/// It is leaked if dropped before reclaimed.
+#[must_use]
+pub struct Retired<'q, T> {
+    qsbr: &'q Qsbr,
+    ptr: *mut T,
+    token: u64,
+}
+
+unsafe impl<'q, T: Send> Send for Retired<'q, T> {}
+
+impl<'q, T> Retired<'q, T> {
+    /// Test if all the readers have released the old version.
+    pub fn is_released(&self) -> bool {
+        self.qsbr.check(self.token, false)
+    }
+
+    /// Take back the old version if it is released, or return self back.
+    pub fn try_reclaim(self) -> ::std::result::Result<T, Self> {
+        if self.is_released() {
+            Ok(unsafe { *Box::from_raw(self.ptr) })
+        } else {
+            Err(self)
+        }
+    }
+
+    /// Wait for the readers to release the old version, and take it back.
+    pub fn reclaim(self) -> T {
+        self.qsbr.check(self.token, true);
+
+        unsafe { *Box::from_raw(self.ptr) }
+    }
+}
@@ -1,5 +1,824 @@
+//!
+//! RTE Ring
+//!
+//! The Ring Manager is a fixed-size queue, implemented as a table of
+//! pointers. Head and tail pointers are modified atomically, allowing
+//! concurrent access to it. It has the following features:
+//!
+//! - FIFO (First In First Out)
+//! - Maximum size is fixed; the pointers are stored in a table.
+//! - Lockless implementation.
+//! - Multi- or single-consumer dequeue.
+//! - Multi- or single-producer enqueue.
+//! - Bulk dequeue.
+//! - Bulk enqueue.
+//!
+//! The producer and consumer behaviors are chosen at the type level,
+//! e.g. `SpscRing<T>` always calls the single-producer/single-consumer functions,
+//! so there is no runtime flag check on the hot path.
+//!
+use std::cell::Cell;
+use std::ffi::CStr;
+use std::marker::PhantomData;
+use std::mem;
+use std::ops::Deref;
+use std::os::raw::{c_uint, c_void};
+use std::os::unix::io::AsRawFd;
+use std::ptr::{self, NonNull};
+use std::result;
+use std::slice;
+use std::sync::atomic::{AtomicU32, Ordering};
+
+use cfile;
 use ffi;
 
+use eal;
+use errors::{AsResult, Result};
+use mbuf;
+use memory::SocketId;
+use utils::{AsCString, AsRaw};
+
 lazy_static! {
     pub static ref RTE_RING_NAMESIZE: usize = ffi::RTE_MEMZONE_NAMESIZE as usize - ffi::RTE_RING_MZ_PREFIX.len() + 1;
 }
+
+bitflags! {
+    pub struct RingFlags: u32 {
+        /// The default enqueue is "single-producer".
+        const RING_F_SP_ENQ     = ffi::RING_F_SP_ENQ;
+        /// The default dequeue is "single-consumer".
+        const RING_F_SC_DEQ     = ffi::RING_F_SC_DEQ;
+        /// Ring holds exactly requested number of entries.
+        ///
+        /// Without this flag set, the ring size requested must be a power of 2,
+        /// and the usable space will be that size - 1.
+        const RING_F_EXACT_SZ   = ffi::RING_F_EXACT_SZ;
+    }
+}
+
+/// An object which could be stored in a ring.
+///
+/// The object is stored as a non-null pointer, so `Option<T>` must have the same layout as a pointer,
+/// and `None` is stored as NULL.
+pub unsafe trait Element: Sized {}
+
+unsafe impl<T> Element for NonNull<T> {}
+
+unsafe impl<T> Element for Box<T> {}
+
+unsafe impl<T> Element for &'static T {}
+
+unsafe impl Element for mbuf::MBuf {}
+
+/// The enqueue behavior of a ring.
+pub trait Producer {
+    /// The flags of ring for the producer.
+    const FLAGS: u32;
+
+    /// Enqueue several objects on the ring, either 0 or n.
+    unsafe fn enqueue_bulk(
+        r: *mut ffi::rte_ring,
+        obj_table: *const *mut c_void,
+        n: c_uint,
+        free_space: *mut c_uint,
+    ) -> c_uint;
+
+    /// Enqueue as many objects as possible on the ring.
+    unsafe fn enqueue_burst(
+        r: *mut ffi::rte_ring,
+        obj_table: *const *mut c_void,
+        n: c_uint,
+        free_space: *mut c_uint,
+    ) -> c_uint;
+}
+
+/// The dequeue behavior of a ring.
+pub trait Consumer {
+    /// The flags of ring for the consumer.
+    const FLAGS: u32;
+
+    /// Dequeue several objects from the ring, either 0 or n.
+    unsafe fn dequeue_bulk(
+        r: *mut ffi::rte_ring,
+        obj_table: *mut *mut c_void,
+        n: c_uint,
+        available: *mut c_uint,
+    ) -> c_uint;
+
+    /// Dequeue as many objects as possible from the ring.
+    unsafe fn dequeue_burst(
+        r: *mut ffi::rte_ring,
+        obj_table: *mut *mut c_void,
+        n: c_uint,
+        available: *mut c_uint,
+    ) -> c_uint;
+}
+
+/// Only one lcore enqueues or dequeues at a time, so the side is not `Sync`.
+pub struct Single(PhantomData<Cell<()>>);
+
+/// The ring is safe to be enqueued or dequeued by multiple lcores.
+pub enum Multi {}
+
+impl Producer for Single {
+    const FLAGS: u32 = ffi::RING_F_SP_ENQ;
+
+    #[inline(always)]
+    unsafe fn enqueue_bulk(
+        r: *mut ffi::rte_ring,
+        obj_table: *const *mut c_void,
+        n: c_uint,
+        free_space: *mut c_uint,
+    ) -> c_uint {
+        ffi::_rte_ring_sp_enqueue_bulk(r, obj_table, n, free_space)
+    }
+
+    #[inline(always)]
+    unsafe fn enqueue_burst(
+        r: *mut ffi::rte_ring,
+        obj_table: *const *mut c_void,
+        n: c_uint,
+        free_space: *mut c_uint,
+    ) -> c_uint {
+        ffi::_rte_ring_sp_enqueue_burst(r, obj_table, n, free_space)
+    }
+}
+
+impl Producer for Multi {
+    const FLAGS: u32 = 0;
+
+    #[inline(always)]
+    unsafe fn enqueue_bulk(
+        r: *mut ffi::rte_ring,
+        obj_table: *const *mut c_void,
+        n: c_uint,
+        free_space: *mut c_uint,
+    ) -> c_uint {
+        ffi::_rte_ring_mp_enqueue_bulk(r, obj_table, n, free_space)
+    }
+
+    #[inline(always)]
+    unsafe fn enqueue_burst(
+        r: *mut ffi::rte_ring,
+        obj_table: *const *mut c_void,
+        n: c_uint,
+        free_space: *mut c_uint,
+    ) -> c_uint {
+        ffi::_rte_ring_mp_enqueue_burst(r, obj_table, n, free_space)
+    }
+}
+
+impl Consumer for Single {
+    const FLAGS: u32 = ffi::RING_F_SC_DEQ;
+
+    #[inline(always)]
+    unsafe fn dequeue_bulk(
+        r: *mut ffi::rte_ring,
+        obj_table: *mut *mut c_void,
+        n: c_uint,
+        available: *mut c_uint,
+    ) -> c_uint {
+        ffi::_rte_ring_sc_dequeue_bulk(r, obj_table, n, available)
+    }
+
+    #[inline(always)]
+    unsafe fn dequeue_burst(
+        r: *mut ffi::rte_ring,
+        obj_table: *mut *mut c_void,
+        n: c_uint,
+        available: *mut c_uint,
+    ) -> c_uint {
+        ffi::_rte_ring_sc_dequeue_burst(r, obj_table, n, available)
+    }
+}
+
+impl Consumer for Multi {
+    const FLAGS: u32 = 0;
+
+    #[inline(always)]
+    unsafe fn dequeue_bulk(
+        r: *mut ffi::rte_ring,
+        obj_table: *mut *mut c_void,
+        n: c_uint,
+        available: *mut c_uint,
+    ) -> c_uint {
+        ffi::_rte_ring_mc_dequeue_bulk(r, obj_table, n, available)
+    }
+
+    #[inline(always)]
+    unsafe fn dequeue_burst(
+        r: *mut ffi::rte_ring,
+        obj_table: *mut *mut c_void,
+        n: c_uint,
+        available: *mut c_uint,
+    ) -> c_uint {
+        ffi::_rte_ring_mc_dequeue_burst(r, obj_table, n, available)
+    }
+}
+
+pub type RawRing = ffi::rte_ring;
+pub type RawRingPtr = *mut ffi::rte_ring;
+
+/// A typed ring, enqueue with the `P` producer and dequeue with the `C` consumer behavior.
+///
+/// A ring is only `Sync` if both sides are `Multi`. A ring with a `Single` side is shared between lcores
+/// by splitting it into an `Enqueuer` and a `Dequeuer`, which are moved to the producer and consumer lcores.
+pub struct Ring<T, P = Multi, C = Multi> {
+    tx: Enqueuer<T, P>,
+    rx: Dequeuer<T, C>,
+}
+
+/// A single-producer, single-consumer ring.
+pub type SpscRing<T> = Ring<T, Single, Single>;
+
+/// A multi-producers, single-consumer ring.
+pub type MpscRing<T> = Ring<T, Multi, Single>;
+
+/// A single-producer, multi-consumers ring.
+pub type SpmcRing<T> = Ring<T, Single, Multi>;
+
+/// A multi-producers, multi-consumers ring.
+pub type MpmcRing<T> = Ring<T, Multi, Multi>;
+
+impl<T, P, C> Deref for Ring<T, P, C> {
+    type Target = RawRing;
+
+    fn deref(&self) -> &Self::Target {
+        unsafe { self.tx.raw.as_ref() }
+    }
+}
+
+impl<T, P, C> AsRaw for Ring<T, P, C> {
+    type Raw = RawRing;
+
+    fn as_raw(&self) -> *mut Self::Raw {
+        self.tx.raw.as_ptr()
+    }
+}
+
+impl<T, P, C> Ring<T, P, C>
+where
+    T: Element,
+    P: Producer,
+    C: Consumer,
+{
+    fn from_raw(raw: NonNull<RawRing>) -> Self {
+        Ring {
+            tx: Enqueuer {
+                raw,
+                phantom: PhantomData,
+            },
+            rx: Dequeuer {
+                raw,
+                phantom: PhantomData,
+            },
+        }
+    }
+
+    /// Create a new ring named *name* in memory.
+    ///
+    /// The new ring size is set to *count*, which must be a power of two,
+    /// unless `RING_F_EXACT_SZ` is set. The single producer/consumer flags
+    /// are set by the type of ring.
+    pub fn create<S: AsRef<str>>(name: S, count: usize, socket_id: SocketId, flags: RingFlags) -> Result<Self> {
+        let name = name.as_cstring();
+        let flags = flags.bits | P::FLAGS | C::FLAGS;
+
+        unsafe { ffi::rte_ring_create(name.as_ptr(), count as u32, socket_id, flags) }
+            .as_result()
+            .map(Self::from_raw)
+    }
+
+    /// Search a ring from its name
+    ///
+    /// # Safety
+    ///
+    /// The found ring is shared with its creator, so its single-producer or single-consumer side
+    /// must not be used concurrently with the side of same direction of another handle.
+    pub unsafe fn lookup<S: AsRef<str>>(name: S) -> Result<Self> {
+        let name = name.as_cstring();
+
+        ffi::rte_ring_lookup(name.as_ptr()).as_result().map(Self::from_raw)
+    }
+
+    /// Search a ring created by the primary process, or create it if not found in the primary process.
+    ///
+    /// # Safety
+    ///
+    /// The ring found in a secondary process follows the contract of `lookup`.
+    pub unsafe fn lookup_or_create<S: AsRef<str>>(
+        name: S,
+        count: usize,
+        socket_id: SocketId,
+        flags: RingFlags,
+    ) -> Result<Self> {
+        eal::lookup_or_create(|| Self::lookup(&name), || Self::create(&name, count, socket_id, flags))
+    }
+
+    /// Split the ring into its enqueue and dequeue sides.
+    pub fn split(self) -> (Enqueuer<T, P>, Dequeuer<T, C>) {
+        (self.tx, self.rx)
+    }
+
+    /// Join the enqueue and dequeue sides split from the same ring.
+    pub fn join(tx: Enqueuer<T, P>, rx: Dequeuer<T, C>) -> Self {
+        assert_eq!(tx.raw, rx.raw, "the sides of different rings");
+
+        Ring { tx, rx }
+    }
+
+    /// De-allocate all memory used by the ring.
+    ///
+    /// The objects remaining in the ring are not freed.
+    pub fn free(self) {
+        unsafe { ffi::rte_ring_free(self.as_raw()) }
+    }
+
+    /// Name of the ring.
+    pub fn name(&self) -> &str {
+        unsafe { CStr::from_ptr(self.name.as_ptr()).to_str().unwrap() }
+    }
+
+    /// Return the number of entries in a ring.
+    #[inline]
+    pub fn count(&self) -> usize {
+        self.rx.count()
+    }
+
+    /// Return the number of free entries in a ring.
+    #[inline]
+    pub fn free_count(&self) -> usize {
+        self.tx.free_count()
+    }
+
+    /// Test if a ring is full.
+    #[inline]
+    pub fn is_full(&self) -> bool {
+        unsafe { ffi::_rte_ring_full(self.as_raw()) != 0 }
+    }
+
+    /// Test if a ring is empty.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.rx.is_empty()
+    }
+
+    /// Return the size of the ring.
+    #[inline]
+    pub fn size(&self) -> usize {
+        unsafe { ffi::_rte_ring_get_size(self.as_raw()) as usize }
+    }
+
+    /// Return the number of elements which can be stored in the ring.
+    #[inline]
+    pub fn capacity(&self) -> usize {
+        unsafe { ffi::_rte_ring_get_capacity(self.as_raw()) as usize }
+    }
+
+    /// Dump the status of the ring to a file.
+    pub fn dump<S: AsRawFd>(&self, s: &S) -> Result<()> {
+        let mut f = cfile::fdopen(s, "w")?;
+
+        unsafe { ffi::rte_ring_dump(&mut **f as *mut _ as *mut _, self.as_raw()) };
+
+        Ok(())
+    }
+
+    /// Enqueue one object on a ring, or return it back if there is not enough room in the ring.
+    #[inline]
+    pub fn enqueue(&self, obj: T) -> result::Result<(), T> {
+        self.tx.enqueue(obj)
+    }
+
+    /// Dequeue one object from a ring.
+    #[inline]
+    pub fn dequeue(&self) -> Option<T> {
+        self.rx.dequeue()
+    }
+
+    /// Enqueue all the objects on the ring, or none of them if there is not enough room.
+    ///
+    /// The enqueued objects are taken from the table, and return the number of them.
+    /// Only the objects before the first empty slot are enqueued.
+    #[inline]
+    pub fn enqueue_bulk(&self, objs: &mut [Option<T>]) -> usize {
+        self.tx.enqueue_bulk(objs)
+    }
+
+    /// Enqueue as many objects as possible on the ring.
+    ///
+    /// The enqueued objects are taken from the head of table, and return the number of them.
+    /// Only the objects before the first empty slot are enqueued.
+    #[inline]
+    pub fn enqueue_burst(&self, objs: &mut [Option<T>]) -> usize {
+        self.tx.enqueue_burst(objs)
+    }
+
+    /// Dequeue objects to fill the whole table, or none of them if there is not enough entries.
+    ///
+    /// The table should be empty, or the previous objects will be leaked.
+    #[inline]
+    pub fn dequeue_bulk(&self, objs: &mut [Option<T>]) -> usize {
+        self.rx.dequeue_bulk(objs)
+    }
+
+    /// Dequeue as many objects as possible to the head of table.
+    ///
+    /// The table should be empty, or the previous objects will be leaked.
+    #[inline]
+    pub fn dequeue_burst(&self, objs: &mut [Option<T>]) -> usize {
+        self.rx.dequeue_burst(objs)
+    }
+}
+
+impl<P: Producer, C: Consumer> Ring<mbuf::MBuf, P, C> {
+    /// Enqueue as many packets of a burst as possible on the ring.
+    ///
+    /// The enqueued packets are removed from the head of a `mbuf::MBufBatch`.
+    #[inline]
+    pub fn enqueue_batch<B: mbuf::TxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        self.tx.enqueue_batch(mbufs)
+    }
+
+    /// Dequeue as many packets as possible from the ring.
+    ///
+    /// The dequeued packets are appended to the tail of a `mbuf::MBufBatch`.
+    #[inline]
+    pub fn dequeue_batch<B: mbuf::RxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        self.rx.dequeue_batch(mbufs)
+    }
+}
+
+impl<T: Element, P: Producer> Ring<T, P, Single> {
+    /// Peek at most `n` objects at the head of a single-consumer ring, without dequeuing or copying them.
+    ///
+    /// The objects stay in the ring until `Peek::consume` is called.
+    #[inline]
+    pub fn peek(&mut self, n: usize) -> Peek<'_, T> {
+        self.rx.peek(n)
+    }
+}
+
+/// The enqueue side of a ring.
+///
+/// It is only `Sync` and `Clone` for the multi-producers,
+/// so the single-producer side is owned and used by one lcore at a time.
+pub struct Enqueuer<T, P = Multi> {
+    raw: NonNull<RawRing>,
+    phantom: PhantomData<(T, P)>,
+}
+
+unsafe impl<T: Send, P> Send for Enqueuer<T, P> {}
+
+unsafe impl<T: Send, P: Sync> Sync for Enqueuer<T, P> {}
+
+impl<T> Clone for Enqueuer<T, Multi> {
+    fn clone(&self) -> Self {
+        Enqueuer {
+            raw: self.raw,
+            phantom: PhantomData,
+        }
+    }
+}
+
+impl<T, P> AsRaw for Enqueuer<T, P> {
+    type Raw = RawRing;
+
+    fn as_raw(&self) -> *mut Self::Raw {
+        self.raw.as_ptr()
+    }
+}
+
+impl<T: Element, P: Producer> Enqueuer<T, P> {
+    /// Return the number of free entries in a ring.
+    #[inline]
+    pub fn free_count(&self) -> usize {
+        unsafe { ffi::_rte_ring_free_count(self.as_raw()) as usize }
+    }
+
+    /// Return the number of elements which can be stored in the ring.
+    #[inline]
+    pub fn capacity(&self) -> usize {
+        unsafe { ffi::_rte_ring_get_capacity(self.as_raw()) as usize }
+    }
+
+    /// Enqueue one object on a ring, or return it back if there is not enough room in the ring.
+    #[inline]
+    pub fn enqueue(&self, obj: T) -> result::Result<(), T> {
+        let obj = Some(obj);
+
+        if unsafe { P::enqueue_bulk(self.as_raw(), &obj as *const _ as *const _, 1, ptr::null_mut()) } == 1 {
+            mem::forget(obj);
+
+            Ok(())
+        } else {
+            Err(obj.unwrap())
+        }
+    }
+
+    /// Enqueue all the objects on the ring, or none of them if there is not enough room.
+    ///
+    /// The enqueued objects are taken from the table, and return the number of them.
+    /// Only the objects before the first empty slot are enqueued.
+    #[inline]
+    pub fn enqueue_bulk(&self, objs: &mut [Option<T>]) -> usize {
+        let objs = packed(objs);
+
+        unsafe {
+            let n = P::enqueue_bulk(
+                self.as_raw(),
+                objs.as_ptr() as *const _,
+                objs.len() as u32,
+                ptr::null_mut(),
+            );
+
+            taken(&mut objs[..n as usize])
+        }
+    }
+
+    /// Enqueue as many objects as possible on the ring.
+    ///
+    /// The enqueued objects are taken from the head of table, and return the number of them.
+    /// Only the objects before the first empty slot are enqueued.
+    #[inline]
+    pub fn enqueue_burst(&self, objs: &mut [Option<T>]) -> usize {
+        let objs = packed(objs);
+
+        unsafe {
+            let n = P::enqueue_burst(
+                self.as_raw(),
+                objs.as_ptr() as *const _,
+                objs.len() as u32,
+                ptr::null_mut(),
+            );
+
+            taken(&mut objs[..n as usize])
+        }
+    }
+}
+
+impl<P: Producer> Enqueuer<mbuf::MBuf, P> {
+    /// Enqueue as many packets of a burst as possible on the ring.
+    ///
+    /// The enqueued packets are removed from the head of a `mbuf::MBufBatch`.
+    #[inline]
+    pub fn enqueue_batch<B: mbuf::TxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        unsafe {
+            let n = {
+                let pending = mbufs.pending();
+
+                P::enqueue_burst(
+                    self.as_raw(),
+                    pending.as_ptr() as *const _,
+                    pending.len() as u32,
+                    ptr::null_mut(),
+                ) as usize
+            };
+
+            mbufs.sent(n);
+
+            n
+        }
+    }
+}
+
+/// The dequeue side of a ring.
+///
+/// It is only `Sync` and `Clone` for the multi-consumers,
+/// so the single-consumer side is owned and used by one lcore at a time.
+pub struct Dequeuer<T, C = Multi> {
+    raw: NonNull<RawRing>,
+    phantom: PhantomData<(T, C)>,
+}
+
+unsafe impl<T: Send, C> Send for Dequeuer<T, C> {}
+
+unsafe impl<T: Send, C: Sync> Sync for Dequeuer<T, C> {}
+
+impl<T> Clone for Dequeuer<T, Multi> {
+    fn clone(&self) -> Self {
+        Dequeuer {
+            raw: self.raw,
+            phantom: PhantomData,
+        }
+    }
+}
+
+impl<T, C> AsRaw for Dequeuer<T, C> {
+    type Raw = RawRing;
+
+    fn as_raw(&self) -> *mut Self::Raw {
+        self.raw.as_ptr()
+    }
+}
+
+impl<T: Element, C: Consumer> Dequeuer<T, C> {
+    /// Return the number of entries in a ring.
+    #[inline]
+    pub fn count(&self) -> usize {
+        unsafe { ffi::_rte_ring_count(self.as_raw()) as usize }
+    }
+
+    /// Test if a ring is empty.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        unsafe { ffi::_rte_ring_empty(self.as_raw()) != 0 }
+    }
+
+    /// Return the number of elements which can be stored in the ring.
+    #[inline]
+    pub fn capacity(&self) -> usize {
+        unsafe { ffi::_rte_ring_get_capacity(self.as_raw()) as usize }
+    }
+
+    /// Dequeue one object from a ring.
+    #[inline]
+    pub fn dequeue(&self) -> Option<T> {
+        let mut obj = None;
+
+        unsafe { C::dequeue_bulk(self.as_raw(), &mut obj as *mut _ as *mut _, 1, ptr::null_mut()) };
+
+        obj
+    }
+
+    /// Dequeue objects to fill the whole table, or none of them if there is not enough entries.
+    ///
+    /// The table should be empty, or the previous objects will be leaked.
+    #[inline]
+    pub fn dequeue_bulk(&self, objs: &mut [Option<T>]) -> usize {
+        unsafe {
+            C::dequeue_bulk(
+                self.as_raw(),
+                objs.as_mut_ptr() as *mut _,
+                objs.len() as u32,
+                ptr::null_mut(),
+            ) as usize
+        }
+    }
+
+    /// Dequeue as many objects as possible to the head of table.
+    ///
+    /// The table should be empty, or the previous objects will be leaked.
+    #[inline]
+    pub fn dequeue_burst(&self, objs: &mut [Option<T>]) -> usize {
+        unsafe {
+            C::dequeue_burst(
+                self.as_raw(),
+                objs.as_mut_ptr() as *mut _,
+                objs.len() as u32,
+                ptr::null_mut(),
+            ) as usize
+        }
+    }
+}
+
+impl<C: Consumer> Dequeuer<mbuf::MBuf, C> {
+    /// Dequeue as many packets as possible from the ring.
+    ///
+    /// The dequeued packets are appended to the tail of a `mbuf::MBufBatch`.
+    #[inline]
+    pub fn dequeue_batch<B: mbuf::RxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        unsafe {
+            let n = {
+                let spare = mbufs.spare();
+
+                C::dequeue_burst(
+                    self.as_raw(),
+                    spare.as_mut_ptr() as *mut _,
+                    spare.len() as u32,
+                    ptr::null_mut(),
+                ) as usize
+            };
+
+            mbufs.filled(n);
+
+            n
+        }
+    }
+}
+
+impl<T: Element> Dequeuer<T, Single> {
+    /// Peek at most `n` objects at the head of a single-consumer ring, without dequeuing or copying them.
+    ///
+    /// The objects stay in the ring until `Peek::consume` is called,
+    /// and the consumer is borrowed exclusively until then, so the objects are never read twice.
+    #[inline]
+    pub fn peek(&mut self, n: usize) -> Peek<'_, T> {
+        unsafe {
+            let r = self.raw.as_ptr();
+            let head = (*r).cons.head;
+            let prod_tail = (*(&(*r).prod.tail as *const u32 as *const AtomicU32)).load(Ordering::Acquire);
+            let n = (prod_tail.wrapping_sub(head) as usize).min(n);
+
+            let idx = (head & (*r).mask) as usize;
+            let ring = r.add(1) as *const T;
+            let n1 = n.min((*r).size as usize - idx);
+
+            Peek {
+                raw: r,
+                head,
+                first: slice::from_raw_parts(ring.add(idx), n1),
+                second: slice::from_raw_parts(ring, n - n1),
+            }
+        }
+    }
+}
+
+// The objects have been enqueued, forget them without dropping.
+#[inline(always)]
+// The objects before the first empty slot, an empty slot would be enqueued as a NULL pointer.
+#[inline]
+fn packed<T>(objs: &mut [Option<T>]) -> &mut [Option<T>] {
+    let len = objs.iter().position(Option::is_none).unwrap_or(objs.len());
+
+    &mut objs[..len]
+}
+
+unsafe fn taken<T>(objs: &mut [Option<T>]) -> usize {
+    for obj in objs.iter_mut() {
+        ptr::write(obj, None)
+    }
+
+    objs.len()
+}
+
+/// The objects at the head of a single-consumer ring.
+///
+/// The ring slots may wrap around, so the objects are split into two slices.
+pub struct Peek<'a, T: 'a> {
+    raw: RawRingPtr,
+    head: u32,
+    first: &'a [T],
+    second: &'a [T],
+}
+
+impl<'a, T: 'a> Peek<'a, T> {
+    /// The number of peeked objects.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.first.len() + self.second.len()
+    }
+
+    /// There is no object in the ring.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.first.is_empty()
+    }
+
+    /// The peeked objects in the ring slots, which are borrowed until the peek is consumed.
+    #[inline]
+    pub fn as_slices(&self) -> (&[T], &[T]) {
+        (self.first, self.second)
+    }
+
+    /// Iterate the peeked objects.
+    #[inline]
+    pub fn iter(&self) -> impl Iterator<Item = &T> {
+        self.first.iter().chain(self.second.iter())
+    }
+
+    /// Dequeue the first `n` peeked objects, and pass their ownership to `f`.
+    #[inline]
+    pub fn consume<F: FnMut(T)>(self, n: usize, mut f: F) {
+        let n = n.min(self.len());
+        let n1 = n.min(self.first.len());
+
+        // the objects moved out are dequeued even if `f` panics
+        let mut consumed = Consumed {
+            raw: self.raw,
+            next: self.head,
+        };
+
+        for obj in self.first[..n1].iter().chain(self.second[..n - n1].iter()) {
+            let obj = unsafe { ptr::read(obj) };
+
+            consumed.next = consumed.next.wrapping_add(1);
+
+            f(obj)
+        }
+    }
+}
+
+// Move the consumer head and tail of a single-consumer ring when dropped.
+struct Consumed {
+    raw: RawRingPtr,
+    next: u32,
+}
+
+impl Drop for Consumed {
+    fn drop(&mut self) {
+        unsafe {
+            (*self.raw).cons.head = self.next;
+            (*(&(*self.raw).cons.tail as *const u32 as *const AtomicU32)).store(self.next, Ordering::Release);
+        }
+    }
+}
+
+/// Dump the status of all rings on the console
+pub fn list_dump<S: AsRawFd>(s: &S) -> Result<()> {
+    let mut f = cfile::fdopen(s, "w")?;
+
+    unsafe { ffi::rte_ring_list_dump(&mut **f as *mut _ as *mut _) };
+
+    Ok(())
+}
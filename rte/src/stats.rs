@@ -0,0 +1,286 @@
+//!
+//! Per-lcore statistics.
+//!
+//! Each lcore owns a cache line aligned slot, indexed by `lcore::Id::index()`,
+//! so the counters are only ever written by a single lcore, without locked instructions
+//! and without false sharing between the lcores.
+//!
+//! The readers aggregate the slots of all the lcores on the slow path,
+//! e.g. when printing the statistics, and never write to them.
+//!
+use std::fmt;
+use std::mem::{self, MaybeUninit};
+use std::ops::{Deref, DerefMut};
+use std::slice;
+use std::sync::atomic::{AtomicU64, Ordering};
+
+use lcore::{self, RTE_MAX_LCORE};
+
+/// A counter with a single writer, the lcore owning it.
+#[derive(Default)]
+pub struct Counter(AtomicU64);
+
+impl fmt::Debug for Counter {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        write!(f, "{}", self.get())
+    }
+}
+
+impl Counter {
+    /// Add `n` to the counter.
+    ///
+    /// It is a plain load and store, so only the lcore owning the counter may call it.
+    #[inline(always)]
+    pub fn add(&self, n: u64) {
+        self.0.store(self.0.load(Ordering::Relaxed) + n, Ordering::Relaxed)
+    }
+
+    /// Increment the counter.
+    #[inline(always)]
+    pub fn incr(&self) {
+        self.add(1)
+    }
+
+    /// Read the counter.
+    #[inline(always)]
+    pub fn get(&self) -> u64 {
+        self.0.load(Ordering::Relaxed)
+    }
+
+    /// Reset the counter.
+    ///
+    /// The increments racing with the reset may be lost.
+    pub fn reset(&self) {
+        self.0.store(0, Ordering::Relaxed)
+    }
+
+    /// The underlying atomic, e.g. for `TxBuffer::count_err_packets`.
+    pub fn as_atomic(&self) -> &AtomicU64 {
+        &self.0
+    }
+}
+
+/// Align the value to a cache line.
+#[repr(align(64))]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct CacheAligned<T>(pub T);
+
+impl<T> Deref for CacheAligned<T> {
+    type Target = T;
+
+    fn deref(&self) -> &Self::Target {
+        &self.0
+    }
+}
+
+impl<T> DerefMut for CacheAligned<T> {
+    fn deref_mut(&mut self) -> &mut Self::Target {
+        &mut self.0
+    }
+}
+
+/// A slot of `T` for each lcore.
+pub struct PerLcore<T> {
+    slots: [CacheAligned<T>; RTE_MAX_LCORE as usize],
+}
+
+impl<T: Default> Default for PerLcore<T> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<T: Default> PerLcore<T> {
+    pub fn new() -> Self {
+        let mut slots: [MaybeUninit<CacheAligned<T>>; RTE_MAX_LCORE as usize] =
+            unsafe { MaybeUninit::uninit().assume_init() };
+
+        for slot in slots.iter_mut() {
+            *slot = MaybeUninit::new(CacheAligned::default());
+        }
+
+        PerLcore {
+            slots: unsafe { (&slots as *const _ as *const [CacheAligned<T>; RTE_MAX_LCORE as usize]).read() },
+        }
+    }
+}
+
+impl<T> PerLcore<T> {
+    /// The slot of the lcore.
+    #[inline(always)]
+    pub fn get(&self, lcore_id: lcore::Id) -> &T {
+        &self.slots[lcore_id.index()]
+    }
+
+    /// The slot of current lcore.
+    ///
+    /// # Panics
+    ///
+    /// Panics if not called from an EAL thread.
+    #[inline]
+    pub fn local(&self) -> &T {
+        self.get(lcore::current().expect("not an EAL thread"))
+    }
+
+    /// Iterate the slots of all the lcores.
+    pub fn iter(&self) -> Iter<'_, T> {
+        Iter(self.slots.iter())
+    }
+
+    /// Aggregate a value from the slots of all the lcores.
+    pub fn sum<F: Fn(&T) -> u64>(&self, f: F) -> u64 {
+        self.iter().map(f).sum()
+    }
+}
+
+impl<'a, T> IntoIterator for &'a PerLcore<T> {
+    type Item = &'a T;
+    type IntoIter = Iter<'a, T>;
+
+    fn into_iter(self) -> Self::IntoIter {
+        self.iter()
+    }
+}
+
+/// An iterator over the slots of a `PerLcore`.
+pub struct Iter<'a, T: 'a>(slice::Iter<'a, CacheAligned<T>>);
+
+impl<'a, T> Iterator for Iter<'a, T> {
+    type Item = &'a T;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        self.0.next().map(|slot| &slot.0)
+    }
+
+    fn size_hint(&self) -> (usize, Option<usize>) {
+        self.0.size_hint()
+    }
+}
+
+// The sub-buckets per power of two of `Histogram`, about 12.5% of precision.
+const HISTOGRAM_SUB_BITS: u32 = 3;
+
+const HISTOGRAM_SUB_BUCKETS: usize = 1 << HISTOGRAM_SUB_BITS;
+
+/// The number of buckets of `Histogram`, which covers all the `u64` values.
+pub const HISTOGRAM_BUCKETS: usize = (64 - HISTOGRAM_SUB_BITS as usize + 1) * HISTOGRAM_SUB_BUCKETS;
+
+/// A log-linear histogram with a single writer, e.g. of latencies in TSC cycles.
+///
+/// Each power of two is split into 8 buckets, so recording a value is a plain increment of a counter.
+pub struct Histogram {
+    buckets: [Counter; HISTOGRAM_BUCKETS],
+}
+
+impl Default for Histogram {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Histogram {
+    pub fn new() -> Self {
+        // the atomic counters are all zeros
+        unsafe { mem::zeroed() }
+    }
+
+    /// Record a value.
+    ///
+    /// Only the lcore owning the histogram may call it, see `Counter::add`.
+    #[inline(always)]
+    pub fn record(&self, value: u64) {
+        self.buckets[Self::bucket_of(value)].incr()
+    }
+
+    /// Reset the histogram.
+    pub fn reset(&self) {
+        for bucket in self.buckets.iter() {
+            bucket.reset()
+        }
+    }
+
+    /// Take a snapshot of the counters.
+    pub fn snapshot(&self) -> HistogramSnapshot {
+        HistogramSnapshot {
+            buckets: self.buckets.iter().map(Counter::get).collect(),
+        }
+    }
+
+    #[inline(always)]
+    fn bucket_of(value: u64) -> usize {
+        if value < HISTOGRAM_SUB_BUCKETS as u64 {
+            value as usize
+        } else {
+            let msb = 63 - value.leading_zeros();
+            let sub = (value >> (msb - HISTOGRAM_SUB_BITS)) as usize & (HISTOGRAM_SUB_BUCKETS - 1);
+
+            (msb - HISTOGRAM_SUB_BITS + 1) as usize * HISTOGRAM_SUB_BUCKETS + sub
+        }
+    }
+
+    // the range of values in a bucket
+    fn range_of(bucket: usize) -> (u64, u64) {
+        if bucket < HISTOGRAM_SUB_BUCKETS {
+            (bucket as u64, bucket as u64)
+        } else {
+            let shift = (bucket / HISTOGRAM_SUB_BUCKETS - 1) as u32;
+            let low = ((HISTOGRAM_SUB_BUCKETS + bucket % HISTOGRAM_SUB_BUCKETS) as u64) << shift;
+
+            (low, low + ((1 << shift) - 1))
+        }
+    }
+}
+
+/// The counters of `Histogram` read at a time, which could be merged from the histograms of lcores.
+#[derive(Clone, Debug)]
+pub struct HistogramSnapshot {
+    buckets: Vec<u64>,
+}
+
+impl Default for HistogramSnapshot {
+    fn default() -> Self {
+        HistogramSnapshot {
+            buckets: vec![0; HISTOGRAM_BUCKETS],
+        }
+    }
+}
+
+impl HistogramSnapshot {
+    /// Add the counters of another snapshot.
+    pub fn merge(&mut self, other: &HistogramSnapshot) {
+        for (sum, n) in self.buckets.iter_mut().zip(other.buckets.iter()) {
+            *sum += n;
+        }
+    }
+
+    /// The number of recorded values.
+    pub fn count(&self) -> u64 {
+        self.buckets.iter().sum()
+    }
+
+    /// The value at the quantile `q` in `[0, 1]`, e.g. 0.99 for p99, or `None` if there isn't any value.
+    ///
+    /// The value is the middle of its bucket.
+    pub fn quantile(&self, q: f64) -> Option<u64> {
+        let count = self.count();
+
+        if count == 0 {
+            return None;
+        }
+
+        let rank = ((count as f64 * q).ceil() as u64).max(1).min(count);
+        let mut seen = 0;
+
+        for (bucket, &n) in self.buckets.iter().enumerate() {
+            seen += n;
+
+            if seen >= rank {
+                let (low, high) = Histogram::range_of(bucket);
+
+                return Some(low + (high - low) / 2);
+            }
+        }
+
+        None
+    }
+}
@@ -0,0 +1,100 @@
+use std::ops::Deref;
+
+use ffi;
+
+use mbuf::{Header, HeaderRef, MBuf};
+
+/// TCP Header
+pub type TcpHdr = ffi::tcp_hdr;
+
+unsafe impl Header for TcpHdr {}
+
+bitflags! {
+    /// The control flags of TCP header.
+    pub struct TcpFlags: u8 {
+        const FIN = 0x01;
+        const SYN = 0x02;
+        const RST = 0x04;
+        const PSH = 0x08;
+        const ACK = 0x10;
+        const URG = 0x20;
+    }
+}
+
+/// A TCP header parsed in place from the packet data.
+pub struct TcpView<'a> {
+    off: usize,
+    hdr: HeaderRef<'a, TcpHdr>,
+}
+
+impl<'a> TcpView<'a> {
+    /// Parse the TCP header at an offset of the packet.
+    ///
+    /// It returns `None` if the data offset is shorter than the header.
+    #[inline]
+    pub fn parse(m: &'a MBuf, off: usize) -> Option<Self> {
+        let hdr = m.header::<TcpHdr>(off)?;
+
+        if usize::from(hdr.data_off >> 4) >= 5 {
+            Some(TcpView { off, hdr })
+        } else {
+            None
+        }
+    }
+
+    /// The source port.
+    #[inline]
+    pub fn src_port(&self) -> u16 {
+        u16::from_be(self.hdr.src_port)
+    }
+
+    /// The destination port.
+    #[inline]
+    pub fn dst_port(&self) -> u16 {
+        u16::from_be(self.hdr.dst_port)
+    }
+
+    /// The sequence number.
+    #[inline]
+    pub fn seq(&self) -> u32 {
+        u32::from_be(self.hdr.sent_seq)
+    }
+
+    /// The acknowledgment number.
+    #[inline]
+    pub fn ack(&self) -> u32 {
+        u32::from_be(self.hdr.recv_ack)
+    }
+
+    /// The length of header with the options.
+    #[inline]
+    pub fn header_len(&self) -> usize {
+        usize::from(self.hdr.data_off >> 4) * 4
+    }
+
+    /// The control flags.
+    #[inline]
+    pub fn flags(&self) -> TcpFlags {
+        TcpFlags::from_bits_truncate(self.hdr.tcp_flags)
+    }
+
+    /// The receive window.
+    #[inline]
+    pub fn window(&self) -> u16 {
+        u16::from_be(self.hdr.rx_win)
+    }
+
+    /// The offset of the payload in the packet.
+    #[inline]
+    pub fn payload_offset(&self) -> usize {
+        self.off + self.header_len()
+    }
+}
+
+impl<'a> Deref for TcpView<'a> {
+    type Target = TcpHdr;
+
+    fn deref(&self) -> &Self::Target {
+        &self.hdr
+    }
+}
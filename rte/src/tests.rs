@@ -1,7 +1,13 @@
 extern crate num_cpus;
 extern crate pretty_env_logger;
 
+use std::alloc::{GlobalAlloc, Layout};
+use std::env;
+use std::fs;
+use std::mem;
+use std::net::Ipv4Addr;
 use std::os::raw::c_void;
+use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, Mutex};
 
 use cfile;
@@ -9,14 +15,30 @@ use log::Level::Debug;
 
 use ffi;
 
+use capture::Sink;
 use common::memory::SOCKET_ID_ANY;
+use cpuflags::{self, CpuVariant};
+use distributor::{Algorithm, Distributor, Worker, WorkerBurst};
 use eal::{self, ProcType};
+use ether;
+use flow::{Action, Ipv4Spec, Item, Rule, TcpSpec};
+use graph::{Batch, Graph, Mode};
+use hash::{FlowTable, HashFlags, Ipv4FiveTuple};
+use ip;
+use ip_frag;
 use launch;
 use lcore;
-use mbuf;
-use memory::AsMutRef;
+use malloc::{self, RteAllocator};
+use mbuf::{self, MBufPool};
+use memory::{self, AsMutRef};
 use mempool::{self, MemoryPool, MemoryPoolFlags};
-use utils::AsRaw;
+use memzone::{self, Arena};
+use rcu::{Qsbr, Rcu};
+use ring::{self, RingFlags};
+use timer::TimerWheel;
+use udp;
+use utils::{AsRaw, FromRaw, IntoRaw};
+use zerocopy::{ExtMem, ZeroCopyTx};
 
 #[test]
 fn test_eal() {
@@ -43,11 +65,31 @@ fn test_eal() {
 
     test_lcore();
 
+    test_cpuflags();
+
     test_launch();
 
     test_mempool();
 
     test_mbuf();
+
+    test_mbuf_batch();
+
+    test_ip_frag();
+
+    test_capture();
+
+    test_malloc();
+
+    test_zerocopy();
+
+    test_ring();
+
+    test_distributor();
+
+    test_graph_plan();
+
+    test_hash();
 }
 
 fn test_config() {
@@ -89,6 +131,27 @@ fn test_lcore() {
     assert_eq!(lcore::id(0).index(), 0);
 }
 
+fn test_cpuflags() {
+    // SSE2 is the baseline of x86_64
+    assert!(cpuflags::enabled(cpuflags::RTE_CPUFLAG_SSE2));
+    assert_eq!(cpuflags::name(cpuflags::RTE_CPUFLAG_SSE2), Some("SSE2"));
+
+    let variant = cpuflags::cpu_variant();
+
+    assert_eq!(cpuflags::cpu_variant(), variant);
+
+    if variant >= CpuVariant::Avx2 {
+        assert!(cpuflags::enabled(cpuflags::RTE_CPUFLAG_AVX2));
+    }
+
+    let src = (0..1000).map(|i| i as u8).collect::<Vec<_>>();
+    let mut dst = vec![0u8; src.len()];
+
+    unsafe { memory::memcpy(dst.as_mut_ptr() as *mut _, src.as_ptr() as *const _, src.len()) };
+
+    assert_eq!(dst, src);
+}
+
 fn test_launch() {
     fn slave_main(mutex: Option<Arc<Mutex<usize>>>) -> i32 {
         debug!("lcore {} is running", lcore::current().unwrap());
@@ -251,4 +314,812 @@ fn test_mbuf() {
     assert!(!p.is_empty());
 
     p.audit();
+
+    let mut cache = p.local_cache();
+
+    assert!(cache.is_cached());
+
+    let mbufs: [mbuf::MBuf; 4] = cache.get_array().unwrap();
+
+    assert_eq!(p.avail_count(), NB_MBUF as usize - 4);
+
+    cache.put_array(mbufs);
+    cache.flush();
+
+    assert_eq!(p.avail_count(), NB_MBUF as usize);
+
+    let mut p = p;
+
+    // the ownership of mbuf is passed through the raw pointer, it is freed only once
+    let raw = p.alloc().unwrap().into_raw();
+
+    assert_eq!(p.avail_count(), NB_MBUF as usize - 1);
+
+    drop(mbuf::MBuf::from_raw(raw).unwrap());
+
+    assert_eq!(p.avail_count(), NB_MBUF as usize);
+
+    let mut m = p.alloc().unwrap();
+
+    m.set_header_lens(14, 20, 20);
+
+    assert_eq!((m.l2_len(), m.l3_len(), m.l4_len(), m.tso_segsz()), (14, 20, 20, 0));
+
+    m.set_packet_type(mbuf::PacketType(
+        ffi::RTE_PTYPE_L2_ETHER | ffi::RTE_PTYPE_L3_IPV4 | ffi::RTE_PTYPE_L4_TCP,
+    ));
+    m.append(64).unwrap();
+
+    assert!(m.packet_type().is_ipv4() && m.packet_type().is_tcp());
+    assert!(m.set_tx_cksum_from_ptype());
+    assert!(m.offload().contains(
+        mbuf::OffloadFlags::PKT_TX_IPV4 | mbuf::OffloadFlags::PKT_TX_IP_CKSUM | mbuf::OffloadFlags::PKT_TX_TCP_CKSUM
+    ));
+    assert_eq!(m.rx_ip_cksum(), mbuf::CksumStatus::Unknown);
+
+    // the L3 type and the checksum requests are replaced, instead of mixed with the new ones
+    let (ipv4, ipv6, ip_cksum) = (
+        mbuf::OffloadFlags::PKT_TX_IPV4,
+        mbuf::OffloadFlags::PKT_TX_IPV6,
+        mbuf::OffloadFlags::PKT_TX_IP_CKSUM,
+    );
+    let l4 = |m: &mbuf::MBuf| m.offload() & mbuf::OffloadFlags::PKT_TX_L4_MASK;
+
+    m.set_tx_cksum(14, 40, false, mbuf::L4Cksum::Udp);
+
+    assert!(m.offload().contains(ipv6) && !m.offload().intersects(ipv4 | ip_cksum));
+    assert_eq!(l4(&m), mbuf::OffloadFlags::PKT_TX_UDP_CKSUM);
+    assert!(m.set_tx_cksum_from_ptype());
+    assert!(m.offload().contains(ipv4 | ip_cksum) && !m.offload().contains(ipv6));
+    assert_eq!(l4(&m), mbuf::OffloadFlags::PKT_TX_TCP_CKSUM);
+
+    m.header_mut::<ether::EtherHdr>(0).unwrap().ether_type = ether::ETHER_TYPE_IPV4_BE;
+    *m.header_mut::<ip::Ipv4Hdr>(14).unwrap() = ip::Ipv4Hdr {
+        version_ihl: 0x45,
+        total_length: 50u16.to_be(),
+        time_to_live: 64,
+        next_proto_id: libc::IPPROTO_UDP as u8,
+        dst_addr: u32::from(Ipv4Addr::new(198, 18, 0, 1)).to_be(),
+        ..Default::default()
+    };
+    m.header_mut::<udp::UdpHdr>(34).unwrap().dst_port = 53u16.to_be();
+
+    assert!(m.header_mut::<udp::UdpHdr>(60).is_none());
+
+    {
+        let eth = ether::EthernetView::parse(&m).unwrap();
+
+        assert!(eth.vlan().is_none());
+        assert_eq!(eth.l3(), Some((ether::ETHER_TYPE_IPv4 as u16, 14)));
+
+        let ipv4 = eth.ipv4().unwrap();
+
+        assert_eq!(ipv4.dst(), Ipv4Addr::new(198, 18, 0, 1));
+        assert_eq!((ipv4.header_len(), ipv4.total_len(), ipv4.ttl()), (20, 50, 64));
+        assert!(!ipv4.is_fragment() && ipv4.tcp().is_none());
+        assert_eq!(ipv4.udp().unwrap().dst_port(), 53);
+        assert!(eth.ipv6().is_none());
+    }
+
+    assert!(m.header::<ip::Ipv4Hdr>(usize::MAX - 2).is_none());
+    assert!(m.header_mut::<ip::Ipv4Hdr>(usize::MAX - 2).is_none());
+
+    // the total length past the end of packet, and the header length shorter than the header
+    m.header_mut::<ip::Ipv4Hdr>(14).unwrap().total_length = 51u16.to_be();
+
+    assert!(ip::Ipv4View::parse(&m, 14).is_none());
+
+    *m.header_mut::<ip::Ipv4Hdr>(14).unwrap() = ip::Ipv4Hdr {
+        version_ihl: 0x44,
+        total_length: 50u16.to_be(),
+        ..Default::default()
+    };
+
+    assert!(ip::Ipv4View::parse(&m, 14).is_none());
+
+    drop(m);
+
+    assert_eq!(p.avail_count(), NB_MBUF as usize);
+}
+
+fn test_mbuf_batch() {
+    const NB_MBUF: u32 = 64;
+    const BATCH_SIZE: usize = 32;
+
+    let mut p = mbuf::pool_create(
+        "mbuf_batch_pool",
+        NB_MBUF,
+        0,
+        0,
+        mbuf::RTE_MBUF_DEFAULT_BUF_SIZE as u16,
+        lcore::socket_id() as i32,
+    )
+    .unwrap();
+
+    let mut batch = mbuf::MBufBatch::<BATCH_SIZE>::new();
+
+    assert!(batch.is_empty());
+    assert_eq!(batch.capacity(), BATCH_SIZE);
+
+    while !batch.is_full() {
+        batch.push(p.alloc().unwrap()).unwrap();
+    }
+
+    assert_eq!(batch.len(), BATCH_SIZE);
+    assert_eq!(p.in_use_count(), BATCH_SIZE);
+
+    assert!(batch.push(p.alloc().unwrap()).is_err());
+    assert_eq!(p.in_use_count(), BATCH_SIZE);
+
+    batch.truncate(16);
+
+    assert_eq!(batch.len(), 16);
+    assert_eq!(p.in_use_count(), 16);
+
+    let mut n = 0;
+
+    batch.retain(|_| {
+        n += 1;
+        n % 2 == 0
+    });
+
+    assert_eq!(batch.len(), 8);
+    assert_eq!(p.in_use_count(), 8);
+
+    let mbufs = batch.drain().take(4).collect::<Vec<_>>();
+
+    assert!(batch.is_empty());
+    assert_eq!(p.in_use_count(), 4);
+
+    mbuf::free_bulk(mbufs);
+
+    assert_eq!(p.in_use_count(), 0);
+
+    while !batch.is_full() {
+        batch.push(p.alloc().unwrap()).unwrap();
+    }
+
+    drop(batch);
+
+    assert_eq!(p.in_use_count(), 0);
+    assert!(p.is_full());
+
+    // a leaked drain leaks the mbufs left, rather than freeing them twice
+    let mut batch = mbuf::MBufBatch::<BATCH_SIZE>::new();
+
+    batch.push(p.alloc().unwrap()).unwrap();
+    batch.push(p.alloc().unwrap()).unwrap();
+
+    {
+        let mut drain = batch.drain();
+        let m = drain.next().unwrap();
+
+        mem::forget(drain);
+        drop(m);
+    }
+
+    assert!(batch.is_empty());
+    assert_eq!(p.in_use_count(), 1);
+}
+
+fn test_ip_frag() {
+    const PKT_LEN: usize = 1000;
+    const MTU: u16 = 500;
+
+    let mut direct_pool = mbuf::pool_create(
+        "frag_direct_pool",
+        64,
+        0,
+        0,
+        mbuf::RTE_MBUF_DEFAULT_BUF_SIZE as u16,
+        lcore::socket_id() as i32,
+    )
+    .unwrap();
+    let indirect_pool = mbuf::pool_create("frag_indirect_pool", 64, 0, 0, 0, lcore::socket_id() as i32).unwrap();
+
+    let mut m = direct_pool.alloc().unwrap();
+
+    m.append(PKT_LEN).unwrap();
+    *m.header_mut::<ip::Ipv4Hdr>(0).unwrap() = ip::Ipv4Hdr {
+        version_ihl: 0x45,
+        total_length: (PKT_LEN as u16).to_be(),
+        packet_id: 1234u16.to_be(),
+        time_to_live: 64,
+        next_proto_id: libc::IPPROTO_UDP as u8,
+        dst_addr: u32::from(Ipv4Addr::new(198, 18, 0, 1)).to_be(),
+        ..Default::default()
+    };
+
+    let mut frags = mbuf::MBufBatch::<8>::new();
+
+    assert_eq!(
+        ip_frag::fragment_ipv4(&m, &mut frags, MTU, &direct_pool, &indirect_pool).unwrap(),
+        3
+    );
+
+    drop(m);
+
+    for m in frags.iter_mut() {
+        assert!(m.pkt_len() <= MTU as usize);
+
+        m.prepend(14).unwrap();
+        m.header_mut::<ether::EtherHdr>(0).unwrap().ether_type = ether::ETHER_TYPE_IPV4_BE;
+
+        assert!(m.parse_packet_type().is_fragment());
+        assert_eq!((m.l2_len(), m.l3_len()), (14, 20));
+    }
+
+    let mut tbl = ip_frag::FragTable::create(16, 4, 64, ::get_tsc_hz(), lcore::socket_id() as i32).unwrap();
+    let mut dr = ip_frag::DeathRow::new();
+
+    assert_eq!(tbl.reassemble_burst(&mut dr, &mut frags, ::rdtsc()), 1);
+
+    dr.free(0);
+
+    assert_eq!(frags[0].pkt_len(), 14 + PKT_LEN);
+
+    let ipv4 = ip::Ipv4View::parse(&frags[0], 14).unwrap();
+
+    assert!(!ipv4.is_fragment());
+    assert_eq!(ipv4.total_len(), PKT_LEN);
+
+    drop(frags);
+    drop(tbl);
+
+    assert!(direct_pool.is_full());
+    assert!(indirect_pool.is_full());
+}
+
+fn test_capture() {
+    const PKT_LEN: usize = 60;
+
+    let mut p = mbuf::pool_create(
+        "capture_pool",
+        16,
+        0,
+        0,
+        mbuf::RTE_MBUF_DEFAULT_BUF_SIZE as u16,
+        lcore::socket_id() as i32,
+    )
+    .unwrap();
+    let clone_pool = mbuf::pool_create("capture_clone_pool", 16, 0, 0, 0, lcore::socket_id() as i32).unwrap();
+    let path = env::temp_dir().join("rte_test_capture.pcapng");
+
+    let mut m = p.alloc().unwrap();
+
+    m.append(PKT_LEN).unwrap();
+
+    {
+        let mut sink = Sink::create("capture_ring", 16, lcore::socket_id() as i32, &path).unwrap();
+        let mut tap = sink.tap(MemoryPool::from(clone_pool.as_raw()), None);
+
+        assert_eq!(tap.capture(&[m]), 1);
+        assert_eq!(tap.stats().captured.get(), 1);
+        assert_eq!(sink.poll().unwrap(), 1);
+    }
+
+    let data = fs::read(&path).unwrap();
+
+    // section header, interface description and enhanced packet blocks
+    assert_eq!(data.len(), 28 + 32 + 32 + PKT_LEN);
+    assert_eq!(&data[..4], &[0x0a, 0x0d, 0x0d, 0x0a]);
+
+    // the clones not written yet are freed with the sink
+    {
+        let sink = Sink::create("capture_ring_left", 16, lcore::socket_id() as i32, &path).unwrap();
+        let mut tap = sink.tap(MemoryPool::from(clone_pool.as_raw()), None);
+        let mut m = p.alloc().unwrap();
+
+        m.append(PKT_LEN).unwrap();
+
+        assert_eq!(tap.capture(&[m]), 1);
+    }
+
+    assert!(clone_pool.is_full());
+
+    fs::remove_file(&path).unwrap();
+}
+
+fn test_malloc() {
+    let alloc = RteAllocator::on_socket(lcore::socket_id() as i32);
+
+    unsafe {
+        let layout = Layout::from_size_align(100, 64).unwrap();
+        let p = alloc.alloc_zeroed(layout);
+
+        assert!(!p.is_null());
+        assert_eq!(p as usize % 64, 0);
+        assert!(malloc::is_rte_memory(p as *const _));
+        assert_eq!(*p, 0);
+
+        let p = alloc.realloc(p, layout, 200);
+
+        assert!(!p.is_null());
+
+        alloc.dealloc(p, Layout::from_size_align(200, 64).unwrap());
+    }
+
+    let mut arena = Arena::reserve("test_arena", 4096, SOCKET_ID_ANY).unwrap();
+
+    assert_eq!(arena.capacity(), 4096);
+    assert!(memzone::lookup("test_arena").is_some());
+
+    assert_eq!(*arena.alloc_value(1u8).unwrap(), 1);
+    assert_eq!(arena.alloc_slice(4, 2u32).unwrap(), &[2, 2, 2, 2]);
+    assert_eq!(arena.used(), 4 + 16);
+    assert!(arena.alloc_slice_copy(&[0u8; 4096]).is_none());
+
+    arena.reset();
+
+    assert_eq!(arena.used(), 0);
+    assert!(arena.alloc_slice_copy(&[0u8; 4096]).is_some());
+
+    drop(arena);
+
+    assert!(memzone::lookup("test_arena").is_none());
+}
+
+fn test_zerocopy() {
+    const LEN: usize = 10000;
+
+    let path = env::temp_dir().join("rte_test_zerocopy");
+
+    fs::write(&path, &[0x5a; LEN][..]).unwrap();
+
+    let file = fs::File::open(&path).unwrap();
+
+    // the pages past the end of file could not be mapped
+    assert!(ExtMem::map_file(&file, LEN + 4096).is_err());
+
+    let mem = ExtMem::map_file(&file, LEN).unwrap();
+
+    assert_eq!(mem.as_slice()[LEN - 1], 0x5a);
+
+    let pool = mbuf::pool_create("zerocopy_pool", 16, 0, 0, 0, lcore::socket_id() as i32).unwrap();
+    let mut tx = ZeroCopyTx::new(mem, pool, 4096).unwrap();
+    let completed = Arc::new(AtomicBool::new(false));
+
+    assert!(tx.packet(LEN, 1).is_err());
+
+    {
+        let completed = completed.clone();
+        let m = tx
+            .packet_with(0, LEN, move || completed.store(true, Ordering::Relaxed))
+            .unwrap();
+
+        assert_eq!(m.pkt_len(), LEN);
+        assert_eq!(m.nb_segs, 3);
+        assert!(m.has_ext_buf());
+        assert_eq!(tx.in_flight(), 1);
+    }
+
+    assert!(completed.load(Ordering::Relaxed));
+    assert_eq!(tx.in_flight(), 0);
+
+    drop(tx);
+
+    fs::remove_file(&path).unwrap();
+}
+
+fn test_ring() {
+    let mut r = ring::SpscRing::<Box<usize>>::create("test_ring", 16, SOCKET_ID_ANY, RingFlags::empty()).unwrap();
+
+    assert_eq!(r.name(), "test_ring");
+    assert_eq!(r.size(), 16);
+    assert_eq!(r.capacity(), 15);
+    assert!(r.is_empty());
+    assert_eq!(
+        r.flags as u32,
+        (RingFlags::RING_F_SP_ENQ | RingFlags::RING_F_SC_DEQ).bits
+    );
+
+    assert!(r.enqueue(Box::new(0)).is_ok());
+    assert_eq!(r.dequeue(), Some(Box::new(0)));
+    assert_eq!(r.dequeue(), None);
+
+    let mut objs = (0..10).map(|i| Some(Box::new(i))).collect::<Vec<_>>();
+
+    assert_eq!(r.enqueue_bulk(&mut objs[..8]), 8);
+    assert!(objs[..8].iter().all(Option::is_none));
+    assert_eq!(r.count(), 8);
+
+    // not enough room for the whole bulk
+    let mut more = (10..18).map(|i| Some(Box::new(i))).collect::<Vec<_>>();
+
+    assert_eq!(r.enqueue_bulk(&mut more), 0);
+    assert!(more.iter().all(Option::is_some));
+
+    assert_eq!(r.enqueue_burst(&mut more), 7);
+    assert!(r.is_full());
+    assert_eq!(more[7], Some(Box::new(17)));
+
+    // zero-copy peek at the head of ring
+    {
+        let peek = r.peek(4);
+
+        assert_eq!(peek.len(), 4);
+        assert_eq!(peek.iter().map(|obj| **obj).collect::<Vec<_>>(), vec![0, 1, 2, 3]);
+
+        let mut consumed = vec![];
+
+        peek.consume(2, |obj| consumed.push(*obj));
+
+        assert_eq!(consumed, vec![0, 1]);
+    }
+
+    assert_eq!(r.count(), 13);
+
+    let mut objs = (0..16).map(|_| None).collect::<Vec<Option<Box<usize>>>>();
+
+    assert_eq!(r.dequeue_bulk(&mut objs[..14]), 0);
+    assert_eq!(r.dequeue_burst(&mut objs), 13);
+    assert_eq!(
+        objs[..13].iter().map(|obj| **obj.as_ref().unwrap()).collect::<Vec<_>>(),
+        vec![2, 3, 4, 5, 6, 7, 10, 11, 12, 13, 14, 15, 16]
+    );
+    assert!(r.is_empty());
+
+    // an empty slot stops the enqueued objects
+    let mut holes = vec![Some(Box::new(20)), None, Some(Box::new(21))];
+
+    assert_eq!(r.enqueue_burst(&mut holes), 1);
+    assert_eq!(holes[2], Some(Box::new(21)));
+    assert_eq!(r.dequeue(), Some(Box::new(20)));
+    assert!(r.is_empty());
+
+    assert_eq!(
+        unsafe { ring::SpscRing::<Box<usize>>::lookup("test_ring") }
+            .unwrap()
+            .as_raw(),
+        r.as_raw()
+    );
+
+    // move the sides to the producer and consumer
+    let (tx, rx) = r.split();
+
+    assert!(tx.enqueue(Box::new(1)).is_ok());
+    assert_eq!(rx.count(), 1);
+    assert_eq!(rx.dequeue(), Some(Box::new(1)));
+
+    let r = ring::SpscRing::join(tx, rx);
+
+    r.free();
+}
+
+fn test_graph_plan() {
+    let graph = Graph::new(Mode::Pipeline)
+        .stage("rx", 1, Some(0), |_| |_: &mut Batch| {})
+        .stage("worker", 2, None, |_| |_: &mut Batch| {});
+
+    let assignments = graph.plan().unwrap();
+
+    assert_eq!(
+        assignments
+            .iter()
+            .map(|a| (a.stage.as_str(), a.stage_idx, a.instance, a.socket_id))
+            .collect::<Vec<_>>(),
+        vec![("rx", 0, 0, 0), ("worker", 1, 0, 0), ("worker", 1, 1, 0)]
+    );
+
+    let mut lcores = assignments.iter().map(|a| *a.lcore_id).collect::<Vec<_>>();
+
+    lcores.sort();
+    lcores.dedup();
+    assert_eq!(lcores.len(), 3);
+    assert!(lcores.iter().all(|&lcore_id| lcore_id != 0));
+
+    let graph = Graph::new(Mode::RunToCompletion)
+        .stage("rx", 2, None, |_| |_: &mut Batch| {})
+        .stage("tx", 1, None, |_| |_: &mut Batch| {});
+
+    let assignments = graph.plan().unwrap();
+
+    assert_eq!(
+        assignments
+            .iter()
+            .map(|a| (a.stage.as_str(), a.stage_idx, a.instance))
+            .collect::<Vec<_>>(),
+        vec![("rx->tx", 0, 0), ("rx->tx", 0, 1)]
+    );
+
+    // the slave lcores are not enough
+    assert!(Graph::new(Mode::Pipeline)
+        .stage("rx", 2, None, |_| |_: &mut Batch| {})
+        .stage("tx", 2, None, |_| |_: &mut Batch| {})
+        .plan()
+        .is_err());
+}
+
+fn test_distributor() {
+    const NB_PKTS: usize = 32;
+
+    // the worker echoes the packets back, and quits after all of them are handled
+    fn worker_main(arg: Option<(Worker, usize)>) -> i32 {
+        let (mut worker, nb_pkts) = arg.unwrap();
+        let mut pkts = WorkerBurst::new();
+        let mut done = WorkerBurst::new();
+        let mut handled = 0;
+
+        while handled < nb_pkts {
+            handled += worker.get_pkts(&mut pkts, &mut done);
+
+            for m in pkts.drain() {
+                done.push(m).unwrap();
+            }
+        }
+
+        worker.return_pkts(&mut done).unwrap();
+
+        handled as i32
+    }
+
+    let mut p = mbuf::pool_create(
+        "dist_pool",
+        64,
+        0,
+        0,
+        mbuf::RTE_MBUF_DEFAULT_BUF_SIZE as u16,
+        lcore::socket_id() as i32,
+    )
+    .unwrap();
+
+    let (mut d, mut workers) =
+        Distributor::create("test_dist", lcore::socket_id() as i32, 1, Algorithm::Burst).unwrap();
+    let worker = workers.pop().unwrap();
+    let slave_id = lcore::id(1);
+
+    assert_eq!(worker.id(), 0);
+
+    launch::remote_launch(worker_main, Some((worker, NB_PKTS)), slave_id).unwrap();
+
+    let mut pkts = mbuf::MBufBatch::<NB_PKTS>::new();
+    let mut returned = mbuf::MBufBatch::<NB_PKTS>::new();
+
+    for i in 0..NB_PKTS {
+        let mut m = p.alloc().unwrap();
+
+        m.set_tag(i as u32 % 4);
+
+        pkts.push(m).unwrap();
+    }
+
+    while returned.len() < NB_PKTS {
+        d.process(&mut pkts);
+        d.returned_pkts(&mut returned);
+    }
+
+    assert!(pkts.is_empty());
+    assert_eq!(slave_id.wait(), launch::JobState::Finished(NB_PKTS as i32));
+    assert_eq!(p.in_use_count(), NB_PKTS);
+
+    drop(returned);
+
+    assert_eq!(p.in_use_count(), 0);
+}
+
+fn test_hash() {
+    let mut t = FlowTable::<Ipv4FiveTuple, String>::create("test_hash", 64, SOCKET_ID_ANY, HashFlags::empty()).unwrap();
+
+    let keys = (0..8)
+        .map(|i| Ipv4FiveTuple::new(0x0a00_0001, 0x0a00_0002 + i, 1024, 80, 6))
+        .collect::<Vec<_>>();
+
+    for (i, key) in keys.iter().enumerate().take(4) {
+        assert_eq!(t.insert(*key, i.to_string()).unwrap(), None);
+    }
+
+    assert_eq!(t.len(), 4);
+    assert_eq!(
+        t.insert(keys[0], String::from("first")).unwrap(),
+        Some(String::from("0"))
+    );
+    assert_eq!(t.lookup(&keys[0]).map(String::as_str), Some("first"));
+    assert_eq!(
+        t.lookup_with_hash(&keys[1], t.hash(&keys[1])).map(String::as_str),
+        Some("1")
+    );
+    assert_eq!(t.lookup(&keys[4]), None);
+
+    {
+        let mut values = vec![None; keys.len()];
+
+        assert_eq!(t.lookup_bulk(&keys, &mut values), 4);
+        assert!(values[..4].iter().all(Option::is_some));
+        assert!(values[4..].iter().all(Option::is_none));
+
+        let sigs = keys.iter().map(|key| t.hash(key)).collect::<Vec<_>>();
+        let mut values = vec![None; keys.len()];
+
+        assert_eq!(t.lookup_bulk_with_hash(&keys, &sigs, &mut values), 4);
+        assert_eq!(values[3].map(String::as_str), Some("3"));
+    }
+
+    assert_eq!(t.remove(&keys[2]), Some(String::from("2")));
+    assert_eq!(t.remove(&keys[2]), None);
+    assert_eq!(t.iter().count(), 3);
+
+    // the slot of a retired key isn't reused by clear
+    let retired = unsafe { t.remove_shared(&keys[3]) }.unwrap();
+
+    assert!(t.clear().is_err());
+    assert_eq!(unsafe { t.reclaim(retired) }, "3");
+
+    t.clear().unwrap();
+
+    assert!(t.is_empty());
+}
+
+#[test]
+fn test_eal_builder() {
+    let builder = eal::Builder::new("test")
+        .lcores("0-3")
+        .memory_channels(4)
+        .socket_mem(&[512, 256])
+        .socket_limit(&[1024, 1024])
+        .in_memory()
+        .file_prefix("standby")
+        .proc_type(ProcType::Auto)
+        .vdev("net_null0")
+        .args(vec!["--no-telemetry"]);
+
+    assert_eq!(
+        builder.build(),
+        [
+            "test",
+            "-l0-3",
+            "-n4",
+            "--socket-mem=512,256",
+            "--socket-limit=1024,1024",
+            "--in-memory",
+            "--file-prefix=standby",
+            "--proc-type=auto",
+            "--vdev=net_null0",
+            "--no-telemetry",
+        ]
+    );
+}
+
+#[test]
+fn test_timer_wheel() {
+    const TICK: u64 = 1000;
+
+    let mut wheel = TimerWheel::new(TICK, 0);
+    let mut expired = Vec::new();
+
+    let near = wheel.add(10 * TICK, 1);
+    let far = wheel.add(100_000 * TICK, 2);
+    let cancelled = wheel.add(20 * TICK, 3);
+    let postponed = wheel.add(30 * TICK, 4);
+
+    assert_eq!(wheel.len(), 4);
+    assert_eq!(wheel.cancel(cancelled), Some(3));
+    assert_eq!(wheel.cancel(cancelled), None);
+    assert!(wheel.postpone(postponed, 5000 * TICK));
+
+    assert_eq!(wheel.advance(9 * TICK, |_, v| expired.push(v)), 0);
+    assert_eq!(wheel.advance(10 * TICK, |_, v| expired.push(v)), 1);
+    assert_eq!(expired, [1]);
+    assert!(wheel.get(near).is_none());
+
+    assert_eq!(wheel.advance(4999 * TICK, |_, v| expired.push(v)), 0);
+    assert_eq!(wheel.advance(5000 * TICK, |_, v| expired.push(v)), 1);
+    assert_eq!(expired, [1, 4]);
+
+    assert_eq!(wheel.get(far), Some(&2));
+    assert_eq!(wheel.advance(1_000_000 * TICK, |_, v| expired.push(v)), 1);
+    assert_eq!(expired, [1, 4, 2]);
+    assert!(wheel.is_empty());
+
+    // a deadline that never comes
+    let never = wheel.add(u64::max_value(), 6);
+
+    assert!(wheel.postpone(never, u64::max_value()));
+    assert_eq!(wheel.advance(2_000_000 * TICK, |_, v| expired.push(v)), 0);
+    assert_eq!(wheel.cancel(never), Some(6));
+}
+
+#[test]
+fn test_flow_pattern() {
+    let rule = Rule::ingress()
+        .pattern(Item::eth())
+        .pattern(
+            Ipv4Spec::default()
+                .src(Ipv4Addr::new(192, 0, 2, 1))
+                .dst(Ipv4Addr::new(192, 0, 2, 2))
+                .proto(libc::IPPROTO_TCP as u8),
+        )
+        .pattern(TcpSpec::default().dst_port(179))
+        .action(Action::Queue(1));
+
+    // the fields of one header are merged into one item, instead of the IPv4-in-IPv4 headers
+    let items = rule.items();
+
+    assert_eq!(items.len(), 3);
+    assert_eq!(items[0], Item::eth());
+
+    match items[1] {
+        Item::Ipv4(Some(spec)) => {
+            assert_eq!(
+                (
+                    spec.spec.hdr.src_addr,
+                    spec.spec.hdr.dst_addr,
+                    spec.spec.hdr.next_proto_id
+                ),
+                (
+                    u32::from(Ipv4Addr::new(192, 0, 2, 1)).to_be(),
+                    u32::from(Ipv4Addr::new(192, 0, 2, 2)).to_be(),
+                    libc::IPPROTO_TCP as u8
+                )
+            );
+            assert_eq!(
+                (
+                    spec.mask.hdr.src_addr,
+                    spec.mask.hdr.dst_addr,
+                    spec.mask.hdr.next_proto_id
+                ),
+                (0xffff_ffff, 0xffff_ffff, 0xff)
+            );
+            assert_eq!((spec.spec.hdr.time_to_live, spec.mask.hdr.time_to_live), (0, 0));
+        }
+        ref item => panic!("unexpected item {:?}", item),
+    }
+
+    match items[2] {
+        Item::Tcp(Some(spec)) => {
+            assert_eq!(
+                (spec.spec.hdr.dst_port, spec.mask.hdr.dst_port),
+                (179u16.to_be(), 0xffff)
+            );
+            assert_eq!((spec.spec.hdr.src_port, spec.mask.hdr.src_port), (0, 0));
+        }
+        ref item => panic!("unexpected item {:?}", item),
+    }
+
+    assert_eq!(Item::tcp_dst(179), items[2]);
+}
+
+#[test]
+fn test_rcu() {
+    let qsbr = Qsbr::new(2);
+    let table = Rcu::new(&qsbr, vec![1, 0]);
+
+    let mut reader = qsbr.register(1).unwrap();
+
+    assert!(qsbr.register(1).is_err());
+    assert!(qsbr.register(2).is_err());
+    assert_eq!(table.read(&reader), &[1, 0]);
+
+    // the old version is held until the reader is quiescent
+    let retired = table.swap(vec![0, 1]);
+    let retired = retired.try_reclaim().err().unwrap();
+
+    reader.quiescent();
+
+    assert_eq!(table.read(&reader), &[0, 1]);
+    assert_eq!(retired.try_reclaim().ok().unwrap(), [1, 0]);
+
+    reader.offline();
+
+    table.update(|ports| ports.iter().map(|p| p + 1).collect());
+
+    reader.online();
+
+    assert_eq!(table.read(&reader), &[1, 2]);
+
+    drop(reader);
+
+    assert_eq!(table.replace(vec![]), [1, 2]);
+}
+
+#[test]
+#[should_panic(expected = "offline or foreign reader")]
+fn test_rcu_offline_read() {
+    let qsbr = Qsbr::new(1);
+    let table = Rcu::new(&qsbr, 1);
+
+    let mut reader = qsbr.register(0).unwrap();
+
+    reader.offline();
+
+    table.read(&reader);
 }
@@ -0,0 +1,513 @@
+//!
+//! RTE Timer
+//!
+//! The `Timer` wraps `rte_timer`, which runs its callback on an lcore calling `manage`,
+//! it fits a few timers, e.g. the statistics refreshing.
+//!
+//! The `TimerWheel` is a hierarchical timing wheel for a huge number of timers, e.g. the flow expiry,
+//! which is owned by a lcore, and advanced once per poll iteration with `rdtsc()`.
+//! The timers are kept in a slab of entries, so adding and cancelling a timer never allocates
+//! once the capacity is reached, and the expired timers are handed out in batches.
+//!
+use std::cmp;
+use std::mem;
+use std::os::raw::c_void;
+use std::os::unix::io::AsRawFd;
+
+use cfile;
+use ffi;
+
+use errors::Result;
+use lcore;
+
+/// Initialize the timer library, after the EAL is initialized.
+pub fn subsystem_init() {
+    unsafe { ffi::rte_timer_subsystem_init() }
+}
+
+/// Run the callbacks of the expired timers of the current lcore.
+///
+/// It should be called periodically from the main loop of lcores owning the timers,
+/// the precision of timers depends on how often it is called.
+#[inline]
+pub fn manage() {
+    unsafe { ffi::rte_timer_manage() }
+}
+
+/// Dump the statistics of timers to a file.
+pub fn dump_stats<S: AsRawFd>(s: &S) -> Result<()> {
+    let mut f = cfile::fdopen(s, "w")?;
+
+    unsafe { ffi::rte_timer_dump_stats(&mut **f as *mut _ as *mut _) };
+
+    Ok(())
+}
+
+/// The type of timer.
+#[repr(u32)]
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum TimerType {
+    /// The timer runs once.
+    Single = ffi::rte_timer_type::SINGLE,
+    /// The timer is reloaded after it runs.
+    Periodical = ffi::rte_timer_type::PERIODICAL,
+}
+
+/// The callback of timer.
+pub type TimerFunc<T> = fn(&T);
+
+struct RawTimer<T> {
+    tim: ffi::rte_timer,
+    f: Option<TimerFunc<T>>,
+    arg: T,
+}
+
+unsafe extern "C" fn timer_stub<T>(_tim: *mut ffi::rte_timer, arg: *mut c_void) {
+    let timer = &*(arg as *const RawTimer<T>);
+
+    if let Some(f) = timer.f {
+        f(&timer.arg)
+    }
+}
+
+/// A timer with an argument passed to its callback.
+///
+/// The timer is boxed, because `rte_timer` is linked in the lists of lcores while it is pending.
+pub struct Timer<T>(Box<RawTimer<T>>);
+
+unsafe impl<T: Send + Sync> Send for Timer<T> {}
+
+impl<T> Drop for Timer<T> {
+    fn drop(&mut self) {
+        self.stop_sync()
+    }
+}
+
+impl<T> Timer<T> {
+    /// Create a stopped timer.
+    pub fn new(arg: T) -> Self {
+        let mut timer = Box::new(RawTimer {
+            tim: unsafe { mem::zeroed() },
+            f: None,
+            arg,
+        });
+
+        unsafe { ffi::rte_timer_init(&mut timer.tim) };
+
+        Timer(timer)
+    }
+
+    /// The argument of timer.
+    #[inline]
+    pub fn arg(&self) -> &T {
+        &self.0.arg
+    }
+
+    /// Start or restart the timer on the current lcore, it expires after `ticks` TSC cycles.
+    ///
+    /// It fails if the timer is running or being configured on another lcore.
+    pub fn reset(&mut self, ticks: u64, ty: TimerType, f: TimerFunc<T>) -> Result<()> {
+        let lcore_id = lcore::current().unwrap_or_else(lcore::Id::any);
+
+        unsafe { self.reset_raw(ticks, ty, lcore_id, f) }
+    }
+
+    /// Start or restart the timer on an lcore, it expires after `ticks` TSC cycles.
+    pub fn reset_on(&mut self, ticks: u64, ty: TimerType, lcore_id: lcore::Id, f: TimerFunc<T>) -> Result<()>
+    where
+        T: Send + Sync,
+    {
+        unsafe { self.reset_raw(ticks, ty, lcore_id, f) }
+    }
+
+    /// Start or restart the timer on an lcore, and wait until it isn't running or being configured.
+    pub fn reset_sync(&mut self, ticks: u64, ty: TimerType, lcore_id: lcore::Id, f: TimerFunc<T>)
+    where
+        T: Send + Sync,
+    {
+        let arg = &*self.0 as *const RawTimer<T> as *mut c_void;
+
+        self.0.f = Some(f);
+
+        unsafe { ffi::rte_timer_reset_sync(&mut self.0.tim, ticks, ty as u32, *lcore_id, Some(timer_stub::<T>), arg) }
+    }
+
+    unsafe fn reset_raw(&mut self, ticks: u64, ty: TimerType, lcore_id: lcore::Id, f: TimerFunc<T>) -> Result<()> {
+        let arg = &*self.0 as *const RawTimer<T> as *mut c_void;
+
+        self.0.f = Some(f);
+
+        let ret = ffi::rte_timer_reset(&mut self.0.tim, ticks, ty as u32, *lcore_id, Some(timer_stub::<T>), arg);
+
+        rte_check!(ret)
+    }
+
+    /// Stop the timer, it fails if the timer is running or being configured on another lcore.
+    pub fn stop(&mut self) -> Result<()> {
+        let ret = unsafe { ffi::rte_timer_stop(&mut self.0.tim) };
+
+        rte_check!(ret)
+    }
+
+    /// Stop the timer, and wait until it isn't running or being configured.
+    pub fn stop_sync(&mut self) {
+        unsafe { ffi::rte_timer_stop_sync(&mut self.0.tim) }
+    }
+
+    /// The timer is pending.
+    #[inline]
+    pub fn is_pending(&self) -> bool {
+        unsafe { ffi::rte_timer_pending(&self.0.tim as *const _ as *mut _) != 0 }
+    }
+}
+
+// The bits of slots per level.
+const LEVEL_BITS: u32 = 6;
+
+/// The number of slots per level.
+pub const SLOTS_PER_LEVEL: usize = 1 << LEVEL_BITS;
+
+/// The number of levels, which covers `2^36` ticks.
+pub const LEVELS: usize = 6;
+
+const SLOT_MASK: u64 = SLOTS_PER_LEVEL as u64 - 1;
+
+// The maximum number of ticks a timer could be placed ahead.
+const MAX_RANGE: u64 = 1 << (LEVEL_BITS as u64 * LEVELS as u64);
+
+const NIL: u32 = u32::max_value();
+
+/// The ID of a timer in the `TimerWheel`.
+#[derive(Clone, Copy, Debug, PartialEq, Eq, Hash)]
+pub struct TimerId {
+    index: u32,
+    gen: u32,
+}
+
+struct Entry<T> {
+    // the expiration in ticks
+    expires: u64,
+    prev: u32,
+    next: u32,
+    // the slot linking the entry, or NIL
+    slot: u32,
+    gen: u32,
+    value: Option<T>,
+}
+
+/// A hierarchical timing wheel.
+///
+/// Each level has 64 slots, a slot of level `n` spans `64^n` ticks,
+/// the timers are cascaded to the lower levels as the wheel advances.
+pub struct TimerWheel<T> {
+    // the TSC cycles per tick
+    tick_cycles: u64,
+    // the current tick
+    now: u64,
+    heads: [u32; SLOTS_PER_LEVEL * LEVELS],
+    // the non-empty slots of each level
+    occupied: [u64; LEVELS],
+    entries: Vec<Entry<T>>,
+    free: Vec<u32>,
+    len: usize,
+}
+
+impl<T> TimerWheel<T> {
+    /// Create a timer wheel with a tick of `tick_cycles` TSC cycles, starting from `now`.
+    pub fn new(tick_cycles: u64, now: u64) -> Self {
+        Self::with_capacity(tick_cycles, now, 0)
+    }
+
+    /// Create a timer wheel with the room of `capacity` timers.
+    pub fn with_capacity(tick_cycles: u64, now: u64, capacity: usize) -> Self {
+        assert!(tick_cycles > 0);
+
+        TimerWheel {
+            tick_cycles,
+            now: now / tick_cycles,
+            heads: [NIL; SLOTS_PER_LEVEL * LEVELS],
+            occupied: [0; LEVELS],
+            entries: Vec::with_capacity(capacity),
+            free: Vec::new(),
+            len: 0,
+        }
+    }
+
+    /// The number of pending timers.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// There isn't any pending timer.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// The TSC cycles per tick.
+    #[inline]
+    pub fn tick_cycles(&self) -> u64 {
+        self.tick_cycles
+    }
+
+    /// Add a timer expiring at `deadline` in TSC cycles, which is rounded up to the next tick.
+    pub fn add(&mut self, deadline: u64, value: T) -> TimerId {
+        let expires = self.ticks(deadline);
+        let index = match self.free.pop() {
+            Some(index) => {
+                let entry = &mut self.entries[index as usize];
+
+                entry.expires = expires;
+                entry.value = Some(value);
+
+                index
+            }
+            None => {
+                self.entries.push(Entry {
+                    expires,
+                    prev: NIL,
+                    next: NIL,
+                    slot: NIL,
+                    gen: 0,
+                    value: Some(value),
+                });
+
+                (self.entries.len() - 1) as u32
+            }
+        };
+
+        self.len += 1;
+        self.link(index);
+
+        TimerId {
+            index,
+            gen: self.entries[index as usize].gen,
+        }
+    }
+
+    /// Postpone a timer to `deadline` in TSC cycles, it returns `false` if the timer has gone.
+    ///
+    /// The timer stays in its slot, and is placed again when the slot is reached,
+    /// so refreshing a timer on each packet is cheap.
+    #[inline]
+    pub fn postpone(&mut self, id: TimerId, deadline: u64) -> bool {
+        let expires = self.ticks(deadline);
+
+        match self.entry_mut(id) {
+            Some(entry) => {
+                if expires > entry.expires {
+                    entry.expires = expires;
+                }
+
+                true
+            }
+            None => false,
+        }
+    }
+
+    /// Cancel a timer, and return its value.
+    pub fn cancel(&mut self, id: TimerId) -> Option<T> {
+        self.entry_mut(id)?;
+        self.unlink(id.index);
+
+        Some(self.release(id.index))
+    }
+
+    /// The value of a pending timer.
+    #[inline]
+    pub fn get(&self, id: TimerId) -> Option<&T> {
+        self.entries
+            .get(id.index as usize)
+            .filter(|entry| entry.gen == id.gen)
+            .and_then(|entry| entry.value.as_ref())
+    }
+
+    /// The value of a pending timer.
+    #[inline]
+    pub fn get_mut(&mut self, id: TimerId) -> Option<&mut T> {
+        self.entry_mut(id).and_then(|entry| entry.value.as_mut())
+    }
+
+    /// Advance the wheel to `now` in TSC cycles, and hand out the expired timers to `f`.
+    ///
+    /// It returns the number of timers expired.
+    #[inline]
+    pub fn advance<F: FnMut(TimerId, T)>(&mut self, now: u64, mut f: F) -> usize {
+        let target = now / self.tick_cycles;
+        let mut nb_expired = 0;
+
+        if target < self.now {
+            return 0;
+        }
+
+        while let Some((level, slot, tick)) = self.next_slot() {
+            if tick > target {
+                break;
+            }
+
+            self.now = tick.max(self.now);
+
+            let idx = level * SLOTS_PER_LEVEL + slot;
+            let mut index = mem::replace(&mut self.heads[idx], NIL);
+
+            self.occupied[level] &= !(1 << slot);
+
+            while index != NIL {
+                let (next, expires) = {
+                    let entry = &mut self.entries[index as usize];
+
+                    entry.slot = NIL;
+
+                    (mem::replace(&mut entry.next, NIL), entry.expires)
+                };
+
+                if expires <= self.now {
+                    let gen = self.entries[index as usize].gen;
+                    let value = self.release(index);
+
+                    f(TimerId { index, gen }, value);
+
+                    nb_expired += 1;
+                } else {
+                    self.link(index);
+                }
+
+                index = next;
+            }
+        }
+
+        self.now = target;
+
+        nb_expired
+    }
+
+    // round up the TSC cycles to ticks, without overflow for a deadline near `u64::MAX`
+    #[inline]
+    fn ticks(&self, cycles: u64) -> u64 {
+        cycles / self.tick_cycles + u64::from(cycles % self.tick_cycles != 0)
+    }
+
+    #[inline]
+    fn entry_mut(&mut self, id: TimerId) -> Option<&mut Entry<T>> {
+        self.entries
+            .get_mut(id.index as usize)
+            .filter(|entry| entry.gen == id.gen && entry.value.is_some())
+    }
+
+    // the first non-empty slot, and its starting tick
+    #[inline]
+    fn next_slot(&self) -> Option<(usize, usize, u64)> {
+        for level in 0..LEVELS {
+            let occupied = self.occupied[level];
+
+            if occupied == 0 {
+                continue;
+            }
+
+            let shift = LEVEL_BITS * level as u32;
+            let pos = (self.now >> shift) & SLOT_MASK;
+            let window = self.now & !((1 << (shift + LEVEL_BITS)) - 1);
+
+            if level < LEVELS - 1 {
+                let occupied = occupied & (!0 << pos);
+
+                if occupied != 0 {
+                    let slot = u64::from(occupied.trailing_zeros());
+
+                    return Some((level, slot as usize, window + (slot << shift)));
+                }
+            } else {
+                // the slots of top level after the current one are in this round, the others in the next round
+                let after = occupied & ((!0 << pos) << 1);
+                let (slot, window) = if after != 0 {
+                    (u64::from(after.trailing_zeros()), window)
+                } else {
+                    (u64::from(occupied.trailing_zeros()), window + MAX_RANGE)
+                };
+
+                return Some((level, slot as usize, window + (slot << shift)));
+            }
+        }
+
+        None
+    }
+
+    // link an entry to the slot of its expiration
+    #[inline]
+    fn link(&mut self, index: u32) {
+        let now = self.now;
+        let mut expires = self.entries[index as usize].expires.max(now);
+
+        // beyond the range of wheel, placed to the farthest slot and placed again when it is reached
+        if expires - now >= MAX_RANGE {
+            expires = now + MAX_RANGE - 1;
+        }
+
+        let masked = (now ^ expires) | SLOT_MASK;
+        let level = cmp::min(((63 - masked.leading_zeros()) / LEVEL_BITS) as usize, LEVELS - 1);
+        let slot = ((expires >> (LEVEL_BITS * level as u32)) & SLOT_MASK) as usize;
+        let idx = level * SLOTS_PER_LEVEL + slot;
+        let head = self.heads[idx];
+
+        {
+            let entry = &mut self.entries[index as usize];
+
+            entry.prev = NIL;
+            entry.next = head;
+            entry.slot = idx as u32;
+        }
+
+        if head != NIL {
+            self.entries[head as usize].prev = index;
+        }
+
+        self.heads[idx] = index;
+        self.occupied[level] |= 1 << slot;
+    }
+
+    // unlink an entry from its slot
+    #[inline]
+    fn unlink(&mut self, index: u32) {
+        let (prev, next, idx) = {
+            let entry = &mut self.entries[index as usize];
+
+            (
+                mem::replace(&mut entry.prev, NIL),
+                mem::replace(&mut entry.next, NIL),
+                mem::replace(&mut entry.slot, NIL),
+            )
+        };
+
+        if idx == NIL {
+            return;
+        }
+
+        if prev != NIL {
+            self.entries[prev as usize].next = next;
+        } else {
+            self.heads[idx as usize] = next;
+
+            if next == NIL {
+                self.occupied[idx as usize / SLOTS_PER_LEVEL] &= !(1 << (idx as usize % SLOTS_PER_LEVEL));
+            }
+        }
+
+        if next != NIL {
+            self.entries[next as usize].prev = prev;
+        }
+    }
+
+    // take the value of an unlinked entry, and put it back to the free list
+    #[inline]
+    fn release(&mut self, index: u32) -> T {
+        let entry = &mut self.entries[index as usize];
+
+        entry.gen = entry.gen.wrapping_add(1);
+
+        self.free.push(index);
+        self.len -= 1;
+
+        entry.value.take().unwrap()
+    }
+}
@@ -0,0 +1,63 @@
+use std::mem;
+use std::ops::Deref;
+
+use ffi;
+
+use mbuf::{Header, HeaderRef, MBuf};
+
+/// UDP Header
+pub type UdpHdr = ffi::udp_hdr;
+
+unsafe impl Header for UdpHdr {}
+
+/// A UDP header parsed in place from the packet data.
+pub struct UdpView<'a> {
+    off: usize,
+    hdr: HeaderRef<'a, UdpHdr>,
+}
+
+impl<'a> UdpView<'a> {
+    /// Parse the UDP header at an offset of the packet.
+    #[inline]
+    pub fn parse(m: &'a MBuf, off: usize) -> Option<Self> {
+        m.header::<UdpHdr>(off).map(|hdr| UdpView { off, hdr })
+    }
+
+    /// The source port.
+    #[inline]
+    pub fn src_port(&self) -> u16 {
+        u16::from_be(self.hdr.src_port)
+    }
+
+    /// The destination port.
+    #[inline]
+    pub fn dst_port(&self) -> u16 {
+        u16::from_be(self.hdr.dst_port)
+    }
+
+    /// The length of datagram, includes the header.
+    #[inline]
+    pub fn len(&self) -> usize {
+        usize::from(u16::from_be(self.hdr.dgram_len))
+    }
+
+    /// The checksum in host byte order, 0 if it is not computed.
+    #[inline]
+    pub fn cksum(&self) -> u16 {
+        u16::from_be(self.hdr.dgram_cksum)
+    }
+
+    /// The offset of the payload in the packet.
+    #[inline]
+    pub fn payload_offset(&self) -> usize {
+        self.off + mem::size_of::<UdpHdr>()
+    }
+}
+
+impl<'a> Deref for UdpView<'a> {
+    type Target = UdpHdr;
+
+    fn deref(&self) -> &Self::Target {
+        &self.hdr
+    }
+}
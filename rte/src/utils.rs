@@ -70,7 +70,12 @@ macro_rules! raw {
 
         impl $crate::utils::IntoRaw for $wrapper {
             fn into_raw(self) -> *mut Self::Raw {
-                self.0.as_ptr()
+                let raw = self.0.as_ptr();
+
+                // the ownership is passed to the caller, so the wrapper must not be dropped
+                ::std::mem::forget(self);
+
+                raw
             }
         }
 
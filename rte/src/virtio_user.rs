@@ -0,0 +1,123 @@
+//!
+//! The exception path with virtio_user.
+//!
+//! A `net_virtio_user` device attached to `/dev/vhost-net` creates a tap interface in the kernel,
+//! and the vhost-net kernel thread exchanges the packets with it through the virtio rings.
+//! Unlike KNI, it doesn't need an out-of-tree kernel module,
+//! and the device supports multiple queues and the checksum offloads like other Ethernet devices.
+//!
+//! The device is created as an Ethernet port, which is configured and started with `EthDevice`,
+//! each queue pair is an exception path of `VirtioUser`.
+//!
+use std::fmt::Write;
+
+use dev;
+use errors::Result;
+use ethdev::{self, EthDevice, PortId, QueueId};
+use ether::EtherAddr;
+use exception::ExceptionPath;
+use mbuf::{RxBurst, TxBurst};
+
+/// The vhost-net device of kernel.
+pub const VHOST_NET_PATH: &str = "/dev/vhost-net";
+
+/// The configuration of a virtio_user device.
+#[derive(Clone, Debug)]
+pub struct VirtioUserConf<'a> {
+    /// The path of vhost backend, the vhost-net device of kernel or a vhost-user socket.
+    pub path: &'a str,
+    /// The name of tap interface in the kernel, assigned by the kernel if empty.
+    pub iface: &'a str,
+    /// The number of queue pairs.
+    pub queues: u16,
+    /// The number of descriptors of each queue.
+    pub queue_size: u16,
+    /// The MAC address of the device, generated if `None`.
+    pub mac: Option<EtherAddr>,
+}
+
+impl<'a> Default for VirtioUserConf<'a> {
+    fn default() -> Self {
+        VirtioUserConf {
+            path: VHOST_NET_PATH,
+            iface: "",
+            queues: 1,
+            queue_size: 256,
+            mac: None,
+        }
+    }
+}
+
+impl<'a> VirtioUserConf<'a> {
+    fn devargs(&self) -> String {
+        let mut args = format!(
+            "path={},queues={},queue_size={}",
+            self.path, self.queues, self.queue_size
+        );
+
+        if !self.iface.is_empty() {
+            let _ = write!(args, ",iface={}", self.iface);
+        }
+
+        if let Some(ref mac) = self.mac {
+            let _ = write!(args, ",mac={}", mac);
+        }
+
+        args
+    }
+}
+
+/// Create a virtio_user device, e.g. `virtio_user0`, and return its port.
+pub fn create(name: &str, conf: &VirtioUserConf) -> Result<PortId> {
+    dev::hotplug_add("vdev", name, &conf.devargs())?;
+
+    ethdev::port_by_name(name)
+}
+
+/// Close the port of a virtio_user device, and remove the device.
+pub fn destroy(name: &str, port_id: PortId) -> Result<()> {
+    port_id.stop().close();
+
+    dev::hotplug_remove("vdev", name)
+}
+
+/// A queue pair of a virtio_user port, as an exception path.
+#[derive(Clone, Copy, Debug)]
+pub struct VirtioUser {
+    port_id: PortId,
+    queue_id: QueueId,
+}
+
+impl VirtioUser {
+    pub fn new(port_id: PortId, queue_id: QueueId) -> Self {
+        VirtioUser { port_id, queue_id }
+    }
+
+    /// The port of virtio_user device.
+    pub fn port_id(&self) -> PortId {
+        self.port_id
+    }
+
+    /// The queue pair of the port.
+    pub fn queue_id(&self) -> QueueId {
+        self.queue_id
+    }
+}
+
+impl ExceptionPath for VirtioUser {
+    #[inline]
+    fn rx_burst<B: RxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        self.port_id.rx_burst(self.queue_id, mbufs)
+    }
+
+    #[inline]
+    fn tx_burst<B: TxBurst + ?Sized>(&self, mbufs: &mut B) -> usize {
+        self.port_id.tx_burst(self.queue_id, mbufs)
+    }
+
+    /// The vhost-net kernel thread handles the requests of tap interface, nothing to do.
+    #[inline]
+    fn handle_requests(&self) -> Result<&Self> {
+        Ok(self)
+    }
+}
@@ -0,0 +1,401 @@
+//!
+//! Zero-copy TX from the application memory.
+//!
+//! An `ExtMem` maps a region of huge pages or a file, and registers it to the EAL as the external memory,
+//! which is also DMA mapped if the devices are bound to VFIO.
+//!
+//! A `ZeroCopyTx` slices the region into chains of mbufs, which are attached to the region as the external buffers
+//! without copying the data. The segments of a packet share a refcounted `rte_mbuf_ext_shared_info`,
+//! and the completion callback is called when the last segment is freed by the driver after it is sent.
+//!
+//! ```no_run
+//! # extern crate rte;
+//! # use std::fs::File;
+//! # use rte::ethdev::EthDevice;
+//! # use rte::mbuf::{self, MBufBatch};
+//! # use rte::zerocopy::{ExtMem, ZeroCopyTx};
+//! # fn main() {
+//! # let dev: rte::PortId = 0;
+//! let file = File::open("index.html").unwrap();
+//! let len = file.metadata().unwrap().len() as usize;
+//! let mem = ExtMem::map_file(&file, len).unwrap();
+//! let pool = mbuf::pool_create("zc_pool", 1024, 32, 0, 0, rte::socket_id() as i32).unwrap();
+//! let mut tx = ZeroCopyTx::new(mem, pool, 2048).unwrap();
+//!
+//! let mut pkts = MBufBatch::<1>::new();
+//!
+//! let _ = pkts.push(tx.packet_with(0, len, || println!("sent")).unwrap());
+//!
+//! // the unsent packets are freed with the batch
+//! dev.tx_burst(0, &mut pkts);
+//! # }
+//! ```
+//!
+use std::cmp;
+use std::fs::File;
+use std::os::raw::c_void;
+use std::os::unix::io::AsRawFd;
+use std::ptr::{self, NonNull};
+use std::slice;
+use std::sync::Arc;
+
+use libc;
+
+use ffi;
+
+use errors::{os_error, rte_error, AsResult, ErrorKind, Result};
+use mbuf::{MBuf, RawExtSharedInfo};
+use mempool::MemoryPool;
+use utils::AsRaw;
+
+// the page size of memory mapped files
+const PAGE_SIZE: usize = 4096;
+
+const MAP_HUGE_SHIFT: i32 = 26;
+
+// the maximum data length of a segment
+const MAX_SEG_SIZE: usize = u16::max_value() as usize;
+
+/// A region of the application memory registered to the EAL, which is unmapped when dropped.
+pub struct ExtMem {
+    addr: NonNull<u8>,
+    len: usize,
+    page_sz: usize,
+    // the IO address of each page, or `RTE_BAD_IOVA` if unknown
+    iovas: Vec<ffi::rte_iova_t>,
+    writable: bool,
+    dma_mapped: bool,
+}
+
+unsafe impl Send for ExtMem {}
+
+unsafe impl Sync for ExtMem {}
+
+impl Drop for ExtMem {
+    fn drop(&mut self) {
+        unsafe {
+            if self.dma_mapped {
+                for (va, iova, len) in self.iova_runs() {
+                    ffi::rte_vfio_container_dma_unmap(ffi::RTE_VFIO_DEFAULT_CONTAINER_FD, va, iova, len as u64);
+                }
+            }
+
+            ffi::rte_extmem_unregister(self.addr.as_ptr() as *mut _, self.len);
+
+            libc::munmap(self.addr.as_ptr() as *mut _, self.len);
+        }
+    }
+}
+
+impl ExtMem {
+    /// Map and lock `len` bytes of anonymous huge pages of `hugepage_sz` bytes, e.g. 2MB or 1GB.
+    pub fn map_hugepages(len: usize, hugepage_sz: usize) -> Result<Self> {
+        let len = align_up(len, hugepage_sz);
+        let flags = libc::MAP_PRIVATE
+            | libc::MAP_ANONYMOUS
+            | libc::MAP_HUGETLB
+            | libc::MAP_POPULATE
+            | libc::MAP_LOCKED
+            | ((hugepage_sz.trailing_zeros() as i32) << MAP_HUGE_SHIFT);
+
+        let addr = unsafe { libc::mmap(ptr::null_mut(), len, libc::PROT_READ | libc::PROT_WRITE, flags, -1, 0) };
+
+        ExtMem::register(addr, len, hugepage_sz, true)
+    }
+
+    /// Map the first `len` bytes of a file read-only, and lock the pages in memory.
+    ///
+    /// The file must not be shorter than `len`, or the pages past the end of file would raise `SIGBUS`.
+    pub fn map_file(file: &File, len: usize) -> Result<Self> {
+        if len as u64 > file.metadata()?.len() {
+            return Err(ErrorKind::InvalidArg("len", len).into());
+        }
+
+        let len = align_up(len, PAGE_SIZE);
+        let flags = libc::MAP_SHARED | libc::MAP_POPULATE | libc::MAP_LOCKED;
+
+        let addr = unsafe { libc::mmap(ptr::null_mut(), len, libc::PROT_READ, flags, file.as_raw_fd(), 0) };
+
+        ExtMem::register(addr, len, PAGE_SIZE, false)
+    }
+
+    fn register(addr: *mut c_void, len: usize, page_sz: usize, writable: bool) -> Result<Self> {
+        if addr == libc::MAP_FAILED {
+            return Err(os_error());
+        }
+
+        // the pages are locked, so their physical addresses will not change
+        let iova_va = unsafe { ffi::rte_eal_iova_mode() } == ffi::rte_iova_mode::RTE_IOVA_VA;
+        let mut iovas = (0..len / page_sz)
+            .map(|i| {
+                let va = addr as usize + i * page_sz;
+
+                if iova_va {
+                    va as ffi::rte_iova_t
+                } else {
+                    unsafe { ffi::rte_mem_virt2phy(va as *const _) }
+                }
+            })
+            .collect::<Vec<_>>();
+
+        let ret = unsafe { ffi::rte_extmem_register(addr, len, iovas.as_mut_ptr(), iovas.len() as u32, page_sz) };
+
+        if ret != 0 {
+            let err = rte_error();
+
+            unsafe { libc::munmap(addr, len) };
+
+            return Err(err);
+        }
+
+        // the region is unregistered and unmapped when dropped
+        let mut mem = ExtMem {
+            addr: unsafe { NonNull::new_unchecked(addr as *mut u8) },
+            len,
+            page_sz,
+            iovas,
+            writable,
+            dma_mapped: false,
+        };
+
+        // the devices bound to VFIO could only access the memory mapped to their IOMMU
+        if unsafe { ffi::rte_vfio_is_enabled(b"vfio\0".as_ptr() as *const _) } != 0
+            && mem.iovas.iter().all(|&iova| iova != ffi::RTE_BAD_IOVA)
+        {
+            for (va, iova, len) in mem.iova_runs() {
+                let ret = unsafe {
+                    ffi::rte_vfio_container_dma_map(ffi::RTE_VFIO_DEFAULT_CONTAINER_FD, va, iova, len as u64)
+                };
+
+                if ret != 0 {
+                    // the region mapped before is unmapped when dropped
+                    mem.dma_mapped = true;
+
+                    return Err(rte_error());
+                }
+            }
+
+            mem.dma_mapped = true;
+        }
+
+        Ok(mem)
+    }
+
+    // the runs of IOVA contiguous pages
+    fn iova_runs(&self) -> Vec<(u64, u64, usize)> {
+        let mut runs: Vec<(u64, u64, usize)> = Vec::new();
+
+        for (i, &iova) in self.iovas.iter().enumerate() {
+            let va = self.addr.as_ptr() as u64 + (i * self.page_sz) as u64;
+
+            if let Some(run) = runs.last_mut() {
+                if run.1 + run.2 as u64 == iova {
+                    run.2 += self.page_sz;
+
+                    continue;
+                }
+            }
+
+            runs.push((va, iova, self.page_sz));
+        }
+
+        runs
+    }
+
+    /// The length of region.
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// The page size of region.
+    pub fn page_sz(&self) -> usize {
+        self.page_sz
+    }
+
+    /// The start address of region.
+    pub fn as_ptr(&self) -> *mut u8 {
+        self.addr.as_ptr()
+    }
+
+    /// The content of region.
+    pub fn as_slice(&self) -> &[u8] {
+        unsafe { slice::from_raw_parts(self.addr.as_ptr(), self.len) }
+    }
+
+    /// The content of region, or `None` if it is a read-only file.
+    ///
+    /// The content is filled before the region is sent from, as it must not be changed by the application
+    /// before the packets are completed.
+    pub fn as_mut_slice(&mut self) -> Option<&mut [u8]> {
+        if self.writable {
+            Some(unsafe { slice::from_raw_parts_mut(self.addr.as_ptr(), self.len) })
+        } else {
+            None
+        }
+    }
+
+    /// The IO address at `off`, and the bytes contiguous in IO address after it, up to about `limit`.
+    #[inline]
+    fn iova(&self, off: usize, limit: usize) -> (ffi::rte_iova_t, usize) {
+        let page = off / self.page_sz;
+        let mut end = (page + 1) * self.page_sz;
+
+        while end < self.len && end - off < limit {
+            let (prev, next) = (self.iovas[end / self.page_sz - 1], self.iovas[end / self.page_sz]);
+
+            // the unknown IO addresses are only used by the drivers without DMA
+            let contiguous = if prev == ffi::RTE_BAD_IOVA {
+                next == ffi::RTE_BAD_IOVA
+            } else {
+                next == prev + self.page_sz as u64
+            };
+
+            if !contiguous {
+                break;
+            }
+
+            end += self.page_sz;
+        }
+
+        let iova = if self.iovas[page] == ffi::RTE_BAD_IOVA {
+            ffi::RTE_BAD_IOVA
+        } else {
+            self.iovas[page] + (off % self.page_sz) as u64
+        };
+
+        (iova, end - off)
+    }
+}
+
+/// The shared info of the segments of a packet, which is freed with the last segment.
+#[repr(C)]
+struct Completion {
+    shinfo: RawExtSharedInfo,
+    // hold the region until the packet is completed
+    mem: Arc<ExtMem>,
+    callback: Option<Box<dyn FnOnce() + Send>>,
+}
+
+unsafe extern "C" fn completion_stub(_addr: *mut c_void, opaque: *mut c_void) {
+    let completion = Box::from_raw(opaque as *mut Completion);
+
+    if let Some(callback) = completion.callback {
+        callback()
+    }
+}
+
+/// Send the application memory as the chains of mbufs attached to it.
+pub struct ZeroCopyTx {
+    mem: Arc<ExtMem>,
+    pool: MemoryPool,
+    seg_size: usize,
+}
+
+impl ZeroCopyTx {
+    /// Send from a region with the mbufs of `pool`, whose data room could be empty,
+    /// and each segment holds at most `seg_size` bytes.
+    pub fn new(mem: ExtMem, pool: MemoryPool, seg_size: usize) -> Result<Self> {
+        if seg_size == 0 || seg_size > MAX_SEG_SIZE {
+            return Err(ErrorKind::InvalidArg("seg_size", seg_size).into());
+        }
+
+        Ok(ZeroCopyTx {
+            mem: Arc::new(mem),
+            pool,
+            seg_size,
+        })
+    }
+
+    /// The region sent from.
+    pub fn mem(&self) -> &ExtMem {
+        &self.mem
+    }
+
+    /// The packets sent from the region and not completed yet.
+    pub fn in_flight(&self) -> usize {
+        Arc::strong_count(&self.mem) - 1
+    }
+
+    /// Build a packet of `len` bytes from `off` of the region.
+    pub fn packet(&mut self, off: usize, len: usize) -> Result<MBuf> {
+        self.build(off, len, None)
+    }
+
+    /// Build a packet of `len` bytes from `off` of the region,
+    /// and call `callback` when it is completed, e.g. sent or dropped.
+    pub fn packet_with<F: FnOnce() + Send + 'static>(&mut self, off: usize, len: usize, callback: F) -> Result<MBuf> {
+        self.build(off, len, Some(Box::new(callback)))
+    }
+
+    fn build(&mut self, off: usize, len: usize, callback: Option<Box<dyn FnOnce() + Send>>) -> Result<MBuf> {
+        if len == 0 || off.checked_add(len).map_or(true, |end| end > self.mem.len()) {
+            return Err(ErrorKind::InvalidArg("len", len).into());
+        }
+
+        let segs = self.segments(off, len);
+
+        if segs.len() > ffi::RTE_MBUF_MAX_NB_SEGS as usize {
+            return Err(ErrorKind::InvalidArg("len", len).into());
+        }
+
+        let mut mbufs = vec![ptr::null_mut(); segs.len()];
+
+        unsafe { ffi::_rte_pktmbuf_alloc_bulk(self.pool.as_raw(), mbufs.as_mut_ptr(), mbufs.len() as u32) }
+            .as_result()?;
+
+        let completion = Box::into_raw(Box::new(Completion {
+            shinfo: RawExtSharedInfo {
+                free_cb: Some(completion_stub),
+                fcb_opaque: ptr::null_mut(),
+                ..Default::default()
+            },
+            mem: self.mem.clone(),
+            callback,
+        }));
+
+        unsafe {
+            let shinfo = &mut (*completion).shinfo;
+
+            shinfo.fcb_opaque = completion as *mut _;
+
+            // each segment holds a reference
+            ffi::_rte_mbuf_ext_refcnt_set(shinfo, segs.len() as u16);
+
+            for (&m, &(off, len, iova)) in mbufs.iter().zip(segs.iter()) {
+                ffi::_rte_pktmbuf_attach_extbuf(m, self.mem.as_ptr().add(off) as *mut _, iova, len as u16, shinfo);
+
+                (*m).data_len = len as u16;
+                (*m).pkt_len = len as u32;
+            }
+
+            let head = mbufs[0];
+
+            for &m in &mbufs[1..] {
+                ffi::_rte_pktmbuf_chain(head, m);
+            }
+
+            Ok(MBuf::from(head))
+        }
+    }
+
+    // the offset, length and IO address of segments
+    fn segments(&self, mut off: usize, len: usize) -> Vec<(usize, usize, ffi::rte_iova_t)> {
+        let end = off + len;
+        let mut segs = Vec::with_capacity(len / self.seg_size + 1);
+
+        while off < end {
+            let (iova, contiguous) = self.mem.iova(off, self.seg_size);
+            let len = cmp::min(cmp::min(end - off, self.seg_size), contiguous);
+
+            segs.push((off, len, iova));
+
+            off += len;
+        }
+
+        segs
+    }
+}
+
+fn align_up(n: usize, align: usize) -> usize {
+    (n + align - 1) & !(align - 1)
+}